@@ -0,0 +1,125 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file Arena.h
+ * Region-based memory allocation.
+ */
+
+#pragma once
+
+#include <boost/noncopyable.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace dev
+{
+
+/**
+ * Memory region that hands out memory by bumping a pointer in large blocks and
+ * releases everything at once when it is destroyed. Individual allocations cannot be
+ * freed. Not thread-safe.
+ */
+class Arena: boost::noncopyable
+{
+public:
+	/// Creates an arena whose first block has @a _initialBlockSize bytes. Every further
+	/// block doubles in size up to @a _maxBlockSize, so that small regions stay small.
+	explicit Arena(size_t _initialBlockSize = 1024, size_t _maxBlockSize = 16 * 1024):
+		m_blockSize(_initialBlockSize), m_maxBlockSize(_maxBlockSize) {}
+
+	/// @returns @a _size bytes of memory aligned to @a _alignment, which has to be
+	/// a power of two not larger than alignof(std::max_align_t).
+	void* allocate(size_t _size, size_t _alignment)
+	{
+		size_t offset = (m_used + _alignment - 1) & ~(_alignment - 1);
+		if (m_blocks.empty() || offset + _size > m_currentBlockSize)
+			return allocateInNewBlock(_size);
+		m_used = offset + _size;
+		return m_blocks.back().get() + offset;
+	}
+
+	/// @returns the number of bytes obtained from the system so far.
+	size_t allocatedBytes() const { return m_allocatedBytes; }
+
+private:
+	void* allocateInNewBlock(size_t _size)
+	{
+		// Requests larger than half a block get a block of their own, so that
+		// the remainder of the current block is not wasted.
+		if (_size > m_blockSize / 2)
+		{
+			m_largeAllocations.emplace_back(new char[_size]);
+			m_allocatedBytes += _size;
+			return m_largeAllocations.back().get();
+		}
+		m_blocks.emplace_back(new char[m_blockSize]);
+		m_allocatedBytes += m_blockSize;
+		m_currentBlockSize = m_blockSize;
+		m_used = _size;
+		m_blockSize = std::min(2 * m_blockSize, m_maxBlockSize);
+		return m_blocks.back().get();
+	}
+
+	/// Size of the next block to allocate.
+	size_t m_blockSize;
+	size_t const m_maxBlockSize;
+	/// Blocks in allocation order, the last one is the one currently used.
+	std::vector<std::unique_ptr<char[]>> m_blocks;
+	std::vector<std::unique_ptr<char[]>> m_largeAllocations;
+	size_t m_currentBlockSize = 0;
+	/// Number of bytes used in the current block.
+	size_t m_used = 0;
+	size_t m_allocatedBytes = 0;
+};
+
+/**
+ * Standard allocator that takes its memory from an Arena. The allocator shares ownership
+ * of the arena, so objects created by std::allocate_shared keep it alive until the last
+ * of them is gone and the arena is released in one step.
+ */
+template <class T>
+class ArenaAllocator
+{
+public:
+	using value_type = T;
+
+	explicit ArenaAllocator(std::shared_ptr<Arena> _arena): m_arena(std::move(_arena)) {}
+	template <class U>
+	ArenaAllocator(ArenaAllocator<U> const& _other): m_arena(_other.arena()) {}
+
+	T* allocate(size_t _n)
+	{
+		static_assert(alignof(T) <= alignof(std::max_align_t), "Over-aligned types are not supported.");
+		return static_cast<T*>(m_arena->allocate(_n * sizeof(T), alignof(T)));
+	}
+	/// Memory is only released together with the arena.
+	void deallocate(T*, size_t) {}
+
+	std::shared_ptr<Arena> const& arena() const { return m_arena; }
+
+	template <class U>
+	bool operator==(ArenaAllocator<U> const& _other) const { return m_arena == _other.arena(); }
+	template <class U>
+	bool operator!=(ArenaAllocator<U> const& _other) const { return m_arena != _other.arena(); }
+
+private:
+	std::shared_ptr<Arena> m_arena;
+};
+
+}
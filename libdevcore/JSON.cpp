@@ -21,8 +21,10 @@
 
 #include "JSON.h"
 
+#include "Assertions.h"
 #include "CommonIO.h"
 
+#include <algorithm>
 #include <sstream>
 #include <map>
 #include <memory>
@@ -118,5 +120,150 @@ bool jsonParseFile(string const& _fileName, Json::Value& _json, string *_errs /*
 	return jsonParse(readFileAsString(_fileName), _json, _errs);
 }
 
+JsonStreamWriter::JsonStreamWriter(ostream& _stream, string const& _indentation):
+	m_stream(_stream),
+	m_indentation(_indentation),
+	m_writer(StreamWriterBuilder({{"indentation", _indentation}}).newStreamWriter())
+{
+}
+
+JsonStreamWriter::~JsonStreamWriter()
+{
+}
+
+void JsonStreamWriter::beginObject()
+{
+	beginValue();
+	m_containers.push_back(Container{false, false});
+}
+
+void JsonStreamWriter::endObject()
+{
+	assertThrow(!m_containers.empty() && !m_containers.back().isArray, JsonStreamWriterError, "No object to end.");
+	endContainer('}');
+}
+
+void JsonStreamWriter::beginArray()
+{
+	beginValue();
+	m_containers.push_back(Container{true, false});
+}
+
+void JsonStreamWriter::endArray()
+{
+	assertThrow(!m_containers.empty() && m_containers.back().isArray, JsonStreamWriterError, "No array to end.");
+	endContainer(']');
+}
+
+void JsonStreamWriter::key(string const& _key)
+{
+	assertThrow(!m_containers.empty() && !m_containers.back().isArray, JsonStreamWriterError, "Key outside of an object.");
+	openMember();
+	writeWithIndent(jsonCompactPrint(Json::Value(_key)));
+	m_stream << (m_indentation.empty() ? ":" : " : ");
+}
+
+void JsonStreamWriter::value(Json::Value const& _value)
+{
+	beginValue();
+	if ((_value.isObject() || _value.isArray()) && !_value.empty())
+	{
+		if (!m_indented)
+			writeIndent();
+		if (m_indentation.empty())
+			m_writer->write(_value, &m_stream);
+		else
+		{
+			// The nested lines have to be shifted to the current indentation.
+			stringstream text;
+			m_writer->write(_value, &text);
+			for (char c: text.str())
+				if (c == '\n')
+					m_stream << '\n' << m_indentString;
+				else
+					m_stream << c;
+		}
+	}
+	else
+		m_writer->write(_value, &m_stream);
+	endValue();
+}
+
+void JsonStreamWriter::object(Json::Value const& _object, map<string, function<void()>> const& _lazyMembers)
+{
+	assertThrow(_object.isObject() || _object.isNull(), JsonStreamWriterError, "Not an object.");
+	vector<string> keys = _object.getMemberNames();
+	for (auto const& member: _lazyMembers)
+	{
+		assertThrow(!_object.isMember(member.first), JsonStreamWriterError, "Duplicate member.");
+		keys.push_back(member.first);
+	}
+	sort(keys.begin(), keys.end());
+	beginObject();
+	for (string const& memberKey: keys)
+	{
+		key(memberKey);
+		auto lazyMember = _lazyMembers.find(memberKey);
+		if (lazyMember != _lazyMembers.end())
+			lazyMember->second();
+		else
+			value(_object[memberKey]);
+	}
+	endObject();
+}
+
+void JsonStreamWriter::openMember()
+{
+	Container& container = m_containers.back();
+	if (!container.open)
+	{
+		writeWithIndent(container.isArray ? "[" : "{");
+		m_indentString += m_indentation;
+		container.open = true;
+	}
+	else
+		m_stream << ",";
+}
+
+void JsonStreamWriter::beginValue()
+{
+	if (!m_containers.empty() && m_containers.back().isArray)
+	{
+		openMember();
+		// Elements of arrays always start on a new line.
+		if (!m_indented)
+			writeIndent();
+		m_indented = true;
+	}
+}
+
+void JsonStreamWriter::endContainer(char _closing)
+{
+	bool const open = m_containers.back().open;
+	m_containers.pop_back();
+	if (open)
+	{
+		m_indentString.resize(m_indentString.size() - m_indentation.size());
+		writeWithIndent(string(1, _closing));
+	}
+	else
+		m_stream << (_closing == '}' ? "{}" : "[]");
+	endValue();
+}
+
+void JsonStreamWriter::writeIndent()
+{
+	if (!m_indentation.empty())
+		m_stream << '\n' << m_indentString;
+}
+
+void JsonStreamWriter::writeWithIndent(string const& _text)
+{
+	if (!m_indented)
+		writeIndent();
+	m_stream << _text;
+	m_indented = false;
+}
+
 
 } // namespace dev
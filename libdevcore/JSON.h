@@ -22,9 +22,16 @@
 
 #pragma once
 
+#include <libdevcore/Exceptions.h>
+
 #include <json/json.h>
 
+#include <functional>
+#include <map>
+#include <memory>
+#include <ostream>
 #include <string>
+#include <vector>
 
 namespace dev {
 
@@ -55,4 +62,60 @@ bool jsonParse(std::string const& _input, Json::Value& _json, std::string* _errs
 /// \return \c true if the document was successfully parsed, \c false if an error occurred.
 bool jsonParseFile(std::string const& _fileName, Json::Value& _json, std::string* _errs = nullptr);
 
+DEV_SIMPLE_EXCEPTION(JsonStreamWriterError);
+
+/**
+ * Writes a JSON document to a stream piece by piece, so that large documents do not have to be
+ * built as a Json::Value first. The output is identical to the one of the jsoncpp stream writer
+ * with the same indentation, i.e. to jsonPrettyPrint for "  ", jsonCompactPrint for "" and
+ * the stream operator for "\t".
+ *
+ * Since Json::Value orders the members of objects by their keys, the members of an object
+ * have to be written in that order.
+ */
+class JsonStreamWriter
+{
+public:
+	JsonStreamWriter(std::ostream& _stream, std::string const& _indentation);
+	~JsonStreamWriter();
+
+	void beginObject();
+	void endObject();
+	void beginArray();
+	void endArray();
+	/// Starts the member @a _key of the current object, its value has to be written next.
+	void key(std::string const& _key);
+	/// Writes a complete value.
+	void value(Json::Value const& _value);
+	/// Writes an object with the members of @a _object and, for each key in @a _lazyMembers,
+	/// a member whose value is written by the given function, all in the order of their keys.
+	void object(Json::Value const& _object, std::map<std::string, std::function<void()>> const& _lazyMembers);
+
+private:
+	struct Container
+	{
+		bool isArray;
+		/// Whether the opening bracket was written, which only happens once the container is not empty.
+		bool open;
+	};
+
+	/// Writes the opening bracket of the innermost container if needed and a separator
+	/// if it is not the first element.
+	void openMember();
+	/// Prepares writing a value into the current context.
+	void beginValue();
+	void endValue() { m_indented = false; }
+	void endContainer(char _closing);
+	void writeIndent();
+	void writeWithIndent(std::string const& _text);
+
+	std::ostream& m_stream;
+	std::string const m_indentation;
+	std::unique_ptr<Json::StreamWriter> m_writer;
+	std::string m_indentString;
+	std::vector<Container> m_containers;
+	/// Mirrors the state of the jsoncpp writer: whether the current line is already indented.
+	bool m_indented = true;
+};
+
 }
@@ -0,0 +1,141 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file ThreadPool.cpp
+ * Fixed-size work-stealing thread pool.
+ */
+
+#include <libdevcore/ThreadPool.h>
+
+#include <algorithm>
+
+using namespace std;
+using namespace dev;
+
+namespace
+{
+/// Pool the current thread is a worker of, if any.
+thread_local ThreadPool const* s_currentPool = nullptr;
+/// Index of the current worker inside s_currentPool.
+thread_local size_t s_currentIndex = 0;
+}
+
+ThreadPool::ThreadPool(size_t _threads)
+{
+	if (_threads == 0)
+		_threads = hardwareConcurrency();
+	for (size_t i = 0; i < _threads; ++i)
+		m_queues.emplace_back(new TaskQueue());
+	for (size_t i = 0; i < _threads; ++i)
+		m_workers.emplace_back([this, i]() { workerLoop(i); });
+}
+
+ThreadPool::~ThreadPool()
+{
+	wait();
+	{
+		lock_guard<mutex> lock(m_mutex);
+		m_stopping = true;
+	}
+	m_taskAvailable.notify_all();
+	for (auto& worker: m_workers)
+		worker.join();
+}
+
+void ThreadPool::post(function<void()> _task)
+{
+	size_t index =
+		s_currentPool == this ?
+		s_currentIndex :
+		m_nextQueue++ % m_queues.size();
+	{
+		lock_guard<mutex> lock(m_mutex);
+		{
+			lock_guard<mutex> queueLock(m_queues[index]->mutex);
+			m_queues[index]->tasks.emplace_back(move(_task));
+		}
+		++m_pending;
+		++m_queued;
+	}
+	m_taskAvailable.notify_one();
+}
+
+void ThreadPool::wait()
+{
+	unique_lock<mutex> lock(m_mutex);
+	m_allDone.wait(lock, [&]() { return m_pending == 0; });
+}
+
+size_t ThreadPool::hardwareConcurrency()
+{
+	return max<size_t>(1, thread::hardware_concurrency());
+}
+
+void ThreadPool::workerLoop(size_t _index)
+{
+	s_currentPool = this;
+	s_currentIndex = _index;
+	while (true)
+	{
+		{
+			unique_lock<mutex> lock(m_mutex);
+			m_taskAvailable.wait(lock, [&]() { return m_stopping || m_queued > 0; });
+			if (m_queued == 0)
+				return;
+		}
+
+		function<void()> task;
+		if (!tryAcquire(_index, task))
+			continue;
+		task();
+
+		lock_guard<mutex> lock(m_mutex);
+		if (--m_pending == 0)
+			m_allDone.notify_all();
+	}
+}
+
+bool ThreadPool::tryAcquire(size_t _index, function<void()>& o_task)
+{
+	bool acquired = false;
+	{
+		TaskQueue& own = *m_queues[_index];
+		lock_guard<mutex> lock(own.mutex);
+		if (!own.tasks.empty())
+		{
+			o_task = move(own.tasks.back());
+			own.tasks.pop_back();
+			acquired = true;
+		}
+	}
+	for (size_t offset = 1; !acquired && offset < m_queues.size(); ++offset)
+	{
+		TaskQueue& victim = *m_queues[(_index + offset) % m_queues.size()];
+		lock_guard<mutex> lock(victim.mutex);
+		if (!victim.tasks.empty())
+		{
+			o_task = move(victim.tasks.front());
+			victim.tasks.pop_front();
+			acquired = true;
+		}
+	}
+	if (acquired)
+	{
+		lock_guard<mutex> lock(m_mutex);
+		--m_queued;
+	}
+	return acquired;
+}
@@ -0,0 +1,89 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file ThreadPool.h
+ * Fixed-size work-stealing thread pool.
+ */
+
+#pragma once
+
+#include <boost/noncopyable.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace dev
+{
+
+/**
+ * Fixed-size thread pool where every worker owns a task queue.
+ * Tasks posted from a worker go to its own queue, tasks posted from outside
+ * are distributed round-robin. Idle workers steal from the other queues.
+ *
+ * Tasks must not throw - exceptions have to be caught and stored by the task itself.
+ */
+class ThreadPool: boost::noncopyable
+{
+public:
+	/// Creates a pool with @a _threads workers. Zero means one worker per hardware thread.
+	explicit ThreadPool(size_t _threads = 0);
+	/// Waits for all pending tasks and joins the workers.
+	~ThreadPool();
+
+	/// Schedules @a _task for execution. Can be called from inside a task.
+	void post(std::function<void()> _task);
+	/// Blocks until all tasks posted so far (and the tasks they posted) are finished.
+	/// Must not be called from inside a task.
+	void wait();
+
+	size_t size() const { return m_workers.size(); }
+
+	/// @returns the number of hardware threads, at least one.
+	static size_t hardwareConcurrency();
+
+private:
+	struct TaskQueue
+	{
+		std::mutex mutex;
+		std::deque<std::function<void()>> tasks;
+	};
+
+	void workerLoop(size_t _index);
+	/// Pops a task from the back of queue @a _index or steals one from the front of another queue.
+	bool tryAcquire(size_t _index, std::function<void()>& o_task);
+
+	std::vector<std::unique_ptr<TaskQueue>> m_queues;
+	std::vector<std::thread> m_workers;
+
+	std::mutex m_mutex;
+	std::condition_variable m_taskAvailable;
+	std::condition_variable m_allDone;
+	/// Number of tasks posted but not yet finished.
+	size_t m_pending = 0;
+	/// Number of tasks sitting in a queue (protected by m_mutex).
+	size_t m_queued = 0;
+	bool m_stopping = false;
+	std::atomic<size_t> m_nextQueue{0};
+};
+
+}
@@ -24,6 +24,7 @@
 #include <libevmasm/CommonSubexpressionEliminator.h>
 #include <libevmasm/ControlFlowGraph.h>
 #include <libevmasm/PeepholeOptimiser.h>
+#include <libevmasm/Inliner.h>
 #include <libevmasm/JumpdestRemover.h>
 #include <libevmasm/BlockDeduplicator.h>
 #include <libevmasm/ConstantOptimiser.h>
@@ -133,6 +134,32 @@ string locationFromSources(StringMap const& _sourceCodes, SourceLocation const&
 	return cut;
 }
 
+/// @returns the number of jumps to each tag that is only used as the target of jumps directly
+/// following a push of the tag (and possibly by falling through into the tag).
+map<size_t, unsigned> directJumpCounts(AssemblyItems const& _items, set<size_t> const& _tagsReferencedFromOutside)
+{
+	map<size_t, unsigned> jumps;
+	set<size_t> otherUses = _tagsReferencedFromOutside;
+	for (size_t i = 0; i < _items.size(); ++i)
+		if (_items[i].type() == Tag)
+			jumps[size_t(_items[i].data())];
+		else if (_items[i].type() == PushTag)
+		{
+			size_t subId;
+			size_t tag;
+			tie(subId, tag) = _items[i].splitForeignPushTag();
+			if (subId != size_t(-1))
+				continue;
+			if (i + 1 < _items.size() && SemanticInformation::isJumpInstruction(_items[i + 1]))
+				jumps[tag]++;
+			else
+				otherUses.insert(tag);
+		}
+	for (size_t tag: otherUses)
+		jumps.erase(tag);
+	return jumps;
+}
+
 class Functionalizer
 {
 public:
@@ -262,70 +289,75 @@ string Assembly::toStringInHex(u256 _value)
 	return hexStr.str();
 }
 
-Json::Value Assembly::assemblyJSON(StringMap const& _sourceCodes) const
+void Assembly::itemsJSON(function<void(Json::Value&&)> const& _append) const
 {
-	Json::Value root;
-
-	Json::Value& collection = root[".code"] = Json::arrayValue;
 	for (AssemblyItem const& i: m_items)
 	{
 		switch (i.type())
 		{
 		case Operation:
-			collection.append(
+			_append(
 				createJsonValue(instructionInfo(i.instruction()).name, i.location().start, i.location().end, i.getJumpTypeAsString()));
 			break;
 		case Push:
-			collection.append(
+			_append(
 				createJsonValue("PUSH", i.location().start, i.location().end, toStringInHex(i.data()), i.getJumpTypeAsString()));
 			break;
 		case PushString:
-			collection.append(
+			_append(
 				createJsonValue("PUSH tag", i.location().start, i.location().end, m_strings.at((h256)i.data())));
 			break;
 		case PushTag:
 			if (i.data() == 0)
-				collection.append(
+				_append(
 					createJsonValue("PUSH [ErrorTag]", i.location().start, i.location().end, ""));
 			else
-				collection.append(
+				_append(
 					createJsonValue("PUSH [tag]", i.location().start, i.location().end, dev::toString(i.data())));
 			break;
 		case PushSub:
-			collection.append(
+			_append(
 				createJsonValue("PUSH [$]", i.location().start, i.location().end, dev::toString(h256(i.data()))));
 			break;
 		case PushSubSize:
-			collection.append(
+			_append(
 				createJsonValue("PUSH #[$]", i.location().start, i.location().end, dev::toString(h256(i.data()))));
 			break;
 		case PushProgramSize:
-			collection.append(
+			_append(
 				createJsonValue("PUSHSIZE", i.location().start, i.location().end));
 			break;
 		case PushLibraryAddress:
-			collection.append(
+			_append(
 				createJsonValue("PUSHLIB", i.location().start, i.location().end, m_libraries.at(h256(i.data())))
 			);
 			break;
 		case PushDeployTimeAddress:
-			collection.append(
+			_append(
 				createJsonValue("PUSHDEPLOYADDRESS", i.location().start, i.location().end)
 			);
 			break;
 		case Tag:
-			collection.append(
+			_append(
 				createJsonValue("tag", i.location().start, i.location().end, dev::toString(i.data())));
-			collection.append(
+			_append(
 				createJsonValue("JUMPDEST", i.location().start, i.location().end));
 			break;
 		case PushData:
-			collection.append(createJsonValue("PUSH data", i.location().start, i.location().end, toStringInHex(i.data())));
+			_append(createJsonValue("PUSH data", i.location().start, i.location().end, toStringInHex(i.data())));
 			break;
 		default:
 			BOOST_THROW_EXCEPTION(InvalidOpcode());
 		}
 	}
+}
+
+Json::Value Assembly::assemblyJSON(StringMap const& _sourceCodes) const
+{
+	Json::Value root;
+
+	Json::Value& collection = root[".code"] = Json::arrayValue;
+	itemsJSON([&](Json::Value&& _item) { collection.append(move(_item)); });
 
 	if (!m_data.empty() || !m_subs.empty())
 	{
@@ -348,6 +380,41 @@ Json::Value Assembly::assemblyJSON(StringMap const& _sourceCodes) const
 	return root;
 }
 
+void Assembly::assemblyJSON(JsonStreamWriter& _writer, StringMap const& _sourceCodes) const
+{
+	Json::Value root(Json::objectValue);
+	map<string, function<void()>> lazyMembers;
+	lazyMembers[".code"] = [&]()
+	{
+		_writer.beginArray();
+		itemsJSON([&](Json::Value&& _item) { _writer.value(_item); });
+		_writer.endArray();
+	};
+
+	if (!m_data.empty() || !m_subs.empty())
+		lazyMembers[".data"] = [&]()
+		{
+			Json::Value data(Json::objectValue);
+			for (auto const& i: m_data)
+				if (u256(i.first) >= m_subs.size())
+					data[toStringInHex((u256)i.first)] = toHex(i.second);
+
+			map<string, function<void()>> subs;
+			for (size_t i = 0; i < m_subs.size(); ++i)
+			{
+				std::stringstream hexStr;
+				hexStr << hex << i;
+				subs[hexStr.str()] = [&, i]() { m_subs[i]->assemblyJSON(_writer, _sourceCodes); };
+			}
+			_writer.object(data, subs);
+		};
+
+	if (m_auxiliaryData.size() > 0)
+		root[".auxdata"] = toHex(m_auxiliaryData);
+
+	_writer.object(root, lazyMembers);
+}
+
 AssemblyItem Assembly::namedTag(string const& _name)
 {
 	assertThrow(!_name.empty(), AssemblyException, "Empty named tag.");
@@ -371,6 +438,7 @@ Assembly& Assembly::optimise(bool _enable, EVMVersion _evmVersion, bool _isCreat
 	settings.runPeephole = true;
 	if (_enable)
 	{
+		settings.runInliner = true;
 		settings.runDeduplicate = true;
 		settings.runCSE = true;
 		settings.runConstantOptimiser = true;
@@ -430,6 +498,18 @@ map<u256, u256> Assembly::optimiseInternal(
 			}
 		}
 
+		if (_settings.runInliner)
+		{
+			Inliner inliner{
+				m_items,
+				_tagsReferencedFromOutside,
+				_settings.isCreation ? 1 : _settings.expectedExecutionsPerDeployment,
+				_settings.isCreation
+			};
+			if (inliner.optimise())
+				count++;
+		}
+
 		// This only modifies PushTags, we have to run again to actually remove code.
 		if (_settings.runDeduplicate)
 		{
@@ -446,15 +526,26 @@ map<u256, u256> Assembly::optimiseInternal(
 			// Control flow graph optimization has been here before but is disabled because it
 			// assumes we only jump to tags that are pushed. This is not the case anymore with
 			// function types that can be stored in storage.
+			// Instead, knowledge about storage, memory and the stack is only carried over from
+			// one block to the next along edges where all predecessors of a block are known:
+			// Straight-line code, jumps to tags that are pushed directly before the jump and are
+			// not used otherwise, and the fall-through into such tags. Blocks with other
+			// predecessors or with a predecessor further down in the code (loops) start without
+			// any knowledge.
 			AssemblyItems optimisedItems;
 
 			bool usesMSize = (find(m_items.begin(), m_items.end(), AssemblyItem{Instruction::MSIZE}) != m_items.end());
 
+			auto expressionClasses = make_shared<ExpressionClasses>();
+			map<size_t, unsigned> pendingJumps = directJumpCounts(m_items, _tagsReferencedFromOutside);
+			map<size_t, KnownStatePointer> jumpStates;
+			// Knowledge at the start of the next block, nullptr if it is unreachable.
+			KnownStatePointer state = make_shared<KnownState>(expressionClasses);
+
 			auto iter = m_items.begin();
 			while (iter != m_items.end())
 			{
-				KnownState emptyState;
-				CommonSubexpressionEliminator eliminator{emptyState};
+				CommonSubexpressionEliminator eliminator{state ? *state : KnownState(expressionClasses)};
 				auto orig = iter;
 				iter = eliminator.feedItems(iter, m_items.end(), usesMSize);
 				bool shouldReplace = false;
@@ -482,6 +573,51 @@ map<u256, u256> Assembly::optimiseInternal(
 				}
 				else
 					copy(orig, iter, back_inserter(optimisedItems));
+
+				if (iter == m_items.end())
+					break;
+				AssemblyItem const& breakingItem = *prev(iter);
+				if (state)
+				{
+					state = eliminator.initialState().copy();
+					state->reduceToTransferableKnowledge();
+				}
+				if (breakingItem.type() == Tag)
+				{
+					size_t tag = size_t(breakingItem.data());
+					if (!pendingJumps.count(tag) || pendingJumps.at(tag) > 0)
+						state = make_shared<KnownState>(expressionClasses);
+					else if (jumpStates.count(tag))
+					{
+						if (state)
+							state->reduceToCommonKnowledge(*jumpStates.at(tag), true);
+						else
+							state = jumpStates.at(tag);
+						// Removes unions of different tags on the stack.
+						state->reduceToTransferableKnowledge();
+					}
+				}
+				else if (SemanticInformation::isJumpInstruction(breakingItem))
+				{
+					if (iter - orig >= 2 && prev(iter, 2)->type() == PushTag)
+					{
+						size_t subId;
+						size_t tag;
+						tie(subId, tag) = prev(iter, 2)->splitForeignPushTag();
+						if (subId == size_t(-1) && pendingJumps.count(tag))
+						{
+							pendingJumps[tag]--;
+							if (state && jumpStates.count(tag))
+								jumpStates.at(tag)->reduceToCommonKnowledge(*state, true);
+							else if (state)
+								jumpStates[tag] = state->copy();
+						}
+					}
+					if (breakingItem == Instruction::JUMP)
+						state = nullptr;
+				}
+				else if (SemanticInformation::altersControlFlow(breakingItem))
+					state = nullptr;
 			}
 			if (optimisedItems.size() < m_items.size())
 			{
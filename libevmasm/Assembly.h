@@ -27,6 +27,7 @@
 
 #include <libdevcore/Common.h>
 #include <libdevcore/Assertions.h>
+#include <libdevcore/JSON.h>
 #include <libdevcore/Keccak256.h>
 
 #include <json/json.h>
@@ -101,6 +102,7 @@ public:
 		bool isCreation = false;
 		bool runJumpdestRemover = false;
 		bool runPeephole = false;
+		bool runInliner = false;
 		bool runDeduplicate = false;
 		bool runCSE = false;
 		bool runConstantOptimiser = false;
@@ -134,6 +136,11 @@ public:
 	Json::Value assemblyJSON(
 		StringMap const& _sourceCodes = StringMap()
 	) const;
+	/// Write the JSON representation of the assembly to @a _writer one item at a time.
+	void assemblyJSON(
+		JsonStreamWriter& _writer,
+		StringMap const& _sourceCodes = StringMap()
+	) const;
 
 public:
 	// These features are only used by LLL
@@ -158,6 +165,8 @@ protected:
 private:
 	static Json::Value createJsonValue(std::string _name, int _begin, int _end, std::string _value = std::string(), std::string _jumpType = std::string());
 	static std::string toStringInHex(u256 _value);
+	/// Calls @a _append with the JSON representation of each item, in order.
+	void itemsJSON(std::function<void(Json::Value&&)> const& _append) const;
 
 protected:
 	/// 0 is reserved for exception
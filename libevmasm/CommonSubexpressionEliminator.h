@@ -77,6 +77,10 @@ public:
 	/// @returns the resulting items after optimization.
 	AssemblyItems getOptimizedItems();
 
+	/// @returns the state the next items start from, i.e. the knowledge after the items
+	/// fed so far including the item that breaks the block. Updated by getOptimizedItems.
+	KnownState const& initialState() const { return m_initialState; }
+
 private:
 	/// Feeds the item into the system for analysis.
 	void feedItem(AssemblyItem const& _item, bool _copyItem = false);
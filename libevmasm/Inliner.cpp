@@ -0,0 +1,171 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Replaces calls to small functions without internal control flow by their body.
+ */
+
+#include <libevmasm/Inliner.h>
+
+#include <libevmasm/AssemblyItem.h>
+#include <libevmasm/GasMeter.h>
+#include <libevmasm/SemanticInformation.h>
+
+#include <libdevcore/CommonData.h>
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+using namespace dev::solidity;
+
+namespace
+{
+
+/// @returns the tag of this assembly referenced by @a _item, or -1 if it references the tag of a sub-assembly.
+size_t localTag(AssemblyItem const& _item)
+{
+	auto subAndTag = _item.splitForeignPushTag();
+	return subAndTag.first == size_t(-1) ? subAndTag.second : size_t(-1);
+}
+
+/// @returns true if the items at @a _position are PUSH <tag> JUMP [in] <tag>:
+bool isCall(AssemblyItems const& _items, size_t _position)
+{
+	return
+		_position + 2 < _items.size() &&
+		_items[_position].type() == PushTag &&
+		_items[_position + 1] == Instruction::JUMP &&
+		_items[_position + 1].getJumpType() == AssemblyItem::JumpType::IntoFunction &&
+		_items[_position + 2].type() == Tag;
+}
+
+}
+
+bool Inliner::optimise()
+{
+	map<size_t, AssemblyItems> functions = inlinableFunctions();
+	if (functions.empty())
+		return false;
+
+	map<size_t, size_t> pushCounts;
+	map<size_t, vector<size_t>> calls;
+	for (size_t i = 0; i < m_items.size(); ++i)
+		if (m_items[i].type() == PushTag)
+		{
+			size_t tag = localTag(m_items[i]);
+			if (tag == size_t(-1))
+				continue;
+			pushCounts[tag]++;
+			if (functions.count(tag) && isCall(m_items, i))
+				calls[tag].push_back(i);
+		}
+
+	// Positions of the calls to inline, mapped to the tag of the called function.
+	map<size_t, size_t> callsToInline;
+	for (auto const& function: calls)
+	{
+		bool allReferencesInlined =
+			pushCounts.at(function.first) == function.second.size() &&
+			!m_tagsReferencedFromOutside.count(function.first);
+		if (shouldInline(functions.at(function.first), function.second.size(), allReferencesInlined))
+			for (size_t position: function.second)
+				callsToInline[position] = function.first;
+	}
+	if (callsToInline.empty())
+		return false;
+
+	// The return address of an inlined call is only removed from the stack again, so its push
+	// is replaced by a constant if it is the only reference to the return tag.
+	set<size_t> unusedReturnAddresses;
+	for (auto const& call: callsToInline)
+	{
+		size_t returnTag = localTag(m_items[call.first + 2]);
+		if (pushCounts[returnTag] != 1 || m_tagsReferencedFromOutside.count(returnTag))
+			continue;
+		for (size_t position = call.first; position > 0; --position)
+			if (m_items[position - 1].type() == PushTag && localTag(m_items[position - 1]) == returnTag)
+			{
+				unusedReturnAddresses.insert(position - 1);
+				break;
+			}
+	}
+
+	AssemblyItems optimisedItems;
+	for (size_t i = 0; i < m_items.size(); ++i)
+		if (callsToInline.count(i))
+		{
+			optimisedItems += functions.at(callsToInline.at(i));
+			// Skip the jump into the function.
+			++i;
+		}
+		else if (unusedReturnAddresses.count(i))
+			optimisedItems.emplace_back(u256(0), m_items[i].location());
+		else
+			optimisedItems.push_back(m_items[i]);
+	m_items = move(optimisedItems);
+	return true;
+}
+
+map<size_t, AssemblyItems> Inliner::inlinableFunctions() const
+{
+	map<size_t, AssemblyItems> functions;
+	for (size_t i = 0; i < m_items.size(); ++i)
+	{
+		if (m_items[i].type() != Tag)
+			continue;
+		size_t end = i + 1;
+		while (
+			end < m_items.size() &&
+			m_items[end].type() != Tag &&
+			!SemanticInformation::altersControlFlow(m_items[end])
+		)
+			++end;
+		if (
+			end == m_items.size() ||
+			m_items[end] != Instruction::JUMP ||
+			m_items[end].getJumpType() != AssemblyItem::JumpType::OutOfFunction
+		)
+			continue;
+		AssemblyItems body(m_items.begin() + i + 1, m_items.begin() + end);
+		body.emplace_back(Instruction::POP, m_items[end].location());
+		functions[localTag(m_items[i])] = move(body);
+	}
+	return functions;
+}
+
+bool Inliner::shouldInline(AssemblyItems const& _body, size_t _calls, bool _allReferencesInlined) const
+{
+	// Each call saves pushing the function tag, both jumps and the JUMPDEST of the function,
+	// but has to remove the return address.
+	bigint savedGas =
+		GasMeter::runGas(Instruction::PUSH1) +
+		2 * GasMeter::runGas(Instruction::JUMP) +
+		GasMeter::runGas(Instruction::JUMPDEST) -
+		GasMeter::runGas(Instruction::POP);
+	// Assume 3 byte addresses, as the constant optimiser does.
+	bigint bodySize = bytesRequired(_body, 3);
+	bigint callSize = AssemblyItem(PushTag).bytesRequired(3) + AssemblyItem(Instruction::JUMP).bytesRequired(3);
+	bigint addedSize = bigint(_calls) * (bodySize - callSize);
+	if (_allReferencesInlined)
+		// The function itself, consisting of its JUMPDEST and the body, is removed.
+		addedSize -= bodySize + 1;
+	if (addedSize <= 0)
+		return true;
+	bigint executions = m_isCreation ? 1 : m_runs;
+	return
+		executions * _calls * savedGas >
+		addedSize * (m_isCreation ? GasCosts::txDataNonZeroGas : GasCosts::createDataGas);
+}
@@ -0,0 +1,80 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Replaces calls to small functions without internal control flow by their body.
+ */
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <set>
+#include <vector>
+
+namespace dev
+{
+namespace eth
+{
+class AssemblyItem;
+using AssemblyItems = std::vector<AssemblyItem>;
+
+/**
+ * Inlines functions whose body is a single basic block that ends in a jump out of the function.
+ *
+ * A call is recognized by the pattern
+ *   PUSH <functionTag> JUMP [in] <returnTag>:
+ * and is replaced by the body of the function, where the final JUMP [out] to the return
+ * address is replaced by a POP. If the return address is not pushed anywhere else, it is
+ * replaced by zero, so that the return tag can be removed and the basic blocks before and
+ * after the call are merged.
+ *
+ * Whether a function is inlined depends on the code size added by all of its copies and
+ * the gas saved by each call, weighted by the expected number of executions.
+ */
+class Inliner
+{
+public:
+	explicit Inliner(
+		AssemblyItems& _items,
+		std::set<size_t> const& _tagsReferencedFromOutside,
+		size_t _runs,
+		bool _isCreation
+	):
+		m_items(_items),
+		m_tagsReferencedFromOutside(_tagsReferencedFromOutside),
+		m_runs(_runs),
+		m_isCreation(_isCreation)
+	{}
+
+	/// @returns true if at least one call was inlined.
+	bool optimise();
+
+private:
+	/// @returns the bodies of all functions that can be inlined, indexed by their tag.
+	/// The final jump out of the function is replaced by a POP.
+	std::map<size_t, AssemblyItems> inlinableFunctions() const;
+	/// @returns true if inlining @a _body at @a _calls call sites is cheaper than calling it.
+	/// @param _allReferencesInlined is true if the function itself is not needed afterwards.
+	bool shouldInline(AssemblyItems const& _body, size_t _calls, bool _allReferencesInlined) const;
+
+	AssemblyItems& m_items;
+	std::set<size_t> const& m_tagsReferencedFromOutside;
+	size_t m_runs;
+	bool m_isCreation;
+};
+
+}
+}
@@ -229,6 +229,74 @@ void KnownState::reduceToCommonKnowledge(KnownState const& _other, bool _combine
 		m_sequenceNumber = max(m_sequenceNumber, _other.m_sequenceNumber);
 }
 
+void KnownState::reduceToTransferableKnowledge()
+{
+	// Classes are transferable if they do not refer to the initial stack contents of the block
+	// (undefined items) and if their value can only change through modifications of storage or
+	// memory, which is tracked by the sequence number.
+	map<Id, bool> transferable;
+	function<bool(Id)> isTransferable = [&](Id _id) -> bool
+	{
+		auto it = transferable.find(_id);
+		if (it != transferable.end())
+			return it->second;
+		ExpressionClasses::Expression const& expr = m_expressionClasses->representative(_id);
+		bool result = expr.item && expr.item->type() != UndefinedItem;
+		if (result && expr.item->type() == Operation)
+			switch (expr.item->instruction())
+			{
+			case Instruction::SLOAD:
+			case Instruction::MLOAD:
+			case Instruction::KECCAK256:
+				break;
+			default:
+				result = SemanticInformation::movable(expr.item->instruction());
+			}
+		for (Id argument: expr.arguments)
+			result = result && isTransferable(argument);
+		return transferable[_id] = result;
+	};
+
+	for (auto it = m_stackElements.begin(); it != m_stackElements.end();)
+		if (isTransferable(it->second))
+			++it;
+		else
+			it = m_stackElements.erase(it);
+
+	// Values of storage or memory slots are only useful if the code generator can access them
+	// in the next block, i.e. if they are on the stack or do not depend on storage or memory.
+	set<Id> stackClasses;
+	for (auto const& element: m_stackElements)
+		stackClasses.insert(element.second);
+	map<Id, bool> computable;
+	function<bool(Id)> isComputable = [&](Id _id) -> bool
+	{
+		if (stackClasses.count(_id))
+			return true;
+		auto it = computable.find(_id);
+		if (it != computable.end())
+			return it->second;
+		ExpressionClasses::Expression const& expr = m_expressionClasses->representative(_id);
+		bool result = expr.sequenceNumber == 0 && isTransferable(_id);
+		for (Id argument: expr.arguments)
+			result = result && isComputable(argument);
+		return computable[_id] = result;
+	};
+	auto reduceContent = [&](map<Id, Id>& _content)
+	{
+		for (auto it = _content.begin(); it != _content.end();)
+			if (isTransferable(it->first) && isComputable(it->second))
+				++it;
+			else
+				it = _content.erase(it);
+	};
+	reduceContent(m_storageContent);
+	reduceContent(m_memoryContent);
+
+	m_knownKeccak256Hashes.clear();
+	m_tagUnions.clear();
+}
+
 bool KnownState::operator==(KnownState const& _other) const
 {
 	if (m_storageContent != _other.m_storageContent || m_memoryContent != _other.m_memoryContent)
@@ -113,6 +113,13 @@ public:
 	/// @param _combineSequenceNumbers if true, sets the sequence number to the maximum of both
 	void reduceToCommonKnowledge(KnownState const& _other, bool _combineSequenceNumbers);
 
+	/// Removes all knowledge that cannot be used at the start of a subsequent block of items:
+	/// Stack elements that depend on the stack contents at the start of the current block or on
+	/// values that can change without a modification of storage or memory (like BALANCE), and
+	/// storage and memory contents whose values are neither on the stack nor computable
+	/// without reading from storage or memory.
+	void reduceToTransferableKnowledge();
+
 	/// @returns a shared pointer to a copy of this state.
 	std::shared_ptr<KnownState> copy() const { return std::make_shared<KnownState>(*this); }
 
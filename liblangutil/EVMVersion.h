@@ -76,6 +76,9 @@ public:
 	bool hasStaticCall() const { return *this >= byzantium(); }
 	bool hasBitwiseShifting() const { return *this >= constantinople(); }
 	bool hasCreate2() const { return *this >= constantinople(); }
+	/// SSTORE is charged by net gas metering (EIP-1283), i.e. writing the value a slot
+	/// already holds is cheap.
+	bool hasNetGasMeteringForStorage() const { return *this >= constantinople(); }
 
 	/// Whether we have to retain the costs for the call opcode itself (false),
 	/// or whether we can just forward easily all remaining gas (true).
@@ -124,6 +124,13 @@ void ErrorReporter::fatalError(Error::Type _type, SourceLocation const& _locatio
 	BOOST_THROW_EXCEPTION(FatalError());
 }
 
+void ErrorReporter::append(ErrorList const& _errorList)
+{
+	for (auto const& error: _errorList)
+		if (!checkForExcessiveErrors(error->type()))
+			m_errorList.push_back(error);
+}
+
 ErrorList const& ErrorReporter::errors() const
 {
 	return m_errorList;
@@ -84,6 +84,10 @@ public:
 
 	void docstringParsingError(std::string const& _description);
 
+	/// Adds errors that were collected by a different reporter, subject to the same
+	/// limits as if they had been reported through this one.
+	void append(ErrorList const& _errorList);
+
 	ErrorList const& errors() const;
 
 	void clear();
@@ -53,9 +53,14 @@
 #include <liblangutil/Exceptions.h>
 #include <liblangutil/Scanner.h>
 #include <algorithm>
+#include <cstring>
 #include <ostream>
 #include <tuple>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 using namespace std;
 
 namespace langutil
@@ -99,6 +104,126 @@ int hexValue(char c)
 		return c - 'A' + 10;
 	else return -1;
 }
+
+/// Character classes for the fast paths below. Each class provides a scalar test and,
+/// if SSE2 is available, a test on 16 bytes at once that sets all bits of the
+/// matching bytes.
+struct NonWhiteSpace
+{
+	bool operator()(char _c) const { return !isWhiteSpace(_c); }
+#if defined(__SSE2__)
+	__m128i operator()(__m128i _chunk) const
+	{
+		__m128i whiteSpace = _mm_or_si128(
+			_mm_or_si128(_mm_cmpeq_epi8(_chunk, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(_chunk, _mm_set1_epi8('\n'))),
+			_mm_or_si128(_mm_cmpeq_epi8(_chunk, _mm_set1_epi8('\t')), _mm_cmpeq_epi8(_chunk, _mm_set1_epi8('\r')))
+		);
+		return _mm_andnot_si128(whiteSpace, _mm_set1_epi8(char(0xff)));
+	}
+#endif
+};
+
+/// Bytes that can start a line break: 0x0a to 0x0d and the first bytes of the UTF-8 encodings
+/// of NEL, LS and PS (see Scanner::isUnicodeLinebreak).
+struct LinebreakStart
+{
+	bool operator()(char _c) const
+	{
+		return (0x0a <= _c && _c <= 0x0d) || uint8_t(_c) == 0xc2 || uint8_t(_c) == 0xe2;
+	}
+#if defined(__SSE2__)
+	__m128i operator()(__m128i _chunk) const
+	{
+		return _mm_or_si128(
+			_mm_and_si128(_mm_cmpgt_epi8(_chunk, _mm_set1_epi8(0x09)), _mm_cmplt_epi8(_chunk, _mm_set1_epi8(0x0e))),
+			_mm_or_si128(_mm_cmpeq_epi8(_chunk, _mm_set1_epi8(char(0xc2))), _mm_cmpeq_epi8(_chunk, _mm_set1_epi8(char(0xe2))))
+		);
+	}
+#endif
+};
+
+/// Characters that end a run of plain characters inside a string literal:
+/// the quote, a backslash and the start of a line break.
+struct StringSpecial
+{
+	explicit StringSpecial(char _quote): quote(_quote) {}
+	bool operator()(char _c) const { return _c == quote || _c == '\\' || LinebreakStart{}(_c); }
+#if defined(__SSE2__)
+	__m128i operator()(__m128i _chunk) const
+	{
+		return _mm_or_si128(
+			_mm_or_si128(_mm_cmpeq_epi8(_chunk, _mm_set1_epi8(quote)), _mm_cmpeq_epi8(_chunk, _mm_set1_epi8('\\'))),
+			LinebreakStart{}(_chunk)
+		);
+	}
+#endif
+	char quote;
+};
+
+/// Line feeds and stars, the characters that need attention inside multi-line doc comments.
+struct LineFeedOrStar
+{
+	bool operator()(char _c) const { return _c == '\n' || _c == '*'; }
+#if defined(__SSE2__)
+	__m128i operator()(__m128i _chunk) const
+	{
+		return _mm_or_si128(_mm_cmpeq_epi8(_chunk, _mm_set1_epi8('\n')), _mm_cmpeq_epi8(_chunk, _mm_set1_epi8('*')));
+	}
+#endif
+};
+
+struct NonHexDigit
+{
+	bool operator()(char _c) const { return !isHexDigit(_c); }
+#if defined(__SSE2__)
+	__m128i operator()(__m128i _chunk) const
+	{
+		auto inRange = [&](char _from, char _to) {
+			return _mm_and_si128(
+				_mm_cmpgt_epi8(_chunk, _mm_set1_epi8(_from - 1)),
+				_mm_cmplt_epi8(_chunk, _mm_set1_epi8(_to + 1))
+			);
+		};
+		__m128i hexDigit = _mm_or_si128(_mm_or_si128(inRange('0', '9'), inRange('a', 'f')), inRange('A', 'F'));
+		return _mm_andnot_si128(hexDigit, _mm_set1_epi8(char(0xff)));
+	}
+#endif
+};
+
+/// @returns the number of characters from the current position of @a _source up to
+/// (excluding) the first one that matches @a _class or up to the end of the input.
+template <class CharacterClass>
+size_t countUntil(CharStream const& _source, CharacterClass const& _class)
+{
+	if (_source.isPastEndOfInput())
+		return 0;
+	char const* begin = _source.source().data() + _source.position();
+	char const* end = _source.source().data() + _source.source().size();
+	char const* it = begin;
+#if defined(__SSE2__)
+	for (; end - it >= 16; it += 16)
+	{
+		__m128i chunk = _mm_loadu_si128(reinterpret_cast<__m128i const*>(it));
+		if (int mask = _mm_movemask_epi8(_class(chunk)))
+			return size_t(it - begin) + size_t(__builtin_ctz(unsigned(mask)));
+	}
+#endif
+	while (it != end && !_class(*it))
+		++it;
+	return size_t(it - begin);
+}
+
+/// Specialisation for a single character, memchr is vectorised by the C library.
+size_t countUntil(CharStream const& _source, char _c)
+{
+	if (_source.isPastEndOfInput())
+		return 0;
+	size_t const position = size_t(_source.position());
+	size_t const remaining = _source.source().size() - position;
+	char const* begin = _source.source().data() + position;
+	void const* found = memchr(begin, _c, remaining);
+	return found ? size_t(static_cast<char const*>(found) - begin) : remaining;
+}
 } // end anonymous namespace
 
 std::string to_string(ScannerError _errorCode)
@@ -268,7 +393,10 @@ bool Scanner::skipWhitespace()
 {
 	int const startPosition = sourcePos();
 	while (isWhiteSpace(m_char))
+	{
 		advance();
+		skip(countUntil(*m_source, NonWhiteSpace{}));
+	}
 	// Return whether or not we skipped any characters.
 	return sourcePos() != startPosition;
 }
@@ -284,7 +412,10 @@ Token Scanner::skipSingleLineComment()
 	// Line terminator is not part of the comment. If it is a
 	// non-ascii line terminator, it will result in a parser error.
 	while (!isUnicodeLinebreak())
+	{
 		if (!advance()) break;
+		skip(countUntil(*m_source, LinebreakStart{}));
+	}
 
 	return Token::Whitespace;
 }
@@ -320,6 +451,7 @@ Token Scanner::scanSingleLineDocComment()
 			break;
 		addCommentLiteralChar(m_char);
 		advance();
+		addLiteralSpan(m_nextSkippedComment.literal, countUntil(*m_source, LinebreakStart{}));
 	}
 	literal.complete();
 	return Token::CommentLiteral;
@@ -330,6 +462,9 @@ Token Scanner::skipMultiLineComment()
 	advance();
 	while (!isSourcePastEndOfInput())
 	{
+		skip(countUntil(*m_source, '*'));
+		if (isSourcePastEndOfInput())
+			break;
 		char ch = m_char;
 		advance();
 
@@ -391,6 +526,7 @@ Token Scanner::scanMultiLineDocComment()
 		addCommentLiteralChar(m_char);
 		charsAdded = true;
 		advance();
+		addLiteralSpan(m_nextSkippedComment.literal, countUntil(*m_source, LineFeedOrStar{}));
 	}
 	literal.complete();
 	if (!endFound)
@@ -739,8 +875,12 @@ Token Scanner::scanString()
 	char const quote = m_char;
 	advance();  // consume quote
 	LiteralScope literal(this, LITERAL_TYPE_STRING);
-	while (m_char != quote && !isSourcePastEndOfInput() && !isUnicodeLinebreak())
+	while (true)
 	{
+		// Characters without special meaning are copied in bulk.
+		addLiteralSpan(m_nextToken.literal, countUntil(*m_source, StringSpecial(quote)));
+		if (m_char == quote || isSourcePastEndOfInput() || isUnicodeLinebreak())
+			break;
 		char c = m_char;
 		advance();
 		if (c == '\\')
@@ -763,8 +903,20 @@ Token Scanner::scanHexString()
 	char const quote = m_char;
 	advance();  // consume quote
 	LiteralScope literal(this, LITERAL_TYPE_STRING);
-	while (m_char != quote && !isSourcePastEndOfInput())
+	while (true)
 	{
+		// Decode complete pairs of hex digits in bulk, an unpaired digit
+		// is left to scanHexByte, which reports the error.
+		size_t const digits = countUntil(*m_source, NonHexDigit{}) & ~size_t(1);
+		if (digits > 0)
+		{
+			char const* hex = m_source->source().data() + sourcePos();
+			for (size_t i = 0; i < digits; i += 2)
+				addLiteralChar(char(hexValue(hex[i]) * 16 + hexValue(hex[i + 1])));
+			skip(digits);
+		}
+		if (m_char == quote || isSourcePastEndOfInput())
+			break;
 		char c = m_char;
 		if (!scanHexByte(c))
 			// can only return false if hex-byte is incomplete (only one hex digit instead of two)
@@ -788,7 +940,7 @@ void Scanner::scanDecimalDigits()
 		return;
 
 	// May continue with decimal digit or underscore for grouping.
-	do addLiteralCharAndAdvance();
+	do advance();
 	while (!m_source->isPastEndOfInput() && (isDecimalDigit(m_char) || m_char == '_'));
 
 	// Defer further validation of underscore to SyntaxChecker.
@@ -798,10 +950,12 @@ Token Scanner::scanNumber(char _charSeen)
 {
 	enum { DECIMAL, HEX, BINARY } kind = DECIMAL;
 	LiteralScope literal(this, LITERAL_TYPE_NUMBER);
+	// Number literals are copied from the source once they are complete.
+	int start = sourcePos();
 	if (_charSeen == '.')
 	{
 		// we have already seen a decimal point of the float
-		addLiteralChar('.');
+		start--;
 		if (m_char == '_')
 			return setError(ScannerError::IllegalToken);
 		scanDecimalDigits();  // we know we have at least one digit
@@ -812,18 +966,18 @@ Token Scanner::scanNumber(char _charSeen)
 		// if the first character is '0' we must check for octals and hex
 		if (m_char == '0')
 		{
-			addLiteralCharAndAdvance();
+			advance();
 			// either 0, 0exxx, 0Exxx, 0.xxx or a hex number
 			if (m_char == 'x')
 			{
 				// hex number
 				kind = HEX;
-				addLiteralCharAndAdvance();
+				advance();
 				if (!isHexDigit(m_char))
 					return setError(ScannerError::IllegalHexDigit); // we must have at least one hex digit after 'x'
 
 				while (isHexDigit(m_char) || m_char == '_') // We keep the underscores for later validation
-					addLiteralCharAndAdvance();
+					advance();
 			}
 			else if (isDecimalDigit(m_char))
 				// We do not allow octal numbers
@@ -839,17 +993,18 @@ Token Scanner::scanNumber(char _charSeen)
 				{
 					// Assume the input may be a floating point number with leading '_' in fraction part.
 					// Recover by consuming it all but returning `Illegal` right away.
-					addLiteralCharAndAdvance(); // '.'
-					addLiteralCharAndAdvance(); // '_'
+					advance(); // '.'
+					advance(); // '_'
 					scanDecimalDigits();
 				}
 				if (m_source->isPastEndOfInput() || !isDecimalDigit(m_source->get(1)))
 				{
 					// A '.' has to be followed by a number.
+					setLiteralFromSource(start);
 					literal.complete();
 					return Token::Number;
 				}
-				addLiteralCharAndAdvance();
+				advance();
 				scanDecimalDigits();
 			}
 		}
@@ -864,16 +1019,17 @@ Token Scanner::scanNumber(char _charSeen)
 		{
 			// Recover from wrongly placed underscore as delimiter in literal with scientific
 			// notation by consuming until the end.
-			addLiteralCharAndAdvance(); // 'e'
-			addLiteralCharAndAdvance(); // '_'
+			advance(); // 'e'
+			advance(); // '_'
 			scanDecimalDigits();
+			setLiteralFromSource(start);
 			literal.complete();
 			return Token::Number;
 		}
 		// scan exponent
-		addLiteralCharAndAdvance(); // 'e' | 'E'
+		advance(); // 'e' | 'E'
 		if (m_char == '+' || m_char == '-')
-			addLiteralCharAndAdvance();
+			advance();
 		if (!isDecimalDigit(m_char)) // we must have at least one decimal digit after 'e'/'E'
 			return setError(ScannerError::IllegalExponent);
 		scanDecimalDigits();
@@ -884,6 +1040,7 @@ Token Scanner::scanNumber(char _charSeen)
 	// if the value is 0).
 	if (isDecimalDigit(m_char) || isIdentifierStart(m_char))
 		return setError(ScannerError::IllegalNumberEnd);
+	setLiteralFromSource(start);
 	literal.complete();
 	return Token::Number;
 }
@@ -892,10 +1049,12 @@ tuple<Token, unsigned, unsigned> Scanner::scanIdentifierOrKeyword()
 {
 	solAssert(isIdentifierStart(m_char), "");
 	LiteralScope literal(this, LITERAL_TYPE_STRING);
-	addLiteralCharAndAdvance();
+	int start = sourcePos();
+	advance();
 	// Scan the rest of the identifier characters.
 	while (isIdentifierPart(m_char)) //get full literal
-		addLiteralCharAndAdvance();
+		advance();
+	setLiteralFromSource(start);
 	literal.complete();
 	return TokenTraits::fromIdentifierOrKeyword(m_nextToken.literal);
 }
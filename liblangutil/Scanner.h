@@ -185,11 +185,26 @@ private:
 	///@name Literal buffer support
 	inline void addLiteralChar(char c) { m_nextToken.literal.push_back(c); }
 	inline void addCommentLiteralChar(char c) { m_nextSkippedComment.literal.push_back(c); }
-	inline void addLiteralCharAndAdvance() { addLiteralChar(m_char); advance(); }
+	/// Sets the literal of the next token to the source between @a _start and the current
+	/// position in one step. Only valid for tokens whose literal is a verbatim part of the source.
+	void setLiteralFromSource(int _start)
+	{
+		m_nextToken.literal.assign(m_source->source(), size_t(_start), size_t(sourcePos() - _start));
+	}
+	/// Appends the next @a _chars characters of the source to @a _literal and advances past them.
+	void addLiteralSpan(std::string& _literal, size_t _chars)
+	{
+		if (_chars == 0)
+			return;
+		_literal.append(m_source->source(), size_t(sourcePos()), _chars);
+		skip(_chars);
+	}
 	void addUnicodeAsUTF8(unsigned codepoint);
 	///@}
 
 	bool advance() { m_char = m_source->advanceAndGet(); return !m_source->isPastEndOfInput(); }
+	/// Advances by @a _chars characters at once.
+	void skip(size_t _chars) { if (_chars > 0) m_char = m_source->advanceAndGet(_chars); }
 	void rollback(int _amount) { m_char = m_source->rollback(_amount); }
 
 	inline Token selectErrorToken(ScannerError _err) { advance(); return setError(_err); }
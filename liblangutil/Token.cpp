@@ -42,7 +42,8 @@
 
 #include <liblangutil/Token.h>
 #include <boost/range/iterator_range.hpp>
-#include <map>
+#include <cstring>
+#include <vector>
 
 using namespace std;
 
@@ -137,17 +138,82 @@ int parseSize(string::const_iterator _begin, string::const_iterator _end)
 	}
 }
 
-static Token keywordByName(string const& _name)
+namespace
 {
-	// The following macros are used inside TOKEN_LIST and cause non-keyword tokens to be ignored
-	// and keywords to be put inside the keywords variable.
+
+/**
+ * Perfect hash table of all keywords. The hash function is parameterised by a seed that is
+ * chosen on construction such that no two keywords share a slot, so a lookup costs one
+ * hash computation and at most one string comparison.
+ */
+class KeywordTable
+{
+public:
+	KeywordTable()
+	{
+		// The following macros are used inside TOKEN_LIST and cause non-keyword tokens to be ignored
+		// and keywords to be put inside the keywords variable.
 #define KEYWORD(name, string, precedence) {string, Token::name},
 #define TOKEN(name, string, precedence)
-	static const map<string, Token> keywords({TOKEN_LIST(TOKEN, KEYWORD)});
+		vector<pair<char const*, Token>> const keywords{TOKEN_LIST(TOKEN, KEYWORD)};
 #undef KEYWORD
 #undef TOKEN
-	auto it = keywords.find(_name);
-	return it == keywords.end() ? Token::Identifier : it->second;
+		while (!tryBuild(keywords))
+			++m_seed;
+	}
+
+	Token lookup(char const* _name, size_t _length) const
+	{
+		Entry const& entry = m_entries[hash(_name, _length) & (c_size - 1)];
+		if (entry.length == _length && entry.name && memcmp(entry.name, _name, _length) == 0)
+			return entry.token;
+		return Token::Identifier;
+	}
+
+private:
+	struct Entry
+	{
+		char const* name = nullptr;
+		size_t length = 0;
+		Token token = Token::Identifier;
+	};
+
+	/// Has to be a power of two.
+	static size_t const c_size = 2048;
+
+	size_t hash(char const* _name, size_t _length) const
+	{
+		// FNV-1a
+		size_t h = 2166136261u ^ m_seed;
+		for (size_t i = 0; i < _length; ++i)
+			h = (h ^ uint8_t(_name[i])) * 16777619u;
+		return h ^ (h >> 11);
+	}
+
+	bool tryBuild(vector<pair<char const*, Token>> const& _keywords)
+	{
+		m_entries = vector<Entry>(c_size);
+		for (auto const& keyword: _keywords)
+		{
+			size_t length = strlen(keyword.first);
+			Entry& entry = m_entries[hash(keyword.first, length) & (c_size - 1)];
+			if (entry.name)
+				return false;
+			entry = Entry{keyword.first, length, keyword.second};
+		}
+		return true;
+	}
+
+	vector<Entry> m_entries;
+	size_t m_seed = 0;
+};
+
+Token keywordByName(char const* _name, size_t _length)
+{
+	static KeywordTable const keywords;
+	return keywords.lookup(_name, _length);
+}
+
 }
 
 tuple<Token, unsigned int, unsigned int> fromIdentifierOrKeyword(string const& _literal)
@@ -155,10 +221,9 @@ tuple<Token, unsigned int, unsigned int> fromIdentifierOrKeyword(string const& _
 	auto positionM = find_if(_literal.begin(), _literal.end(), ::isdigit);
 	if (positionM != _literal.end())
 	{
-		string baseType(_literal.begin(), positionM);
 		auto positionX = find_if_not(positionM, _literal.end(), ::isdigit);
 		int m = parseSize(positionM, positionX);
-		Token keyword = keywordByName(baseType);
+		Token keyword = keywordByName(_literal.data(), size_t(positionM - _literal.begin()));
 		if (keyword == Token::Bytes)
 		{
 			if (0 < m && m <= 32 && positionX == _literal.end())
@@ -197,7 +262,7 @@ tuple<Token, unsigned int, unsigned int> fromIdentifierOrKeyword(string const& _
 		return make_tuple(Token::Identifier, 0, 0);
 	}
 
-	return make_tuple(keywordByName(_literal), 0, 0);
+	return make_tuple(keywordByName(_literal.data(), _literal.size()), 0, 0);
 }
 
 }
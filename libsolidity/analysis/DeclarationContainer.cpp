@@ -26,6 +26,8 @@
 #include <libsolidity/ast/Types.h>
 #include <libdevcore/StringUtils.h>
 
+#include <algorithm>
+
 using namespace std;
 using namespace dev;
 using namespace dev::solidity;
@@ -39,10 +41,12 @@ Declaration const* DeclarationContainer::conflictingDeclaration(
 		_name = &_declaration.name();
 	solAssert(!_name->empty(), "");
 	vector<Declaration const*> declarations;
-	if (m_declarations.count(*_name))
-		declarations += m_declarations.at(*_name);
-	if (m_invisibleDeclarations.count(*_name))
-		declarations += m_invisibleDeclarations.at(*_name);
+	auto visible = m_declarations.find(*_name);
+	if (visible != m_declarations.end())
+		declarations = visible->second;
+	auto invisible = m_invisibleDeclarations.find(*_name);
+	if (invisible != m_invisibleDeclarations.end())
+		declarations += invisible->second;
 
 	if (
 		dynamic_cast<FunctionDefinition const*>(&_declaration) ||
@@ -82,13 +86,15 @@ Declaration const* DeclarationContainer::conflictingDeclaration(
 
 void DeclarationContainer::activateVariable(ASTString const& _name)
 {
+	auto invisible = m_invisibleDeclarations.find(_name);
 	solAssert(
-		m_invisibleDeclarations.count(_name) && m_invisibleDeclarations.at(_name).size() == 1,
+		invisible != m_invisibleDeclarations.end() && invisible->second.size() == 1,
 		"Tried to activate a non-inactive variable or multiple inactive variables with the same name."
 	);
-	solAssert(m_declarations.count(_name) == 0 || m_declarations.at(_name).empty(), "");
-	m_declarations[_name].emplace_back(m_invisibleDeclarations.at(_name).front());
-	m_invisibleDeclarations.erase(_name);
+	vector<Declaration const*>& visible = m_declarations[_name];
+	solAssert(visible.empty(), "");
+	visible.emplace_back(invisible->second.front());
+	m_invisibleDeclarations.erase(invisible);
 }
 
 bool DeclarationContainer::isInvisible(ASTString const& _name) const
@@ -127,15 +133,28 @@ vector<Declaration const*> DeclarationContainer::resolveName(ASTString const& _n
 {
 	solAssert(!_name.empty(), "Attempt to resolve empty name.");
 	vector<Declaration const*> result;
-	if (m_declarations.count(_name))
-		result = m_declarations.at(_name);
-	if (_alsoInvisible && m_invisibleDeclarations.count(_name))
-		result += m_invisibleDeclarations.at(_name);
-	if (result.empty() && _recursive && m_enclosingContainer)
-		result = m_enclosingContainer->resolveName(_name, true, _alsoInvisible);
+	for (DeclarationContainer const* container = this; container; container = container->m_enclosingContainer)
+	{
+		auto visible = container->m_declarations.find(_name);
+		if (visible != container->m_declarations.end())
+			result = visible->second;
+		if (_alsoInvisible)
+		{
+			auto invisible = container->m_invisibleDeclarations.find(_name);
+			if (invisible != container->m_invisibleDeclarations.end())
+				result += invisible->second;
+		}
+		if (!result.empty() || !_recursive)
+			break;
+	}
 	return result;
 }
 
+map<ASTString, vector<Declaration const*>> DeclarationContainer::declarations() const
+{
+	return map<ASTString, vector<Declaration const*>>(m_declarations.begin(), m_declarations.end());
+}
+
 vector<ASTString> DeclarationContainer::similarNames(ASTString const& _name) const
 {
 
@@ -145,17 +164,17 @@ vector<ASTString> DeclarationContainer::similarNames(ASTString const& _name) con
 
 	vector<ASTString> similar;
 	size_t maximumEditDistance = _name.size() > 3 ? 2 : _name.size() / 2;
-	for (auto const& declaration: m_declarations)
-	{
-		string const& declarationName = declaration.first;
-		if (stringWithinDistance(_name, declarationName, maximumEditDistance, MAXIMUM_LENGTH_THRESHOLD))
-			similar.push_back(declarationName);
-	}
-	for (auto const& declaration: m_invisibleDeclarations)
+	// Visible names are suggested before invisible ones, both in the order of the names.
+	for (auto const* declarations: {&m_declarations, &m_invisibleDeclarations})
 	{
-		string const& declarationName = declaration.first;
-		if (stringWithinDistance(_name, declarationName, maximumEditDistance, MAXIMUM_LENGTH_THRESHOLD))
-			similar.push_back(declarationName);
+		size_t const found = similar.size();
+		for (auto const& declaration: *declarations)
+		{
+			string const& declarationName = declaration.first;
+			if (stringWithinDistance(_name, declarationName, maximumEditDistance, MAXIMUM_LENGTH_THRESHOLD))
+				similar.push_back(declarationName);
+		}
+		sort(similar.begin() + found, similar.end());
 	}
 
 	if (m_enclosingContainer)
@@ -26,6 +26,7 @@
 #include <boost/noncopyable.hpp>
 #include <map>
 #include <set>
+#include <unordered_map>
 
 namespace dev
 {
@@ -53,7 +54,8 @@ public:
 	std::vector<Declaration const*> resolveName(ASTString const& _name, bool _recursive = false, bool _alsoInvisible = false) const;
 	ASTNode const* enclosingNode() const { return m_enclosingNode; }
 	DeclarationContainer const* enclosingContainer() const { return m_enclosingContainer; }
-	std::map<ASTString, std::vector<Declaration const*>> const& declarations() const { return m_declarations; }
+	/// @returns the visible declarations of this container ordered by name.
+	std::map<ASTString, std::vector<Declaration const*>> declarations() const;
 	/// @returns whether declaration is valid, and if not also returns previous declaration.
 	Declaration const* conflictingDeclaration(Declaration const& _declaration, ASTString const* _name = nullptr) const;
 
@@ -71,8 +73,8 @@ public:
 private:
 	ASTNode const* m_enclosingNode;
 	DeclarationContainer const* m_enclosingContainer;
-	std::map<ASTString, std::vector<Declaration const*>> m_declarations;
-	std::map<ASTString, std::vector<Declaration const*>> m_invisibleDeclarations;
+	std::unordered_map<ASTString, std::vector<Declaration const*>> m_declarations;
+	std::unordered_map<ASTString, std::vector<Declaration const*>> m_invisibleDeclarations;
 };
 
 }
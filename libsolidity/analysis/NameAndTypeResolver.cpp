@@ -38,7 +38,7 @@ namespace solidity
 
 NameAndTypeResolver::NameAndTypeResolver(
 	vector<Declaration const*> const& _globals,
-	map<ASTNode const*, shared_ptr<DeclarationContainer>>& _scopes,
+	unordered_map<ASTNode const*, shared_ptr<DeclarationContainer>>& _scopes,
 	ErrorReporter& _errorReporter
 ) :
 	m_scopes(_scopes),
@@ -54,6 +54,8 @@ NameAndTypeResolver::NameAndTypeResolver(
 
 bool NameAndTypeResolver::registerDeclarations(SourceUnit& _sourceUnit, ASTNode const* _currentScope)
 {
+	// New declarations can be injected into existing contract scopes.
+	m_inheritableDeclarations.clear();
 	// The helper registers all declarations in m_scopes as a side-effect of its construction.
 	try
 	{
@@ -325,44 +327,56 @@ bool NameAndTypeResolver::resolveNamesAndTypesInternal(ASTNode& _node, bool _res
 
 void NameAndTypeResolver::importInheritedScope(ContractDefinition const& _base)
 {
+	for (auto const& declaration: inheritableDeclarations(_base))
+		if (!m_currentScope->registerDeclaration(*declaration))
+		{
+			SourceLocation firstDeclarationLocation;
+			SourceLocation secondDeclarationLocation;
+			Declaration const* conflictingDeclaration = m_currentScope->conflictingDeclaration(*declaration);
+			solAssert(conflictingDeclaration, "");
+
+			// Usual shadowing is not an error
+			if (dynamic_cast<VariableDeclaration const*>(declaration) && dynamic_cast<VariableDeclaration const*>(conflictingDeclaration))
+				continue;
+
+			// Usual shadowing is not an error
+			if (dynamic_cast<ModifierDefinition const*>(declaration) && dynamic_cast<ModifierDefinition const*>(conflictingDeclaration))
+				continue;
+
+			if (declaration->location().start < conflictingDeclaration->location().start)
+			{
+				firstDeclarationLocation = declaration->location();
+				secondDeclarationLocation = conflictingDeclaration->location();
+			}
+			else
+			{
+				firstDeclarationLocation = conflictingDeclaration->location();
+				secondDeclarationLocation = declaration->location();
+			}
+
+			m_errorReporter.declarationError(
+				secondDeclarationLocation,
+				SecondarySourceLocation().append("The previous declaration is here:", firstDeclarationLocation),
+				"Identifier already declared."
+			);
+		}
+}
+
+vector<Declaration const*> const& NameAndTypeResolver::inheritableDeclarations(ContractDefinition const& _base)
+{
+	auto cached = m_inheritableDeclarations.find(&_base);
+	if (cached != m_inheritableDeclarations.end())
+		return cached->second;
+
 	auto iterator = m_scopes.find(&_base);
 	solAssert(iterator != end(m_scopes), "");
+	vector<Declaration const*>& declarations = m_inheritableDeclarations[&_base];
 	for (auto const& nameAndDeclaration: iterator->second->declarations())
 		for (auto const& declaration: nameAndDeclaration.second)
 			// Import if it was declared in the base, is not the constructor and is visible in derived classes
 			if (declaration->scope() == &_base && declaration->isVisibleInDerivedContracts())
-				if (!m_currentScope->registerDeclaration(*declaration))
-				{
-					SourceLocation firstDeclarationLocation;
-					SourceLocation secondDeclarationLocation;
-					Declaration const* conflictingDeclaration = m_currentScope->conflictingDeclaration(*declaration);
-					solAssert(conflictingDeclaration, "");
-
-					// Usual shadowing is not an error
-					if (dynamic_cast<VariableDeclaration const*>(declaration) && dynamic_cast<VariableDeclaration const*>(conflictingDeclaration))
-						continue;
-
-					// Usual shadowing is not an error
-					if (dynamic_cast<ModifierDefinition const*>(declaration) && dynamic_cast<ModifierDefinition const*>(conflictingDeclaration))
-						continue;
-
-					if (declaration->location().start < conflictingDeclaration->location().start)
-					{
-						firstDeclarationLocation = declaration->location();
-						secondDeclarationLocation = conflictingDeclaration->location();
-					}
-					else
-					{
-						firstDeclarationLocation = conflictingDeclaration->location();
-						secondDeclarationLocation = declaration->location();
-					}
-
-					m_errorReporter.declarationError(
-						secondDeclarationLocation,
-						SecondarySourceLocation().append("The previous declaration is here:", firstDeclarationLocation),
-						"Identifier already declared."
-					);
-				}
+				declarations.push_back(declaration);
+	return declarations;
 }
 
 void NameAndTypeResolver::linearizeBaseContracts(ContractDefinition& _contract)
@@ -449,7 +463,7 @@ string NameAndTypeResolver::similarNameSuggestions(ASTString const& _name) const
 }
 
 DeclarationRegistrationHelper::DeclarationRegistrationHelper(
-	map<ASTNode const*, shared_ptr<DeclarationContainer>>& _scopes,
+	unordered_map<ASTNode const*, shared_ptr<DeclarationContainer>>& _scopes,
 	ASTNode& _astRoot,
 	ErrorReporter& _errorReporter,
 	ASTNode const* _currentScope
@@ -690,7 +704,7 @@ void DeclarationRegistrationHelper::endVisit(EventDefinition&)
 
 void DeclarationRegistrationHelper::enterNewSubScope(ASTNode& _subScope)
 {
-	map<ASTNode const*, shared_ptr<DeclarationContainer>>::iterator iter;
+	unordered_map<ASTNode const*, shared_ptr<DeclarationContainer>>::iterator iter;
 	bool newlyAdded;
 	shared_ptr<DeclarationContainer> container(new DeclarationContainer(m_currentScope, m_scopes[m_currentScope].get()));
 	tie(iter, newlyAdded) = m_scopes.emplace(&_subScope, move(container));
@@ -31,6 +31,7 @@
 
 #include <list>
 #include <map>
+#include <unordered_map>
 
 namespace langutil
 {
@@ -54,7 +55,7 @@ public:
 	/// are filled during the lifetime of this object.
 	NameAndTypeResolver(
 		std::vector<Declaration const*> const& _globals,
-		std::map<ASTNode const*, std::shared_ptr<DeclarationContainer>>& _scopes,
+		std::unordered_map<ASTNode const*, std::shared_ptr<DeclarationContainer>>& _scopes,
 		langutil::ErrorReporter& _errorReporter
 	);
 	/// Registers all declarations found in the AST node, usually a source unit.
@@ -115,6 +116,10 @@ private:
 	/// Imports all members declared directly in the given contract (i.e. does not import inherited members)
 	/// into the current scope if they are not present already.
 	void importInheritedScope(ContractDefinition const& _base);
+	/// @returns the members declared directly in the given contract that are visible in derived
+	/// contracts, ordered by name. The list is computed once per contract, since in deep inheritance
+	/// hierarchies every base is imported into each of its derived contracts.
+	std::vector<Declaration const*> const& inheritableDeclarations(ContractDefinition const& _base);
 
 	/// Computes "C3-Linearization" of base contracts and stores it inside the contract. Reports errors if any
 	void linearizeBaseContracts(ContractDefinition& _contract);
@@ -127,7 +132,9 @@ private:
 	/// where nullptr denotes the global scope. Note that structs are not scope since they do
 	/// not contain code.
 	/// Aliases (for example `import "x" as y;`) create multiple pointers to the same scope.
-	std::map<ASTNode const*, std::shared_ptr<DeclarationContainer>>& m_scopes;
+	std::unordered_map<ASTNode const*, std::shared_ptr<DeclarationContainer>>& m_scopes;
+	/// Cache for @a inheritableDeclarations.
+	std::unordered_map<ContractDefinition const*, std::vector<Declaration const*>> m_inheritableDeclarations;
 
 	DeclarationContainer* m_currentScope = nullptr;
 	langutil::ErrorReporter& m_errorReporter;
@@ -145,7 +152,7 @@ public:
 	/// @param _currentScope should be nullptr if we start at SourceUnit, but can be different
 	/// to inject new declarations into an existing scope, used by snippets.
 	DeclarationRegistrationHelper(
-		std::map<ASTNode const*, std::shared_ptr<DeclarationContainer>>& _scopes,
+		std::unordered_map<ASTNode const*, std::shared_ptr<DeclarationContainer>>& _scopes,
 		ASTNode& _astRoot,
 		langutil::ErrorReporter& _errorReporter,
 		ASTNode const* _currentScope = nullptr
@@ -196,7 +203,7 @@ private:
 	/// @returns the canonical name of the current scope.
 	std::string currentCanonicalName() const;
 
-	std::map<ASTNode const*, std::shared_ptr<DeclarationContainer>>& m_scopes;
+	std::unordered_map<ASTNode const*, std::shared_ptr<DeclarationContainer>>& m_scopes;
 	ASTNode const* m_currentScope = nullptr;
 	VariableScope* m_currentFunction = nullptr;
 	langutil::ErrorReporter& m_errorReporter;
@@ -24,6 +24,7 @@
 #include <libsolidity/analysis/NameAndTypeResolver.h>
 #include <libsolidity/analysis/ConstantEvaluator.h>
 #include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/TypeProvider.h>
 
 #include <libyul/AsmAnalysis.h>
 #include <libyul/AsmAnalysisInfo.h>
@@ -129,7 +130,7 @@ bool ReferencesResolver::visit(ElementaryTypeName const& _typeName)
 			{
 				case StateMutability::Payable:
 				case StateMutability::NonPayable:
-					_typeName.annotation().type = make_shared<AddressType>(*_typeName.stateMutability());
+					_typeName.annotation().type = TypeProvider::address(*_typeName.stateMutability());
 					break;
 				default:
 					m_errorReporter.typeError(
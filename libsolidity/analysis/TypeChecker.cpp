@@ -22,6 +22,7 @@
 
 #include <libsolidity/analysis/TypeChecker.h>
 #include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/TypeProvider.h>
 
 #include <libyul/AsmAnalysis.h>
 #include <libyul/AsmAnalysisInfo.h>
@@ -177,7 +178,7 @@ TypePointers TypeChecker::typeCheckABIDecodeAndRetrieveReturnType(FunctionCall c
 			actualType = ReferenceType::copyForLocationIfReference(DataLocation::Memory, actualType);
 			// We force address payable for address types.
 			if (actualType->category() == Type::Category::Address)
-				actualType = make_shared<AddressType>(StateMutability::Payable);
+				actualType = TypeProvider::address(StateMutability::Payable);
 			solAssert(
 				!actualType->dataStoredIn(DataLocation::CallData) &&
 				!actualType->dataStoredIn(DataLocation::Storage),
@@ -1274,7 +1275,7 @@ void TypeChecker::endVisit(BinaryOperation const& _operation)
 	_operation.annotation().commonType = commonType;
 	_operation.annotation().type =
 		TokenTraits::isCompareOp(_operation.getOperator()) ?
-		make_shared<BoolType>() :
+		TypeProvider::boolean() :
 		commonType;
 	_operation.annotation().isPure =
 		_operation.leftExpression().annotation().isPure &&
@@ -1400,7 +1401,7 @@ TypePointer TypeChecker::typeCheckTypeConversionAndRetrieveReturnType(
 		if (resultType->category() == Type::Category::Address)
 		{
 			bool const payable = argType->isExplicitlyConvertibleTo(AddressType::addressPayable());
-			resultType = make_shared<AddressType>(
+			resultType = TypeProvider::address(
 				payable ? StateMutability::Payable : StateMutability::NonPayable
 			);
 		}
@@ -1908,7 +1909,7 @@ void TypeChecker::endVisit(NewExpression const& _newExpression)
 			);
 		type = ReferenceType::copyForLocationIfReference(DataLocation::Memory, type);
 		_newExpression.annotation().type = make_shared<FunctionType>(
-			TypePointers{make_shared<IntegerType>(256)},
+			TypePointers{TypeProvider::uint256()},
 			TypePointers{type},
 			strings(),
 			strings(),
@@ -2090,8 +2091,7 @@ bool TypeChecker::visit(IndexAccess const& _access)
 		}
 		else
 		{
-			expectType(*index, IntegerType::uint256());
-			if (!m_errorReporter.hasErrors())
+			if (expectType(*index, IntegerType::uint256()))
 				if (auto numberType = dynamic_cast<RationalNumberType const*>(type(*index).get()))
 				{
 					solAssert(!numberType->isFractional(), "");
@@ -2146,7 +2146,7 @@ bool TypeChecker::visit(IndexAccess const& _access)
 				if (bytesType.numBytes() <= integerType->literalValue(nullptr))
 					m_errorReporter.typeError(_access.location(), "Out of bounds array access.");
 		}
-		resultType = make_shared<FixedBytesType>(1);
+		resultType = TypeProvider::fixedBytes(1);
 		isLValue = false; // @todo this heavily depends on how it is embedded
 		break;
 	}
@@ -2254,7 +2254,7 @@ void TypeChecker::endVisit(Literal const& _literal)
 	if (_literal.looksLikeAddress())
 	{
 		// Assign type here if it even looks like an address. This prevents double errors for invalid addresses
-		_literal.annotation().type = make_shared<AddressType>(StateMutability::Payable);
+		_literal.annotation().type = TypeProvider::address(StateMutability::Payable);
 
 		string msg;
 		if (_literal.valueWithoutUnderscores().length() != 42) // "0x" + 40 hex digits
@@ -2311,7 +2311,11 @@ bool TypeChecker::contractDependenciesAreCyclic(
 		return true;
 	set<ContractDefinition const*> seen(_seenContracts);
 	seen.insert(&_contract);
-	for (auto const* c: _contract.annotation().contractDependencies)
+	auto const& dependencies =
+		(m_otherContractDependencies && &_contract != m_scope) ?
+		m_otherContractDependencies(_contract) :
+		_contract.annotation().contractDependencies;
+	for (auto const* c: dependencies)
 		if (contractDependenciesAreCyclic(*c, seen))
 			return true;
 	return false;
@@ -29,6 +29,9 @@
 #include <libsolidity/ast/ASTVisitor.h>
 #include <libsolidity/ast/Types.h>
 
+#include <functional>
+#include <set>
+
 namespace langutil
 {
 class ErrorReporter;
@@ -47,9 +50,20 @@ namespace solidity
 class TypeChecker: private ASTConstVisitor
 {
 public:
+	/// Provides the contract dependencies of contracts other than the one being checked.
+	using ContractDependencies = std::function<std::set<ContractDefinition const*> const&(ContractDefinition const&)>;
+
 	/// @param _errorReporter provides the error logging functionality.
-	TypeChecker(EVMVersion _evmVersion, langutil::ErrorReporter& _errorReporter):
+	/// @param _otherContractDependencies if set, is used instead of the annotations of other
+	/// contracts to detect cyclic contract creation, because these annotations are written
+	/// while contracts are checked concurrently.
+	TypeChecker(
+		EVMVersion _evmVersion,
+		langutil::ErrorReporter& _errorReporter,
+		ContractDependencies _otherContractDependencies = ContractDependencies()
+	):
 		m_evmVersion(_evmVersion),
+		m_otherContractDependencies(std::move(_otherContractDependencies)),
 		m_errorReporter(_errorReporter)
 	{}
 
@@ -156,6 +170,8 @@ private:
 
 	EVMVersion m_evmVersion;
 
+	ContractDependencies m_otherContractDependencies;
+
 	/// Flag indicating whether we are currently inside an EmitStatement.
 	bool m_insideEmitStatement = false;
 
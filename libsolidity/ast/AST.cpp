@@ -34,15 +34,18 @@ using namespace std;
 using namespace dev;
 using namespace dev::solidity;
 
+/// Per-thread counter for AST node IDs, so that concurrent compilations
+/// each number their nodes starting from one.
 class IDDispenser
 {
 public:
 	static size_t next() { return ++instance(); }
 	static void reset() { instance() = 0; }
+	static void setNext(size_t _id) { instance() = _id - 1; }
 private:
 	static size_t& instance()
 	{
-		static IDDispenser dispenser;
+		thread_local IDDispenser dispenser;
 		return dispenser.id;
 	}
 	size_t id = 0;
@@ -64,6 +67,11 @@ void ASTNode::resetID()
 	IDDispenser::reset();
 }
 
+void ASTNode::setNextID(size_t _id)
+{
+	IDDispenser::setNext(_id);
+}
+
 ASTAnnotation& ASTNode::annotation() const
 {
 	if (!m_annotation)
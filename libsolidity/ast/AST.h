@@ -69,8 +69,11 @@ public:
 
 	/// @returns an identifier of this AST node that is unique for a single compilation run.
 	size_t id() const { return m_id; }
-	/// Resets the global ID counter. This invalidates all previous IDs.
+	/// Resets the ID counter of the current thread. This invalidates all previous IDs.
 	static void resetID();
+	/// Sets the ID counter of the current thread so that the next node created receives the
+	/// ID @a _id. Used to recreate nodes with the IDs they had before.
+	static void setNextID(size_t _id);
 
 	virtual void accept(ASTVisitor& _visitor) = 0;
 	virtual void accept(ASTConstVisitor& _visitor) const = 0;
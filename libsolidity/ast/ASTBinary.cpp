@@ -0,0 +1,1498 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Compact binary serialisation of the AST.
+ */
+
+#include <libsolidity/ast/ASTBinary.h>
+
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/Types.h>
+
+#include <libyul/AsmData.h>
+
+#include <liblangutil/CharStream.h>
+
+#include <libdevcore/CommonData.h>
+
+#include <algorithm>
+
+using namespace std;
+using namespace dev;
+using namespace langutil;
+using namespace dev::solidity;
+
+namespace
+{
+
+bytes const c_magic{'S', 'A', 'S', 'T'};
+uint64_t const c_formatVersion = 1;
+
+void appendVarint(bytes& _output, uint64_t _value)
+{
+	while (_value >= 0x80)
+	{
+		_output.push_back(uint8_t(_value | 0x80));
+		_value >>= 7;
+	}
+	_output.push_back(uint8_t(_value));
+}
+
+/// Maps signed to unsigned integers such that values of small magnitude stay small.
+uint64_t zigzag(int64_t _value)
+{
+	return (uint64_t(_value) << 1) ^ uint64_t(_value >> 63);
+}
+
+int64_t unzigzag(uint64_t _value)
+{
+	return int64_t(_value >> 1) ^ -int64_t(_value & 1);
+}
+
+/// @returns the visibility as given in the source, i.e. without applying the default.
+Declaration::Visibility declaredVisibility(Declaration const& _declaration)
+{
+	return _declaration.noVisibilitySpecified() ? Declaration::Visibility::Default : _declaration.visibility();
+}
+
+bool isTyped(ASTBinaryNodeKind _kind)
+{
+	return
+		_kind == ASTBinaryNodeKind::VariableDeclaration ||
+		(ASTBinaryNodeKind::Conditional <= _kind && _kind <= ASTBinaryNodeKind::Literal);
+}
+
+}
+
+bytes ASTBinaryWriter::write(SourceUnit const& _sourceUnit)
+{
+	m_nodes.clear();
+	m_stringIndices.clear();
+	m_strings.clear();
+	m_typeIndices.clear();
+	m_typesByIdentifier.clear();
+	m_types.clear();
+	m_source = _sourceUnit.location().source;
+
+	_sourceUnit.accept(*this);
+	size_t sourceName = stringIndex(m_source ? m_source->name() : _sourceUnit.annotation().path);
+
+	bytes output = c_magic;
+	appendVarint(output, c_formatVersion);
+	appendVarint(output, m_strings.size());
+	for (string const* str: m_strings)
+	{
+		appendVarint(output, str->size());
+		output += asBytes(*str);
+	}
+	appendVarint(output, m_types.size());
+	for (auto const& type: m_types)
+	{
+		appendVarint(output, type.first + 1);
+		appendVarint(output, type.second + 1);
+	}
+	appendVarint(output, sourceName + 1);
+	output += m_nodes;
+	m_nodes.clear();
+	return output;
+}
+
+bool ASTBinaryWriter::visit(SourceUnit const& _node)
+{
+	writeHeader(ASTBinaryNodeKind::SourceUnit, _node);
+	writeNodes(_node.nodes());
+	return false;
+}
+
+bool ASTBinaryWriter::visit(PragmaDirective const& _node)
+{
+	writeHeader(ASTBinaryNodeKind::PragmaDirective, _node);
+	writeVarint(_node.tokens().size());
+	for (Token token: _node.tokens())
+		writeToken(token);
+	writeVarint(_node.literals().size());
+	for (ASTString const& literal: _node.literals())
+		writeString(literal);
+	return false;
+}
+
+bool ASTBinaryWriter::visit(ImportDirective const& _node)
+{
+	writeHeader(ASTBinaryNodeKind::ImportDirective, _node);
+	writeString(_node.path());
+	writeString(_node.name());
+	writeVarint(_node.symbolAliases().size());
+	for (auto const& symbolAlias: _node.symbolAliases())
+	{
+		writeNode(symbolAlias.first);
+		writeOptionalString(symbolAlias.second);
+	}
+	return false;
+}
+
+bool ASTBinaryWriter::visit(ContractDefinition const& _node)
+{
+	writeHeader(ASTBinaryNodeKind::ContractDefinition, _node);
+	writeString(_node.name());
+	writeOptionalString(_node.documentation());
+	writeNodes(_node.baseContracts());
+	writeNodes(_node.subNodes());
+	writeVarint(unsigned(_node.contractKind()));
+	return false;
+}
+
+bool ASTBinaryWriter::visit(InheritanceSpecifier const& _node)
+{
+	writeHeader(ASTBinaryNodeKind::InheritanceSpecifier, _node);
+	writeNode(&_node.name());
+	writeOptionalNodes(_node.arguments());
+	return false;
+}
+
+bool ASTBinaryWriter::visit(UsingForDirective const& _node)
+{
+	writeHeader(ASTBinaryNodeKind::UsingForDirective, _node);
+	writeNode(&_node.libraryName());
+	writeNode(_node.typeName());
+	return false;
+}
+
+bool ASTBinaryWriter::visit(StructDefinition const& _node)
+{
+	writeHeader(ASTBinaryNodeKind::StructDefinition, _node);
+	writeString(_node.name());
+	writeNodes(_node.members());
+	return false;
+}
+
+bool ASTBinaryWriter::visit(EnumDefinition const& _node)
+{
+	writeHeader(ASTBinaryNodeKind::EnumDefinition, _node);
+	writeString(_node.name());
+	writeNodes(_node.members());
+	return false;
+}
+
+bool ASTBinaryWriter::visit(EnumValue const& _node)
+{
+	writeHeader(ASTBinaryNodeKind::EnumValue, _node);
+	writeString(_node.name());
+	return false;
+}
+
+bool ASTBinaryWriter::visit(ParameterList const& _node)
+{
+	writeHeader(ASTBinaryNodeKind::ParameterList, _node);
+	writeNodes(_node.parameters());
+	return false;
+}
+
+bool ASTBinaryWriter::visit(FunctionDefinition const& _node)
+{
+	writeHeader(ASTBinaryNodeKind::FunctionDefinition, _node);
+	writeString(_node.name());
+	writeVarint(unsigned(declaredVisibility(_node)));
+	writeVarint(unsigned(_node.stateMutability()));
+	writeBool(_node.isConstructor());
+	writeOptionalString(_node.documentation());
+	writeNode(&_node.parameterList());
+	writeNodes(_node.modifiers());
+	writeNode(_node.returnParameterList());
+	writeNode(_node.isImplemented() ? &_node.body() : nullptr);
+	return false;
+}
+
+bool ASTBinaryWriter::visit(VariableDeclaration const& _node)
+{
+	writeHeader(ASTBinaryNodeKind::VariableDeclaration, _node);
+	writeType(_node.annotation().type);
+	writeNode(_node.typeName());
+	writeString(_node.name());
+	writeNode(_node.value());
+	writeVarint(unsigned(declaredVisibility(_node)));
+	writeBool(_node.isStateVariable());
+	writeBool(_node.isIndexed());
+	writeBool(_node.isConstant());
+	writeVarint(unsigned(_node.referenceLocation()));
+	return false;
+}
+
+bool ASTBinaryWriter::visit(ModifierDefinition const& _node)
+{
+	writeHeader(ASTBinaryNodeKind::ModifierDefinition, _node);
+	writeString(_node.name());
+	writeOptionalString(_node.documentation());
+	writeNode(&_node.parameterList());
+	writeNode(&_node.body());
+	return false;
+}
+
+bool ASTBinaryWriter::visit(ModifierInvocation const& _node)
+{
+	writeHeader(ASTBinaryNodeKind::ModifierInvocation, _node);
+	writeNode(_node.name());
+	writeOptionalNodes(_node.arguments());
+	return false;
+}
+
+bool ASTBinaryWriter::visit(EventDefinition const& _node)
+{
+	writeHeader(ASTBinaryNodeKind::EventDefinition, _node);
+	writeString(_node.name());
+	writeOptionalString(_node.documentation());
+	writeNode(&_node.parameterList());
+	writeBool(_node.isAnonymous());
+	return false;
+}
+
+bool ASTBinaryWriter::visit(ElementaryTypeName const& _node)
+{
+	writeHeader(ASTBinaryNodeKind::ElementaryTypeName, _node);
+	writeElementaryTypeNameToken(_node.typeName());
+	writeVarint(_node.stateMutability() ? unsigned(*_node.stateMutability()) + 1 : 0);
+	return false;
+}
+
+bool ASTBinaryWriter::visit(UserDefinedTypeName const& _node)
+{
+	writeHeader(ASTBinaryNodeKind::UserDefinedTypeName, _node);
+	writeVarint(_node.namePath().size());
+	for (ASTString const& name: _node.namePath())
+		writeString(name);
+	return false;
+}
+
+bool ASTBinaryWriter::visit(FunctionTypeName const& _node)
+{
+	writeHeader(ASTBinaryNodeKind::FunctionTypeName, _node);
+	writeNode(_node.parameterTypeList());
+	writeNode(_node.returnParameterTypeList());
+	writeVarint(unsigned(_node.visibility()));
+	writeVarint(unsigned(_node.stateMutability()));
+	return false;
+}
+
+bool ASTBinaryWriter::visit(Mapping const& _node)
+{
+	writeHeader(ASTBinaryNodeKind::Mapping, _node);
+	writeNode(&_node.keyType());
+	writeNode(&_node.valueType());
+	return false;
+}
+
+bool ASTBinaryWriter::visit(ArrayTypeName const& _node)
+{
+	writeHeader(ASTBinaryNodeKind::ArrayTypeName, _node);
+	writeNode(&_node.baseType());
+	writeNode(_node.length());
+	return false;
+}
+
+bool ASTBinaryWriter::visit(InlineAssembly const& _node)
+{
+	writeHeader(ASTBinaryNodeKind::InlineAssembly, _node);
+	writeOptionalString(_node.documentation());
+	writeYul(_node.operations());
+	return false;
+}
+
+bool ASTBinaryWriter::visit(Block const& _node)
+{
+	writeHeader(ASTBinaryNodeKind::Block, _node);
+	writeOptionalString(_node.documentation());
+	writeNodes(_node.statements());
+	return false;
+}
+
+bool ASTBinaryWriter::visit(PlaceholderStatement const& _node)
+{
+	writeHeader(ASTBinaryNodeKind::PlaceholderStatement, _node);
+	writeOptionalString(_node.documentation());
+	return false;
+}
+
+bool ASTBinaryWriter::visit(IfStatement const& _node)
+{
+	writeHeader(ASTBinaryNodeKind::IfStatement, _node);
+	writeOptionalString(_node.documentation());
+	writeNode(&_node.condition());
+	writeNode(&_node.trueStatement());
+	writeNode(_node.falseStatement());
+	return false;
+}
+
+bool ASTBinaryWriter::visit(WhileStatement const& _node)
+{
+	writeHeader(ASTBinaryNodeKind::WhileStatement, _node);
+	writeOptionalString(_node.documentation());
+	writeNode(&_node.condition());
+	writeNode(&_node.body());
+	writeBool(_node.isDoWhile());
+	return false;
+}
+
+bool ASTBinaryWriter::visit(ForStatement const& _node)
+{
+	writeHeader(ASTBinaryNodeKind::ForStatement, _node);
+	writeOptionalString(_node.documentation());
+	writeNode(_node.initializationExpression());
+	writeNode(_node.condition());
+	writeNode(_node.loopExpression());
+	writeNode(&_node.body());
+	return false;
+}
+
+bool ASTBinaryWriter::visit(Continue const& _node)
+{
+	writeHeader(ASTBinaryNodeKind::Continue, _node);
+	writeOptionalString(_node.documentation());
+	return false;
+}
+
+bool ASTBinaryWriter::visit(Break const& _node)
+{
+	writeHeader(ASTBinaryNodeKind::Break, _node);
+	writeOptionalString(_node.documentation());
+	return false;
+}
+
+bool ASTBinaryWriter::visit(Return const& _node)
+{
+	writeHeader(ASTBinaryNodeKind::Return, _node);
+	writeOptionalString(_node.documentation());
+	writeNode(_node.expression());
+	return false;
+}
+
+bool ASTBinaryWriter::visit(Throw const& _node)
+{
+	writeHeader(ASTBinaryNodeKind::Throw, _node);
+	writeOptionalString(_node.documentation());
+	return false;
+}
+
+bool ASTBinaryWriter::visit(EmitStatement const& _node)
+{
+	writeHeader(ASTBinaryNodeKind::EmitStatement, _node);
+	writeOptionalString(_node.documentation());
+	writeNode(&_node.eventCall());
+	return false;
+}
+
+bool ASTBinaryWriter::visit(VariableDeclarationStatement const& _node)
+{
+	writeHeader(ASTBinaryNodeKind::VariableDeclarationStatement, _node);
+	writeOptionalString(_node.documentation());
+	writeNodes(_node.declarations());
+	writeNode(_node.initialValue());
+	return false;
+}
+
+bool ASTBinaryWriter::visit(ExpressionStatement const& _node)
+{
+	writeHeader(ASTBinaryNodeKind::ExpressionStatement, _node);
+	writeOptionalString(_node.documentation());
+	writeNode(&_node.expression());
+	return false;
+}
+
+bool ASTBinaryWriter::visit(Conditional const& _node)
+{
+	writeHeader(ASTBinaryNodeKind::Conditional, _node);
+	writeNode(&_node.condition());
+	writeNode(&_node.trueExpression());
+	writeNode(&_node.falseExpression());
+	return false;
+}
+
+bool ASTBinaryWriter::visit(Assignment const& _node)
+{
+	writeHeader(ASTBinaryNodeKind::Assignment, _node);
+	writeNode(&_node.leftHandSide());
+	writeToken(_node.assignmentOperator());
+	writeNode(&_node.rightHandSide());
+	return false;
+}
+
+bool ASTBinaryWriter::visit(TupleExpression const& _node)
+{
+	writeHeader(ASTBinaryNodeKind::TupleExpression, _node);
+	writeNodes(_node.components());
+	writeBool(_node.isInlineArray());
+	return false;
+}
+
+bool ASTBinaryWriter::visit(UnaryOperation const& _node)
+{
+	writeHeader(ASTBinaryNodeKind::UnaryOperation, _node);
+	writeToken(_node.getOperator());
+	writeNode(&_node.subExpression());
+	writeBool(_node.isPrefixOperation());
+	return false;
+}
+
+bool ASTBinaryWriter::visit(BinaryOperation const& _node)
+{
+	writeHeader(ASTBinaryNodeKind::BinaryOperation, _node);
+	writeNode(&_node.leftExpression());
+	writeToken(_node.getOperator());
+	writeNode(&_node.rightExpression());
+	return false;
+}
+
+bool ASTBinaryWriter::visit(FunctionCall const& _node)
+{
+	writeHeader(ASTBinaryNodeKind::FunctionCall, _node);
+	writeNode(&_node.expression());
+	writeNodes(_node.arguments());
+	writeVarint(_node.names().size());
+	for (ASTPointer<ASTString> const& name: _node.names())
+		writeString(*name);
+	return false;
+}
+
+bool ASTBinaryWriter::visit(NewExpression const& _node)
+{
+	writeHeader(ASTBinaryNodeKind::NewExpression, _node);
+	writeNode(&_node.typeName());
+	return false;
+}
+
+bool ASTBinaryWriter::visit(MemberAccess const& _node)
+{
+	writeHeader(ASTBinaryNodeKind::MemberAccess, _node);
+	writeNode(&_node.expression());
+	writeString(_node.memberName());
+	return false;
+}
+
+bool ASTBinaryWriter::visit(IndexAccess const& _node)
+{
+	writeHeader(ASTBinaryNodeKind::IndexAccess, _node);
+	writeNode(&_node.baseExpression());
+	writeNode(_node.indexExpression());
+	return false;
+}
+
+bool ASTBinaryWriter::visit(Identifier const& _node)
+{
+	writeHeader(ASTBinaryNodeKind::Identifier, _node);
+	writeString(_node.name());
+	return false;
+}
+
+bool ASTBinaryWriter::visit(ElementaryTypeNameExpression const& _node)
+{
+	writeHeader(ASTBinaryNodeKind::ElementaryTypeNameExpression, _node);
+	writeElementaryTypeNameToken(_node.typeName());
+	return false;
+}
+
+bool ASTBinaryWriter::visit(Literal const& _node)
+{
+	writeHeader(ASTBinaryNodeKind::Literal, _node);
+	writeToken(_node.token());
+	writeString(_node.value());
+	writeToken(Token(_node.subDenomination()));
+	return false;
+}
+
+bool ASTBinaryWriter::visitNode(ASTNode const&)
+{
+	solAssert(false, "AST node not supported by the binary format.");
+	return false;
+}
+
+void ASTBinaryWriter::writeVarint(uint64_t _value)
+{
+	appendVarint(m_nodes, _value);
+}
+
+size_t ASTBinaryWriter::stringIndex(string const& _string)
+{
+	auto inserted = m_stringIndices.emplace(_string, m_strings.size());
+	if (inserted.second)
+		m_strings.push_back(&inserted.first->first);
+	return inserted.first->second;
+}
+
+void ASTBinaryWriter::writeString(string const& _string)
+{
+	writeVarint(stringIndex(_string) + 1);
+}
+
+void ASTBinaryWriter::writeOptionalString(ASTPointer<ASTString> const& _string)
+{
+	if (_string)
+		writeString(*_string);
+	else
+		writeVarint(0);
+}
+
+void ASTBinaryWriter::writeLocation(SourceLocation const& _location)
+{
+	if (!_location.source)
+	{
+		writeVarint(0);
+		return;
+	}
+	writeVarint(zigzag(_location.start) + 1);
+	writeVarint(zigzag(int64_t(_location.end) - _location.start));
+}
+
+void ASTBinaryWriter::writeType(TypePointer const& _type)
+{
+	if (!_type)
+	{
+		writeVarint(0);
+		return;
+	}
+	auto it = m_typeIndices.find(_type.get());
+	if (it == m_typeIndices.end())
+	{
+		// Types that are not canonical instances are interned by their identifier.
+		string identifier = _type->identifier();
+		auto inserted = m_typesByIdentifier.emplace(identifier, m_types.size());
+		if (inserted.second)
+			m_types.emplace_back(stringIndex(identifier), stringIndex(_type->toString()));
+		it = m_typeIndices.emplace(_type.get(), inserted.first->second).first;
+	}
+	writeVarint(it->second + 1);
+}
+
+void ASTBinaryWriter::writeElementaryTypeNameToken(ElementaryTypeNameToken const& _token)
+{
+	writeToken(_token.token());
+	writeVarint(_token.firstNumber());
+	writeVarint(_token.secondNumber());
+}
+
+void ASTBinaryWriter::writeHeader(ASTBinaryNodeKind _kind, ASTNode const& _node)
+{
+	writeVarint(unsigned(_kind));
+	writeVarint(_node.id());
+	writeLocation(_node.location());
+}
+
+void ASTBinaryWriter::writeHeader(ASTBinaryNodeKind _kind, Expression const& _node)
+{
+	writeHeader(_kind, static_cast<ASTNode const&>(_node));
+	writeType(_node.annotation().type);
+}
+
+void ASTBinaryWriter::writeNode(ASTNode const* _node)
+{
+	if (_node)
+		_node->accept(*this);
+	else
+		writeVarint(unsigned(ASTBinaryNodeKind::Null));
+}
+
+void ASTBinaryWriter::writeOptionalNodes(vector<ASTPointer<Expression>> const* _nodes)
+{
+	if (!_nodes)
+	{
+		writeVarint(0);
+		return;
+	}
+	writeVarint(_nodes->size() + 1);
+	for (auto const& node: *_nodes)
+		writeNode(node);
+}
+
+void ASTBinaryWriter::writeYul(yul::Block const& _block)
+{
+	writeLocation(_block.location);
+	writeVarint(_block.statements.size());
+	for (yul::Statement const& statement: _block.statements)
+		writeYul(statement);
+}
+
+void ASTBinaryWriter::writeYul(yul::Statement const& _statement)
+{
+	// The tag is the index of the alternative in the variant.
+	writeVarint(_statement.which());
+	boost::apply_visitor([this](auto const& _node) { writeYul(_node); }, _statement);
+}
+
+void ASTBinaryWriter::writeYul(yul::Expression const& _expression)
+{
+	writeVarint(_expression.which());
+	boost::apply_visitor([this](auto const& _node) { writeYul(_node); }, _expression);
+}
+
+void ASTBinaryWriter::writeYul(yul::ExpressionStatement const& _statement)
+{
+	writeLocation(_statement.location);
+	writeYul(_statement.expression);
+}
+
+void ASTBinaryWriter::writeYul(yul::Instruction const& _instruction)
+{
+	writeLocation(_instruction.location);
+	writeVarint(unsigned(_instruction.instruction));
+}
+
+void ASTBinaryWriter::writeYul(yul::Label const& _label)
+{
+	writeLocation(_label.location);
+	writeString(_label.name.str());
+}
+
+void ASTBinaryWriter::writeYul(yul::StackAssignment const& _assignment)
+{
+	writeLocation(_assignment.location);
+	writeYul(_assignment.variableName);
+}
+
+void ASTBinaryWriter::writeYul(yul::Assignment const& _assignment)
+{
+	solAssert(_assignment.value, "");
+	writeLocation(_assignment.location);
+	writeVarint(_assignment.variableNames.size());
+	for (yul::Identifier const& variableName: _assignment.variableNames)
+		writeYul(variableName);
+	writeYul(*_assignment.value);
+}
+
+void ASTBinaryWriter::writeYul(yul::VariableDeclaration const& _declaration)
+{
+	writeLocation(_declaration.location);
+	writeYul(_declaration.variables);
+	writeBool(!!_declaration.value);
+	if (_declaration.value)
+		writeYul(*_declaration.value);
+}
+
+void ASTBinaryWriter::writeYul(yul::FunctionDefinition const& _function)
+{
+	writeLocation(_function.location);
+	writeString(_function.name.str());
+	writeYul(_function.parameters);
+	writeYul(_function.returnVariables);
+	writeYul(_function.body);
+}
+
+void ASTBinaryWriter::writeYul(yul::If const& _if)
+{
+	solAssert(_if.condition, "");
+	writeLocation(_if.location);
+	writeYul(*_if.condition);
+	writeYul(_if.body);
+}
+
+void ASTBinaryWriter::writeYul(yul::Switch const& _switch)
+{
+	solAssert(_switch.expression, "");
+	writeLocation(_switch.location);
+	writeYul(*_switch.expression);
+	writeVarint(_switch.cases.size());
+	for (yul::Case const& switchCase: _switch.cases)
+	{
+		writeLocation(switchCase.location);
+		writeBool(!!switchCase.value);
+		if (switchCase.value)
+			writeYul(*switchCase.value);
+		writeYul(switchCase.body);
+	}
+}
+
+void ASTBinaryWriter::writeYul(yul::ForLoop const& _loop)
+{
+	solAssert(_loop.condition, "");
+	writeLocation(_loop.location);
+	writeYul(_loop.pre);
+	writeYul(*_loop.condition);
+	writeYul(_loop.post);
+	writeYul(_loop.body);
+}
+
+void ASTBinaryWriter::writeYul(yul::FunctionalInstruction const& _instruction)
+{
+	writeLocation(_instruction.location);
+	writeVarint(unsigned(_instruction.instruction));
+	writeVarint(_instruction.arguments.size());
+	for (yul::Expression const& argument: _instruction.arguments)
+		writeYul(argument);
+}
+
+void ASTBinaryWriter::writeYul(yul::FunctionCall const& _call)
+{
+	writeLocation(_call.location);
+	writeYul(_call.functionName);
+	writeVarint(_call.arguments.size());
+	for (yul::Expression const& argument: _call.arguments)
+		writeYul(argument);
+}
+
+void ASTBinaryWriter::writeYul(yul::Identifier const& _identifier)
+{
+	writeLocation(_identifier.location);
+	writeString(_identifier.name.str());
+}
+
+void ASTBinaryWriter::writeYul(yul::Literal const& _literal)
+{
+	writeLocation(_literal.location);
+	writeVarint(unsigned(_literal.kind));
+	writeString(_literal.value.str());
+	writeString(_literal.type.str());
+}
+
+void ASTBinaryWriter::writeYul(yul::TypedName const& _name)
+{
+	writeLocation(_name.location);
+	writeString(_name.name.str());
+	writeString(_name.type.str());
+}
+
+void ASTBinaryWriter::writeYul(vector<yul::TypedName> const& _names)
+{
+	writeVarint(_names.size());
+	for (yul::TypedName const& name: _names)
+		writeYul(name);
+}
+
+ASTPointer<SourceUnit> ASTBinaryReader::read(bytes const& _data, shared_ptr<CharStream> _source)
+{
+	m_data = &_data;
+	m_position = 0;
+	m_strings.clear();
+	m_types.clear();
+	m_nodeTypes.clear();
+	m_arena = make_shared<Arena>();
+	m_maxID = 0;
+
+	assertThrow(
+		_data.size() >= c_magic.size() && equal(c_magic.begin(), c_magic.end(), _data.begin()),
+		InvalidBinaryAST,
+		"Not a binary AST."
+	);
+	m_position = c_magic.size();
+	assertThrow(readVarint() == c_formatVersion, InvalidBinaryAST, "Unsupported format version.");
+
+	m_strings.resize(readLength());
+	for (auto& str: m_strings)
+	{
+		size_t length = readLength();
+		auto begin = _data.begin() + m_position;
+		str = make_shared<ASTString>(begin, begin + length);
+		m_position += length;
+	}
+	m_types.resize(readLength());
+	for (auto& type: m_types)
+	{
+		type.identifier = *readString();
+		type.name = *readString();
+	}
+	ASTPointer<ASTString> sourceName = readString();
+	m_source = _source ? std::move(_source) : make_shared<CharStream>("", *sourceName);
+
+	ASTPointer<SourceUnit> sourceUnit = readNode<SourceUnit>();
+	assertThrow(m_position == _data.size(), InvalidBinaryAST, "Unexpected data after the source unit.");
+	sourceUnit->annotation().path = *sourceName;
+	ASTNode::setNextID(m_maxID + 1);
+
+	m_data = nullptr;
+	m_source.reset();
+	m_arena.reset();
+	return sourceUnit;
+}
+
+ASTBinaryReader::TypeDescription const* ASTBinaryReader::type(size_t _nodeID) const
+{
+	auto it = m_nodeTypes.find(_nodeID);
+	if (it == m_nodeTypes.end())
+		return nullptr;
+	return &m_types[it->second];
+}
+
+uint64_t ASTBinaryReader::readVarint()
+{
+	uint64_t value = 0;
+	for (unsigned shift = 0; ; shift += 7)
+	{
+		assertThrow(m_position < m_data->size(), InvalidBinaryAST, "Unexpected end of data.");
+		assertThrow(shift < 64, InvalidBinaryAST, "Integer too large.");
+		uint8_t byte = (*m_data)[m_position++];
+		value |= uint64_t(byte & 0x7f) << shift;
+		if (!(byte & 0x80))
+			return value;
+	}
+}
+
+bool ASTBinaryReader::readBool()
+{
+	uint64_t value = readVarint();
+	assertThrow(value <= 1, InvalidBinaryAST, "Invalid boolean.");
+	return value == 1;
+}
+
+Token ASTBinaryReader::readToken()
+{
+	uint64_t value = readVarint();
+	assertThrow(value < TokenTraits::count(), InvalidBinaryAST, "Invalid token.");
+	return Token(value);
+}
+
+ASTPointer<ASTString> ASTBinaryReader::readOptionalString()
+{
+	uint64_t index = readVarint();
+	if (index == 0)
+		return nullptr;
+	assertThrow(index <= m_strings.size(), InvalidBinaryAST, "Invalid string reference.");
+	return m_strings[index - 1];
+}
+
+ASTPointer<ASTString> ASTBinaryReader::readString()
+{
+	ASTPointer<ASTString> str = readOptionalString();
+	assertThrow(str, InvalidBinaryAST, "Missing string.");
+	return str;
+}
+
+SourceLocation ASTBinaryReader::readLocation()
+{
+	SourceLocation location;
+	uint64_t start = readVarint();
+	if (start == 0)
+		return location;
+	location.start = int(unzigzag(start - 1));
+	location.end = int(location.start + unzigzag(readVarint()));
+	location.source = m_source;
+	return location;
+}
+
+ElementaryTypeNameToken ASTBinaryReader::readElementaryTypeNameToken()
+{
+	Token token = readToken();
+	assertThrow(TokenTraits::isElementaryTypeName(token), InvalidBinaryAST, "Invalid elementary type.");
+	uint64_t firstNumber = readVarint();
+	uint64_t secondNumber = readVarint();
+	bool validSize = firstNumber == 0 && secondNumber == 0;
+	if (token == Token::BytesM)
+		validSize = firstNumber <= 32 && secondNumber == 0;
+	else if (token == Token::IntM || token == Token::UIntM)
+		validSize = firstNumber <= 256 && firstNumber % 8 == 0 && secondNumber == 0;
+	else if (token == Token::FixedMxN || token == Token::UFixedMxN)
+		validSize = 8 <= firstNumber && firstNumber <= 256 && firstNumber % 8 == 0 && secondNumber <= 80;
+	assertThrow(validSize, InvalidBinaryAST, "Invalid elementary type size.");
+	return ElementaryTypeNameToken(token, unsigned(firstNumber), unsigned(secondNumber));
+}
+
+Declaration::Visibility ASTBinaryReader::readVisibility()
+{
+	uint64_t value = readVarint();
+	assertThrow(value <= unsigned(Declaration::Visibility::External), InvalidBinaryAST, "Invalid visibility.");
+	return Declaration::Visibility(value);
+}
+
+StateMutability ASTBinaryReader::readStateMutability()
+{
+	uint64_t value = readVarint();
+	assertThrow(value <= unsigned(StateMutability::Payable), InvalidBinaryAST, "Invalid state mutability.");
+	return StateMutability(value);
+}
+
+size_t ASTBinaryReader::readLength()
+{
+	uint64_t length = readVarint();
+	assertThrow(length <= m_data->size() - m_position, InvalidBinaryAST, "Invalid length.");
+	return size_t(length);
+}
+
+unique_ptr<vector<ASTPointer<Expression>>> ASTBinaryReader::readOptionalNodes()
+{
+	uint64_t count = readVarint();
+	if (count == 0)
+		return nullptr;
+	assertThrow(count - 1 <= m_data->size() - m_position, InvalidBinaryAST, "Invalid length.");
+	auto nodes = make_unique<vector<ASTPointer<Expression>>>(count - 1);
+	for (auto& node: *nodes)
+		node = readNode<Expression>();
+	return nodes;
+}
+
+template <class T, class... Args>
+ASTPointer<T> ASTBinaryReader::create(size_t _id, SourceLocation const& _location, Args&&... _args)
+{
+	ASTNode::setNextID(_id);
+	m_maxID = max(m_maxID, _id);
+	return allocate_shared<T>(ArenaAllocator<T>(m_arena), _location, std::forward<Args>(_args)...);
+}
+
+ASTPointer<ASTNode> ASTBinaryReader::readNode(bool _optional)
+{
+	uint64_t kindValue = readVarint();
+	assertThrow(kindValue <= unsigned(ASTBinaryNodeKind::Literal), InvalidBinaryAST, "Invalid node kind.");
+	ASTBinaryNodeKind kind = ASTBinaryNodeKind(kindValue);
+	if (kind == ASTBinaryNodeKind::Null)
+	{
+		assertThrow(_optional, InvalidBinaryAST, "Missing node.");
+		return nullptr;
+	}
+	size_t id = readVarint();
+	assertThrow(id > 0, InvalidBinaryAST, "Invalid node ID.");
+	SourceLocation location = readLocation();
+	if (isTyped(kind))
+		if (uint64_t type = readVarint())
+		{
+			assertThrow(type <= m_types.size(), InvalidBinaryAST, "Invalid type reference.");
+			m_nodeTypes[id] = type - 1;
+		}
+
+	// Fields are read into variables first, since the order of evaluation
+	// of function arguments is unspecified.
+	switch (kind)
+	{
+	case ASTBinaryNodeKind::SourceUnit:
+	{
+		auto nodes = readNodes<ASTNode>();
+		return create<SourceUnit>(id, location, nodes);
+	}
+	case ASTBinaryNodeKind::PragmaDirective:
+	{
+		vector<Token> tokens(readLength());
+		for (Token& token: tokens)
+			token = readToken();
+		vector<ASTString> literals(readLength());
+		for (ASTString& literal: literals)
+			literal = *readString();
+		return create<PragmaDirective>(id, location, tokens, literals);
+	}
+	case ASTBinaryNodeKind::ImportDirective:
+	{
+		auto path = readString();
+		auto unitAlias = readString();
+		vector<pair<ASTPointer<Identifier>, ASTPointer<ASTString>>> symbolAliases(readLength());
+		for (auto& symbolAlias: symbolAliases)
+		{
+			symbolAlias.first = readNode<Identifier>();
+			symbolAlias.second = readOptionalString();
+		}
+		return create<ImportDirective>(id, location, path, unitAlias, std::move(symbolAliases));
+	}
+	case ASTBinaryNodeKind::ContractDefinition:
+	{
+		auto name = readString();
+		auto documentation = readOptionalString();
+		auto baseContracts = readNodes<InheritanceSpecifier>();
+		auto subNodes = readNodes<ASTNode>();
+		uint64_t contractKind = readVarint();
+		assertThrow(
+			contractKind <= unsigned(ContractDefinition::ContractKind::Library),
+			InvalidBinaryAST,
+			"Invalid contract kind."
+		);
+		return create<ContractDefinition>(
+			id,
+			location,
+			name,
+			documentation,
+			baseContracts,
+			subNodes,
+			ContractDefinition::ContractKind(contractKind)
+		);
+	}
+	case ASTBinaryNodeKind::InheritanceSpecifier:
+	{
+		auto baseName = readNode<UserDefinedTypeName>();
+		auto arguments = readOptionalNodes();
+		return create<InheritanceSpecifier>(id, location, baseName, std::move(arguments));
+	}
+	case ASTBinaryNodeKind::UsingForDirective:
+	{
+		auto libraryName = readNode<UserDefinedTypeName>();
+		auto typeName = readOptionalNode<TypeName>();
+		return create<UsingForDirective>(id, location, libraryName, typeName);
+	}
+	case ASTBinaryNodeKind::StructDefinition:
+	{
+		auto name = readString();
+		auto members = readNodes<VariableDeclaration>();
+		return create<StructDefinition>(id, location, name, members);
+	}
+	case ASTBinaryNodeKind::EnumDefinition:
+	{
+		auto name = readString();
+		auto members = readNodes<EnumValue>();
+		return create<EnumDefinition>(id, location, name, members);
+	}
+	case ASTBinaryNodeKind::EnumValue:
+	{
+		auto name = readString();
+		return create<EnumValue>(id, location, name);
+	}
+	case ASTBinaryNodeKind::ParameterList:
+	{
+		auto parameters = readNodes<VariableDeclaration>();
+		return create<ParameterList>(id, location, parameters);
+	}
+	case ASTBinaryNodeKind::FunctionDefinition:
+	{
+		auto name = readString();
+		Declaration::Visibility visibility = readVisibility();
+		StateMutability stateMutability = readStateMutability();
+		bool isConstructor = readBool();
+		auto documentation = readOptionalString();
+		auto parameters = readNode<ParameterList>();
+		auto modifiers = readNodes<ModifierInvocation>();
+		auto returnParameters = readOptionalNode<ParameterList>();
+		auto body = readOptionalNode<Block>();
+		return create<FunctionDefinition>(
+			id,
+			location,
+			name,
+			visibility,
+			stateMutability,
+			isConstructor,
+			documentation,
+			parameters,
+			modifiers,
+			returnParameters,
+			body
+		);
+	}
+	case ASTBinaryNodeKind::VariableDeclaration:
+	{
+		auto typeName = readOptionalNode<TypeName>();
+		auto name = readString();
+		auto value = readOptionalNode<Expression>();
+		Declaration::Visibility visibility = readVisibility();
+		bool isStateVariable = readBool();
+		bool isIndexed = readBool();
+		bool isConstant = readBool();
+		uint64_t referenceLocation = readVarint();
+		assertThrow(
+			referenceLocation <= VariableDeclaration::Location::CallData,
+			InvalidBinaryAST,
+			"Invalid data location."
+		);
+		return create<VariableDeclaration>(
+			id,
+			location,
+			typeName,
+			name,
+			value,
+			visibility,
+			isStateVariable,
+			isIndexed,
+			isConstant,
+			VariableDeclaration::Location(referenceLocation)
+		);
+	}
+	case ASTBinaryNodeKind::ModifierDefinition:
+	{
+		auto name = readString();
+		auto documentation = readOptionalString();
+		auto parameters = readNode<ParameterList>();
+		auto body = readNode<Block>();
+		return create<ModifierDefinition>(id, location, name, documentation, parameters, body);
+	}
+	case ASTBinaryNodeKind::ModifierInvocation:
+	{
+		auto name = readNode<Identifier>();
+		auto arguments = readOptionalNodes();
+		return create<ModifierInvocation>(id, location, name, std::move(arguments));
+	}
+	case ASTBinaryNodeKind::EventDefinition:
+	{
+		auto name = readString();
+		auto documentation = readOptionalString();
+		auto parameters = readNode<ParameterList>();
+		bool anonymous = readBool();
+		return create<EventDefinition>(id, location, name, documentation, parameters, anonymous);
+	}
+	case ASTBinaryNodeKind::ElementaryTypeName:
+	{
+		ElementaryTypeNameToken typeName = readElementaryTypeNameToken();
+		boost::optional<StateMutability> stateMutability;
+		if (uint64_t value = readVarint())
+		{
+			assertThrow(value - 1 <= unsigned(StateMutability::Payable), InvalidBinaryAST, "Invalid state mutability.");
+			stateMutability = StateMutability(value - 1);
+		}
+		assertThrow(
+			!stateMutability || typeName.token() == Token::Address,
+			InvalidBinaryAST,
+			"State mutability given for a type other than address."
+		);
+		return create<ElementaryTypeName>(id, location, typeName, stateMutability);
+	}
+	case ASTBinaryNodeKind::UserDefinedTypeName:
+	{
+		vector<ASTString> namePath(readLength());
+		for (ASTString& name: namePath)
+			name = *readString();
+		return create<UserDefinedTypeName>(id, location, namePath);
+	}
+	case ASTBinaryNodeKind::FunctionTypeName:
+	{
+		auto parameterTypes = readNode<ParameterList>();
+		auto returnTypes = readNode<ParameterList>();
+		Declaration::Visibility visibility = readVisibility();
+		StateMutability stateMutability = readStateMutability();
+		return create<FunctionTypeName>(id, location, parameterTypes, returnTypes, visibility, stateMutability);
+	}
+	case ASTBinaryNodeKind::Mapping:
+	{
+		auto keyType = readNode<ElementaryTypeName>();
+		auto valueType = readNode<TypeName>();
+		return create<Mapping>(id, location, keyType, valueType);
+	}
+	case ASTBinaryNodeKind::ArrayTypeName:
+	{
+		auto baseType = readNode<TypeName>();
+		auto length = readOptionalNode<Expression>();
+		return create<ArrayTypeName>(id, location, baseType, length);
+	}
+	case ASTBinaryNodeKind::InlineAssembly:
+	{
+		auto documentation = readOptionalString();
+		auto operations = make_shared<yul::Block>(readYulBlock());
+		return create<InlineAssembly>(id, location, documentation, operations);
+	}
+	case ASTBinaryNodeKind::Block:
+	{
+		auto documentation = readOptionalString();
+		auto statements = readNodes<Statement>();
+		return create<Block>(id, location, documentation, statements);
+	}
+	case ASTBinaryNodeKind::PlaceholderStatement:
+	{
+		auto documentation = readOptionalString();
+		return create<PlaceholderStatement>(id, location, documentation);
+	}
+	case ASTBinaryNodeKind::IfStatement:
+	{
+		auto documentation = readOptionalString();
+		auto condition = readNode<Expression>();
+		auto trueBody = readNode<Statement>();
+		auto falseBody = readOptionalNode<Statement>();
+		return create<IfStatement>(id, location, documentation, condition, trueBody, falseBody);
+	}
+	case ASTBinaryNodeKind::WhileStatement:
+	{
+		auto documentation = readOptionalString();
+		auto condition = readNode<Expression>();
+		auto body = readNode<Statement>();
+		bool isDoWhile = readBool();
+		return create<WhileStatement>(id, location, documentation, condition, body, isDoWhile);
+	}
+	case ASTBinaryNodeKind::ForStatement:
+	{
+		auto documentation = readOptionalString();
+		auto initExpression = readOptionalNode<Statement>();
+		auto condition = readOptionalNode<Expression>();
+		auto loopExpression = readOptionalNode<ExpressionStatement>();
+		auto body = readNode<Statement>();
+		return create<ForStatement>(id, location, documentation, initExpression, condition, loopExpression, body);
+	}
+	case ASTBinaryNodeKind::Continue:
+	{
+		auto documentation = readOptionalString();
+		return create<Continue>(id, location, documentation);
+	}
+	case ASTBinaryNodeKind::Break:
+	{
+		auto documentation = readOptionalString();
+		return create<Break>(id, location, documentation);
+	}
+	case ASTBinaryNodeKind::Return:
+	{
+		auto documentation = readOptionalString();
+		auto expression = readOptionalNode<Expression>();
+		return create<Return>(id, location, documentation, expression);
+	}
+	case ASTBinaryNodeKind::Throw:
+	{
+		auto documentation = readOptionalString();
+		return create<Throw>(id, location, documentation);
+	}
+	case ASTBinaryNodeKind::EmitStatement:
+	{
+		auto documentation = readOptionalString();
+		auto eventCall = readNode<FunctionCall>();
+		return create<EmitStatement>(id, location, documentation, eventCall);
+	}
+	case ASTBinaryNodeKind::VariableDeclarationStatement:
+	{
+		auto documentation = readOptionalString();
+		auto variables = readNodes<VariableDeclaration>(true);
+		auto initialValue = readOptionalNode<Expression>();
+		return create<VariableDeclarationStatement>(id, location, documentation, variables, initialValue);
+	}
+	case ASTBinaryNodeKind::ExpressionStatement:
+	{
+		auto documentation = readOptionalString();
+		auto expression = readNode<Expression>();
+		return create<ExpressionStatement>(id, location, documentation, expression);
+	}
+	case ASTBinaryNodeKind::Conditional:
+	{
+		auto condition = readNode<Expression>();
+		auto trueExpression = readNode<Expression>();
+		auto falseExpression = readNode<Expression>();
+		return create<Conditional>(id, location, condition, trueExpression, falseExpression);
+	}
+	case ASTBinaryNodeKind::Assignment:
+	{
+		auto leftHandSide = readNode<Expression>();
+		Token assignmentOperator = readToken();
+		assertThrow(TokenTraits::isAssignmentOp(assignmentOperator), InvalidBinaryAST, "Invalid assignment operator.");
+		auto rightHandSide = readNode<Expression>();
+		return create<Assignment>(id, location, leftHandSide, assignmentOperator, rightHandSide);
+	}
+	case ASTBinaryNodeKind::TupleExpression:
+	{
+		auto components = readNodes<Expression>(true);
+		bool isArray = readBool();
+		return create<TupleExpression>(id, location, components, isArray);
+	}
+	case ASTBinaryNodeKind::UnaryOperation:
+	{
+		Token unaryOperator = readToken();
+		assertThrow(TokenTraits::isUnaryOp(unaryOperator), InvalidBinaryAST, "Invalid unary operator.");
+		auto subExpression = readNode<Expression>();
+		bool isPrefix = readBool();
+		return create<UnaryOperation>(id, location, unaryOperator, subExpression, isPrefix);
+	}
+	case ASTBinaryNodeKind::BinaryOperation:
+	{
+		auto left = readNode<Expression>();
+		Token binaryOperator = readToken();
+		assertThrow(
+			TokenTraits::isBinaryOp(binaryOperator) || TokenTraits::isCompareOp(binaryOperator),
+			InvalidBinaryAST,
+			"Invalid binary operator."
+		);
+		auto right = readNode<Expression>();
+		return create<BinaryOperation>(id, location, left, binaryOperator, right);
+	}
+	case ASTBinaryNodeKind::FunctionCall:
+	{
+		auto expression = readNode<Expression>();
+		auto arguments = readNodes<Expression>();
+		vector<ASTPointer<ASTString>> names(readLength());
+		for (auto& name: names)
+			name = readString();
+		return create<FunctionCall>(id, location, expression, arguments, names);
+	}
+	case ASTBinaryNodeKind::NewExpression:
+	{
+		auto typeName = readNode<TypeName>();
+		return create<NewExpression>(id, location, typeName);
+	}
+	case ASTBinaryNodeKind::MemberAccess:
+	{
+		auto expression = readNode<Expression>();
+		auto memberName = readString();
+		return create<MemberAccess>(id, location, expression, memberName);
+	}
+	case ASTBinaryNodeKind::IndexAccess:
+	{
+		auto base = readNode<Expression>();
+		auto index = readOptionalNode<Expression>();
+		return create<IndexAccess>(id, location, base, index);
+	}
+	case ASTBinaryNodeKind::Identifier:
+	{
+		auto name = readString();
+		return create<Identifier>(id, location, name);
+	}
+	case ASTBinaryNodeKind::ElementaryTypeNameExpression:
+	{
+		ElementaryTypeNameToken typeName = readElementaryTypeNameToken();
+		return create<ElementaryTypeNameExpression>(id, location, typeName);
+	}
+	case ASTBinaryNodeKind::Literal:
+	{
+		Token token = readToken();
+		auto value = readString();
+		Token subDenomination = readToken();
+		assertThrow(
+			subDenomination == Token::Illegal ||
+			TokenTraits::isEtherSubdenomination(subDenomination) ||
+			TokenTraits::isTimeSubdenomination(subDenomination),
+			InvalidBinaryAST,
+			"Invalid subdenomination."
+		);
+		return create<Literal>(id, location, token, value, Literal::SubDenomination(subDenomination));
+	}
+	case ASTBinaryNodeKind::Null:
+		break;
+	}
+	solAssert(false, "");
+	return nullptr;
+}
+
+yul::Block ASTBinaryReader::readYulBlock()
+{
+	yul::Block block;
+	block.location = readLocation();
+	block.statements.resize(readLength());
+	for (yul::Statement& statement: block.statements)
+		statement = readYulStatement();
+	return block;
+}
+
+yul::Statement ASTBinaryReader::readYulStatement()
+{
+	uint64_t tag = readVarint();
+	SourceLocation location = readLocation();
+	switch (tag)
+	{
+	case 0:
+		return yul::ExpressionStatement{location, readYulExpression()};
+	case 1:
+	{
+		uint64_t instruction = readVarint();
+		assertThrow(instruction <= 0xff, InvalidBinaryAST, "Invalid instruction.");
+		return yul::Instruction{location, solidity::Instruction(instruction)};
+	}
+	case 2:
+		return yul::Label{location, yul::YulString(*readString())};
+	case 3:
+		return yul::StackAssignment{location, readYulIdentifier()};
+	case 4:
+	{
+		vector<yul::Identifier> variableNames(readLength());
+		for (yul::Identifier& variableName: variableNames)
+			variableName = readYulIdentifier();
+		auto value = make_unique<yul::Expression>(readYulExpression());
+		return yul::Assignment{location, std::move(variableNames), std::move(value)};
+	}
+	case 5:
+	{
+		yul::TypedNameList variables = readYulTypedNames();
+		unique_ptr<yul::Expression> value;
+		if (readBool())
+			value = make_unique<yul::Expression>(readYulExpression());
+		return yul::VariableDeclaration{location, std::move(variables), std::move(value)};
+	}
+	case 6:
+	{
+		yul::YulString name(*readString());
+		yul::TypedNameList parameters = readYulTypedNames();
+		yul::TypedNameList returnVariables = readYulTypedNames();
+		return yul::FunctionDefinition{location, name, std::move(parameters), std::move(returnVariables), readYulBlock()};
+	}
+	case 7:
+	{
+		auto condition = make_unique<yul::Expression>(readYulExpression());
+		return yul::If{location, std::move(condition), readYulBlock()};
+	}
+	case 8:
+	{
+		auto expression = make_unique<yul::Expression>(readYulExpression());
+		vector<yul::Case> cases(readLength());
+		for (yul::Case& switchCase: cases)
+		{
+			switchCase.location = readLocation();
+			if (readBool())
+				switchCase.value = make_unique<yul::Literal>(readYulLiteral());
+			switchCase.body = readYulBlock();
+		}
+		return yul::Switch{location, std::move(expression), std::move(cases)};
+	}
+	case 9:
+	{
+		yul::Block pre = readYulBlock();
+		auto condition = make_unique<yul::Expression>(readYulExpression());
+		yul::Block post = readYulBlock();
+		return yul::ForLoop{location, std::move(pre), std::move(condition), std::move(post), readYulBlock()};
+	}
+	case 10:
+	{
+		// The location has already been read.
+		yul::Block block{location, {}};
+		block.statements.resize(readLength());
+		for (yul::Statement& statement: block.statements)
+			statement = readYulStatement();
+		return block;
+	}
+	default:
+		BOOST_THROW_EXCEPTION(InvalidBinaryAST() << errinfo_comment("Invalid inline assembly statement."));
+	}
+}
+
+yul::Expression ASTBinaryReader::readYulExpression()
+{
+	uint64_t tag = readVarint();
+	switch (tag)
+	{
+	case 0:
+	{
+		SourceLocation location = readLocation();
+		uint64_t instruction = readVarint();
+		assertThrow(instruction <= 0xff, InvalidBinaryAST, "Invalid instruction.");
+		return yul::FunctionalInstruction{location, solidity::Instruction(instruction), readYulExpressions()};
+	}
+	case 1:
+	{
+		SourceLocation location = readLocation();
+		yul::Identifier functionName = readYulIdentifier();
+		return yul::FunctionCall{location, functionName, readYulExpressions()};
+	}
+	case 2:
+		return readYulIdentifier();
+	case 3:
+		return readYulLiteral();
+	default:
+		BOOST_THROW_EXCEPTION(InvalidBinaryAST() << errinfo_comment("Invalid inline assembly expression."));
+	}
+}
+
+yul::Identifier ASTBinaryReader::readYulIdentifier()
+{
+	SourceLocation location = readLocation();
+	return yul::Identifier{location, yul::YulString(*readString())};
+}
+
+yul::Literal ASTBinaryReader::readYulLiteral()
+{
+	SourceLocation location = readLocation();
+	uint64_t kind = readVarint();
+	assertThrow(kind <= unsigned(yul::LiteralKind::String), InvalidBinaryAST, "Invalid literal kind.");
+	yul::YulString value(*readString());
+	yul::YulString type(*readString());
+	return yul::Literal{location, yul::LiteralKind(kind), value, type};
+}
+
+yul::TypedName ASTBinaryReader::readYulTypedName()
+{
+	SourceLocation location = readLocation();
+	yul::YulString name(*readString());
+	yul::YulString type(*readString());
+	return yul::TypedName{location, name, type};
+}
+
+vector<yul::TypedName> ASTBinaryReader::readYulTypedNames()
+{
+	vector<yul::TypedName> names(readLength());
+	for (yul::TypedName& name: names)
+		name = readYulTypedName();
+	return names;
+}
+
+vector<yul::Expression> ASTBinaryReader::readYulExpressions()
+{
+	vector<yul::Expression> expressions(readLength());
+	for (yul::Expression& expression: expressions)
+		expression = readYulExpression();
+	return expressions;
+}
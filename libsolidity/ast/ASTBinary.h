@@ -0,0 +1,310 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Compact binary serialisation of the AST.
+ */
+
+#pragma once
+
+#include <libsolidity/ast/ASTVisitor.h>
+
+#include <libyul/AsmDataForward.h>
+
+#include <libdevcore/Arena.h>
+#include <libdevcore/Common.h>
+#include <libdevcore/Exceptions.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace langutil
+{
+class CharStream;
+}
+
+namespace dev
+{
+namespace solidity
+{
+
+DEV_SIMPLE_EXCEPTION(InvalidBinaryAST);
+
+/// Tags of the nodes in the binary AST format. Zero marks an absent optional node.
+/// New kinds have to be appended to keep existing files readable.
+enum class ASTBinaryNodeKind: uint8_t
+{
+	Null,
+	SourceUnit,
+	PragmaDirective,
+	ImportDirective,
+	ContractDefinition,
+	InheritanceSpecifier,
+	UsingForDirective,
+	StructDefinition,
+	EnumDefinition,
+	EnumValue,
+	ParameterList,
+	FunctionDefinition,
+	VariableDeclaration,
+	ModifierDefinition,
+	ModifierInvocation,
+	EventDefinition,
+	ElementaryTypeName,
+	UserDefinedTypeName,
+	FunctionTypeName,
+	Mapping,
+	ArrayTypeName,
+	InlineAssembly,
+	Block,
+	PlaceholderStatement,
+	IfStatement,
+	WhileStatement,
+	ForStatement,
+	Continue,
+	Break,
+	Return,
+	Throw,
+	EmitStatement,
+	VariableDeclarationStatement,
+	ExpressionStatement,
+	Conditional,
+	Assignment,
+	TupleExpression,
+	UnaryOperation,
+	BinaryOperation,
+	FunctionCall,
+	NewExpression,
+	MemberAccess,
+	IndexAccess,
+	Identifier,
+	ElementaryTypeNameExpression,
+	Literal
+};
+
+/**
+ * Writes a source unit in a compact binary format.
+ *
+ * The output consists of a magic number and a format version, a table of all strings used
+ * by the source unit (names, literals, documentation, type names), a table of the types
+ * assigned to expressions and variable declarations during analysis, the name of the source
+ * and finally the nodes in pre-order. Each node is stored as its kind, its ID, its source
+ * location and its fields in constructor order. Strings and types are referenced by their
+ * index in the respective table and all integers are stored as LEB128 varints.
+ */
+class ASTBinaryWriter: private ASTConstVisitor
+{
+public:
+	/// @returns the binary representation of @a _sourceUnit. The types of expressions and
+	/// variable declarations are included if the source unit has been analysed.
+	bytes write(SourceUnit const& _sourceUnit);
+
+private:
+	bool visit(SourceUnit const& _node) override;
+	bool visit(PragmaDirective const& _node) override;
+	bool visit(ImportDirective const& _node) override;
+	bool visit(ContractDefinition const& _node) override;
+	bool visit(InheritanceSpecifier const& _node) override;
+	bool visit(UsingForDirective const& _node) override;
+	bool visit(StructDefinition const& _node) override;
+	bool visit(EnumDefinition const& _node) override;
+	bool visit(EnumValue const& _node) override;
+	bool visit(ParameterList const& _node) override;
+	bool visit(FunctionDefinition const& _node) override;
+	bool visit(VariableDeclaration const& _node) override;
+	bool visit(ModifierDefinition const& _node) override;
+	bool visit(ModifierInvocation const& _node) override;
+	bool visit(EventDefinition const& _node) override;
+	bool visit(ElementaryTypeName const& _node) override;
+	bool visit(UserDefinedTypeName const& _node) override;
+	bool visit(FunctionTypeName const& _node) override;
+	bool visit(Mapping const& _node) override;
+	bool visit(ArrayTypeName const& _node) override;
+	bool visit(InlineAssembly const& _node) override;
+	bool visit(Block const& _node) override;
+	bool visit(PlaceholderStatement const& _node) override;
+	bool visit(IfStatement const& _node) override;
+	bool visit(WhileStatement const& _node) override;
+	bool visit(ForStatement const& _node) override;
+	bool visit(Continue const& _node) override;
+	bool visit(Break const& _node) override;
+	bool visit(Return const& _node) override;
+	bool visit(Throw const& _node) override;
+	bool visit(EmitStatement const& _node) override;
+	bool visit(VariableDeclarationStatement const& _node) override;
+	bool visit(ExpressionStatement const& _node) override;
+	bool visit(Conditional const& _node) override;
+	bool visit(Assignment const& _node) override;
+	bool visit(TupleExpression const& _node) override;
+	bool visit(UnaryOperation const& _node) override;
+	bool visit(BinaryOperation const& _node) override;
+	bool visit(FunctionCall const& _node) override;
+	bool visit(NewExpression const& _node) override;
+	bool visit(MemberAccess const& _node) override;
+	bool visit(IndexAccess const& _node) override;
+	bool visit(Identifier const& _node) override;
+	bool visit(ElementaryTypeNameExpression const& _node) override;
+	bool visit(Literal const& _node) override;
+	bool visitNode(ASTNode const& _node) override;
+
+	/// @returns the index of @a _string in the string table, adding it if necessary.
+	size_t stringIndex(std::string const& _string);
+	void writeVarint(uint64_t _value);
+	void writeBool(bool _value) { writeVarint(_value ? 1 : 0); }
+	void writeToken(Token _token) { writeVarint(unsigned(_token)); }
+	void writeString(std::string const& _string);
+	void writeOptionalString(ASTPointer<ASTString> const& _string);
+	void writeLocation(langutil::SourceLocation const& _location);
+	void writeType(TypePointer const& _type);
+	void writeElementaryTypeNameToken(ElementaryTypeNameToken const& _token);
+	/// Writes the kind, ID and location of a node.
+	void writeHeader(ASTBinaryNodeKind _kind, ASTNode const& _node);
+	/// Writes the header of an expression followed by its type.
+	void writeHeader(ASTBinaryNodeKind _kind, Expression const& _node);
+	void writeNode(ASTNode const* _node);
+	template <class T>
+	void writeNode(ASTPointer<T> const& _node) { writeNode(_node.get()); }
+	template <class T>
+	void writeNodes(std::vector<ASTPointer<T>> const& _nodes)
+	{
+		writeVarint(_nodes.size());
+		for (auto const& node: _nodes)
+			writeNode(node.get());
+	}
+	/// Writes an argument list that can be absent (as opposed to empty).
+	void writeOptionalNodes(std::vector<ASTPointer<Expression>> const* _nodes);
+
+	void writeYul(yul::Block const& _block);
+	void writeYul(yul::Statement const& _statement);
+	void writeYul(yul::Expression const& _expression);
+	void writeYul(yul::ExpressionStatement const& _statement);
+	void writeYul(yul::Instruction const& _instruction);
+	void writeYul(yul::Label const& _label);
+	void writeYul(yul::StackAssignment const& _assignment);
+	void writeYul(yul::Assignment const& _assignment);
+	void writeYul(yul::VariableDeclaration const& _declaration);
+	void writeYul(yul::FunctionDefinition const& _function);
+	void writeYul(yul::If const& _if);
+	void writeYul(yul::Switch const& _switch);
+	void writeYul(yul::ForLoop const& _loop);
+	void writeYul(yul::FunctionalInstruction const& _instruction);
+	void writeYul(yul::FunctionCall const& _call);
+	void writeYul(yul::Identifier const& _identifier);
+	void writeYul(yul::Literal const& _literal);
+	void writeYul(yul::TypedName const& _name);
+	void writeYul(std::vector<yul::TypedName> const& _names);
+
+	/// Serialised nodes, written after the string and type tables.
+	bytes m_nodes;
+	std::unordered_map<std::string, size_t> m_stringIndices;
+	std::vector<std::string const*> m_strings;
+	std::unordered_map<Type const*, size_t> m_typeIndices;
+	std::unordered_map<std::string, size_t> m_typesByIdentifier;
+	/// Pairs of string indices of the identifier and the name of each type.
+	std::vector<std::pair<size_t, size_t>> m_types;
+	std::shared_ptr<langutil::CharStream> m_source;
+};
+
+/**
+ * Recreates a source unit from the output of ASTBinaryWriter.
+ *
+ * The nodes are created with the IDs they had when they were written. Afterwards, the ID
+ * counter of the current thread continues after the largest ID read, so a source unit
+ * should be read before other nodes of the same compilation are created.
+ * The result is an AST as returned by the parser: annotations are not restored, the recorded
+ * types are only available through type().
+ */
+class ASTBinaryReader
+{
+public:
+	struct TypeDescription
+	{
+		std::string identifier;
+		std::string name;
+	};
+
+	/// Reads the source unit in @a _data. The source locations of the nodes refer to @a _source,
+	/// which should be the source the AST was created from. If it is not given, a source with
+	/// the stored name and empty content is used.
+	/// Throws InvalidBinaryAST if the data is malformed.
+	ASTPointer<SourceUnit> read(bytes const& _data, std::shared_ptr<langutil::CharStream> _source = {});
+
+	/// @returns the type recorded for the node with ID @a _nodeID in the last source unit read
+	/// or nullptr if there is none.
+	TypeDescription const* type(size_t _nodeID) const;
+
+private:
+	uint64_t readVarint();
+	bool readBool();
+	Token readToken();
+	ASTPointer<ASTString> readOptionalString();
+	ASTPointer<ASTString> readString();
+	langutil::SourceLocation readLocation();
+	ElementaryTypeNameToken readElementaryTypeNameToken();
+	Declaration::Visibility readVisibility();
+	StateMutability readStateMutability();
+
+	/// Reads a node or null, if @a _optional is true.
+	ASTPointer<ASTNode> readNode(bool _optional);
+	template <class T>
+	ASTPointer<T> readNode(bool _optional = false)
+	{
+		ASTPointer<ASTNode> node = readNode(_optional);
+		auto typedNode = std::dynamic_pointer_cast<T>(node);
+		assertThrow(!node || typedNode, InvalidBinaryAST, "Unexpected node kind.");
+		return typedNode;
+	}
+	template <class T>
+	ASTPointer<T> readOptionalNode() { return readNode<T>(true); }
+	template <class T>
+	std::vector<ASTPointer<T>> readNodes(bool _optionalElements = false)
+	{
+		std::vector<ASTPointer<T>> nodes(readLength());
+		for (auto& node: nodes)
+			node = readNode<T>(_optionalElements);
+		return nodes;
+	}
+	std::unique_ptr<std::vector<ASTPointer<Expression>>> readOptionalNodes();
+	/// Reads the number of elements of a sequence, each of which takes at least one byte.
+	size_t readLength();
+
+	template <class T, class... Args>
+	ASTPointer<T> create(size_t _id, langutil::SourceLocation const& _location, Args&&... _args);
+
+	yul::Block readYulBlock();
+	yul::Statement readYulStatement();
+	yul::Expression readYulExpression();
+	yul::Identifier readYulIdentifier();
+	yul::Literal readYulLiteral();
+	yul::TypedName readYulTypedName();
+	std::vector<yul::TypedName> readYulTypedNames();
+	std::vector<yul::Expression> readYulExpressions();
+
+	bytes const* m_data = nullptr;
+	size_t m_position = 0;
+	std::vector<ASTPointer<ASTString>> m_strings;
+	std::vector<TypeDescription> m_types;
+	std::map<size_t, size_t> m_nodeTypes;
+	std::shared_ptr<langutil::CharStream> m_source;
+	std::shared_ptr<dev::Arena> m_arena;
+	size_t m_maxID = 0;
+};
+
+}
+}
@@ -186,7 +186,43 @@ Json::Value ASTJsonConverter::inlineAssemblyIdentifierToJson(pair<yul::Identifie
 
 void ASTJsonConverter::print(ostream& _stream, ASTNode const& _node)
 {
-	_stream << toJson(_node);
+	// Same format as the stream operator of Json::Value.
+	JsonStreamWriter writer(_stream, "\t");
+	print(writer, _node);
+}
+
+void ASTJsonConverter::print(JsonStreamWriter& _writer, ASTNode const& _node)
+{
+	vector<ASTPointer<ASTNode>> subNodes;
+	if (auto sourceUnit = dynamic_cast<SourceUnit const*>(&_node))
+		subNodes = sourceUnit->nodes();
+	else if (auto contract = dynamic_cast<ContractDefinition const*>(&_node))
+		subNodes = contract->subNodes();
+	if (subNodes.empty())
+	{
+		_writer.value(toJson(_node));
+		return;
+	}
+
+	m_nodeWithoutSubNodes = &_node;
+	Json::Value json = toJson(_node);
+	m_nodeWithoutSubNodes = nullptr;
+
+	// In the legacy format, the sub-nodes come last in the list of children.
+	string const subNodesKey = m_legacy ? "children" : "nodes";
+	Json::Value precedingChildren(Json::arrayValue);
+	json.removeMember(subNodesKey, &precedingChildren);
+	_writer.object(json, {{subNodesKey, [&]() {
+		_writer.beginArray();
+		for (auto const& child: precedingChildren)
+			_writer.value(child);
+		for (auto const& subNode: subNodes)
+			if (subNode)
+				print(_writer, *subNode);
+			else if (!m_legacy)
+				_writer.value(Json::nullValue);
+		_writer.endArray();
+	}}});
 }
 
 Json::Value&& ASTJsonConverter::toJson(ASTNode const& _node)
@@ -204,15 +240,13 @@ bool ASTJsonConverter::visit(SourceUnit const& _node)
 		for (Declaration const* overload: sym.second)
 			exportedSymbols[sym.first].append(nodeId(*overload));
 	}
-	setJsonNode(
-		_node,
-		"SourceUnit",
-		{
-			make_pair("absolutePath", _node.annotation().path),
-			make_pair("exportedSymbols", move(exportedSymbols)),
-			make_pair("nodes", toJson(_node.nodes()))
-		}
-	);
+	std::vector<pair<string, Json::Value>> attributes = {
+		make_pair("absolutePath", _node.annotation().path),
+		make_pair("exportedSymbols", move(exportedSymbols))
+	};
+	if (&_node != m_nodeWithoutSubNodes)
+		attributes.emplace_back("nodes", toJson(_node.nodes()));
+	setJsonNode(_node, "SourceUnit", move(attributes));
 	return false;
 }
 
@@ -252,17 +286,19 @@ bool ASTJsonConverter::visit(ImportDirective const& _node)
 
 bool ASTJsonConverter::visit(ContractDefinition const& _node)
 {
-	setJsonNode(_node, "ContractDefinition", {
+	std::vector<pair<string, Json::Value>> attributes = {
 		make_pair("name", _node.name()),
 		make_pair("documentation", _node.documentation() ? Json::Value(*_node.documentation()) : Json::nullValue),
 		make_pair("contractKind", contractKind(_node.contractKind())),
 		make_pair("fullyImplemented", _node.annotation().unimplementedFunctions.empty()),
 		make_pair("linearizedBaseContracts", getContainerIds(_node.annotation().linearizedBaseContracts)),
 		make_pair("baseContracts", toJson(_node.baseContracts())),
-		make_pair("contractDependencies", getContainerIds(_node.annotation().contractDependencies)),
-		make_pair("nodes", toJson(_node.subNodes())),
-		make_pair("scope", idOrNull(_node.scope()))
-	});
+		make_pair("contractDependencies", getContainerIds(_node.annotation().contractDependencies))
+	};
+	if (&_node != m_nodeWithoutSubNodes)
+		attributes.emplace_back("nodes", toJson(_node.subNodes()));
+	attributes.emplace_back("scope", idOrNull(_node.scope()));
+	setJsonNode(_node, "ContractDefinition", move(attributes));
 	return false;
 }
 
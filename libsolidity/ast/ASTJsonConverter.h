@@ -26,6 +26,8 @@
 #include <libsolidity/ast/ASTVisitor.h>
 #include <liblangutil/Exceptions.h>
 
+#include <libdevcore/JSON.h>
+
 #include <json/json.h>
 #include <ostream>
 #include <stack>
@@ -55,6 +57,10 @@ public:
 	);
 	/// Output the json representation of the AST to _stream.
 	void print(std::ostream& _stream, ASTNode const& _node);
+	/// Writes the json representation of the AST to @a _writer. Source units and contracts are
+	/// written one sub-node at a time, so only the JSON of a single top-level declaration
+	/// is held in memory at any time.
+	void print(JsonStreamWriter& _writer, ASTNode const& _node);
 	Json::Value&& toJson(ASTNode const& _node);
 	template <class T>
 	Json::Value toJson(std::vector<ASTPointer<T>> const& _nodes)
@@ -172,6 +178,8 @@ private:
 
 	bool m_legacy = false; ///< if true, use legacy format
 	bool m_inEvent = false; ///< whether we are currently inside an event or not
+	/// Source unit or contract whose sub-nodes are left out, since they are written separately.
+	ASTNode const* m_nodeWithoutSubNodes = nullptr;
 	Json::Value m_currentValue;
 	std::map<std::string, unsigned> m_sourceIndices;
 };
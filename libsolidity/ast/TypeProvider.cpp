@@ -0,0 +1,131 @@
+/*
+    This file is part of solidity.
+
+    solidity is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    solidity is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Canonical instances of the elementary types.
+ */
+
+#include <libsolidity/ast/TypeProvider.h>
+
+using namespace std;
+using namespace dev;
+using namespace dev::solidity;
+
+namespace
+{
+thread_local TypeProvider* s_currentProvider = nullptr;
+}
+
+TypeProvider::Scope::Scope(TypeProvider& _provider): m_previous(s_currentProvider)
+{
+	s_currentProvider = &_provider;
+}
+
+TypeProvider::Scope::~Scope()
+{
+	s_currentProvider = m_previous;
+}
+
+TypeProvider* TypeProvider::current()
+{
+	return s_currentProvider;
+}
+
+shared_ptr<BoolType const> TypeProvider::boolean()
+{
+	TypeProvider* provider = current();
+	if (!provider)
+		return make_shared<BoolType>();
+	lock_guard<recursive_mutex> lock(provider->m_mutex);
+	if (!provider->m_boolean)
+		provider->m_boolean = make_shared<BoolType>();
+	return provider->m_boolean;
+}
+
+shared_ptr<IntegerType const> TypeProvider::integer(unsigned _bits, IntegerType::Modifier _modifier)
+{
+	TypeProvider* provider = current();
+	if (!provider)
+		return make_shared<IntegerType>(_bits, _modifier);
+	solAssert(_bits > 0 && _bits <= 256 && _bits % 8 == 0, "Invalid bit number for integer type: " + dev::toString(_bits));
+	lock_guard<recursive_mutex> lock(provider->m_mutex);
+	auto& type = provider->m_integers[_bits / 8 - 1 + (_modifier == IntegerType::Modifier::Signed ? 32 : 0)];
+	if (!type)
+		type = make_shared<IntegerType>(_bits, _modifier);
+	return type;
+}
+
+shared_ptr<FixedBytesType const> TypeProvider::fixedBytes(unsigned _bytes)
+{
+	TypeProvider* provider = current();
+	if (!provider)
+		return make_shared<FixedBytesType>(_bytes);
+	solAssert(_bytes > 0 && _bytes <= 32, "Invalid byte number for fixed bytes type: " + dev::toString(_bytes));
+	lock_guard<recursive_mutex> lock(provider->m_mutex);
+	auto& type = provider->m_fixedBytes[_bytes - 1];
+	if (!type)
+		type = make_shared<FixedBytesType>(_bytes);
+	return type;
+}
+
+shared_ptr<FixedPointType const> TypeProvider::fixedPoint(
+	unsigned _totalBits,
+	unsigned _fractionalDigits,
+	FixedPointType::Modifier _modifier
+)
+{
+	TypeProvider* provider = current();
+	if (!provider)
+		return make_shared<FixedPointType>(_totalBits, _fractionalDigits, _modifier);
+	lock_guard<recursive_mutex> lock(provider->m_mutex);
+	auto& type = provider->m_fixedPoints[make_tuple(_totalBits, _fractionalDigits, _modifier)];
+	if (!type)
+		type = make_shared<FixedPointType>(_totalBits, _fractionalDigits, _modifier);
+	return type;
+}
+
+shared_ptr<AddressType const> TypeProvider::address(StateMutability _stateMutability)
+{
+	TypeProvider* provider = current();
+	if (!provider)
+		return make_shared<AddressType>(_stateMutability);
+	solAssert(
+		_stateMutability == StateMutability::NonPayable || _stateMutability == StateMutability::Payable,
+		"Invalid state mutability for address type."
+	);
+	lock_guard<recursive_mutex> lock(provider->m_mutex);
+	auto& type = provider->m_addresses[_stateMutability == StateMutability::Payable ? 1 : 0];
+	if (!type)
+		type = make_shared<AddressType>(_stateMutability);
+	return type;
+}
+
+shared_ptr<ArrayType const> TypeProvider::byteArray(DataLocation _location, bool _isString, bool _isPointer)
+{
+	auto create = [&]() {
+		auto type = make_shared<ArrayType>(_location, _isString);
+		static_cast<ReferenceType&>(*type).m_isPointer = _isPointer;
+		return type;
+	};
+	TypeProvider* provider = current();
+	if (!provider)
+		return create();
+	lock_guard<recursive_mutex> lock(provider->m_mutex);
+	auto& type = provider->m_byteArrays[size_t(_location) * 4 + (_isString ? 2 : 0) + (_isPointer ? 1 : 0)];
+	if (!type)
+		type = create();
+	return type;
+}
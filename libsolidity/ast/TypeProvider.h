@@ -0,0 +1,92 @@
+/*
+    This file is part of solidity.
+
+    solidity is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    solidity is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Canonical instances of the elementary types.
+ */
+
+#pragma once
+
+#include <libsolidity/ast/Types.h>
+
+#include <boost/noncopyable.hpp>
+
+#include <array>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+
+namespace dev
+{
+namespace solidity
+{
+
+/**
+ * Hands out one instance per distinct elementary type (bool, integers, fixed bytes,
+ * fixed point numbers, addresses, bytes and string), so that equal types share a single
+ * object and its member cache.
+ *
+ * A provider is installed for the current thread through TypeProvider::Scope, usually by
+ * the CompilerStack for the duration of analysis and code generation. Several threads can
+ * install the same provider. The cached member lists refer to contracts of the compilation,
+ * so a provider must not outlive its AST.
+ * If no provider is installed, every request creates a new type.
+ */
+class TypeProvider: boost::noncopyable
+{
+public:
+	/// Installs a provider for the current thread while the scope object is alive.
+	class Scope: boost::noncopyable
+	{
+	public:
+		explicit Scope(TypeProvider& _provider);
+		~Scope();
+	private:
+		TypeProvider* m_previous;
+	};
+
+	static std::shared_ptr<BoolType const> boolean();
+	static std::shared_ptr<IntegerType const> integer(unsigned _bits, IntegerType::Modifier _modifier);
+	static std::shared_ptr<IntegerType const> uint256() { return integer(256, IntegerType::Modifier::Unsigned); }
+	static std::shared_ptr<FixedBytesType const> fixedBytes(unsigned _bytes);
+	static std::shared_ptr<FixedPointType const> fixedPoint(
+		unsigned _totalBits,
+		unsigned _fractionalDigits,
+		FixedPointType::Modifier _modifier
+	);
+	static std::shared_ptr<AddressType const> address(StateMutability _stateMutability = StateMutability::NonPayable);
+	/// @returns the type of "bytes" or, if @a _isString, "string" at the given location.
+	static std::shared_ptr<ArrayType const> byteArray(DataLocation _location, bool _isString, bool _isPointer = true);
+
+private:
+	/// @returns the provider installed for the current thread or nullptr.
+	static TypeProvider* current();
+
+	/// Recursive because creating a byte array type requests its base type.
+	std::recursive_mutex m_mutex;
+	std::shared_ptr<BoolType const> m_boolean;
+	/// Integer types indexed by bits / 8 - 1, signed types follow the unsigned ones.
+	std::array<std::shared_ptr<IntegerType const>, 64> m_integers;
+	std::array<std::shared_ptr<FixedBytesType const>, 32> m_fixedBytes;
+	std::map<std::tuple<unsigned, unsigned, FixedPointType::Modifier>, std::shared_ptr<FixedPointType const>> m_fixedPoints;
+	std::array<std::shared_ptr<AddressType const>, 2> m_addresses;
+	/// Byte arrays indexed by location, string flag and pointer flag.
+	std::array<std::shared_ptr<ArrayType const>, 12> m_byteArrays;
+};
+
+}
+}
@@ -23,6 +23,7 @@
 #include <libsolidity/ast/Types.h>
 
 #include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/TypeProvider.h>
 
 #include <libdevcore/Algorithms.h>
 #include <libdevcore/CommonData.h>
@@ -42,6 +43,7 @@
 #include <boost/range/algorithm/copy.hpp>
 
 #include <limits>
+#include <mutex>
 
 using namespace std;
 using namespace dev;
@@ -51,6 +53,11 @@ using namespace dev::solidity;
 namespace
 {
 
+/// Guards the data of types that is computed on first use (member lists, storage offsets
+/// and the like). Types can be shared by contracts that are analysed concurrently.
+/// Computing the data of one type can require the data of another one.
+recursive_mutex s_lazyTypeDataMutex;
+
 unsigned int mostSignificantBit(bigint const& _number)
 {
 #if BOOST_VERSION < 105500
@@ -194,6 +201,7 @@ void MemberList::combine(MemberList const & _other)
 
 pair<u256, unsigned> const* MemberList::memberStorageOffset(string const& _name) const
 {
+	lock_guard<recursive_mutex> lock(s_lazyTypeDataMutex);
 	if (!m_storageOffsets)
 	{
 		TypePointers memberTypes;
@@ -211,6 +219,7 @@ pair<u256, unsigned> const* MemberList::memberStorageOffset(string const& _name)
 
 u256 const& MemberList::storageSize() const
 {
+	lock_guard<recursive_mutex> lock(s_lazyTypeDataMutex);
 	// trigger lazy computation
 	memberStorageOffset("");
 	return m_storageOffsets->storageSize();
@@ -296,33 +305,33 @@ TypePointer Type::fromElementaryTypeName(ElementaryTypeNameToken const& _type)
 	switch (token)
 	{
 	case Token::IntM:
-		return make_shared<IntegerType>(m, IntegerType::Modifier::Signed);
+		return TypeProvider::integer(m, IntegerType::Modifier::Signed);
 	case Token::UIntM:
-		return make_shared<IntegerType>(m, IntegerType::Modifier::Unsigned);
+		return TypeProvider::integer(m, IntegerType::Modifier::Unsigned);
 	case Token::BytesM:
-		return make_shared<FixedBytesType>(m);
+		return TypeProvider::fixedBytes(m);
 	case Token::FixedMxN:
-		return make_shared<FixedPointType>(m, n, FixedPointType::Modifier::Signed);
+		return TypeProvider::fixedPoint(m, n, FixedPointType::Modifier::Signed);
 	case Token::UFixedMxN:
-		return make_shared<FixedPointType>(m, n, FixedPointType::Modifier::Unsigned);
+		return TypeProvider::fixedPoint(m, n, FixedPointType::Modifier::Unsigned);
 	case Token::Int:
-		return make_shared<IntegerType>(256, IntegerType::Modifier::Signed);
+		return TypeProvider::integer(256, IntegerType::Modifier::Signed);
 	case Token::UInt:
-		return make_shared<IntegerType>(256, IntegerType::Modifier::Unsigned);
+		return TypeProvider::integer(256, IntegerType::Modifier::Unsigned);
 	case Token::Fixed:
-		return make_shared<FixedPointType>(128, 18, FixedPointType::Modifier::Signed);
+		return TypeProvider::fixedPoint(128, 18, FixedPointType::Modifier::Signed);
 	case Token::UFixed:
-		return make_shared<FixedPointType>(128, 18, FixedPointType::Modifier::Unsigned);
+		return TypeProvider::fixedPoint(128, 18, FixedPointType::Modifier::Unsigned);
 	case Token::Byte:
-		return make_shared<FixedBytesType>(1);
+		return TypeProvider::fixedBytes(1);
 	case Token::Address:
-		return make_shared<AddressType>(StateMutability::NonPayable);
+		return TypeProvider::address(StateMutability::NonPayable);
 	case Token::Bool:
-		return make_shared<BoolType>();
+		return TypeProvider::boolean();
 	case Token::Bytes:
-		return make_shared<ArrayType>(DataLocation::Storage);
+		return TypeProvider::byteArray(DataLocation::Storage, false);
 	case Token::String:
-		return make_shared<ArrayType>(DataLocation::Storage, true);
+		return TypeProvider::byteArray(DataLocation::Storage, true);
 	//no types found
 	default:
 		solAssert(
@@ -362,11 +371,11 @@ TypePointer Type::fromElementaryTypeName(string const& _name)
 		if (nameParts.size() == 2)
 		{
 			if (nameParts[1] == "payable")
-				return make_shared<AddressType>(StateMutability::Payable);
+				return TypeProvider::address(StateMutability::Payable);
 			else
 				solAssert(false, "Invalid state mutability for address type: " + nameParts[1]);
 		}
-		return make_shared<AddressType>(StateMutability::NonPayable);
+		return TypeProvider::address(StateMutability::NonPayable);
 	}
 	else
 	{
@@ -381,7 +390,7 @@ TypePointer Type::forLiteral(Literal const& _literal)
 	{
 	case Token::TrueLiteral:
 	case Token::FalseLiteral:
-		return make_shared<BoolType>();
+		return TypeProvider::boolean();
 	case Token::Number:
 		return RationalNumberType::forLiteral(_literal);
 	case Token::StringLiteral:
@@ -405,6 +414,7 @@ TypePointer Type::commonType(TypePointer const& _a, TypePointer const& _b)
 
 MemberList const& Type::members(ContractDefinition const* _currentScope) const
 {
+	lock_guard<recursive_mutex> lock(s_lazyTypeDataMutex);
 	if (!m_members[_currentScope])
 	{
 		MemberList::MemberMap members = nativeMembers(_currentScope);
@@ -536,6 +546,8 @@ TypeResult AddressType::binaryOperatorResult(Token _operator, TypePointer const&
 
 bool AddressType::operator==(Type const& _other) const
 {
+	if (&_other == this)
+		return true;
 	if (_other.category() != category())
 		return false;
 	AddressType const& other = dynamic_cast<AddressType const&>(_other);
@@ -545,7 +557,7 @@ bool AddressType::operator==(Type const& _other) const
 MemberList::MemberMap AddressType::nativeMembers(ContractDefinition const*) const
 {
 	MemberList::MemberMap members = {
-		{"balance", make_shared<IntegerType>(256)},
+		{"balance", TypeProvider::uint256()},
 		{"call", make_shared<FunctionType>(strings{"bytes memory"}, strings{"bool", "bytes memory"}, FunctionType::Kind::BareCall, false, StateMutability::Payable)},
 		{"callcode", make_shared<FunctionType>(strings{"bytes memory"}, strings{"bool", "bytes memory"}, FunctionType::Kind::BareCallCode, false, StateMutability::Payable)},
 		{"delegatecall", make_shared<FunctionType>(strings{"bytes memory"}, strings{"bool", "bytes memory"}, FunctionType::Kind::BareDelegateCall, false)},
@@ -637,6 +649,8 @@ TypeResult IntegerType::unaryOperatorResult(Token _operator) const
 
 bool IntegerType::operator==(Type const& _other) const
 {
+	if (&_other == this)
+		return true;
 	if (_other.category() != category())
 		return false;
 	IntegerType const& other = dynamic_cast<IntegerType const&>(_other);
@@ -755,6 +769,8 @@ TypeResult FixedPointType::unaryOperatorResult(Token _operator) const
 
 bool FixedPointType::operator==(Type const& _other) const
 {
+	if (&_other == this)
+		return true;
 	if (_other.category() != category())
 		return false;
 	FixedPointType const& other = dynamic_cast<FixedPointType const&>(_other);
@@ -799,9 +815,9 @@ TypeResult FixedPointType::binaryOperatorResult(Token _operator, TypePointer con
 	return commonType;
 }
 
-std::shared_ptr<IntegerType> FixedPointType::asIntegerType() const
+std::shared_ptr<IntegerType const> FixedPointType::asIntegerType() const
 {
-	return make_shared<IntegerType>(numBits(), isSigned() ? IntegerType::Modifier::Signed : IntegerType::Modifier::Unsigned);
+	return TypeProvider::integer(numBits(), isSigned() ? IntegerType::Modifier::Signed : IntegerType::Modifier::Unsigned);
 }
 
 tuple<bool, rational> RationalNumberType::parseRational(string const& _value)
@@ -858,7 +874,7 @@ TypePointer RationalNumberType::forLiteral(Literal const& _literal)
 		{
 			size_t const digitCount = _literal.valueWithoutUnderscores().length() - 2;
 			if (digitCount % 2 == 0 && (digitCount / 2) <= 32)
-				compatibleBytesType = make_shared<FixedBytesType>(digitCount / 2);
+				compatibleBytesType = TypeProvider::fixedBytes(digitCount / 2);
 		}
 
 		return make_shared<RationalNumberType>(get<1>(validLiteral), compatibleBytesType);
@@ -1312,7 +1328,7 @@ shared_ptr<IntegerType const> RationalNumberType::integerType() const
 	if (value > u256(-1))
 		return shared_ptr<IntegerType const>();
 	else
-		return make_shared<IntegerType>(
+		return TypeProvider::integer(
 			max(bytesRequired(value), 1u) * 8,
 			negative ? IntegerType::Modifier::Signed : IntegerType::Modifier::Unsigned
 		);
@@ -1349,7 +1365,7 @@ shared_ptr<FixedPointType const> RationalNumberType::fixedPointType() const
 	unsigned totalBits = max(bytesRequired(v), 1u) * 8;
 	solAssert(totalBits <= 256, "");
 
-	return make_shared<FixedPointType>(
+	return TypeProvider::fixedPoint(
 		totalBits, fractionalDigits,
 		negative ? FixedPointType::Modifier::Signed : FixedPointType::Modifier::Unsigned
 	);
@@ -1399,7 +1415,7 @@ std::string StringLiteralType::toString(bool) const
 
 TypePointer StringLiteralType::mobileType() const
 {
-	return make_shared<ArrayType>(DataLocation::Memory, true);
+	return TypeProvider::byteArray(DataLocation::Memory, true);
 }
 
 bool StringLiteralType::isValidUTF8() const
@@ -1465,7 +1481,7 @@ TypeResult FixedBytesType::binaryOperatorResult(Token _operator, TypePointer con
 
 MemberList::MemberMap FixedBytesType::nativeMembers(const ContractDefinition*) const
 {
-	return MemberList::MemberMap{MemberList::Member{"length", make_shared<IntegerType>(8)}};
+	return MemberList::MemberMap{MemberList::Member{"length", TypeProvider::integer(8, IntegerType::Modifier::Unsigned)}};
 }
 
 string FixedBytesType::richIdentifier() const
@@ -1475,6 +1491,8 @@ string FixedBytesType::richIdentifier() const
 
 bool FixedBytesType::operator==(Type const& _other) const
 {
+	if (&_other == this)
+		return true;
 	if (_other.category() != category())
 		return false;
 	FixedBytesType const& other = dynamic_cast<FixedBytesType const&>(_other);
@@ -1611,6 +1629,13 @@ string ReferenceType::identifierLocationSuffix() const
 	return id;
 }
 
+ArrayType::ArrayType(DataLocation _location, bool _isString):
+	ReferenceType(_location),
+	m_arrayKind(_isString ? ArrayKind::String : ArrayKind::Bytes),
+	m_baseType(TypeProvider::fixedBytes(1))
+{
+}
+
 BoolResult ArrayType::isImplicitlyConvertibleTo(const Type& _convertTo) const
 {
 	if (_convertTo.category() != category())
@@ -1689,6 +1714,8 @@ string ArrayType::richIdentifier() const
 
 bool ArrayType::operator==(Type const& _other) const
 {
+	if (&_other == this)
+		return true;
 	if (_other.category() != category())
 		return false;
 	ArrayType const& other = dynamic_cast<ArrayType const&>(_other);
@@ -1821,12 +1848,12 @@ MemberList::MemberMap ArrayType::nativeMembers(ContractDefinition const*) const
 	MemberList::MemberMap members;
 	if (!isString())
 	{
-		members.emplace_back("length", make_shared<IntegerType>(256));
+		members.emplace_back("length", TypeProvider::uint256());
 		if (isDynamicallySized() && location() == DataLocation::Storage)
 		{
 			members.emplace_back("push", make_shared<FunctionType>(
 				TypePointers{baseType()},
-				TypePointers{make_shared<IntegerType>(256)},
+				TypePointers{TypeProvider::uint256()},
 				strings{string()},
 				strings{string()},
 				isByteArray() ? FunctionType::Kind::ByteArrayPush : FunctionType::Kind::ArrayPush
@@ -1846,7 +1873,7 @@ MemberList::MemberMap ArrayType::nativeMembers(ContractDefinition const*) const
 TypePointer ArrayType::encodingType() const
 {
 	if (location() == DataLocation::Storage)
-		return make_shared<IntegerType>(256);
+		return TypeProvider::uint256();
 	else
 		return this->copyForLocation(DataLocation::Memory, true);
 }
@@ -1854,7 +1881,7 @@ TypePointer ArrayType::encodingType() const
 TypePointer ArrayType::decodingType() const
 {
 	if (location() == DataLocation::Storage)
-		return make_shared<IntegerType>(256);
+		return TypeProvider::uint256();
 	else
 		return shared_from_this();
 }
@@ -1901,6 +1928,8 @@ u256 ArrayType::memorySize() const
 
 TypePointer ArrayType::copyForLocation(DataLocation _location, bool _isPointer) const
 {
+	if (isByteArray())
+		return TypeProvider::byteArray(_location, isString(), _isPointer);
 	auto copy = make_shared<ArrayType>(_location);
 	copy->m_isPointer = _isPointer;
 	copy->m_arrayKind = m_arrayKind;
@@ -1936,6 +1965,13 @@ string ContractType::canonicalName() const
 	return m_contract.annotation().canonicalName;
 }
 
+TypePointer ContractType::encodingType() const
+{
+	if (isSuper())
+		return TypePointer{};
+	return TypeProvider::address(isPayable() ? StateMutability::Payable : StateMutability::NonPayable);
+}
+
 MemberList::MemberMap ContractType::nativeMembers(ContractDefinition const* _contract) const
 {
 	MemberList::MemberMap members;
@@ -1983,6 +2019,7 @@ MemberList::MemberMap ContractType::nativeMembers(ContractDefinition const* _con
 
 shared_ptr<FunctionType const> const& ContractType::newExpressionType() const
 {
+	lock_guard<recursive_mutex> lock(s_lazyTypeDataMutex);
 	if (!m_constructorType)
 		m_constructorType = FunctionType::newExpressionType(m_contract);
 	return m_constructorType;
@@ -2103,6 +2140,11 @@ MemberList::MemberMap StructType::nativeMembers(ContractDefinition const*) const
 	return members;
 }
 
+TypePointer StructType::encodingType() const
+{
+	return location() == DataLocation::Storage ? TypeProvider::uint256() : shared_from_this();
+}
+
 TypePointer StructType::interfaceType(bool _inLibrary) const
 {
 	if (!canBeUsedExternally(_inLibrary))
@@ -2232,6 +2274,7 @@ set<string> StructType::membersMissingInMemory() const
 
 bool StructType::recursive() const
 {
+	lock_guard<recursive_mutex> lock(s_lazyTypeDataMutex);
 	if (!m_recursive.is_initialized())
 	{
 		auto visitor = [&](StructDefinition const& _struct, CycleDetector<StructDefinition>& _cycleDetector, size_t /*_depth*/)
@@ -2278,6 +2321,11 @@ unsigned EnumType::storageBytes() const
 		return dev::bytesRequired(elements - 1);
 }
 
+TypePointer EnumType::encodingType() const
+{
+	return TypeProvider::integer(8 * int(storageBytes()), IntegerType::Modifier::Unsigned);
+}
+
 string EnumType::toString(bool) const
 {
 	return string("enum ") + m_enum.annotation().canonicalName;
@@ -2444,7 +2492,7 @@ FunctionType::FunctionType(VariableDeclaration const& _varDecl):
 				break;
 			returnType = arrayType->baseType();
 			m_parameterNames.emplace_back("");
-			m_parameterTypes.push_back(make_shared<IntegerType>(256));
+			m_parameterTypes.push_back(TypeProvider::uint256());
 		}
 		else
 			break;
@@ -2843,7 +2891,7 @@ MemberList::MemberMap FunctionType::nativeMembers(ContractDefinition const*) con
 	{
 		MemberList::MemberMap members;
 		if (m_kind == Kind::External)
-			members.emplace_back("selector", make_shared<FixedBytesType>(4));
+			members.emplace_back("selector", TypeProvider::fixedBytes(4));
 		if (m_kind != Kind::BareDelegateCall)
 		{
 			if (isPayable())
@@ -3165,6 +3213,11 @@ string MappingType::canonicalName() const
 	return "mapping(" + keyType()->canonicalName() + " => " + valueType()->canonicalName() + ")";
 }
 
+TypePointer MappingType::encodingType() const
+{
+	return TypeProvider::uint256();
+}
+
 string TypeType::richIdentifier() const
 {
 	return "t_type" + identifierList(actualType());
@@ -3335,31 +3388,31 @@ MemberList::MemberMap MagicType::nativeMembers(ContractDefinition const*) const
 	{
 	case Kind::Block:
 		return MemberList::MemberMap({
-			{"coinbase", make_shared<AddressType>(StateMutability::Payable)},
-			{"timestamp", make_shared<IntegerType>(256)},
+			{"coinbase", TypeProvider::address(StateMutability::Payable)},
+			{"timestamp", TypeProvider::uint256()},
 			{"blockhash", make_shared<FunctionType>(strings{"uint"}, strings{"bytes32"}, FunctionType::Kind::BlockHash, false, StateMutability::View)},
-			{"difficulty", make_shared<IntegerType>(256)},
-			{"number", make_shared<IntegerType>(256)},
-			{"gaslimit", make_shared<IntegerType>(256)}
+			{"difficulty", TypeProvider::uint256()},
+			{"number", TypeProvider::uint256()},
+			{"gaslimit", TypeProvider::uint256()}
 		});
 	case Kind::Message:
 		return MemberList::MemberMap({
-			{"sender", make_shared<AddressType>(StateMutability::Payable)},
-			{"gas", make_shared<IntegerType>(256)},
-			{"value", make_shared<IntegerType>(256)},
-			{"data", make_shared<ArrayType>(DataLocation::CallData)},
-			{"sig", make_shared<FixedBytesType>(4)}
+			{"sender", TypeProvider::address(StateMutability::Payable)},
+			{"gas", TypeProvider::uint256()},
+			{"value", TypeProvider::uint256()},
+			{"data", TypeProvider::byteArray(DataLocation::CallData, false)},
+			{"sig", TypeProvider::fixedBytes(4)}
 		});
 	case Kind::Transaction:
 		return MemberList::MemberMap({
-			{"origin", make_shared<AddressType>(StateMutability::Payable)},
-			{"gasprice", make_shared<IntegerType>(256)}
+			{"origin", TypeProvider::address(StateMutability::Payable)},
+			{"gasprice", TypeProvider::uint256()}
 		});
 	case Kind::ABI:
 		return MemberList::MemberMap({
 			{"encode", make_shared<FunctionType>(
 				TypePointers(),
-				TypePointers{make_shared<ArrayType>(DataLocation::Memory)},
+				TypePointers{TypeProvider::byteArray(DataLocation::Memory, false)},
 				strings{},
 				strings{},
 				FunctionType::Kind::ABIEncode,
@@ -3368,7 +3421,7 @@ MemberList::MemberMap MagicType::nativeMembers(ContractDefinition const*) const
 			)},
 			{"encodePacked", make_shared<FunctionType>(
 				TypePointers(),
-				TypePointers{make_shared<ArrayType>(DataLocation::Memory)},
+				TypePointers{TypeProvider::byteArray(DataLocation::Memory, false)},
 				strings{},
 				strings{},
 				FunctionType::Kind::ABIEncodePacked,
@@ -3376,8 +3429,8 @@ MemberList::MemberMap MagicType::nativeMembers(ContractDefinition const*) const
 				StateMutability::Pure
 			)},
 			{"encodeWithSelector", make_shared<FunctionType>(
-				TypePointers{make_shared<FixedBytesType>(4)},
-				TypePointers{make_shared<ArrayType>(DataLocation::Memory)},
+				TypePointers{TypeProvider::fixedBytes(4)},
+				TypePointers{TypeProvider::byteArray(DataLocation::Memory, false)},
 				strings{},
 				strings{},
 				FunctionType::Kind::ABIEncodeWithSelector,
@@ -3385,8 +3438,8 @@ MemberList::MemberMap MagicType::nativeMembers(ContractDefinition const*) const
 				StateMutability::Pure
 			)},
 			{"encodeWithSignature", make_shared<FunctionType>(
-				TypePointers{make_shared<ArrayType>(DataLocation::Memory, true)},
-				TypePointers{make_shared<ArrayType>(DataLocation::Memory)},
+				TypePointers{TypeProvider::byteArray(DataLocation::Memory, true)},
+				TypePointers{TypeProvider::byteArray(DataLocation::Memory, false)},
 				strings{},
 				strings{},
 				FunctionType::Kind::ABIEncodeWithSignature,
@@ -3424,3 +3477,8 @@ string MagicType::toString(bool) const
 		solAssert(false, "Unknown kind of magic.");
 	}
 }
+
+TypePointer InaccessibleDynamicType::decodingType() const
+{
+	return TypeProvider::uint256();
+}
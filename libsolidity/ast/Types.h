@@ -46,6 +46,7 @@ namespace solidity
 {
 
 class Type; // forward
+class TypeProvider; // forward
 class FunctionType; // forward
 using TypePointer = std::shared_ptr<Type const>;
 using FunctionTypePointer = std::shared_ptr<FunctionType const>;
@@ -456,7 +457,7 @@ public:
 	bigint minIntegerValue() const;
 
 	/// @returns the smallest integer type that can hold this type with fractional parts shifted to integers.
-	std::shared_ptr<IntegerType> asIntegerType() const;
+	std::shared_ptr<IntegerType const> asIntegerType() const;
 
 private:
 	unsigned m_totalBits;
@@ -666,6 +667,8 @@ protected:
 
 	DataLocation m_location = DataLocation::Storage;
 	bool m_isPointer = true;
+
+	friend class TypeProvider;
 };
 
 /**
@@ -684,12 +687,7 @@ public:
 	Category category() const override { return Category::Array; }
 
 	/// Constructor for a byte array ("bytes") and string.
-	explicit ArrayType(DataLocation _location, bool _isString = false):
-		ReferenceType(_location),
-		m_arrayKind(_isString ? ArrayKind::String : ArrayKind::Bytes),
-		m_baseType(std::make_shared<FixedBytesType>(1))
-	{
-	}
+	explicit ArrayType(DataLocation _location, bool _isString = false);
 	/// Constructor for a dynamically sized array type ("type[]")
 	ArrayType(DataLocation _location, TypePointer const& _baseType):
 		ReferenceType(_location),
@@ -778,12 +776,7 @@ public:
 	std::string canonicalName() const override;
 
 	MemberList::MemberMap nativeMembers(ContractDefinition const* _currentScope) const override;
-	TypePointer encodingType() const override
-	{
-		if (isSuper())
-			return TypePointer{};
-		return std::make_shared<AddressType>(isPayable() ? StateMutability::Payable : StateMutability::NonPayable);
-	}
+	TypePointer encodingType() const override;
 	TypePointer interfaceType(bool _inLibrary) const override
 	{
 		if (isSuper())
@@ -834,10 +827,7 @@ public:
 	std::string toString(bool _short) const override;
 
 	MemberList::MemberMap nativeMembers(ContractDefinition const* _currentScope) const override;
-	TypePointer encodingType() const override
-	{
-		return location() == DataLocation::Storage ? std::make_shared<IntegerType>(256) : shared_from_this();
-	}
+	TypePointer encodingType() const override;
 	TypePointer interfaceType(bool _inLibrary) const override;
 	bool canBeUsedExternally(bool _inLibrary) const override;
 
@@ -892,10 +882,7 @@ public:
 	bool isValueType() const override { return true; }
 
 	BoolResult isExplicitlyConvertibleTo(Type const& _convertTo) const override;
-	TypePointer encodingType() const override
-	{
-		return std::make_shared<IntegerType>(8 * int(storageBytes()));
-	}
+	TypePointer encodingType() const override;
 	TypePointer interfaceType(bool _inLibrary) const override
 	{
 		return _inLibrary ? shared_from_this() : encodingType();
@@ -1200,10 +1187,7 @@ public:
 	std::string canonicalName() const override;
 	bool canLiveOutsideStorage() const override { return false; }
 	TypeResult binaryOperatorResult(Token, TypePointer const&) const override { return TypePointer(); }
-	TypePointer encodingType() const override
-	{
-		return std::make_shared<IntegerType>(256);
-	}
+	TypePointer encodingType() const override;
 	TypePointer interfaceType(bool _inLibrary) const override
 	{
 		return _inLibrary ? shared_from_this() : TypePointer();
@@ -1351,7 +1335,7 @@ public:
 	unsigned sizeOnStack() const override { return 1; }
 	bool hasSimpleZeroValueInMemory() const override { solAssert(false, ""); }
 	std::string toString(bool) const override { return "inaccessible dynamic type"; }
-	TypePointer decodingType() const override { return std::make_shared<IntegerType>(256); }
+	TypePointer decodingType() const override;
 };
 
 }
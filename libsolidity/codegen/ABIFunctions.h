@@ -86,7 +86,6 @@ public:
 	/// empty return value.
 	std::pair<std::string, std::set<std::string>> requestedFunctions();
 
-private:
 	/// @returns the name of the cleanup function for the given type and
 	/// adds its implementation to the requested functions.
 	/// @param _revertOnFailure if true, causes revert on invalid data,
@@ -98,6 +97,7 @@ private:
 	/// (i.e. "clean"). Asserts on failure.
 	std::string conversionFunction(Type const& _from, Type const& _to);
 
+private:
 	std::string cleanupCombinedExternalFunctionIdFunction();
 
 	/// @returns a function that combines the address and selector to a single value
@@ -22,6 +22,7 @@
 
 #include <libsolidity/codegen/ArrayUtils.h>
 
+#include <libsolidity/ast/TypeProvider.h>
 #include <libsolidity/ast/Types.h>
 #include <libsolidity/codegen/CompilerContext.h>
 #include <libsolidity/codegen/CompilerUtils.h>
@@ -43,7 +44,7 @@ void ArrayUtils::copyArrayToStorage(ArrayType const& _targetType, ArrayType cons
 	// stack layout: [source_ref] [source length] target_ref (top)
 	solAssert(_targetType.location() == DataLocation::Storage, "");
 
-	TypePointer uint256 = make_shared<IntegerType>(256);
+	TypePointer uint256 = TypeProvider::uint256();
 	TypePointer targetBaseType = _targetType.isByteArray() ? uint256 : _targetType.baseType();
 	TypePointer sourceBaseType = _sourceType.isByteArray() ? uint256 : _sourceType.baseType();
 
@@ -467,52 +468,43 @@ void ArrayUtils::copyArrayToMemory(ArrayType const& _sourceType, bool _padToWord
 		}
 
 		// stack here: memory_end_offset storage_data_offset memory_offset
-		bool haveByteOffset = !_sourceType.isByteArray() && storageBytes <= 16;
-		if (haveByteOffset)
-			m_context << u256(0) << Instruction::SWAP1;
-		// stack here: memory_end_offset storage_data_offset [storage_byte_offset] memory_offset
-		eth::AssemblyItem loopStart = m_context.newTag();
-		m_context << loopStart;
-		// load and store
-		if (_sourceType.isByteArray())
-		{
-			// Packed both in storage and memory.
-			m_context << Instruction::DUP2 << Instruction::SLOAD;
-			m_context << Instruction::DUP2 << Instruction::MSTORE;
-			// increment storage_data_offset by 1
-			m_context << Instruction::SWAP1 << u256(1) << Instruction::ADD;
-			// increment memory offset by 32
-			m_context << Instruction::SWAP1 << u256(32) << Instruction::ADD;
-		}
+		if (!_sourceType.isByteArray() && storageBytes <= 16)
+			copyPackedStorageItemsToMemory(*_sourceType.baseType());
 		else
 		{
-			// stack here: memory_end_offset storage_data_offset [storage_byte_offset] memory_offset
-			if (haveByteOffset)
-				m_context << Instruction::DUP3 << Instruction::DUP3;
-			else
-				m_context << Instruction::DUP2 << u256(0);
-			StorageItem(m_context, *_sourceType.baseType()).retrieveValue(SourceLocation(), true);
-			if (auto baseArray = dynamic_cast<ArrayType const*>(_sourceType.baseType().get()))
-				copyArrayToMemory(*baseArray, _padToWordBoundaries);
-			else
-				utils.storeInMemoryDynamic(*_sourceType.baseType());
-			// increment storage_data_offset and byte offset
-			if (haveByteOffset)
-				incrementByteOffset(storageBytes, 2, 3);
+			eth::AssemblyItem loopStart = m_context.newTag();
+			m_context << loopStart;
+			// load and store
+			if (_sourceType.isByteArray())
+			{
+				// Packed both in storage and memory.
+				m_context << Instruction::DUP2 << Instruction::SLOAD;
+				m_context << Instruction::DUP2 << Instruction::MSTORE;
+				// increment storage_data_offset by 1
+				m_context << Instruction::SWAP1 << u256(1) << Instruction::ADD;
+				// increment memory offset by 32
+				m_context << Instruction::SWAP1 << u256(32) << Instruction::ADD;
+			}
 			else
 			{
+				// stack here: memory_end_offset storage_data_offset memory_offset
+				m_context << Instruction::DUP2 << u256(0);
+				StorageItem(m_context, *_sourceType.baseType()).retrieveValue(SourceLocation(), true);
+				if (auto baseArray = dynamic_cast<ArrayType const*>(_sourceType.baseType().get()))
+					copyArrayToMemory(*baseArray, _padToWordBoundaries);
+				else
+					utils.storeInMemoryDynamic(*_sourceType.baseType());
+				// increment storage_data_offset
 				m_context << Instruction::SWAP1;
 				m_context << storageSize << Instruction::ADD;
 				m_context << Instruction::SWAP1;
 			}
+			// check for loop condition
+			m_context << Instruction::DUP1 << Instruction::DUP4;
+			m_context << Instruction::GT;
+			m_context.appendConditionalJumpTo(loopStart);
 		}
-		// check for loop condition
-		m_context << Instruction::DUP1 << dupInstruction(haveByteOffset ? 5 : 4);
-		m_context << Instruction::GT;
-		m_context.appendConditionalJumpTo(loopStart);
-		// stack here: memory_end_offset storage_data_offset [storage_byte_offset] memory_offset
-		if (haveByteOffset)
-			m_context << Instruction::SWAP1 << Instruction::POP;
+		// stack here: memory_end_offset storage_data_offset memory_offset
 		if (_padToWordBoundaries && baseSize % 32 != 0)
 		{
 			// memory_end_offset - start is the actual length (we want to compute the ceil of).
@@ -527,6 +519,43 @@ void ArrayUtils::copyArrayToMemory(ArrayType const& _sourceType, bool _padToWord
 	}
 }
 
+void ArrayUtils::copyPackedStorageItemsToMemory(Type const& _baseType) const
+{
+	unsigned storageBytes = _baseType.storageBytes();
+	solAssert(_baseType.isValueType() && storageBytes <= 16, "");
+	CompilerUtils utils(m_context);
+	StorageItem item(m_context, _baseType);
+
+	// stack here: memory_end_offset storage_data_offset memory_offset
+	eth::AssemblyItem slotLoopStart = m_context.newTag();
+	m_context << slotLoopStart;
+	// load the slot only once and unpack its items from the stack
+	m_context << Instruction::DUP2 << Instruction::SLOAD;
+	// compute the memory offset behind the last item of this slot
+	m_context << Instruction::DUP2 << u256(32 * (32 / storageBytes)) << Instruction::ADD;
+	// stack here: memory_end_offset storage_data_offset memory_offset slot_value slot_memory_end
+	eth::AssemblyItem itemLoopStart = m_context.newTag();
+	m_context << itemLoopStart;
+	m_context << Instruction::DUP3 << Instruction::DUP3;
+	item.retrieveValueFromSlot(0);
+	utils.storeInMemoryDynamic(_baseType);
+	m_context << Instruction::SWAP3 << Instruction::POP;
+	// shift the next item into the lower-order bytes
+	m_context << Instruction::SWAP1;
+	utils.rightShiftNumberOnStack(8 * storageBytes);
+	m_context << Instruction::SWAP1;
+	// continue while memory_offset < slot_memory_end and memory_offset < memory_end_offset
+	m_context << Instruction::DUP1 << Instruction::DUP4 << Instruction::LT;
+	m_context << Instruction::DUP6 << Instruction::DUP5 << Instruction::LT << Instruction::AND;
+	m_context.appendConditionalJumpTo(itemLoopStart);
+	m_context << Instruction::POP << Instruction::POP;
+	// increment storage_data_offset by 1
+	m_context << Instruction::SWAP1 << u256(1) << Instruction::ADD << Instruction::SWAP1;
+	// stack here: memory_end_offset storage_data_offset memory_offset
+	m_context << Instruction::DUP1 << Instruction::DUP4 << Instruction::GT;
+	m_context.appendConditionalJumpTo(slotLoopStart);
+}
+
 void ArrayUtils::clearArray(ArrayType const& _typeIn) const
 {
 	TypePointer type = _typeIn.shared_from_this();
@@ -557,10 +586,12 @@ void ArrayUtils::clearArray(ArrayType const& _typeIn) const
 				// unroll loop for small arrays @todo choose a good value
 				// Note that we loop over storage slots here, not elements.
 				for (unsigned i = 1; i < _type.storageSize(); ++i)
-					_context
-						<< u256(0) << Instruction::DUP2 << Instruction::SSTORE
-						<< u256(1) << Instruction::ADD;
-				_context << u256(0) << Instruction::SWAP1 << Instruction::SSTORE;
+				{
+					ArrayUtils(_context).clearStorageSlot();
+					_context << u256(1) << Instruction::ADD;
+				}
+				ArrayUtils(_context).clearStorageSlot();
+				_context << Instruction::POP;
 			}
 			else if (!_type.baseType()->isValueType() && _type.length() <= 4)
 			{
@@ -583,7 +614,7 @@ void ArrayUtils::clearArray(ArrayType const& _typeIn) const
 				ArrayUtils(_context).convertLengthToSize(_type);
 				_context << Instruction::ADD << Instruction::SWAP1;
 				if (_type.baseType()->storageBytes() < 32)
-					ArrayUtils(_context).clearStorageLoop(make_shared<IntegerType>(256));
+					ArrayUtils(_context).clearStorageLoop(TypeProvider::uint256());
 				else
 					ArrayUtils(_context).clearStorageLoop(_type.baseType());
 				_context << Instruction::POP;
@@ -624,7 +655,7 @@ void ArrayUtils::clearDynamicArray(ArrayType const& _type) const
 		<< Instruction::SWAP1;
 	// stack: data_pos_end data_pos
 	if (_type.isByteArray() || _type.baseType()->storageBytes() < 32)
-		clearStorageLoop(make_shared<IntegerType>(256));
+		clearStorageLoop(TypeProvider::uint256());
 	else
 		clearStorageLoop(_type.baseType());
 	// cleanup
@@ -731,7 +762,7 @@ void ArrayUtils::resizeDynamicArray(ArrayType const& _typeIn) const
 				ArrayUtils(_context).convertLengthToSize(_type);
 				_context << Instruction::DUP2 << Instruction::ADD << Instruction::SWAP1;
 				// stack: ref new_length current_length first_word data_location_end data_location
-				ArrayUtils(_context).clearStorageLoop(make_shared<IntegerType>(256));
+				ArrayUtils(_context).clearStorageLoop(TypeProvider::uint256());
 				_context << Instruction::POP;
 				// stack: ref new_length current_length first_word
 				solAssert(_context.stackHeight() - stackHeightStart == 4 - 2, "3");
@@ -770,7 +801,7 @@ void ArrayUtils::resizeDynamicArray(ArrayType const& _typeIn) const
 			_context << Instruction::SWAP2 << Instruction::ADD;
 			// stack: ref new_length delete_end delete_start
 			if (_type.isByteArray() || _type.baseType()->storageBytes() < 32)
-				ArrayUtils(_context).clearStorageLoop(make_shared<IntegerType>(256));
+				ArrayUtils(_context).clearStorageLoop(TypeProvider::uint256());
 			else
 				ArrayUtils(_context).clearStorageLoop(_type.baseType());
 
@@ -939,9 +970,14 @@ void ArrayUtils::clearStorageLoop(TypePointer const& _type) const
 			eth::AssemblyItem zeroLoopEnd = _context.newTag();
 			_context.appendConditionalJumpTo(zeroLoopEnd);
 			// delete
-			_context << u256(0);
-			StorageItem(_context, *_type).setToZero(SourceLocation(), false);
-			_context << Instruction::POP;
+			if (_type->isValueType() && _type->storageBytes() == 32)
+				ArrayUtils(_context).clearStorageSlot();
+			else
+			{
+				_context << u256(0);
+				StorageItem(_context, *_type).setToZero(SourceLocation(), false);
+				_context << Instruction::POP;
+			}
 			// increment
 			_context << _type->storageSize() << Instruction::ADD;
 			_context.appendJumpTo(loopStart);
@@ -957,6 +993,23 @@ void ArrayUtils::clearStorageLoop(TypePointer const& _type) const
 	);
 }
 
+void ArrayUtils::clearStorageSlot() const
+{
+	// stack: slot
+	if (m_context.evmVersion().hasNetGasMeteringForStorage())
+	{
+		m_context << u256(0) << Instruction::DUP2 << Instruction::SSTORE;
+		return;
+	}
+	// Writing zero to a slot that is already zero costs as much as resetting a non-zero
+	// slot, while checking it only costs an SLOAD.
+	eth::AssemblyItem skip = m_context.newTag();
+	m_context << Instruction::DUP1 << Instruction::SLOAD << Instruction::ISZERO;
+	m_context.appendConditionalJumpTo(skip);
+	m_context << u256(0) << Instruction::DUP2 << Instruction::SSTORE;
+	m_context << skip;
+}
+
 void ArrayUtils::convertLengthToSize(ArrayType const& _arrayType, bool _pad) const
 {
 	if (_arrayType.location() == DataLocation::Storage)
@@ -104,6 +104,16 @@ public:
 	void accessIndex(ArrayType const& _arrayType, bool _doBoundsCheck = true) const;
 
 private:
+	/// Copies the items of a storage array that stores multiple items of type @a _baseType
+	/// per slot to memory. Each slot is loaded only once and its items are unpacked on the stack.
+	/// Stack pre: memory_end_offset storage_data_offset memory_offset
+	/// Stack post: memory_end_offset updated_storage_data_offset updated_memory_offset
+	void copyPackedStorageItemsToMemory(Type const& _baseType) const;
+	/// Sets the given storage slot to zero. Unless storage writes use net gas metering, the
+	/// slot is only written to if it is not zero already.
+	/// Stack pre: storage_slot
+	/// Stack post: storage_slot
+	void clearStorageSlot() const;
 	/// Adds the given number of bytes to a storage byte offset counter and also increments
 	/// the storage offset if adding this number again would increase the counter over 32.
 	/// @param byteOffsetPosition the stack offset of the storage byte offset
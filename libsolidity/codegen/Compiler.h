@@ -34,13 +34,27 @@ namespace solidity {
 class Compiler
 {
 public:
-	explicit Compiler(EVMVersion _evmVersion = EVMVersion{}, bool _optimize = false, unsigned _runs = 200):
+	/// @param _inlineAssemblyCache parsed inline assembly snippets that are shared with other
+	/// compilers, a new cache is used if it is not given.
+	explicit Compiler(
+		EVMVersion _evmVersion = EVMVersion{},
+		bool _optimize = false,
+		unsigned _runs = 200,
+		std::shared_ptr<InlineAssemblyCache> _inlineAssemblyCache = nullptr
+	):
 		m_optimize(_optimize),
 		m_optimizeRuns(_runs),
-		m_runtimeContext(_evmVersion),
+		m_runtimeContext(_evmVersion, nullptr, std::move(_inlineAssemblyCache)),
 		m_context(_evmVersion, &m_runtimeContext)
 	{ }
 
+	/// Keeps the given local variables at fixed memory addresses instead of on the stack.
+	/// Has to be called before the contract is compiled.
+	void setSpilledVariables(std::map<Declaration const*, u256> const& _variables)
+	{
+		m_runtimeContext.setSpilledVariables(_variables);
+		m_context.setSpilledVariables(_variables);
+	}
 	/// Compiles a contract.
 	/// @arg _metadata contains the to be injected metadata CBOR
 	void compileContract(
@@ -64,6 +78,10 @@ public:
 	{
 		return m_context.assemblyJSON(_sourceCodes);
 	}
+	void assemblyJSON(JsonStreamWriter& _writer, StringMap const& _sourceCodes = StringMap()) const
+	{
+		m_context.assemblyJSON(_writer, _sourceCodes);
+	}
 	/// @returns Assembly items of the normal compiler context
 	eth::AssemblyItems const& assemblyItems() const { return m_context.assembly().items(); }
 	/// @returns Assembly items of the runtime compiler context
@@ -179,6 +179,13 @@ bool CompilerContext::isLocalVariable(Declaration const* _declaration) const
 	return !!m_localVariables.count(_declaration);
 }
 
+u256 CompilerContext::spilledVariableAddress(Declaration const& _declaration) const
+{
+	auto it = m_spilledVariables.find(&_declaration);
+	solAssert(it != m_spilledVariables.end(), "Variable not found in memory.");
+	return it->second;
+}
+
 eth::AssemblyItem CompilerContext::functionEntryLabel(Declaration const& _declaration)
 {
 	return m_functionCompilationQueue.entryLabel(_declaration, *this);
@@ -362,43 +369,54 @@ void CompilerContext::appendInlineAssembly(
 		}
 	};
 
-	ErrorList errors;
-	ErrorReporter errorReporter(errors);
-	auto scanner = make_shared<langutil::Scanner>(langutil::CharStream(_assembly, "--CODEGEN--"));
-	auto parserResult = yul::Parser(errorReporter, yul::EVMDialect::strictAssemblyForEVM()).parse(scanner, false);
+	// The same snippets are used at many call sites, so they are only parsed and analysed once.
+	// Neither depends on the call site: the analysis only needs to know which of the local
+	// variables exist and the stack positions are only determined during code generation.
+	InlineAssemblyCache::Snippet& snippet = m_inlineAssemblyCache->snippets[make_pair(_assembly, _localVariables)];
+	if (!snippet.code)
+	{
+		ErrorList errors;
+		ErrorReporter errorReporter(errors);
+		auto scanner = make_shared<langutil::Scanner>(langutil::CharStream(_assembly, "--CODEGEN--"));
+		auto parserResult = yul::Parser(errorReporter, yul::EVMDialect::strictAssemblyForEVM()).parse(scanner, false);
 #ifdef SOL_OUTPUT_ASM
-	cout << yul::AsmPrinter()(*parserResult) << endl;
+		cout << yul::AsmPrinter()(*parserResult) << endl;
 #endif
-	yul::AsmAnalysisInfo analysisInfo;
-	bool analyzerResult = false;
-	if (parserResult)
-		analyzerResult = yul::AsmAnalyzer(
-			analysisInfo,
-			errorReporter,
-			m_evmVersion,
-			boost::none,
-			yul::EVMDialect::strictAssemblyForEVM(),
-			identifierAccess.resolve
-		).analyze(*parserResult);
-	if (!parserResult || !errorReporter.errors().empty() || !analyzerResult)
-	{
-		string message =
-			"Error parsing/analyzing inline assembly block:\n"
-			"------------------ Input: -----------------\n" +
-			_assembly + "\n"
-			"------------------ Errors: ----------------\n";
-		for (auto const& error: errorReporter.errors())
-			message += SourceReferenceFormatter::formatExceptionInformation(
-				*error,
-				(error->type() == Error::Type::Warning) ? "Warning" : "Error"
-			);
-		message += "-------------------------------------------\n";
+		auto analysisInfo = make_shared<yul::AsmAnalysisInfo>();
+		bool analyzerResult = false;
+		if (parserResult)
+			analyzerResult = yul::AsmAnalyzer(
+				*analysisInfo,
+				errorReporter,
+				m_evmVersion,
+				boost::none,
+				yul::EVMDialect::strictAssemblyForEVM(),
+				identifierAccess.resolve
+			).analyze(*parserResult);
+		if (!parserResult || !errorReporter.errors().empty() || !analyzerResult)
+		{
+			m_inlineAssemblyCache->snippets.erase(make_pair(_assembly, _localVariables));
+			string message =
+				"Error parsing/analyzing inline assembly block:\n"
+				"------------------ Input: -----------------\n" +
+				_assembly + "\n"
+				"------------------ Errors: ----------------\n";
+			for (auto const& error: errorReporter.errors())
+				message += SourceReferenceFormatter::formatExceptionInformation(
+					*error,
+					(error->type() == Error::Type::Warning) ? "Warning" : "Error"
+				);
+			message += "-------------------------------------------\n";
+
+			solAssert(false, message);
+		}
 
-		solAssert(false, message);
+		solAssert(errorReporter.errors().empty(), "Failed to analyze inline assembly block.");
+		snippet.code = std::move(parserResult);
+		snippet.analysisInfo = std::move(analysisInfo);
 	}
 
-	solAssert(errorReporter.errors().empty(), "Failed to analyze inline assembly block.");
-	CodeGenerator::assemble(*parserResult, analysisInfo, *m_asm, identifierAccess, _system);
+	CodeGenerator::assemble(*snippet.code, *snippet.analysisInfo, *m_asm, identifierAccess, _system);
 
 	// Reset the source location to the one of the node (instead of the CODEGEN source location)
 	updateSourceLocation();
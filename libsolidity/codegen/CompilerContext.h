@@ -33,14 +33,37 @@
 #include <libdevcore/Common.h>
 
 #include <functional>
+#include <map>
+#include <memory>
 #include <ostream>
 #include <stack>
 #include <queue>
 #include <utility>
 
+namespace yul
+{
+struct AsmAnalysisInfo;
+struct Block;
+}
+
 namespace dev {
 namespace solidity {
 
+/**
+ * Inline assembly snippets of the code generator that have already been parsed and analysed,
+ * keyed by their source and their local variables. Code is only generated from them at each
+ * call site, so they can be shared by the contexts of all contracts that are compiled for
+ * the same EVM version.
+ */
+struct InlineAssemblyCache
+{
+	struct Snippet
+	{
+		std::shared_ptr<yul::Block> code;
+		std::shared_ptr<yul::AsmAnalysisInfo> analysisInfo;
+	};
+	std::map<std::pair<std::string, std::vector<std::string>>, Snippet> snippets;
+};
 
 /**
  * Context to be shared by all units that compile the same contract.
@@ -49,17 +72,30 @@ namespace solidity {
 class CompilerContext
 {
 public:
-	explicit CompilerContext(EVMVersion _evmVersion = EVMVersion{}, CompilerContext* _runtimeContext = nullptr):
+	/// Creates a new context. The inline assembly cache is shared with the runtime context
+	/// if @a _inlineAssemblyCache is not given.
+	explicit CompilerContext(
+		EVMVersion _evmVersion = EVMVersion{},
+		CompilerContext* _runtimeContext = nullptr,
+		std::shared_ptr<InlineAssemblyCache> _inlineAssemblyCache = nullptr
+	):
 		m_asm(std::make_shared<eth::Assembly>()),
 		m_evmVersion(_evmVersion),
 		m_runtimeContext(_runtimeContext),
-		m_abiFunctions(m_evmVersion)
+		m_abiFunctions(m_evmVersion),
+		m_inlineAssemblyCache(std::move(_inlineAssemblyCache))
 	{
 		if (m_runtimeContext)
 			m_runtimeSub = size_t(m_asm->newSub(m_runtimeContext->m_asm).data());
+		if (!m_inlineAssemblyCache)
+			m_inlineAssemblyCache = m_runtimeContext ?
+				m_runtimeContext->m_inlineAssemblyCache :
+				std::make_shared<InlineAssemblyCache>();
 	}
 
 	EVMVersion const& evmVersion() const { return m_evmVersion; }
+	/// @returns the cache of parsed inline assembly snippets used by this context.
+	std::shared_ptr<InlineAssemblyCache> const& inlineAssemblyCache() const { return m_inlineAssemblyCache; }
 
 	/// Update currently enabled set of experimental features.
 	void setExperimentalFeatures(std::set<ExperimentalFeature> const& _features) { m_experimentalFeatures = _features; }
@@ -84,6 +120,16 @@ public:
 	bool isLocalVariable(Declaration const* _declaration) const;
 	bool isStateVariable(Declaration const* _declaration) const { return m_stateVariables.count(_declaration) != 0; }
 
+	/// Sets the local variables that are kept at fixed memory addresses instead of on the stack.
+	void setSpilledVariables(std::map<Declaration const*, u256> const& _variables) { m_spilledVariables = _variables; }
+	std::map<Declaration const*, u256> const& spilledVariables() const { return m_spilledVariables; }
+	bool isSpilledVariable(Declaration const* _declaration) const { return m_spilledVariables.count(_declaration) != 0; }
+	/// @returns the memory address of the given spilled local variable.
+	u256 spilledVariableAddress(Declaration const& _declaration) const;
+	/// @returns the size of the memory area directly after CompilerUtils::generalPurposeMemoryStart
+	/// that is reserved for spilled local variables.
+	u256 spilledVariablesMemorySize() const { return 32 * m_spilledVariables.size(); }
+
 	/// @returns the entry label of the given function and creates it if it does not exist yet.
 	eth::AssemblyItem functionEntryLabel(Declaration const& _declaration);
 	/// @returns the entry label of the given function. Might return an AssemblyItem of type
@@ -243,6 +289,10 @@ public:
 	{
 		return m_asm->assemblyJSON(_sourceCodes);
 	}
+	void assemblyJSON(JsonStreamWriter& _writer, StringMap const& _sourceCodes = StringMap()) const
+	{
+		m_asm->assemblyJSON(_writer, _sourceCodes);
+	}
 
 	eth::LinkerObject const& assembledObject() const { return m_asm->assemble(); }
 	eth::LinkerObject const& assembledRuntimeObject(size_t _subIndex) const { return m_asm->sub(_subIndex).assemble(); }
@@ -315,6 +365,8 @@ private:
 	/// modifier is applied twice, the position of the variable needs to be restored
 	/// after the nested modifier is left.
 	std::map<Declaration const*, std::vector<unsigned>> m_localVariables;
+	/// Memory addresses of local variables that are not kept on the stack.
+	std::map<Declaration const*, u256> m_spilledVariables;
 	/// List of current inheritance hierarchy from derived to base.
 	std::vector<ContractDefinition const*> m_inheritanceHierarchy;
 	/// Stack of current visited AST nodes, used for location attachment
@@ -329,6 +381,8 @@ private:
 	ABIFunctions m_abiFunctions;
 	/// The queue of low-level functions to generate.
 	std::queue<std::tuple<std::string, unsigned, unsigned, std::function<void(CompilerContext&)>>> m_lowLevelFunctionGenerationQueue;
+	/// Inline assembly snippets that were already parsed and analysed.
+	std::shared_ptr<InlineAssemblyCache> m_inlineAssemblyCache;
 };
 
 }
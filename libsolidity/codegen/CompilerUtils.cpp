@@ -23,6 +23,7 @@
 #include <libsolidity/codegen/CompilerUtils.h>
 
 #include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/TypeProvider.h>
 #include <libsolidity/codegen/ABIFunctions.h>
 #include <libsolidity/codegen/ArrayUtils.h>
 #include <libsolidity/codegen/LValue.h>
@@ -42,6 +43,7 @@ const size_t CompilerUtils::freeMemoryPointer = 64;
 const size_t CompilerUtils::zeroPointer = CompilerUtils::freeMemoryPointer + 32;
 const size_t CompilerUtils::generalPurposeMemoryStart = CompilerUtils::zeroPointer + 32;
 const unsigned CompilerUtils::identityContractAddress = 4;
+const size_t CompilerUtils::minIdentityCopySize = 0x140;
 
 static_assert(CompilerUtils::freeMemoryPointer >= 64, "Free memory pointer must not overlap with scratch area.");
 static_assert(CompilerUtils::zeroPointer >= CompilerUtils::freeMemoryPointer + 32, "Zero pointer must not overlap with free memory pointer.");
@@ -49,7 +51,7 @@ static_assert(CompilerUtils::generalPurposeMemoryStart >= CompilerUtils::zeroPoi
 
 void CompilerUtils::initialiseFreeMemoryPointer()
 {
-	m_context << u256(generalPurposeMemoryStart);
+	m_context << u256(generalPurposeMemoryStart) + m_context.spilledVariablesMemorySize();
 	storeFreeMemoryPointer();
 }
 
@@ -85,7 +87,7 @@ void CompilerUtils::revertWithStringData(Type const& _argumentType)
 	m_context << Instruction::DUP2 << Instruction::MSTORE;
 	m_context << u256(4) << Instruction::ADD;
 	// Stack: <string data> <mem pos of encoding start>
-	abiEncode({_argumentType.shared_from_this()}, {make_shared<ArrayType>(DataLocation::Memory, true)});
+	abiEncode({_argumentType.shared_from_this()}, {TypeProvider::byteArray(DataLocation::Memory, true)});
 	toSizeAfterFreeMemoryPointer();
 	m_context << Instruction::REVERT;
 }
@@ -532,23 +534,20 @@ void CompilerUtils::memoryCopy32()
 {
 	// Stack here: size target source
 
-	m_context.appendInlineAssembly(R"(
+	memoryCopyWithIdentity(R"(
 		{
 			for { let i := 0 } lt(i, len) { i := add(i, 32) } {
 				mstore(add(dst, i), mload(add(src, i)))
 			}
 		}
-	)",
-		{ "len", "dst", "src" }
-	);
-	m_context << Instruction::POP << Instruction::POP << Instruction::POP;
+	)");
 }
 
 void CompilerUtils::memoryCopy()
 {
 	// Stack here: size target source
 
-	m_context.appendInlineAssembly(R"(
+	memoryCopyWithIdentity(R"(
 		{
 			// copy 32 bytes at once
 			for
@@ -567,10 +566,7 @@ void CompilerUtils::memoryCopy()
 			let dstpart := and(mload(dst), mask)
 			mstore(dst, or(srcpart, dstpart))
 		}
-	)",
-		{ "len", "dst", "src" }
-	);
-	m_context << Instruction::POP << Instruction::POP << Instruction::POP;
+	)");
 }
 
 void CompilerUtils::splitExternalFunctionType(bool _leftAligned)
@@ -930,8 +926,34 @@ void CompilerUtils::convertType(
 				allocateMemory();
 				m_context << Instruction::SWAP1 << Instruction::DUP2;
 				// stack: <memory ptr> <source ref> <memory ptr>
-				for (auto const& member: typeOnStack.members(nullptr))
+				MemberList const& memberList = typeOnStack.members(nullptr);
+				MemberList::MemberMap const members(memberList.begin(), memberList.end());
+				for (size_t i = 0; i < members.size(); ++i)
 				{
+					size_t packedMembers = StorageItem::packedMembersInSlot(typeOnStack, members, i);
+					if (packedMembers > 1)
+					{
+						// Members that share a slot are read with a single SLOAD.
+						m_context << typeOnStack.storageOffsetsOfMember(members[i].name).first;
+						m_context << Instruction::DUP3 << Instruction::ADD << Instruction::SLOAD << Instruction::SWAP1;
+						// stack: <memory ptr> <source ref> <slot value> <memory ptr>
+						for (size_t j = i; j < i + packedMembers; ++j)
+						{
+							MemberList::Member const& member = members[j];
+							m_context << Instruction::DUP2;
+							StorageItem(m_context, *member.type).retrieveValueFromSlot(
+								typeOnStack.storageOffsetsOfMember(member.name).second
+							);
+							TypePointer targetMemberType = targetType.memberType(member.name);
+							solAssert(!!targetMemberType, "Member not found in target type.");
+							convertType(*member.type, *targetMemberType, true);
+							storeInMemoryDynamic(*targetMemberType, true);
+						}
+						m_context << Instruction::SWAP1 << Instruction::POP;
+						i += packedMembers - 1;
+						continue;
+					}
+					MemberList::Member const& member = members[i];
 					if (!member.type->canLiveOutsideStorage())
 						continue;
 					pair<u256, unsigned> const& offsets = typeOnStack.storageOffsetsOfMember(member.name);
@@ -1288,6 +1310,31 @@ void CompilerUtils::rightShiftNumberOnStack(unsigned _bits)
 		m_context << (u256(1) << _bits) << Instruction::SWAP1 << Instruction::DIV;
 }
 
+void CompilerUtils::memoryCopyWithIdentity(string const& _copyLoop)
+{
+	// Stack here: size target source
+	eth::AssemblyItem copyLoop = m_context.newTag();
+	eth::AssemblyItem copyEnd = m_context.newTag();
+	m_context << u256(minIdentityCopySize) << Instruction::DUP4 << Instruction::LT;
+	m_context.appendConditionalJumpTo(copyLoop);
+
+	// The call only fails if it runs out of gas, in which case the copy loop would
+	// have run out of gas as well.
+	Whiskers templ(R"({
+		if iszero(<call>(gas(), <identity>, <value> src, len, dst, len)) { invalid() }
+	})");
+	templ("call", m_context.evmVersion().hasStaticCall() ? "staticcall" : "call");
+	templ("identity", to_string(identityContractAddress));
+	templ("value", m_context.evmVersion().hasStaticCall() ? "" : "0,");
+	m_context.appendInlineAssembly(templ.render(), { "len", "dst", "src" });
+	m_context.appendJumpTo(copyEnd);
+
+	m_context << copyLoop;
+	m_context.appendInlineAssembly(_copyLoop, { "len", "dst", "src" });
+	m_context << copyEnd;
+	m_context << Instruction::POP << Instruction::POP << Instruction::POP;
+}
+
 unsigned CompilerUtils::prepareMemoryStore(Type const& _type, bool _padToWords)
 {
 	solAssert(
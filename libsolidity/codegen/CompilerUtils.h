@@ -177,11 +177,13 @@ public:
 
 	/// Copies full 32 byte words in memory (regions cannot overlap), i.e. may copy more than length.
 	/// Length can be zero, in this case, it copies nothing.
+	/// Regions of at least minIdentityCopySize bytes are copied using the identity precompile.
 	/// Stack pre: <size> <target> <source>
 	/// Stack post:
 	void memoryCopy32();
 	/// Copies data in memory (regions cannot overlap).
 	/// Length can be zero, in this case, it copies nothing.
+	/// Regions of at least minIdentityCopySize bytes are copied using the identity precompile.
 	/// Stack pre: <size> <target> <source>
 	/// Stack post:
 	void memoryCopy();
@@ -277,6 +279,15 @@ public:
 private:
 	/// Address of the precompiled identity contract.
 	static const unsigned identityContractAddress;
+	/// Minimum size in bytes of a memory region that is copied using the identity precompile.
+	/// Below that, copying word by word is cheaper than the call.
+	static const size_t minIdentityCopySize;
+
+	/// Appends code that copies memory using the identity precompile if the region is at least
+	/// minIdentityCopySize bytes long and using the inline assembly @a _copyLoop otherwise.
+	/// Stack pre: <size> <target> <source>
+	/// Stack post:
+	void memoryCopyWithIdentity(std::string const& _copyLoop);
 
 	/// Stores the given string in memory.
 	/// Stack pre: mempos
@@ -25,6 +25,7 @@
 #include <libsolidity/codegen/CompilerUtils.h>
 #include <libsolidity/codegen/ContractCompiler.h>
 #include <libsolidity/codegen/ExpressionCompiler.h>
+#include <libsolidity/codegen/LValue.h>
 
 #include <libevmasm/Instruction.h>
 #include <libevmasm/Assembly.h>
@@ -898,10 +899,19 @@ bool ContractCompiler::visit(VariableDeclarationStatement const& _variableDeclar
 	CompilerContext::LocationSetter locationSetter(m_context, _variableDeclarationStatement);
 
 	// Local variable slots are reserved when their declaration is visited,
-	// and freed in the end of their scope.
+	// and freed in the end of their scope. Spilled variables live in memory
+	// and only have to be reset if there is no initial value.
 	for (auto _decl: _variableDeclarationStatement.declarations())
 		if (_decl)
-			appendStackVariableInitialisation(*_decl);
+		{
+			if (!m_context.isSpilledVariable(_decl.get()))
+				appendStackVariableInitialisation(*_decl);
+			else if (!_variableDeclarationStatement.initialValue())
+			{
+				CompilerUtils(m_context).pushZeroValue(*_decl->annotation().type);
+				appendSpilledVariableAssignment(*_decl);
+			}
+		}
 
 	StackHeightChecker checker(m_context);
 	if (Expression const* expression = _variableDeclarationStatement.initialValue())
@@ -922,7 +932,10 @@ bool ContractCompiler::visit(VariableDeclarationStatement const& _variableDeclar
 			if (VariableDeclaration const* varDecl = declarations[j].get())
 			{
 				utils.convertType(*valueTypes[j], *varDecl->annotation().type);
-				utils.moveToStackVariable(*varDecl);
+				if (m_context.isSpilledVariable(varDecl))
+					appendSpilledVariableAssignment(*varDecl);
+				else
+					utils.moveToStackVariable(*varDecl);
 			}
 			else
 				utils.popStackElement(*valueTypes[j]);
@@ -1048,6 +1061,13 @@ void ContractCompiler::appendStackVariableInitialisation(VariableDeclaration con
 	CompilerUtils(m_context).pushZeroValue(*_variable.annotation().type);
 }
 
+void ContractCompiler::appendSpilledVariableAssignment(VariableDeclaration const& _variable)
+{
+	Type const& type = *_variable.annotation().type;
+	m_context << m_context.spilledVariableAddress(_variable);
+	MemoryItem(m_context, type).storeValue(type, _variable.location(), true);
+}
+
 void ContractCompiler::compileExpression(Expression const& _expression, TypePointer const& _targetType)
 {
 	ExpressionCompiler expressionCompiler(m_context, m_optimise);
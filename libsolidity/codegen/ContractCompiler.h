@@ -44,7 +44,13 @@ public:
 		m_runtimeCompiler(_runtimeCompiler),
 		m_context(_context)
 	{
-		m_context = CompilerContext(_context.evmVersion(), _runtimeCompiler ? &_runtimeCompiler->m_context : nullptr);
+		std::map<Declaration const*, u256> spilledVariables = _context.spilledVariables();
+		m_context = CompilerContext(
+			_context.evmVersion(),
+			_runtimeCompiler ? &_runtimeCompiler->m_context : nullptr,
+			_context.inlineAssemblyCache()
+		);
+		m_context.setSpilledVariables(spilledVariables);
 	}
 
 	void compileContract(
@@ -122,6 +128,8 @@ private:
 	void appendModifierOrFunctionCode();
 
 	void appendStackVariableInitialisation(VariableDeclaration const& _variable);
+	/// Moves the value on the stack top into the memory slot of the given spilled local variable.
+	void appendSpilledVariableAssignment(VariableDeclaration const& _variable);
 	void compileExpression(Expression const& _expression, TypePointer const& _targetType = TypePointer());
 
 	/// Frees the variables of a certain scope (to be used when leaving).
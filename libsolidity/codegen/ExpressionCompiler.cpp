@@ -23,6 +23,7 @@
 #include <libsolidity/codegen/ExpressionCompiler.h>
 
 #include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/TypeProvider.h>
 #include <libsolidity/codegen/CompilerContext.h>
 #include <libsolidity/codegen/CompilerUtils.h>
 #include <libsolidity/codegen/LValue.h>
@@ -853,10 +854,10 @@ bool ExpressionCompiler::visit(FunctionCall const& _functionCall)
 			solAssert(function.parameterTypes().size() == 1, "");
 			solAssert(!!function.parameterTypes()[0], "");
 			TypePointer paramType = function.parameterTypes()[0];
-			shared_ptr<ArrayType> arrayType =
+			shared_ptr<ArrayType const> arrayType =
 				function.kind() == FunctionType::Kind::ArrayPush ?
 				make_shared<ArrayType>(DataLocation::Storage, paramType) :
-				make_shared<ArrayType>(DataLocation::Storage);
+				TypeProvider::byteArray(DataLocation::Storage, false);
 
 			// stack: ArrayReference
 			arguments[0]->accept(*this);
@@ -1042,7 +1043,7 @@ bool ExpressionCompiler::visit(FunctionCall const& _functionCall)
 					{
 						FixedHash<4> hash(dev::keccak256(stringType->value()));
 						m_context << (u256(FixedHash<4>::Arith(hash)) << (256 - 32));
-						dataOnStack = make_shared<FixedBytesType>(4);
+						dataOnStack = TypeProvider::fixedBytes(4);
 					}
 					else
 					{
@@ -1053,7 +1054,7 @@ bool ExpressionCompiler::visit(FunctionCall const& _functionCall)
 						m_context << Instruction::KECCAK256;
 						// stack: <memory pointer> <hash>
 
-						dataOnStack = make_shared<FixedBytesType>(32);
+						dataOnStack = TypeProvider::fixedBytes(32);
 					}
 				}
 				else
@@ -2137,6 +2138,11 @@ void ExpressionCompiler::setLValueFromDeclaration(Declaration const& _declaratio
 {
 	if (m_context.isLocalVariable(&_declaration))
 		setLValue<StackVariable>(_expression, dynamic_cast<VariableDeclaration const&>(_declaration));
+	else if (m_context.isSpilledVariable(&_declaration))
+	{
+		m_context << m_context.spilledVariableAddress(_declaration);
+		setLValue<MemoryItem>(_expression, *dynamic_cast<VariableDeclaration const&>(_declaration).annotation().type);
+	}
 	else if (m_context.isStateVariable(&_declaration))
 		setLValue<StorageItem>(_expression, dynamic_cast<VariableDeclaration const&>(_declaration));
 	else
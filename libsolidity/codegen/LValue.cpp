@@ -178,39 +178,10 @@ void StorageItem::retrieveValue(SourceLocation const&, bool _remove) const
 		m_context << Instruction::POP << Instruction::SLOAD;
 	else
 	{
-		bool cleaned = false;
 		m_context
 			<< Instruction::SWAP1 << Instruction::SLOAD << Instruction::SWAP1
 			<< u256(0x100) << Instruction::EXP << Instruction::SWAP1 << Instruction::DIV;
-		if (m_dataType->category() == Type::Category::FixedPoint)
-			// implementation should be very similar to the integer case.
-			solUnimplemented("Not yet implemented - FixedPointType.");
-		if (m_dataType->category() == Type::Category::FixedBytes)
-		{
-			CompilerUtils(m_context).leftShiftNumberOnStack(256 - 8 * m_dataType->storageBytes());
-			cleaned = true;
-		}
-		else if (
-			m_dataType->category() == Type::Category::Integer &&
-			dynamic_cast<IntegerType const&>(*m_dataType).isSigned()
-		)
-		{
-			m_context << u256(m_dataType->storageBytes() - 1) << Instruction::SIGNEXTEND;
-			cleaned = true;
-		}
-		else if (FunctionType const* fun = dynamic_cast<decltype(fun)>(m_dataType))
-		{
-			if (fun->kind() == FunctionType::Kind::External)
-			{
-				CompilerUtils(m_context).splitExternalFunctionType(false);
-				cleaned = true;
-			}
-		}
-		if (!cleaned)
-		{
-			solAssert(m_dataType->sizeOnStack() == 1, "");
-			m_context << ((u256(0x1) << (8 * m_dataType->storageBytes())) - 1) << Instruction::AND;
-		}
+		cleanRetrievedValue();
 	}
 }
 
@@ -254,28 +225,7 @@ void StorageItem::storeValue(Type const& _sourceType, SourceLocation const& _loc
 			// stack: value storage_ref cleared_value multiplier
 			utils.copyToStackTop(3 + m_dataType->sizeOnStack(), m_dataType->sizeOnStack());
 			// stack: value storage_ref cleared_value multiplier value
-			if (FunctionType const* fun = dynamic_cast<decltype(fun)>(m_dataType))
-			{
-				solAssert(_sourceType == *m_dataType, "function item stored but target is not equal to source");
-				if (fun->kind() == FunctionType::Kind::External)
-					// Combine the two-item function type into a single stack slot.
-					utils.combineExternalFunctionType(false);
-				else
-					m_context <<
-						((u256(1) << (8 * m_dataType->storageBytes())) - 1) <<
-						Instruction::AND;
-			}
-			else if (m_dataType->category() == Type::Category::FixedBytes)
-			{
-				solAssert(_sourceType.category() == Type::Category::FixedBytes, "source not fixed bytes");
-				CompilerUtils(m_context).rightShiftNumberOnStack(256 - 8 * dynamic_cast<FixedBytesType const&>(*m_dataType).numBytes());
-			}
-			else
-			{
-				solAssert(m_dataType->sizeOnStack() == 1, "Invalid stack size for opaque type.");
-				// remove the higher order bits
-				utils.convertType(_sourceType, *m_dataType, true, true);
-			}
+			convertValueForSlot(_sourceType);
 			m_context  << Instruction::MUL << Instruction::OR;
 			// stack: value storage_ref updated_value
 			m_context << Instruction::SWAP1 << Instruction::SSTORE;
@@ -310,9 +260,20 @@ void StorageItem::storeValue(Type const& _sourceType, SourceLocation const& _loc
 				"Struct assignment with conversion."
 			);
 			solAssert(sourceType.location() != DataLocation::CallData, "Structs in calldata not supported.");
-			for (auto const& member: structType.members(nullptr))
+			MemberList const& memberList = structType.members(nullptr);
+			MemberList::MemberMap const members(memberList.begin(), memberList.end());
+			for (size_t i = 0; i < members.size(); ++i)
 			{
+				size_t packedMembers = packedMembersInSlot(structType, members, i);
+				if (packedMembers > 1)
+				{
+					// Members that share a slot are written with a single SSTORE.
+					storePackedMembers(sourceType, members, i, packedMembers, _location);
+					i += packedMembers - 1;
+					continue;
+				}
 				// assign each member that is not a mapping
+				MemberList::Member const& member = members[i];
 				TypePointer const& memberType = member.type;
 				if (memberType->category() == Type::Category::Mapping)
 					continue;
@@ -359,6 +320,157 @@ void StorageItem::storeValue(Type const& _sourceType, SourceLocation const& _loc
 	}
 }
 
+void StorageItem::retrieveValueFromSlot(unsigned _byteOffset) const
+{
+	solAssert(m_dataType->isValueType() && m_dataType->storageBytes() < 32, "");
+	// stack: slot_value
+	if (_byteOffset > 0)
+		m_context << (u256(1) << (8 * _byteOffset)) << Instruction::SWAP1 << Instruction::DIV;
+	cleanRetrievedValue();
+}
+
+void StorageItem::storeValueInSlot(Type const& _sourceType, unsigned _byteOffset) const
+{
+	solAssert(m_dataType->isValueType() && m_dataType->storageBytes() < 32, "");
+	u256 const multiplier = u256(1) << (8 * _byteOffset);
+	// stack: slot_value value...
+	convertValueForSlot(_sourceType);
+	if (_byteOffset > 0)
+		m_context << multiplier << Instruction::MUL;
+	// stack: slot_value shifted_value
+	m_context << Instruction::SWAP1;
+	m_context << ~(((u256(1) << (8 * m_dataType->storageBytes())) - 1) * multiplier) << Instruction::AND;
+	m_context << Instruction::OR;
+}
+
+size_t StorageItem::packedMembersInSlot(
+	StructType const& _structType,
+	MemberList::MemberMap const& _members,
+	size_t _first
+)
+{
+	auto isPacked = [](TypePointer const& _type) {
+		return _type->isValueType() && _type->storageBytes() < 32;
+	};
+	if (!isPacked(_members.at(_first).type))
+		return 0;
+	u256 const& slot = _structType.storageOffsetsOfMember(_members[_first].name).first;
+	size_t end = _first + 1;
+	while (
+		end < _members.size() &&
+		isPacked(_members[end].type) &&
+		_structType.storageOffsetsOfMember(_members[end].name).first == slot
+	)
+		++end;
+	return end - _first;
+}
+
+void StorageItem::cleanRetrievedValue() const
+{
+	bool cleaned = false;
+	if (m_dataType->category() == Type::Category::FixedPoint)
+		// implementation should be very similar to the integer case.
+		solUnimplemented("Not yet implemented - FixedPointType.");
+	if (m_dataType->category() == Type::Category::FixedBytes)
+	{
+		CompilerUtils(m_context).leftShiftNumberOnStack(256 - 8 * m_dataType->storageBytes());
+		cleaned = true;
+	}
+	else if (
+		m_dataType->category() == Type::Category::Integer &&
+		dynamic_cast<IntegerType const&>(*m_dataType).isSigned()
+	)
+	{
+		m_context << u256(m_dataType->storageBytes() - 1) << Instruction::SIGNEXTEND;
+		cleaned = true;
+	}
+	else if (FunctionType const* fun = dynamic_cast<decltype(fun)>(m_dataType))
+	{
+		if (fun->kind() == FunctionType::Kind::External)
+		{
+			CompilerUtils(m_context).splitExternalFunctionType(false);
+			cleaned = true;
+		}
+	}
+	if (!cleaned)
+	{
+		solAssert(m_dataType->sizeOnStack() == 1, "");
+		m_context << ((u256(0x1) << (8 * m_dataType->storageBytes())) - 1) << Instruction::AND;
+	}
+}
+
+void StorageItem::convertValueForSlot(Type const& _sourceType) const
+{
+	if (FunctionType const* fun = dynamic_cast<decltype(fun)>(m_dataType))
+	{
+		solAssert(_sourceType == *m_dataType, "function item stored but target is not equal to source");
+		if (fun->kind() == FunctionType::Kind::External)
+			// Combine the two-item function type into a single stack slot.
+			CompilerUtils(m_context).combineExternalFunctionType(false);
+		else
+			m_context <<
+				((u256(1) << (8 * m_dataType->storageBytes())) - 1) <<
+				Instruction::AND;
+	}
+	else if (m_dataType->category() == Type::Category::FixedBytes)
+	{
+		solAssert(_sourceType.category() == Type::Category::FixedBytes, "source not fixed bytes");
+		CompilerUtils(m_context).rightShiftNumberOnStack(256 - 8 * dynamic_cast<FixedBytesType const&>(*m_dataType).numBytes());
+	}
+	else
+	{
+		solAssert(m_dataType->sizeOnStack() == 1, "Invalid stack size for opaque type.");
+		// remove the higher order bits
+		CompilerUtils(m_context).convertType(_sourceType, *m_dataType, true, true);
+	}
+}
+
+void StorageItem::storePackedMembers(
+	StructType const& _sourceType,
+	MemberList::MemberMap const& _members,
+	size_t _first,
+	size_t _count,
+	SourceLocation const& _location
+) const
+{
+	auto const& structType = dynamic_cast<StructType const&>(*m_dataType);
+	u256 const& slot = structType.storageOffsetsOfMember(_members.at(_first).name).first;
+	// stack: source_ref target_ref
+	m_context << slot << Instruction::DUP2 << Instruction::ADD;
+	m_context << Instruction::DUP1 << Instruction::SLOAD;
+	// stack: source_ref target_ref target_slot slot_value
+	if (_sourceType.location() == DataLocation::Storage)
+	{
+		// The source has the same layout, so the bytes of the members are copied at once.
+		unsigned const begin = structType.storageOffsetsOfMember(_members[_first].name).second;
+		MemberList::Member const& last = _members.at(_first + _count - 1);
+		unsigned const end = structType.storageOffsetsOfMember(last.name).second + last.type->storageBytes();
+		u256 const mask = ((u256(1) << (8 * (end - begin))) - 1) << (8 * begin);
+		m_context << ~mask << Instruction::AND;
+		m_context << slot << Instruction::DUP5 << Instruction::ADD << Instruction::SLOAD;
+		m_context << mask << Instruction::AND << Instruction::OR;
+	}
+	else
+	{
+		solAssert(_sourceType.location() == DataLocation::Memory, "");
+		for (size_t i = _first; i < _first + _count; ++i)
+		{
+			MemberList::Member const& member = _members[i];
+			TypePointer sourceMemberType = _sourceType.memberType(member.name);
+			m_context << _sourceType.memoryOffsetOfMember(member.name);
+			m_context << Instruction::DUP5 << Instruction::ADD;
+			MemoryItem(m_context, *sourceMemberType).retrieveValue(_location, true);
+			// stack: source_ref target_ref target_slot slot_value source_value...
+			StorageItem(m_context, *member.type).storeValueInSlot(
+				*sourceMemberType,
+				structType.storageOffsetsOfMember(member.name).second
+			);
+		}
+	}
+	// stack: source_ref target_ref target_slot updated_slot_value
+	m_context << Instruction::SWAP1 << Instruction::SSTORE;
+}
+
 void StorageItem::setToZero(SourceLocation const&, bool _removeReference) const
 {
 	if (m_dataType->category() == Type::Category::Array)
@@ -23,6 +23,7 @@
 #pragma once
 
 #include <libsolidity/codegen/ArrayUtils.h>
+#include <libsolidity/ast/Types.h>
 #include <liblangutil/SourceLocation.h>
 #include <memory>
 #include <vector>
@@ -147,6 +148,44 @@ public:
 		langutil::SourceLocation const& _location = {},
 		bool _removeReference = true
 	) const override;
+
+	/// Extracts the value at byte offset @a _byteOffset from the content of a storage slot.
+	/// Stack pre: slot_value
+	/// Stack post: value...
+	void retrieveValueFromSlot(unsigned _byteOffset) const;
+	/// Replaces the bytes at offset @a _byteOffset in the content of a storage slot by the value
+	/// of type @a _sourceType on top of the stack.
+	/// Stack pre: slot_value value...
+	/// Stack post: updated_slot_value
+	void storeValueInSlot(Type const& _sourceType, unsigned _byteOffset) const;
+
+	/// @returns the number of members of @a _members starting at index @a _first that
+	/// are value types packed into the same storage slot of @a _structType. Such members
+	/// can be accessed with a single SLOAD or SSTORE.
+	static size_t packedMembersInSlot(
+		StructType const& _structType,
+		MemberList::MemberMap const& _members,
+		size_t _first
+	);
+
+private:
+	/// Removes the higher order bytes of a value of the data type that was shifted to the lower
+	/// order bytes of a storage slot value.
+	void cleanRetrievedValue() const;
+	/// Converts a value of type @a _sourceType to the data type, such that it only occupies the
+	/// lower order bytes of a single stack slot.
+	void convertValueForSlot(Type const& _sourceType) const;
+	/// Assigns the @a _count members starting at index @a _first, which are packed into the same
+	/// storage slot, from a struct of type @a _sourceType to a struct of the data type.
+	/// Stack pre: source_ref target_ref
+	/// Stack post: source_ref target_ref
+	void storePackedMembers(
+		StructType const& _sourceType,
+		MemberList::MemberMap const& _members,
+		size_t _first,
+		size_t _count,
+		langutil::SourceLocation const& _location
+	) const;
 };
 
 /**
@@ -0,0 +1,262 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Selection of local variables that are kept in memory instead of on the stack.
+ */
+
+#include <libsolidity/codegen/StackSpiller.h>
+
+#include <libsolidity/codegen/CompilerUtils.h>
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTVisitor.h>
+
+#include <boost/range/iterator_range.hpp>
+
+#include <algorithm>
+#include <set>
+
+using namespace std;
+using namespace dev;
+using namespace langutil;
+using namespace dev::solidity;
+
+namespace
+{
+
+/**
+ * Collects the internal calls, the local variables and the number of references to each
+ * variable of a function or modifier.
+ */
+class CallableInfo: private ASTConstVisitor
+{
+public:
+	explicit CallableInfo(CallableDeclaration const& _callable) { _callable.accept(*this); }
+
+	/// Functions that are called directly.
+	set<FunctionDefinition const*> calledFunctions;
+	/// Names of the modifiers that are invoked.
+	set<string> invokedModifiers;
+	/// Functions that are referenced without being called, i.e. whose address might be taken.
+	set<FunctionDefinition const*> referencedFunctions;
+	/// True if internal functions are called through function pointers.
+	bool callsFunctionPointers = false;
+	/// Variables declared in statements in the order of their declaration.
+	vector<VariableDeclaration const*> localVariables;
+	/// Number of references to each variable.
+	map<VariableDeclaration const*, size_t> references;
+	/// Variables accessed from inline assembly.
+	set<VariableDeclaration const*> assemblyReferences;
+
+private:
+	bool visit(FunctionCall const& _functionCall) override
+	{
+		if (_functionCall.annotation().kind != FunctionCallKind::FunctionCall)
+			return true;
+		auto functionType = dynamic_pointer_cast<FunctionType const>(_functionCall.expression().annotation().type);
+		if (!functionType || functionType->kind() != FunctionType::Kind::Internal)
+			return true;
+		if (auto function = referencedFunction(_functionCall.expression()))
+		{
+			calledFunctions.insert(function);
+			m_directCallees.insert(&_functionCall.expression());
+		}
+		else
+			callsFunctionPointers = true;
+		return true;
+	}
+	bool visit(ModifierInvocation const& _modifier) override
+	{
+		invokedModifiers.insert(_modifier.name()->name());
+		if (_modifier.arguments())
+			for (auto const& argument: *_modifier.arguments())
+				argument->accept(*this);
+		return false;
+	}
+	bool visit(VariableDeclarationStatement const& _statement) override
+	{
+		for (auto const& declaration: _statement.declarations())
+			if (declaration)
+				localVariables.push_back(declaration.get());
+		return true;
+	}
+	bool visit(InlineAssembly const& _inlineAssembly) override
+	{
+		for (auto const& reference: _inlineAssembly.annotation().externalReferences)
+			if (auto variable = dynamic_cast<VariableDeclaration const*>(reference.second.declaration))
+				assemblyReferences.insert(variable);
+		return false;
+	}
+	void endVisit(Identifier const& _identifier) override
+	{
+		Declaration const* declaration = _identifier.annotation().referencedDeclaration;
+		if (auto variable = dynamic_cast<VariableDeclaration const*>(declaration))
+			references[variable]++;
+		endVisitFunctionReference(_identifier);
+	}
+	void endVisit(MemberAccess const& _memberAccess) override
+	{
+		endVisitFunctionReference(_memberAccess);
+	}
+	void endVisitFunctionReference(Expression const& _expression)
+	{
+		if (auto function = referencedFunction(_expression))
+			if (!m_directCallees.count(&_expression))
+				referencedFunctions.insert(function);
+	}
+
+	static FunctionDefinition const* referencedFunction(Expression const& _expression)
+	{
+		if (auto identifier = dynamic_cast<Identifier const*>(&_expression))
+			return dynamic_cast<FunctionDefinition const*>(identifier->annotation().referencedDeclaration);
+		else if (auto memberAccess = dynamic_cast<MemberAccess const*>(&_expression))
+			return dynamic_cast<FunctionDefinition const*>(memberAccess->annotation().referencedDeclaration);
+		return nullptr;
+	}
+
+	set<Expression const*> m_directCallees;
+};
+
+}
+
+StackSpiller::StackSpiller(ContractDefinition const& _contract)
+{
+	// Collect all functions and modifiers of the inheritance hierarchy and all
+	// (library) functions they call.
+	map<CallableDeclaration const*, CallableInfo> callables;
+	vector<CallableDeclaration const*> queue;
+	for (ContractDefinition const* contract: _contract.annotation().linearizedBaseContracts)
+	{
+		for (FunctionDefinition const* function: contract->definedFunctions())
+			queue.push_back(function);
+		for (ModifierDefinition const* modifier: contract->functionModifiers())
+			queue.push_back(modifier);
+	}
+	while (!queue.empty())
+	{
+		CallableDeclaration const* callable = queue.back();
+		queue.pop_back();
+		if (callables.count(callable))
+			continue;
+		CallableInfo const& info = callables.emplace(callable, CallableInfo(*callable)).first->second;
+		for (auto const* function: info.calledFunctions)
+			if (!callables.count(function))
+				queue.push_back(function);
+		for (auto const* function: info.referencedFunctions)
+			if (!callables.count(function))
+				queue.push_back(function);
+	}
+
+	// Build the call graph. Calls are resolved by name to take virtual functions
+	// and modifiers into account, calls through function pointers can reach every
+	// function whose address is used.
+	multimap<string, CallableDeclaration const*> callablesByName;
+	set<CallableDeclaration const*> pointerTargets;
+	for (auto const& callable: callables)
+	{
+		callablesByName.emplace(callable.first->name(), callable.first);
+		pointerTargets += callable.second.referencedFunctions;
+	}
+	map<CallableDeclaration const*, set<CallableDeclaration const*>> callGraph;
+	for (auto const& callable: callables)
+	{
+		CallableInfo const& info = callable.second;
+		set<CallableDeclaration const*>& successors = callGraph[callable.first];
+		for (auto const* function: info.calledFunctions)
+		{
+			successors.insert(function);
+			for (auto const& candidate: boost::make_iterator_range(callablesByName.equal_range(function->name())))
+				if (dynamic_cast<FunctionDefinition const*>(candidate.second))
+					successors.insert(candidate.second);
+		}
+		for (auto const& modifier: info.invokedModifiers)
+			for (auto const& candidate: boost::make_iterator_range(callablesByName.equal_range(modifier)))
+				if (dynamic_cast<ModifierDefinition const*>(candidate.second))
+					successors.insert(candidate.second);
+		if (info.callsFunctionPointers)
+			successors += pointerTargets;
+	}
+
+	auto isRecursive = [&](CallableDeclaration const* _callable) -> bool
+	{
+		set<CallableDeclaration const*> visited;
+		vector<CallableDeclaration const*> toVisit(callGraph[_callable].begin(), callGraph[_callable].end());
+		while (!toVisit.empty())
+		{
+			CallableDeclaration const* current = toVisit.back();
+			toVisit.pop_back();
+			if (current == _callable)
+				return true;
+			if (visited.insert(current).second)
+				toVisit += callGraph[current];
+		}
+		return false;
+	};
+
+	for (auto const& callable: callables)
+	{
+		auto function = dynamic_cast<FunctionDefinition const*>(callable.first);
+		if (!function || !function->isImplemented() || isRecursive(function))
+			continue;
+		CallableInfo const& info = callable.second;
+		vector<VariableDeclaration const*> candidates;
+		for (auto const* variable: info.localVariables)
+		{
+			TypePointer type = variable->annotation().type;
+			if (
+				type &&
+				type->isValueType() &&
+				type->sizeOnStack() == 1 &&
+				!info.assemblyReferences.count(variable)
+			)
+				candidates.push_back(variable);
+		}
+		// Among equally used variables, prefer the ones declared first, because they
+		// occupy the deepest stack slots.
+		stable_sort(candidates.begin(), candidates.end(), [&](VariableDeclaration const* _a, VariableDeclaration const* _b) {
+			auto referencesOf = [&](VariableDeclaration const* _variable) -> size_t {
+				auto it = info.references.find(_variable);
+				return it == info.references.end() ? 0 : it->second;
+			};
+			return referencesOf(_a) < referencesOf(_b);
+		});
+		if (!candidates.empty())
+			m_candidates[function] = move(candidates);
+	}
+}
+
+bool StackSpiller::isStackTooDeepError(CompilerError const& _error)
+{
+	string const* comment = _error.comment();
+	return comment && comment->find("Stack too deep") == 0;
+}
+
+bool StackSpiller::spillVariableAt(SourceLocation const& _location)
+{
+	for (auto& functionAndCandidates: m_candidates)
+	{
+		if (!functionAndCandidates.first->location().contains(_location))
+			continue;
+		vector<VariableDeclaration const*>& candidates = functionAndCandidates.second;
+		if (candidates.empty())
+			return false;
+		u256 address = u256(CompilerUtils::generalPurposeMemoryStart) + 32 * m_spilledVariables.size();
+		m_spilledVariables[candidates.front()] = address;
+		candidates.erase(candidates.begin());
+		return true;
+	}
+	return false;
+}
@@ -0,0 +1,72 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Selection of local variables that are kept in memory instead of on the stack.
+ */
+
+#pragma once
+
+#include <libsolidity/ast/ASTForward.h>
+#include <liblangutil/Exceptions.h>
+#include <liblangutil/SourceLocation.h>
+#include <libdevcore/Common.h>
+
+#include <map>
+#include <vector>
+
+namespace dev
+{
+namespace solidity
+{
+
+/**
+ * Selects local variables of a contract that are moved from the stack to a memory area
+ * reserved at compile time directly after CompilerUtils::generalPurposeMemoryStart.
+ *
+ * This is used if the code generator fails with a "Stack too deep" error: The least used
+ * local variable of the function the error occurred in is moved to memory and the contract
+ * is compiled again.
+ *
+ * Only value-type local variables declared in the body of functions that cannot be re-entered
+ * while they are active (i.e. that are not part of a cycle in the call graph) are considered.
+ * Variables accessed from inline assembly always stay on the stack.
+ */
+class StackSpiller
+{
+public:
+	explicit StackSpiller(ContractDefinition const& _contract);
+
+	/// @returns true if @a _error was thrown by the code generator because a stack slot
+	/// could not be reached.
+	static bool isStackTooDeepError(langutil::CompilerError const& _error);
+
+	/// Moves the least used local variable of the function containing @a _location
+	/// to memory that has not been moved yet.
+	/// @returns false if there is no such variable.
+	bool spillVariableAt(langutil::SourceLocation const& _location);
+
+	/// @returns the memory addresses of all local variables that are moved to memory.
+	std::map<Declaration const*, u256> const& spilledVariables() const { return m_spilledVariables; }
+
+private:
+	/// Local variables that can be moved to memory per function, least used first.
+	std::map<FunctionDefinition const*, std::vector<VariableDeclaration const*>> m_candidates;
+	std::map<Declaration const*, u256> m_spilledVariables;
+};
+
+}
+}
@@ -0,0 +1,203 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Class that contains contextual information during IR generation.
+ */
+
+#include <libsolidity/codegen/ir/IRGenerationContext.h>
+
+#include <libsolidity/ast/AST.h>
+
+#include <libdevcore/Whiskers.h>
+
+using namespace std;
+using namespace dev;
+using namespace dev::solidity;
+
+IRGenerationContext::IRGenerationContext(EVMVersion _evmVersion, ContractDefinition const& _mostDerivedContract):
+	m_evmVersion(_evmVersion),
+	m_mostDerivedContract(_mostDerivedContract),
+	m_abiFunctions(_evmVersion)
+{
+	for (auto const& variable: ContractType(_mostDerivedContract).stateVariables())
+		m_stateVariables[get<0>(variable)] = make_pair(get<1>(variable), get<2>(variable));
+}
+
+string IRGenerationContext::localVariableName(VariableDeclaration const& _varDecl) const
+{
+	return "vloc_" + _varDecl.name() + "_" + to_string(_varDecl.id());
+}
+
+string IRGenerationContext::newYulVariable()
+{
+	return "_" + to_string(++m_varCounter);
+}
+
+string IRGenerationContext::functionName(FunctionDefinition const& _function)
+{
+	if (m_requestedFunctions.insert(&_function).second)
+		m_functionQueue.push_back(&_function);
+	return "fun_" + _function.name() + "_" + to_string(_function.id());
+}
+
+FunctionDefinition const& IRGenerationContext::virtualFunction(FunctionDefinition const& _function) const
+{
+	// Library functions cannot be overridden.
+	if (auto scope = dynamic_cast<ContractDefinition const*>(_function.scope()))
+		if (scope->isLibrary())
+			return _function;
+	FunctionType functionType(_function);
+	for (ContractDefinition const* contract: m_mostDerivedContract.annotation().linearizedBaseContracts)
+		for (FunctionDefinition const* function: contract->definedFunctions())
+			if (
+				function->name() == _function.name() &&
+				!function->isConstructor() &&
+				FunctionType(*function).asCallableFunction(false)->hasEqualParameterTypes(functionType)
+			)
+				return *function;
+	solAssert(false, "Function " + _function.name() + " not found.");
+	return _function;
+}
+
+FunctionDefinition const* IRGenerationContext::nextFunctionToGenerate()
+{
+	if (m_functionQueue.empty())
+		return nullptr;
+	FunctionDefinition const* function = m_functionQueue.front();
+	m_functionQueue.erase(m_functionQueue.begin());
+	return function;
+}
+
+pair<u256, unsigned> IRGenerationContext::storageLocationOfVariable(VariableDeclaration const& _varDecl) const
+{
+	auto it = m_stateVariables.find(&_varDecl);
+	solAssert(it != m_stateVariables.end(), "Unknown state variable " + _varDecl.name() + ".");
+	return it->second;
+}
+
+string IRGenerationContext::readFromStorageFunction(Type const& _type, unsigned _offset)
+{
+	solUnimplementedAssert(_type.isValueType(), "Only value types can be read from storage.");
+	string functionName = "read_from_storage_offset_" + to_string(_offset) + "_" + _type.identifier();
+	return createFunction(functionName, [&]() {
+		unsigned storageBytes = _type.storageBytes();
+		solAssert(_offset + storageBytes <= 32, "");
+		string value = shiftRight("sload(slot)", 8 * _offset);
+		if (storageBytes < 32)
+			value = "and(" + value + ", " + toCompactHexWithPrefix((u256(1) << (8 * storageBytes)) - 1) + ")";
+		// Fixed bytes are stored in the lower-order bytes of their part of the slot.
+		if (_type.category() == Type::Category::FixedBytes)
+			value = shiftLeft(value, 256 - 8 * storageBytes);
+		return Whiskers(R"(
+			function <functionName>(slot) -> value {
+				value := <cleanup>(<value>)
+			}
+		)")
+		("functionName", functionName)
+		("cleanup", m_abiFunctions.cleanupFunction(_type))
+		("value", value)
+		.render();
+	});
+}
+
+string IRGenerationContext::updateStorageValueFunction(Type const& _type, unsigned _offset)
+{
+	solUnimplementedAssert(_type.isValueType(), "Only value types can be written to storage.");
+	string functionName = "update_storage_value_offset_" + to_string(_offset) + "_" + _type.identifier();
+	return createFunction(functionName, [&]() {
+		unsigned storageBytes = _type.storageBytes();
+		solAssert(_offset + storageBytes <= 32, "");
+		if (storageBytes == 32)
+			return Whiskers(R"(
+				function <functionName>(slot, value) {
+					sstore(slot, value)
+				}
+			)")
+			("functionName", functionName)
+			.render();
+
+		u256 mask = (u256(1) << (8 * storageBytes)) - 1;
+		string value = "value";
+		if (_type.category() == Type::Category::FixedBytes)
+			value = shiftRight(value, 256 - 8 * storageBytes);
+		value = "and(" + value + ", " + toCompactHexWithPrefix(mask) + ")";
+		return Whiskers(R"(
+			function <functionName>(slot, value) {
+				sstore(slot, or(and(sload(slot), <clearMask>), <value>))
+			}
+		)")
+		("functionName", functionName)
+		("clearMask", toCompactHexWithPrefix(~(mask << (8 * _offset))))
+		("value", shiftLeft(value, 8 * _offset))
+		.render();
+	});
+}
+
+string IRGenerationContext::mappingIndexAccessFunction(MappingType const& _mappingType)
+{
+	solUnimplementedAssert(_mappingType.keyType()->isValueType(), "Only value types are supported as mapping keys.");
+	string functionName = "mapping_index_access_" + _mappingType.identifier();
+	return createFunction(functionName, [&]() {
+		return Whiskers(R"(
+			function <functionName>(slot, key) -> dataSlot {
+				mstore(0, key)
+				mstore(0x20, slot)
+				dataSlot := keccak256(0, 0x40)
+			}
+		)")
+		("functionName", functionName)
+		.render();
+	});
+}
+
+string IRGenerationContext::requestedFunctions()
+{
+	string result;
+	for (auto const& function: m_helperFunctions)
+		result += function.second;
+	m_helperFunctions.clear();
+	return result + m_abiFunctions.requestedFunctions().first;
+}
+
+string IRGenerationContext::createFunction(string const& _name, function<string()> const& _creator)
+{
+	if (!m_helperFunctions.count(_name))
+	{
+		string function = _creator();
+		solAssert(!function.empty(), "");
+		m_helperFunctions[_name] = function;
+	}
+	return _name;
+}
+
+string IRGenerationContext::shiftLeft(string const& _value, unsigned _bits) const
+{
+	if (_bits == 0)
+		return _value;
+	if (m_evmVersion.hasBitwiseShifting())
+		return "shl(" + to_string(_bits) + ", " + _value + ")";
+	return "mul(" + _value + ", " + toCompactHexWithPrefix(u256(1) << _bits) + ")";
+}
+
+string IRGenerationContext::shiftRight(string const& _value, unsigned _bits) const
+{
+	if (_bits == 0)
+		return _value;
+	if (m_evmVersion.hasBitwiseShifting())
+		return "shr(" + to_string(_bits) + ", " + _value + ")";
+	return "div(" + _value + ", " + toCompactHexWithPrefix(u256(1) << _bits) + ")";
+}
@@ -0,0 +1,108 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Class that contains contextual information during IR generation.
+ */
+
+#pragma once
+
+#include <libsolidity/codegen/ABIFunctions.h>
+#include <libsolidity/ast/ASTForward.h>
+
+#include <liblangutil/EVMVersion.h>
+
+#include <libdevcore/Common.h>
+
+#include <functional>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace dev
+{
+namespace solidity
+{
+
+class Type;
+class MappingType;
+
+/**
+ * Class that contains contextual information during the generation of the code of one
+ * Yul object, i.e. of the creation or of the runtime code of a contract.
+ *
+ * Keeps track of the Yul functions generated for Solidity functions and of the helper
+ * functions, which are only generated once per object.
+ */
+class IRGenerationContext
+{
+public:
+	IRGenerationContext(EVMVersion _evmVersion, ContractDefinition const& _mostDerivedContract);
+
+	EVMVersion evmVersion() const { return m_evmVersion; }
+	ABIFunctions& abiFunctions() { return m_abiFunctions; }
+	ContractDefinition const& mostDerivedContract() const { return m_mostDerivedContract; }
+
+	/// @returns the name of the Yul variable holding the local variable or parameter @a _varDecl.
+	std::string localVariableName(VariableDeclaration const& _varDecl) const;
+	/// @returns a new name for a Yul variable that is not used anywhere else.
+	std::string newYulVariable();
+
+	/// @returns the name of the Yul function implementing @a _function and requests its generation.
+	std::string functionName(FunctionDefinition const& _function);
+	/// @returns the function an internal call to @a _function refers to in the most derived contract.
+	FunctionDefinition const& virtualFunction(FunctionDefinition const& _function) const;
+	/// @returns a function whose code was requested but not generated yet or nullptr and
+	/// removes it from the queue.
+	FunctionDefinition const* nextFunctionToGenerate();
+
+	/// @returns the storage slot and the byte offset inside the slot of the state variable @a _varDecl.
+	std::pair<u256, unsigned> storageLocationOfVariable(VariableDeclaration const& _varDecl) const;
+
+	/// @returns the name of a function that reads a value of type @a _type at byte offset
+	/// @a _offset from the storage slot given as its argument.
+	std::string readFromStorageFunction(Type const& _type, unsigned _offset);
+	/// @returns the name of a function that writes a value of type @a _type at byte offset
+	/// @a _offset into a storage slot. Arguments: slot, value.
+	std::string updateStorageValueFunction(Type const& _type, unsigned _offset);
+	/// @returns the name of a function that computes the storage slot of the value stored under
+	/// a key in a mapping of type @a _mappingType. Arguments: slot, key converted to the key type.
+	std::string mappingIndexAccessFunction(MappingType const& _mappingType);
+	/// @returns the concatenation of all helper functions requested so far, including the
+	/// ABI functions, and clears the list.
+	std::string requestedFunctions();
+
+private:
+	/// @returns @a _name after adding the code returned by @a _creator to the helper functions
+	/// unless a function of that name was already requested.
+	std::string createFunction(std::string const& _name, std::function<std::string()> const& _creator);
+	/// @returns a Yul expression that shifts @a _value by @a _bits to the left or right.
+	std::string shiftLeft(std::string const& _value, unsigned _bits) const;
+	std::string shiftRight(std::string const& _value, unsigned _bits) const;
+
+	EVMVersion m_evmVersion;
+	ContractDefinition const& m_mostDerivedContract;
+	ABIFunctions m_abiFunctions;
+	std::map<VariableDeclaration const*, std::pair<u256, unsigned>> m_stateVariables;
+	std::set<FunctionDefinition const*> m_requestedFunctions;
+	std::vector<FunctionDefinition const*> m_functionQueue;
+	std::map<std::string, std::string> m_helperFunctions;
+	size_t m_varCounter = 0;
+};
+
+}
+}
@@ -0,0 +1,289 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Component that translates Solidity code into Yul.
+ */
+
+#include <libsolidity/codegen/ir/IRGenerator.h>
+
+#include <libsolidity/codegen/ir/IRGenerationContext.h>
+#include <libsolidity/codegen/ir/IRGeneratorForStatements.h>
+#include <libsolidity/ast/AST.h>
+
+#include <libdevcore/Whiskers.h>
+
+#include <boost/algorithm/string/join.hpp>
+#include <boost/range/adaptor/reversed.hpp>
+
+using namespace std;
+using namespace dev;
+using namespace dev::solidity;
+
+string IRGenerator::run(ContractDefinition const& _contract)
+{
+	solUnimplementedAssert(
+		!_contract.isLibrary() || _contract.interfaceFunctions().empty(),
+		"Libraries with external functions are not yet implemented in the IR generator."
+	);
+	return Whiskers(R"(
+		object "<objectName>" {
+			code {
+				<creationCode>
+			}
+			object "<objectName>_deployed" {
+				code {
+					<deployedCode>
+				}
+			}
+		}
+	)")
+	("objectName", _contract.name() + "_" + to_string(_contract.id()))
+	("creationCode", creationCode(_contract))
+	("deployedCode", deployedCode(_contract))
+	.render();
+}
+
+string IRGenerator::creationCode(ContractDefinition const& _contract)
+{
+	IRGenerationContext context(m_evmVersion, _contract);
+	string initCode;
+	FunctionDefinition const* mostDerivedConstructor = nullptr;
+	// Initialization of state variables and constructors in base-to-derived order.
+	for (ContractDefinition const* contract: boost::adaptors::reverse(_contract.annotation().linearizedBaseContracts))
+	{
+		for (auto const& base: contract->baseContracts())
+			solUnimplementedAssert(
+				!base->arguments(),
+				"Base constructor arguments are not yet implemented in the IR generator."
+			);
+		for (VariableDeclaration const* variable: contract->stateVariables())
+			if (variable->value() && !variable->isConstant())
+				initCode += IRGeneratorForStatements(context).stateVariableInitialization(*variable);
+		if (FunctionDefinition const* constructor = contract->constructor())
+		{
+			solUnimplementedAssert(
+				constructor->parameters().empty(),
+				"Constructor parameters are not yet implemented in the IR generator."
+			);
+			initCode += context.functionName(*constructor) + "()\n";
+			mostDerivedConstructor = constructor;
+		}
+	}
+
+	string deployedName = _contract.name() + "_" + to_string(_contract.id()) + "_deployed";
+	return Whiskers(R"(
+		mstore(64, 128)
+		<callValueCheck>
+		<initCode>
+		codecopy(0, dataoffset("<deployedName>"), datasize("<deployedName>"))
+		return(0, datasize("<deployedName>"))
+		<functions>
+	)")
+	("callValueCheck",
+		_contract.isLibrary() || (mostDerivedConstructor && mostDerivedConstructor->isPayable()) ?
+		"" :
+		callValueCheck()
+	)
+	("initCode", initCode)
+	("deployedName", deployedName)
+	("functions", generateRequestedFunctions(context))
+	.render();
+}
+
+string IRGenerator::deployedCode(ContractDefinition const& _contract)
+{
+	IRGenerationContext context(m_evmVersion, _contract);
+	string dispatch = dispatchRoutine(_contract, context);
+	return Whiskers(R"(
+		mstore(64, 128)
+		<dispatch>
+		<functions>
+	)")
+	("dispatch", dispatch)
+	("functions", generateRequestedFunctions(context))
+	.render();
+}
+
+string IRGenerator::dispatchRoutine(ContractDefinition const& _contract, IRGenerationContext& _context)
+{
+	string selector = m_evmVersion.hasBitwiseShifting() ?
+		"shr(224, calldataload(0))" :
+		"div(calldataload(0), " + toCompactHexWithPrefix(u256(1) << 224) + ")";
+
+	vector<string> getters;
+	vector<Whiskers::StringMap> cases;
+	for (auto const& function: _contract.interfaceFunctions())
+	{
+		FunctionTypePointer const& type = function.second;
+		solAssert(type->hasDeclaration(), "");
+		for (auto const& parameterType: type->parameterTypes())
+			IRGeneratorForStatements::requireSupportedType(*parameterType);
+		for (auto const& returnType: type->returnParameterTypes())
+			IRGeneratorForStatements::requireSupportedType(*returnType);
+
+		string functionName;
+		if (auto functionDefinition = dynamic_cast<FunctionDefinition const*>(&type->declaration()))
+			functionName = _context.functionName(*functionDefinition);
+		else
+		{
+			auto const& variable = dynamic_cast<VariableDeclaration const&>(type->declaration());
+			getters.push_back(generateGetter(variable, _context));
+			functionName = getterName(variable);
+		}
+
+		vector<string> parameters;
+		for (size_t i = 0; i < type->parameterTypes().size(); ++i)
+			parameters.push_back("param_" + to_string(i));
+		vector<string> returns;
+		for (size_t i = 0; i < type->returnParameterTypes().size(); ++i)
+			returns.push_back("ret_" + to_string(i));
+
+		string call = functionName + "(" + boost::algorithm::join(parameters, ", ") + ")";
+		if (!returns.empty())
+			call = "let " + boost::algorithm::join(returns, ", ") + " := " + call;
+		string decode;
+		if (!parameters.empty())
+			decode =
+				"let " + boost::algorithm::join(parameters, ", ") + " := " +
+				_context.abiFunctions().tupleDecoder(type->parameterTypes()) +
+				"(4, calldatasize())";
+		string encode = "memPos";
+		if (!returns.empty())
+		{
+			vector<string> encoderArguments{"memPos"};
+			for (auto const& value: returns | boost::adaptors::reversed)
+				encoderArguments.push_back(value);
+			encode =
+				_context.abiFunctions().tupleEncoder(type->returnParameterTypes(), type->returnParameterTypes()) +
+				"(" + boost::algorithm::join(encoderArguments, ", ") + ")";
+		}
+
+		cases.push_back({
+			{"selector", toCompactHexWithPrefix(u256(FixedHash<4>::Arith(function.first)))},
+			{"signature", type->externalSignature()},
+			{"callValueCheck", type->isPayable() ? "" : callValueCheck()},
+			{"decode", decode},
+			{"call", call},
+			{"encode", encode}
+		});
+	}
+
+	string fallback = "revert(0, 0)";
+	if (FunctionDefinition const* fallbackFunction = _contract.fallbackFunction())
+		fallback =
+			(fallbackFunction->isPayable() ? "" : callValueCheck() + "\n") +
+			_context.functionName(*fallbackFunction) + "()\nstop()";
+
+	Whiskers dispatch(R"(
+		if iszero(lt(calldatasize(), 4)) {
+			let selector := <shiftedSelector>
+			switch selector
+			<#cases>
+			case <selector> {
+				// <signature>
+				<callValueCheck>
+				<decode>
+				<call>
+				let memPos := mload(64)
+				let memEnd := <encode>
+				return(memPos, sub(memEnd, memPos))
+			}
+			</cases>
+			default {}
+		}
+		<fallback>
+		<getters>
+	)");
+	dispatch("shiftedSelector", selector);
+	dispatch("cases", cases);
+	dispatch("fallback", fallback);
+	dispatch("getters", boost::algorithm::join(getters, ""));
+	return dispatch.render();
+}
+
+string IRGenerator::generateFunction(FunctionDefinition const& _function, IRGenerationContext& _context)
+{
+	solUnimplementedAssert(_function.modifiers().empty(), "Modifiers are not yet implemented in the IR generator.");
+	vector<string> parameters;
+	for (auto const& parameter: _function.parameters())
+	{
+		IRGeneratorForStatements::requireSupportedType(*parameter->annotation().type);
+		parameters.push_back(_context.localVariableName(*parameter));
+	}
+	vector<string> returns;
+	for (auto const& returnParameter: _function.returnParameters())
+	{
+		IRGeneratorForStatements::requireSupportedType(*returnParameter->annotation().type);
+		returns.push_back(_context.localVariableName(*returnParameter));
+	}
+	return Whiskers(R"(
+		function <functionName>(<parameters>) <returns> {
+			<body>
+		}
+	)")
+	("functionName", _context.functionName(_function))
+	("parameters", boost::algorithm::join(parameters, ", "))
+	("returns", returns.empty() ? "" : "-> " + boost::algorithm::join(returns, ", "))
+	("body", IRGeneratorForStatements(_context).functionBody(_function))
+	.render();
+}
+
+string IRGenerator::generateGetter(VariableDeclaration const& _varDecl, IRGenerationContext& _context)
+{
+	pair<u256, unsigned> location = _context.storageLocationOfVariable(_varDecl);
+	TypePointer type = _varDecl.annotation().type;
+	vector<string> keys;
+	string body = "let slot := " + formatNumber(location.first) + "\n";
+	while (auto mappingType = dynamic_cast<MappingType const*>(type.get()))
+	{
+		IRGeneratorForStatements::requireSupportedType(*mappingType->keyType());
+		string key = "key_" + to_string(keys.size());
+		body += "slot := " + _context.mappingIndexAccessFunction(*mappingType) + "(slot, " + key + ")\n";
+		keys.push_back(key);
+		type = mappingType->valueType();
+		location.second = 0;
+	}
+	IRGeneratorForStatements::requireSupportedType(*type);
+	body += "value := " + _context.readFromStorageFunction(*type, location.second) + "(slot)\n";
+	return Whiskers(R"(
+		function <functionName>(<keys>) -> value {
+			<body>
+		}
+	)")
+	("functionName", getterName(_varDecl))
+	("keys", boost::algorithm::join(keys, ", "))
+	("body", body)
+	.render();
+}
+
+string IRGenerator::generateRequestedFunctions(IRGenerationContext& _context)
+{
+	string functions;
+	while (FunctionDefinition const* function = _context.nextFunctionToGenerate())
+		functions += generateFunction(*function, _context);
+	return functions + _context.requestedFunctions();
+}
+
+string IRGenerator::getterName(VariableDeclaration const& _varDecl)
+{
+	return "getter_" + _varDecl.name() + "_" + to_string(_varDecl.id());
+}
+
+string IRGenerator::callValueCheck()
+{
+	return "if callvalue() { revert(0, 0) }";
+}
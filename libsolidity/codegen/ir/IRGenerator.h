@@ -0,0 +1,72 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Component that translates Solidity code into Yul.
+ */
+
+#pragma once
+
+#include <libsolidity/ast/ASTForward.h>
+
+#include <liblangutil/EVMVersion.h>
+
+#include <string>
+
+namespace dev
+{
+namespace solidity
+{
+
+class IRGenerationContext;
+
+/**
+ * Generates a Yul object for a contract, which consists of the creation code and a
+ * sub-object with the runtime code. The result is meant to be run through the Yul
+ * optimiser before it is compiled to EVM bytecode.
+ */
+class IRGenerator
+{
+public:
+	explicit IRGenerator(EVMVersion _evmVersion): m_evmVersion(_evmVersion) {}
+
+	/// @returns the Yul object implementing @a _contract.
+	/// Throws an UnimplementedFeatureError if the contract uses features that are not supported yet.
+	std::string run(ContractDefinition const& _contract);
+
+private:
+	std::string creationCode(ContractDefinition const& _contract);
+	std::string deployedCode(ContractDefinition const& _contract);
+
+	/// @returns the code that calls the interface function given by its selector in calldata
+	/// or the fallback function.
+	std::string dispatchRoutine(ContractDefinition const& _contract, IRGenerationContext& _context);
+	/// @returns the Yul function implementing @a _function.
+	std::string generateFunction(FunctionDefinition const& _function, IRGenerationContext& _context);
+	/// @returns the Yul function implementing the getter of the state variable @a _varDecl.
+	std::string generateGetter(VariableDeclaration const& _varDecl, IRGenerationContext& _context);
+	/// @returns the Yul functions implementing all Solidity functions that were requested
+	/// so far and the helper functions they use.
+	std::string generateRequestedFunctions(IRGenerationContext& _context);
+
+	static std::string getterName(VariableDeclaration const& _varDecl);
+	static std::string callValueCheck();
+
+	EVMVersion const m_evmVersion;
+};
+
+}
+}
@@ -0,0 +1,1166 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Component that translates Solidity statements and expressions into Yul.
+ */
+
+#include <libsolidity/codegen/ir/IRGeneratorForStatements.h>
+
+#include <libsolidity/codegen/ir/IRGenerationContext.h>
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/TypeProvider.h>
+
+#include <libdevcore/Keccak256.h>
+
+#include <boost/algorithm/string/join.hpp>
+#include <boost/range/adaptor/reversed.hpp>
+
+using namespace std;
+using namespace dev;
+using namespace langutil;
+using namespace dev::solidity;
+
+namespace
+{
+
+/// @returns the types of the components of the value of @a _expression.
+TypePointers componentTypes(Expression const& _expression)
+{
+	TypePointer const& type = _expression.annotation().type;
+	if (auto tupleType = dynamic_cast<TupleType const*>(type.get()))
+		return tupleType->components();
+	return {type};
+}
+
+/// Finds assignments, increments, decrements and deletes that are part of a larger
+/// expression, i.e. that can change a local variable after its value was read.
+class NestedAssignmentFinder: private ASTConstVisitor
+{
+public:
+	static bool find(ASTNode const& _node)
+	{
+		NestedAssignmentFinder finder;
+		_node.accept(finder);
+		return finder.m_found;
+	}
+
+private:
+	bool visit(ExpressionStatement const& _statement) override
+	{
+		m_statementExpressions.insert(&_statement.expression());
+		return true;
+	}
+	void endVisit(Assignment const& _assignment) override { check(_assignment); }
+	void endVisit(UnaryOperation const& _operation) override
+	{
+		if (TokenTraits::isCountOp(_operation.getOperator()) || _operation.getOperator() == Token::Delete)
+			check(_operation);
+	}
+	void check(Expression const& _expression)
+	{
+		if (!m_statementExpressions.count(&_expression))
+			m_found = true;
+	}
+
+	set<Expression const*> m_statementExpressions;
+	bool m_found = false;
+};
+
+}
+
+string IRGeneratorForStatements::functionBody(FunctionDefinition const& _function)
+{
+	for (auto const& returnParameter: _function.returnParameters())
+	{
+		m_returnVariables.push_back(m_context.localVariableName(*returnParameter));
+		m_returnTypes.push_back(returnParameter->annotation().type);
+	}
+	m_copyLocalVariables = NestedAssignmentFinder::find(_function.body());
+	_function.body().accept(*this);
+	if (m_returnFlag.empty())
+		return m_code.str();
+	return "let " + m_returnFlag + " := 0\n" + m_code.str();
+}
+
+string IRGeneratorForStatements::stateVariableInitialization(VariableDeclaration const& _varDecl)
+{
+	solAssert(_varDecl.value(), "");
+	TypePointer const& type = _varDecl.annotation().type;
+	requireSupportedType(*type);
+	_varDecl.value()->accept(*this);
+	pair<u256, unsigned> location = m_context.storageLocationOfVariable(_varDecl);
+	writeToLValue(
+		LValue{type, "", formatNumber(location.first), location.second},
+		convertedValue(*_varDecl.value(), *type)
+	);
+	return "{\n" + m_code.str() + "}\n";
+}
+
+bool IRGeneratorForStatements::visit(Block const& _block)
+{
+	bool outerMayInterrupt = m_mayInterrupt;
+	bool blockMayInterrupt = false;
+	m_mayInterrupt = false;
+	size_t guards = 0;
+	m_code << "{\n";
+	for (auto const& statement: _block.statements())
+	{
+		if (m_mayInterrupt)
+		{
+			// The remaining statements are skipped after break, continue or return.
+			string flag = m_loopControlVariables.empty() ? m_returnFlag : m_loopControlVariables.back();
+			solAssert(!flag.empty(), "");
+			m_code << "if iszero(" << flag << ") {\n";
+			++guards;
+			blockMayInterrupt = true;
+			m_mayInterrupt = false;
+		}
+		// Statements are put into their own scope, so that the stack slots of the Yul variables
+		// holding intermediate values are freed at their end. Declared variables have to
+		// stay visible, though.
+		if (dynamic_cast<VariableDeclarationStatement const*>(statement.get()))
+			statement->accept(*this);
+		else
+		{
+			m_code << "{\n";
+			statement->accept(*this);
+			m_code << "}\n";
+		}
+	}
+	for (; guards > 0; --guards)
+		m_code << "}\n";
+	m_code << "}\n";
+	m_mayInterrupt = outerMayInterrupt || blockMayInterrupt || m_mayInterrupt;
+	return false;
+}
+
+bool IRGeneratorForStatements::visit(IfStatement const& _ifStatement)
+{
+	_ifStatement.condition().accept(*this);
+	string condition = valueOf(_ifStatement.condition());
+	if (_ifStatement.falseStatement())
+	{
+		m_code << "switch " << condition << "\ncase 0 {\n";
+		_ifStatement.falseStatement()->accept(*this);
+		m_code << "}\ndefault {\n";
+		_ifStatement.trueStatement().accept(*this);
+		m_code << "}\n";
+	}
+	else
+	{
+		m_code << "if " << condition << " {\n";
+		_ifStatement.trueStatement().accept(*this);
+		m_code << "}\n";
+	}
+	return false;
+}
+
+bool IRGeneratorForStatements::visit(WhileStatement const& _whileStatement)
+{
+	generateLoop(_whileStatement.body(), &_whileStatement.condition(), nullptr, _whileStatement.isDoWhile());
+	return false;
+}
+
+bool IRGeneratorForStatements::visit(ForStatement const& _forStatement)
+{
+	m_code << "{\n";
+	if (_forStatement.initializationExpression())
+		_forStatement.initializationExpression()->accept(*this);
+	generateLoop(_forStatement.body(), _forStatement.condition(), _forStatement.loopExpression(), false);
+	m_code << "}\n";
+	return false;
+}
+
+bool IRGeneratorForStatements::visit(Continue const&)
+{
+	solAssert(!m_loopControlVariables.empty(), "");
+	m_code << m_loopControlVariables.back() << " := 1\n";
+	m_mayInterrupt = true;
+	return false;
+}
+
+bool IRGeneratorForStatements::visit(Break const&)
+{
+	solAssert(!m_loopControlVariables.empty(), "");
+	m_code << m_loopControlVariables.back() << " := 2\n";
+	m_mayInterrupt = true;
+	return false;
+}
+
+bool IRGeneratorForStatements::visit(Return const& _return)
+{
+	if (Expression const* expression = _return.expression())
+	{
+		vector<Expression const*> components{expression};
+		if (auto tuple = dynamic_cast<TupleExpression const*>(expression))
+			if (tuple->components().size() > 1)
+			{
+				components.clear();
+				for (auto const& component: tuple->components())
+					components.push_back(component.get());
+			}
+		solAssert(components.size() == m_returnVariables.size(), "");
+		vector<string> code;
+		vector<string> values;
+		bool readsReturnVariables = false;
+		for (size_t i = 0; i < components.size(); ++i)
+		{
+			code.push_back(generateNested([&]() {
+				components[i]->accept(*this);
+				values.push_back(convertedValue(*components[i], *m_returnTypes[i]));
+			}));
+			for (auto const& variable: m_returnVariables)
+				if (code[i].find(variable) != string::npos || values[i].find(variable) != string::npos)
+					readsReturnVariables = true;
+		}
+		if (readsReturnVariables)
+		{
+			// All values have to be computed before the first return variable is assigned.
+			for (size_t i = 0; i < components.size(); ++i)
+			{
+				m_code << code[i];
+				string value = m_context.newYulVariable();
+				m_code << "let " << value << " := " << values[i] << "\n";
+				values[i] = value;
+			}
+			for (size_t i = 0; i < values.size(); ++i)
+				m_code << m_returnVariables[i] << " := " << values[i] << "\n";
+		}
+		else
+			// Otherwise, the intermediate values of each component are removed from the stack
+			// before the next one is computed.
+			for (size_t i = 0; i < values.size(); ++i)
+				m_code << "{\n" << code[i] << m_returnVariables[i] << " := " << values[i] << "\n}\n";
+	}
+	if (m_returnFlag.empty())
+		m_returnFlag = m_context.newYulVariable();
+	m_code << m_returnFlag << " := 1\n";
+	if (!m_loopControlVariables.empty())
+	{
+		m_code << m_loopControlVariables.back() << " := 2\n";
+		m_loopsContainingReturns.back() = true;
+	}
+	m_mayInterrupt = true;
+	return false;
+}
+
+bool IRGeneratorForStatements::visit(EmitStatement const& _emit)
+{
+	_emit.eventCall().accept(*this);
+	return false;
+}
+
+bool IRGeneratorForStatements::visit(VariableDeclarationStatement const& _variableDeclarationStatement)
+{
+	auto const& declarations = _variableDeclarationStatement.declarations();
+	for (auto const& declaration: declarations)
+		if (declaration)
+			requireSupportedType(*declaration->annotation().type);
+
+	for (auto const& declaration: declarations)
+		if (declaration)
+			m_code << "let " << m_context.localVariableName(*declaration) << " := 0\n";
+
+	if (Expression const* initialValue = _variableDeclarationStatement.initialValue())
+	{
+		// The intermediate values are only visible inside of the nested block.
+		m_code << "{\n";
+		initialValue->accept(*this);
+		vector<string> const& values = valuesOf(*initialValue);
+		TypePointers types = componentTypes(*initialValue);
+		solAssert(values.size() == declarations.size(), "");
+		for (size_t i = 0; i < declarations.size(); ++i)
+			if (declarations[i])
+				m_code <<
+					m_context.localVariableName(*declarations[i]) <<
+					" := " <<
+					convert(values[i], *types[i], *declarations[i]->annotation().type) <<
+					"\n";
+		m_code << "}\n";
+	}
+	return false;
+}
+
+bool IRGeneratorForStatements::visit(ExpressionStatement const& _expressionStatement)
+{
+	_expressionStatement.expression().accept(*this);
+	return false;
+}
+
+bool IRGeneratorForStatements::visit(InlineAssembly const&)
+{
+	solUnimplemented("Inline assembly is not yet implemented in the IR generator.");
+}
+
+bool IRGeneratorForStatements::visit(PlaceholderStatement const&)
+{
+	solUnimplemented("Modifiers are not yet implemented in the IR generator.");
+}
+
+bool IRGeneratorForStatements::visit(Throw const&)
+{
+	solUnimplemented("Throw is not yet implemented in the IR generator.");
+}
+
+bool IRGeneratorForStatements::visit(Conditional const& _conditional)
+{
+	TypePointer const& type = _conditional.annotation().type;
+	requireSupportedType(*type);
+	_conditional.condition().accept(*this);
+	string result = m_context.newYulVariable();
+	m_code << "let " << result << "\n";
+	m_code << "switch " << valueOf(_conditional.condition()) << "\ncase 0 {\n";
+	_conditional.falseExpression().accept(*this);
+	m_code << result << " := " << convertedValue(_conditional.falseExpression(), *type) << "\n";
+	m_code << "}\ndefault {\n";
+	_conditional.trueExpression().accept(*this);
+	m_code << result << " := " << convertedValue(_conditional.trueExpression(), *type) << "\n";
+	m_code << "}\n";
+	define(_conditional, vector<string>{result});
+	return false;
+}
+
+bool IRGeneratorForStatements::visit(Assignment const& _assignment)
+{
+	Expression const& leftHandSide = _assignment.leftHandSide();
+	Expression const& rightHandSide = _assignment.rightHandSide();
+	Token assignmentOperator = _assignment.assignmentOperator();
+
+	rightHandSide.accept(*this);
+	leftHandSide.accept(*this);
+
+	if (assignmentOperator == Token::Assign)
+	{
+		// Collect the targets, components of tuples can be empty.
+		vector<LValue const*> lValues;
+		if (auto tuple = dynamic_cast<TupleExpression const*>(&leftHandSide))
+			for (auto const& component: tuple->components())
+			{
+				solUnimplementedAssert(
+					!component || !dynamic_cast<TupleExpression const*>(component.get()),
+					"Nested tuple assignments are not yet implemented in the IR generator."
+				);
+				lValues.push_back(component ? &m_lValues.at(component.get()) : nullptr);
+			}
+		else
+			lValues.push_back(&m_lValues.at(&leftHandSide));
+
+		vector<string> const& values = valuesOf(rightHandSide);
+		TypePointers types = componentTypes(rightHandSide);
+		solAssert(values.size() == lValues.size(), "");
+		// All values are copied before the first assignment, because they can refer to the
+		// local variables that are assigned to.
+		vector<string> assigned;
+		for (size_t i = 0; i < values.size(); ++i)
+			if (lValues[i])
+			{
+				string value = m_context.newYulVariable();
+				m_code << "let " << value << " := " << convert(values[i], *types[i], *lValues[i]->type) << "\n";
+				assigned.push_back(value);
+			}
+		for (size_t i = 0, j = 0; i < values.size(); ++i)
+			if (lValues[i])
+				writeToLValue(*lValues[i], assigned[j++]);
+		define(_assignment, lValues.size() == 1 ? assigned : vector<string>{});
+	}
+	else
+	{
+		Expression const* target = &leftHandSide;
+		while (auto tuple = dynamic_cast<TupleExpression const*>(target))
+		{
+			solAssert(tuple->components().size() == 1, "");
+			target = tuple->components().front().get();
+		}
+		LValue const& lValue = m_lValues.at(target);
+		Token binaryOperator = TokenTraits::AssignmentToBinaryOp(assignmentOperator);
+		TypePointer rightType = TokenTraits::isShiftOp(binaryOperator) ?
+			rightHandSide.annotation().type->mobileType() :
+			lValue.type;
+		solAssert(rightType, "");
+		string right = convertedVariable(rightHandSide, *rightType);
+		string left = m_context.newYulVariable();
+		m_code << "let " << left << " := " << readFromLValue(lValue) << "\n";
+		string result = m_context.newYulVariable();
+		m_code << "let " << result << " := " << binaryOperation(binaryOperator, *lValue.type, left, right, *rightType) << "\n";
+		writeToLValue(lValue, result);
+		define(_assignment, vector<string>{result});
+	}
+	return false;
+}
+
+bool IRGeneratorForStatements::visit(TupleExpression const& _tuple)
+{
+	solUnimplementedAssert(!_tuple.isInlineArray(), "Inline arrays are not yet implemented in the IR generator.");
+	if (_tuple.annotation().lValueRequested)
+	{
+		for (auto const& component: _tuple.components())
+			if (component)
+				component->accept(*this);
+		// A single component in parentheses is the same location as the component itself.
+		if (_tuple.components().size() == 1)
+			m_lValues[&_tuple] = m_lValues.at(_tuple.components().front().get());
+		return false;
+	}
+
+	vector<string> values;
+	for (auto const& component: _tuple.components())
+	{
+		solAssert(component, "");
+		component->accept(*this);
+		values += valuesOf(*component);
+	}
+	define(_tuple, values);
+	return false;
+}
+
+bool IRGeneratorForStatements::visit(UnaryOperation const& _unaryOperation)
+{
+	TypePointer const& type = _unaryOperation.annotation().type;
+	if (type->category() == Type::Category::RationalNumber)
+	{
+		define(_unaryOperation, vector<string>{formatNumber(type->literalValue(nullptr))});
+		return false;
+	}
+
+	Token op = _unaryOperation.getOperator();
+	Expression const& subExpression = _unaryOperation.subExpression();
+	subExpression.accept(*this);
+	switch (op)
+	{
+	case Token::Delete:
+		writeToLValue(m_lValues.at(&subExpression), "0");
+		define(_unaryOperation, vector<string>{});
+		break;
+	case Token::Inc:
+	case Token::Dec:
+	{
+		LValue const& lValue = m_lValues.at(&subExpression);
+		solUnimplementedAssert(
+			lValue.type->category() == Type::Category::Integer,
+			"Increment and decrement are only implemented for integers in the IR generator."
+		);
+		string oldValue = m_context.newYulVariable();
+		m_code << "let " << oldValue << " := " << readFromLValue(lValue) << "\n";
+		string newValue = m_context.newYulVariable();
+		m_code <<
+			"let " << newValue << " := " <<
+			m_context.abiFunctions().cleanupFunction(*lValue.type) <<
+			"(" << (op == Token::Inc ? "add" : "sub") << "(" << oldValue << ", 1))\n";
+		writeToLValue(lValue, newValue);
+		define(_unaryOperation, vector<string>{_unaryOperation.isPrefixOperation() ? newValue : oldValue});
+		break;
+	}
+	case Token::Not:
+		define(_unaryOperation, "iszero(" + valueOf(subExpression) + ")");
+		break;
+	case Token::BitNot:
+		define(
+			_unaryOperation,
+			m_context.abiFunctions().cleanupFunction(*type) + "(not(" + valueOf(subExpression) + "))"
+		);
+		break;
+	case Token::Sub:
+		solUnimplementedAssert(
+			type->category() == Type::Category::Integer,
+			"Negation is only implemented for integers in the IR generator."
+		);
+		define(
+			_unaryOperation,
+			m_context.abiFunctions().cleanupFunction(*type) + "(sub(0, " + valueOf(subExpression) + "))"
+		);
+		break;
+	default:
+		solUnimplemented("Unary operator " + string(TokenTraits::toString(op)) + " is not yet implemented in the IR generator.");
+	}
+	return false;
+}
+
+bool IRGeneratorForStatements::visit(BinaryOperation const& _binaryOperation)
+{
+	Expression const& leftExpression = _binaryOperation.leftExpression();
+	Expression const& rightExpression = _binaryOperation.rightExpression();
+	TypePointer const& commonType = _binaryOperation.annotation().commonType;
+	solAssert(commonType, "");
+	Token op = _binaryOperation.getOperator();
+
+	if (op == Token::And || op == Token::Or)
+	{
+		// The right operand is only evaluated if it determines the result.
+		leftExpression.accept(*this);
+		string result = m_context.newYulVariable();
+		m_code << "let " << result << " := " << valueOf(leftExpression) << "\n";
+		m_code << (op == Token::And ? "if " + result : "if iszero(" + result + ")") << " {\n";
+		rightExpression.accept(*this);
+		m_code << result << " := " << valueOf(rightExpression) << "\n}\n";
+		define(_binaryOperation, vector<string>{result});
+	}
+	else if (commonType->category() == Type::Category::RationalNumber)
+		define(_binaryOperation, vector<string>{formatNumber(commonType->literalValue(nullptr))});
+	else
+	{
+		TypePointer rightType = TokenTraits::isShiftOp(op) ? rightExpression.annotation().type->mobileType() : commonType;
+		solAssert(rightType, "");
+		// Same evaluation order as in the legacy code generator.
+		rightExpression.accept(*this);
+		string right = convertedVariable(rightExpression, *rightType);
+		leftExpression.accept(*this);
+		string left = convertedVariable(leftExpression, *commonType);
+
+		if (TokenTraits::isCompareOp(op))
+		{
+			solUnimplementedAssert(
+				commonType->isValueType() &&
+				commonType->category() != Type::Category::FixedPoint &&
+				commonType->category() != Type::Category::Function,
+				"Comparison of " + commonType->toString() + " is not yet implemented in the IR generator."
+			);
+			auto integerType = dynamic_cast<IntegerType const*>(commonType.get());
+			bool isSigned = integerType && integerType->isSigned();
+			string lessThan = isSigned ? "slt" : "lt";
+			string greaterThan = isSigned ? "sgt" : "gt";
+			string comparison;
+			switch (op)
+			{
+			case Token::Equal: comparison = "eq(" + left + ", " + right + ")"; break;
+			case Token::NotEqual: comparison = "iszero(eq(" + left + ", " + right + "))"; break;
+			case Token::LessThan: comparison = lessThan + "(" + left + ", " + right + ")"; break;
+			case Token::GreaterThan: comparison = greaterThan + "(" + left + ", " + right + ")"; break;
+			case Token::LessThanOrEqual: comparison = "iszero(" + greaterThan + "(" + left + ", " + right + "))"; break;
+			case Token::GreaterThanOrEqual: comparison = "iszero(" + lessThan + "(" + left + ", " + right + "))"; break;
+			default: solAssert(false, "Unknown comparison operator.");
+			}
+			define(_binaryOperation, comparison);
+		}
+		else
+			define(_binaryOperation, binaryOperation(op, *commonType, left, right, *rightType));
+	}
+	return false;
+}
+
+bool IRGeneratorForStatements::visit(FunctionCall const& _functionCall)
+{
+	auto const& annotation = _functionCall.annotation();
+	if (annotation.kind == FunctionCallKind::TypeConversion)
+	{
+		solAssert(_functionCall.arguments().size() == 1, "");
+		requireSupportedType(*annotation.type);
+		Expression const& argument = *_functionCall.arguments().front();
+		argument.accept(*this);
+		define(_functionCall, convertedValue(argument, *annotation.type));
+		return false;
+	}
+	solUnimplementedAssert(
+		annotation.kind == FunctionCallKind::FunctionCall,
+		"Struct constructors are not yet implemented in the IR generator."
+	);
+
+	FunctionType const& function = dynamic_cast<FunctionType const&>(*_functionCall.expression().annotation().type);
+	solUnimplementedAssert(!function.bound(), "Bound functions are not yet implemented in the IR generator.");
+	TypePointers const& parameterTypes = function.parameterTypes();
+
+	vector<ASTPointer<Expression const>> arguments = _functionCall.arguments();
+	if (!_functionCall.names().empty())
+	{
+		// Sort named arguments into the order of the parameters.
+		vector<ASTPointer<Expression const>> const& callArguments = _functionCall.arguments();
+		auto const& callNames = _functionCall.names();
+		vector<string> const& parameterNames = function.parameterNames();
+		for (size_t i = 0; i < parameterNames.size(); ++i)
+			for (size_t j = 0; j < callNames.size(); ++j)
+				if (parameterNames[i] == *callNames[j])
+					arguments[i] = callArguments[j];
+	}
+
+	switch (function.kind())
+	{
+	case FunctionType::Kind::Internal:
+	{
+		FunctionDefinition const* functionDefinition = nullptr;
+		Expression const& expression = _functionCall.expression();
+		if (auto identifier = dynamic_cast<Identifier const*>(&expression))
+		{
+			if (auto definition = dynamic_cast<FunctionDefinition const*>(identifier->annotation().referencedDeclaration))
+				functionDefinition = &m_context.virtualFunction(*definition);
+		}
+		else if (auto memberAccess = dynamic_cast<MemberAccess const*>(&expression))
+		{
+			// Calls to functions of base contracts or libraries by name are not virtual.
+			auto definition = dynamic_cast<FunctionDefinition const*>(memberAccess->annotation().referencedDeclaration);
+			if (definition && memberAccess->expression().annotation().type->category() == Type::Category::TypeType)
+				functionDefinition = definition;
+		}
+		solUnimplementedAssert(
+			functionDefinition,
+			"Calls through function pointers and to super functions are not yet implemented in the IR generator."
+		);
+
+		vector<string> argumentValues;
+		for (size_t i = 0; i < arguments.size(); ++i)
+		{
+			arguments[i]->accept(*this);
+			argumentValues.push_back(convertedVariable(*arguments[i], *parameterTypes[i]));
+		}
+		vector<string> results;
+		for (auto const& returnType: function.returnParameterTypes())
+		{
+			requireSupportedType(*returnType);
+			results.push_back(m_context.newYulVariable());
+		}
+		if (!results.empty())
+			m_code << "let " << boost::algorithm::join(results, ", ") << " := ";
+		m_code <<
+			m_context.functionName(*functionDefinition) <<
+			"(" << boost::algorithm::join(argumentValues, ", ") << ")\n";
+		define(_functionCall, results);
+		break;
+	}
+	case FunctionType::Kind::Event:
+		appendEvent(_functionCall);
+		break;
+	case FunctionType::Kind::Assert:
+	case FunctionType::Kind::Require:
+	{
+		arguments.front()->accept(*this);
+		m_code << "if iszero(" << valueOf(*arguments.front()) << ") {\n";
+		if (function.kind() == FunctionType::Kind::Assert)
+			m_code << "invalid()\n";
+		else
+			appendRevert(arguments.size() > 1 ? arguments[1].get() : nullptr);
+		m_code << "}\n";
+		define(_functionCall, vector<string>{});
+		break;
+	}
+	case FunctionType::Kind::Revert:
+		appendRevert(arguments.empty() ? nullptr : arguments.front().get());
+		define(_functionCall, vector<string>{});
+		break;
+	case FunctionType::Kind::GasLeft:
+		define(_functionCall, "gas()");
+		break;
+	case FunctionType::Kind::BlockHash:
+		arguments.front()->accept(*this);
+		define(_functionCall, "blockhash(" + convertedValue(*arguments.front(), *parameterTypes.front()) + ")");
+		break;
+	case FunctionType::Kind::AddMod:
+	case FunctionType::Kind::MulMod:
+	{
+		vector<string> values(3);
+		for (size_t i = 3; i-- > 0;)
+		{
+			arguments[i]->accept(*this);
+			values[i] = convertedVariable(*arguments[i], *TypeProvider::uint256());
+		}
+		m_code << "if iszero(" << values[2] << ") { invalid() }\n";
+		define(
+			_functionCall,
+			(function.kind() == FunctionType::Kind::AddMod ? "addmod(" : "mulmod(") +
+			boost::algorithm::join(values, ", ") + ")"
+		);
+		break;
+	}
+	case FunctionType::Kind::Selfdestruct:
+		arguments.front()->accept(*this);
+		m_code << "selfdestruct(" << convertedValue(*arguments.front(), *parameterTypes.front()) << ")\n";
+		define(_functionCall, vector<string>{});
+		break;
+	default:
+		solUnimplemented("Calls to " + function.toString(true) + " are not yet implemented in the IR generator.");
+	}
+	return false;
+}
+
+bool IRGeneratorForStatements::visit(NewExpression const&)
+{
+	solUnimplemented("The new expression is not yet implemented in the IR generator.");
+}
+
+bool IRGeneratorForStatements::visit(MemberAccess const& _memberAccess)
+{
+	string const& member = _memberAccess.memberName();
+	Expression const& expression = _memberAccess.expression();
+	Type const& baseType = *expression.annotation().type;
+	switch (baseType.category())
+	{
+	case Type::Category::Magic:
+	{
+		static map<pair<MagicType::Kind, string>, string> const magicMembers{
+			{{MagicType::Kind::Message, "sender"}, "caller()"},
+			{{MagicType::Kind::Message, "value"}, "callvalue()"},
+			{{MagicType::Kind::Message, "sig"}, "and(calldataload(0), " + formatNumber(u256(0xffffffff) << (256 - 32)) + ")"},
+			{{MagicType::Kind::Transaction, "origin"}, "origin()"},
+			{{MagicType::Kind::Transaction, "gasprice"}, "gasprice()"},
+			{{MagicType::Kind::Block, "coinbase"}, "coinbase()"},
+			{{MagicType::Kind::Block, "timestamp"}, "timestamp()"},
+			{{MagicType::Kind::Block, "difficulty"}, "difficulty()"},
+			{{MagicType::Kind::Block, "number"}, "number()"},
+			{{MagicType::Kind::Block, "gaslimit"}, "gaslimit()"}
+		};
+		auto it = magicMembers.find(make_pair(dynamic_cast<MagicType const&>(baseType).kind(), member));
+		solUnimplementedAssert(it != magicMembers.end(), "Member " + member + " is not yet implemented in the IR generator.");
+		define(_memberAccess, it->second);
+		break;
+	}
+	case Type::Category::Address:
+		solUnimplementedAssert(member == "balance", "Member " + member + " is not yet implemented in the IR generator.");
+		expression.accept(*this);
+		define(_memberAccess, "balance(" + valueOf(expression) + ")");
+		break;
+	case Type::Category::TypeType:
+	{
+		TypePointer actualType = dynamic_cast<TypeType const&>(baseType).actualType();
+		auto enumType = dynamic_cast<EnumType const*>(actualType.get());
+		solUnimplementedAssert(enumType, "Member " + member + " is not yet implemented in the IR generator.");
+		define(_memberAccess, vector<string>{to_string(enumType->memberValue(member))});
+		break;
+	}
+	default:
+		solUnimplemented("Member access to " + baseType.toString() + " is not yet implemented in the IR generator.");
+	}
+	return false;
+}
+
+bool IRGeneratorForStatements::visit(IndexAccess const& _indexAccess)
+{
+	Expression const& baseExpression = _indexAccess.baseExpression();
+	auto mappingType = dynamic_cast<MappingType const*>(baseExpression.annotation().type.get());
+	solUnimplementedAssert(mappingType, "Index access is only implemented for mappings in the IR generator.");
+	solAssert(_indexAccess.indexExpression(), "");
+	requireSupportedType(*mappingType->keyType());
+
+	baseExpression.accept(*this);
+	_indexAccess.indexExpression()->accept(*this);
+	string slot = m_context.newYulVariable();
+	m_code <<
+		"let " << slot << " := " <<
+		m_context.mappingIndexAccessFunction(*mappingType) <<
+		"(" << valueOf(baseExpression) << ", " <<
+		convertedValue(*_indexAccess.indexExpression(), *mappingType->keyType()) << ")\n";
+
+	TypePointer const& valueType = mappingType->valueType();
+	if (valueType->category() == Type::Category::Mapping)
+		m_values[&_indexAccess] = {slot};
+	else
+	{
+		requireSupportedType(*valueType);
+		LValue lValue{valueType, "", slot, 0};
+		if (_indexAccess.annotation().lValueRequested)
+			m_lValues[&_indexAccess] = lValue;
+		else
+			define(_indexAccess, readFromLValue(lValue));
+	}
+	return false;
+}
+
+bool IRGeneratorForStatements::visit(Identifier const& _identifier)
+{
+	Declaration const* declaration = _identifier.annotation().referencedDeclaration;
+	if (auto magicVariable = dynamic_cast<MagicVariableDeclaration const*>(declaration))
+	{
+		if (magicVariable->name() == "this")
+			define(_identifier, "address()");
+		else if (magicVariable->name() == "now")
+			define(_identifier, "timestamp()");
+		else
+			// Members and calls of the other magic variables are handled by the parent expression.
+			solUnimplementedAssert(
+				magicVariable->type()->category() == Type::Category::Magic ||
+				magicVariable->type()->category() == Type::Category::Function,
+				"Magic variable " + magicVariable->name() + " is not yet implemented in the IR generator."
+			);
+	}
+	else if (auto variable = dynamic_cast<VariableDeclaration const*>(declaration))
+	{
+		TypePointer const& type = variable->annotation().type;
+		if (variable->isConstant())
+		{
+			solAssert(variable->value(), "");
+			variable->value()->accept(*this);
+			define(_identifier, convertedValue(*variable->value(), *type));
+		}
+		else if (variable->isStateVariable())
+		{
+			pair<u256, unsigned> location = m_context.storageLocationOfVariable(*variable);
+			if (type->category() == Type::Category::Mapping)
+				m_values[&_identifier] = {formatNumber(location.first)};
+			else
+			{
+				requireSupportedType(*type);
+				LValue lValue{type, "", formatNumber(location.first), location.second};
+				if (_identifier.annotation().lValueRequested)
+					m_lValues[&_identifier] = lValue;
+				else
+					define(_identifier, readFromLValue(lValue));
+			}
+		}
+		else
+		{
+			requireSupportedType(*type);
+			string name = m_context.localVariableName(*variable);
+			if (_identifier.annotation().lValueRequested)
+				m_lValues[&_identifier] = LValue{type, name, "", 0};
+			else if (m_copyLocalVariables)
+				define(_identifier, name);
+			else
+				define(_identifier, vector<string>{name});
+		}
+	}
+	else
+		solUnimplementedAssert(
+			!dynamic_cast<FunctionDefinition const*>(declaration),
+			"Function pointers are not yet implemented in the IR generator."
+		);
+	return false;
+}
+
+bool IRGeneratorForStatements::visit(ElementaryTypeNameExpression const&)
+{
+	return false;
+}
+
+bool IRGeneratorForStatements::visit(Literal const& _literal)
+{
+	TypePointer const& type = _literal.annotation().type;
+	if (type->category() == Type::Category::StringLiteral)
+		// String literals are only converted to their target type.
+		define(_literal, vector<string>{});
+	else
+		define(_literal, vector<string>{formatNumber(type->literalValue(&_literal))});
+	return false;
+}
+
+void IRGeneratorForStatements::generateLoop(
+	Statement const& _body,
+	Expression const* _condition,
+	ExpressionStatement const* _loopExpression,
+	bool _isDoWhileLoop
+)
+{
+	bool outerMayInterrupt = m_mayInterrupt;
+	// Zero while the loop runs normally, one after continue and two once the loop is left.
+	string control = m_context.newYulVariable();
+	m_code << "let " << control << " := 0\n";
+	m_loopControlVariables.push_back(control);
+	m_loopsContainingReturns.push_back(false);
+
+	string condition;
+	if (_condition)
+		condition = generateNested([&]() {
+			_condition->accept(*this);
+			m_code << "if iszero(" << valueOf(*_condition) << ") { " << control << " := 2 }\n";
+		});
+
+	m_code << "for {} lt(" << control << ", 2) {\n";
+	if (_loopExpression)
+		m_code << "if lt(" << control << ", 2) {\n" << generateNested([&]() {
+			_loopExpression->accept(*this);
+		}) << "}\n";
+	m_code << "}\n{\n" << control << " := 0\n";
+	if (_isDoWhileLoop)
+	{
+		_body.accept(*this);
+		if (_condition)
+			m_code << "if lt(" << control << ", 2) {\n" << condition << "}\n";
+	}
+	else if (_condition)
+	{
+		m_code << condition << "if iszero(" << control << ") {\n";
+		_body.accept(*this);
+		m_code << "}\n";
+	}
+	else
+		_body.accept(*this);
+	m_code << "}\n";
+
+	bool containsReturn = m_loopsContainingReturns.back();
+	m_loopControlVariables.pop_back();
+	m_loopsContainingReturns.pop_back();
+	if (containsReturn && !m_loopControlVariables.empty())
+	{
+		m_code << "if " << m_returnFlag << " { " << m_loopControlVariables.back() << " := 2 }\n";
+		m_loopsContainingReturns.back() = true;
+	}
+	// Break and continue only affect this loop.
+	m_mayInterrupt = outerMayInterrupt || containsReturn;
+}
+
+void IRGeneratorForStatements::appendEvent(FunctionCall const& _functionCall)
+{
+	FunctionType const& function = dynamic_cast<FunctionType const&>(*_functionCall.expression().annotation().type);
+	auto const& event = dynamic_cast<EventDefinition const&>(function.declaration());
+	TypePointers const& parameterTypes = function.parameterTypes();
+	auto const& arguments = _functionCall.arguments();
+	solUnimplementedAssert(_functionCall.names().empty(), "Named event arguments are not yet implemented in the IR generator.");
+
+	vector<string> topics;
+	if (!event.isAnonymous())
+		topics.push_back(formatNumber(u256(h256::Arith(dev::keccak256(function.externalSignature())))));
+	vector<string> dataValues;
+	TypePointers dataTypes;
+	for (size_t i = 0; i < arguments.size(); ++i)
+	{
+		requireSupportedType(*parameterTypes[i]);
+		arguments[i]->accept(*this);
+		string value = convertedVariable(*arguments[i], *parameterTypes[i]);
+		if (event.parameters()[i]->isIndexed())
+			topics.push_back(value);
+		else
+		{
+			dataValues.push_back(value);
+			dataTypes.push_back(parameterTypes[i]);
+		}
+	}
+	solAssert(topics.size() <= 4, "");
+	pair<string, string> data = appendABIEncoding(dataValues, dataTypes);
+	m_code << "log" << topics.size() << "(" << data.first << ", sub(" << data.second << ", " << data.first << ")";
+	for (auto const& topic: topics)
+		m_code << ", " << topic;
+	m_code << ")\n";
+	define(_functionCall, vector<string>{});
+}
+
+void IRGeneratorForStatements::appendRevert(Expression const* _message)
+{
+	if (!_message)
+	{
+		m_code << "revert(0, 0)\n";
+		return;
+	}
+	TypePointer const& messageType = _message->annotation().type;
+	solUnimplementedAssert(
+		messageType->category() == Type::Category::StringLiteral,
+		"Only string literals are implemented as error messages in the IR generator."
+	);
+	string position = m_context.newYulVariable();
+	m_code << "let " << position << " := mload(64)\n";
+	m_code <<
+		"mstore(" << position << ", " <<
+		formatNumber(u256(FixedHash<4>::Arith(FixedHash<4>(dev::keccak256("Error(string)")))) << (256 - 32)) <<
+		")\n";
+	string end = m_context.newYulVariable();
+	m_code <<
+		"let " << end << " := " <<
+		m_context.abiFunctions().tupleEncoder({messageType}, {TypeProvider::byteArray(DataLocation::Memory, true)}) <<
+		"(add(" << position << ", 4))\n";
+	m_code << "revert(" << position << ", sub(" << end << ", " << position << "))\n";
+}
+
+pair<string, string> IRGeneratorForStatements::appendABIEncoding(
+	vector<string> const& _values,
+	TypePointers const& _types
+)
+{
+	string start = m_context.newYulVariable();
+	string end = m_context.newYulVariable();
+	m_code << "let " << start << " := mload(64)\n";
+	if (_values.empty())
+		m_code << "let " << end << " := " << start << "\n";
+	else
+	{
+		vector<string> arguments{start};
+		for (auto const& value: _values | boost::adaptors::reversed)
+			arguments.push_back(value);
+		m_code <<
+			"let " << end << " := " <<
+			m_context.abiFunctions().tupleEncoder(_types, _types) <<
+			"(" << boost::algorithm::join(arguments, ", ") << ")\n";
+	}
+	return make_pair(start, end);
+}
+
+string IRGeneratorForStatements::generateNested(function<void()> const& _generator)
+{
+	ostringstream code;
+	swap(code, m_code);
+	_generator();
+	swap(code, m_code);
+	return code.str();
+}
+
+void IRGeneratorForStatements::define(Expression const& _node, string const& _expression)
+{
+	string variable = m_context.newYulVariable();
+	m_code << "let " << variable << " := " << _expression << "\n";
+	m_values[&_node] = {variable};
+}
+
+void IRGeneratorForStatements::define(Expression const& _node, vector<string> const& _variables)
+{
+	m_values[&_node] = _variables;
+}
+
+string IRGeneratorForStatements::valueOf(Expression const& _expression) const
+{
+	vector<string> const& values = valuesOf(_expression);
+	solAssert(values.size() == 1, "");
+	return values.front();
+}
+
+vector<string> const& IRGeneratorForStatements::valuesOf(Expression const& _expression) const
+{
+	auto it = m_values.find(&_expression);
+	solAssert(it != m_values.end(), "No value generated for expression.");
+	return it->second;
+}
+
+string IRGeneratorForStatements::convertedValue(Expression const& _expression, Type const& _to)
+{
+	Type const& from = *_expression.annotation().type;
+	if (auto stringLiteral = dynamic_cast<StringLiteralType const*>(&from))
+	{
+		solUnimplementedAssert(
+			_to.category() == Type::Category::FixedBytes,
+			"String literals are only implemented for fixed bytes types in the IR generator."
+		);
+		return formatNumber(u256(h256(stringLiteral->value(), h256::FromBinary, h256::AlignLeft)));
+	}
+	if (auto rational = dynamic_cast<RationalNumberType const*>(&from))
+		if (!rational->isFractional() && from.isImplicitlyConvertibleTo(_to))
+		{
+			if (_to.category() == Type::Category::Integer)
+				return formatNumber(rational->literalValue(nullptr));
+			if (auto fixedBytesType = dynamic_cast<FixedBytesType const*>(&_to))
+				return formatNumber(rational->literalValue(nullptr) << (256 - 8 * fixedBytesType->numBytes()));
+		}
+	return convert(valueOf(_expression), from, _to);
+}
+
+string IRGeneratorForStatements::convertedVariable(Expression const& _expression, Type const& _to)
+{
+	string value = convertedValue(_expression, _to);
+	// Literals are converted at compile time and values that do not need a conversion
+	// are already held by variables.
+	if (value.find('(') == string::npos)
+		return value;
+	string variable = m_context.newYulVariable();
+	m_code << "let " << variable << " := " << value << "\n";
+	return variable;
+}
+
+string IRGeneratorForStatements::convert(string const& _value, Type const& _from, Type const& _to)
+{
+	if (_from == _to)
+		return _value;
+	return m_context.abiFunctions().conversionFunction(_from, _to) + "(" + _value + ")";
+}
+
+string IRGeneratorForStatements::binaryOperation(
+	Token _operator,
+	Type const& _type,
+	string const& _left,
+	string const& _right,
+	Type const& _rightType
+)
+{
+	string cleanup = m_context.abiFunctions().cleanupFunction(_type);
+	if (TokenTraits::isShiftOp(_operator))
+	{
+		auto amountType = dynamic_cast<IntegerType const*>(&_rightType);
+		solAssert(amountType, "Invalid shift amount type.");
+		if (amountType->isSigned())
+			m_code << "if slt(" << _right << ", 0) { invalid() }\n";
+		bool hasShifts = m_context.evmVersion().hasBitwiseShifting();
+		auto integerType = dynamic_cast<IntegerType const*>(&_type);
+		bool isSigned = integerType && integerType->isSigned();
+		string factor = "exp(2, " + _right + ")";
+		string shifted;
+		if (_operator == Token::SHL)
+			shifted = hasShifts ? "shl(" + _right + ", " + _left + ")" : "mul(" + _left + ", " + factor + ")";
+		else if (hasShifts)
+			shifted = string(isSigned ? "sar(" : "shr(") + _right + ", " + _left + ")";
+		else if (isSigned)
+		{
+			// Flip all bits of negative values before and after the division to round towards
+			// negative infinity.
+			string mask = "sub(0, slt(" + _left + ", 0))";
+			shifted = "xor(div(xor(" + _left + ", " + mask + "), " + factor + "), " + mask + ")";
+		}
+		else
+			shifted = "div(" + _left + ", " + factor + ")";
+		return cleanup + "(" + shifted + ")";
+	}
+
+	switch (_operator)
+	{
+	case Token::BitOr:
+		return "or(" + _left + ", " + _right + ")";
+	case Token::BitXor:
+		return "xor(" + _left + ", " + _right + ")";
+	case Token::BitAnd:
+		return "and(" + _left + ", " + _right + ")";
+	default:
+		break;
+	}
+
+	auto integerType = dynamic_cast<IntegerType const*>(&_type);
+	solUnimplementedAssert(integerType, "Arithmetic on " + _type.toString() + " is not yet implemented in the IR generator.");
+	bool isSigned = integerType->isSigned();
+	string operation;
+	switch (_operator)
+	{
+	case Token::Add:
+		operation = "add";
+		break;
+	case Token::Sub:
+		operation = "sub";
+		break;
+	case Token::Mul:
+		operation = "mul";
+		break;
+	case Token::Div:
+	case Token::Mod:
+		m_code << "if iszero(" << _right << ") { invalid() }\n";
+		if (_operator == Token::Div)
+			operation = isSigned ? "sdiv" : "div";
+		else
+			operation = isSigned ? "smod" : "mod";
+		break;
+	case Token::Exp:
+		operation = "exp";
+		break;
+	default:
+		solAssert(false, "Unknown binary operator.");
+	}
+	return cleanup + "(" + operation + "(" + _left + ", " + _right + "))";
+}
+
+string IRGeneratorForStatements::readFromLValue(LValue const& _lValue)
+{
+	if (!_lValue.variable.empty())
+		return _lValue.variable;
+	return m_context.readFromStorageFunction(*_lValue.type, _lValue.offset) + "(" + _lValue.slot + ")";
+}
+
+void IRGeneratorForStatements::writeToLValue(LValue const& _lValue, string const& _value)
+{
+	if (!_lValue.variable.empty())
+		m_code << _lValue.variable << " := " << _value << "\n";
+	else
+		m_code <<
+			m_context.updateStorageValueFunction(*_lValue.type, _lValue.offset) <<
+			"(" << _lValue.slot << ", " << _value << ")\n";
+}
+
+void IRGeneratorForStatements::requireSupportedType(Type const& _type)
+{
+	solUnimplementedAssert(
+		_type.isValueType() &&
+		_type.sizeOnStack() == 1 &&
+		_type.category() != Type::Category::Function &&
+		_type.category() != Type::Category::FixedPoint,
+		"Type " + _type.toString() + " is not yet implemented in the IR generator."
+	);
+}
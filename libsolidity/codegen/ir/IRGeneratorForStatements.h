@@ -0,0 +1,172 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Component that translates Solidity statements and expressions into Yul.
+ */
+
+#pragma once
+
+#include <libsolidity/ast/ASTVisitor.h>
+#include <libsolidity/ast/Types.h>
+
+#include <functional>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace dev
+{
+namespace solidity
+{
+
+class IRGenerationContext;
+
+/**
+ * Component that translates the body of a function, or the initial value of a state
+ * variable, into Yul statements.
+ *
+ * The value of every expression is assigned to new Yul variables, one per component of the
+ * expression's type, which are removed again by the Yul optimiser.
+ * Yul has no statements that leave a loop or a function early, so break, continue and return
+ * set control variables and the statements following them are only run if these are zero.
+ * Only value types are supported; everything else throws an UnimplementedFeatureError.
+ */
+class IRGeneratorForStatements: private ASTConstVisitor
+{
+public:
+	explicit IRGeneratorForStatements(IRGenerationContext& _context): m_context(_context) {}
+
+	/// @returns the body of the Yul function implementing @a _function.
+	std::string functionBody(FunctionDefinition const& _function);
+	/// @returns the code that stores the initial value of the state variable @a _varDecl.
+	std::string stateVariableInitialization(VariableDeclaration const& _varDecl);
+
+	/// Throws an UnimplementedFeatureError if values of @a _type cannot be handled.
+	static void requireSupportedType(Type const& _type);
+
+private:
+	/// Location of a value that can be assigned to: A Yul variable holding a local variable,
+	/// or a byte offset inside a storage slot, whose number is held by a Yul variable or literal.
+	struct LValue
+	{
+		TypePointer type;
+		std::string variable;
+		std::string slot;
+		unsigned offset = 0;
+	};
+
+	bool visit(Block const& _block) override;
+	bool visit(IfStatement const& _ifStatement) override;
+	bool visit(WhileStatement const& _whileStatement) override;
+	bool visit(ForStatement const& _forStatement) override;
+	bool visit(Continue const& _continue) override;
+	bool visit(Break const& _break) override;
+	bool visit(Return const& _return) override;
+	bool visit(EmitStatement const& _emit) override;
+	bool visit(VariableDeclarationStatement const& _variableDeclarationStatement) override;
+	bool visit(ExpressionStatement const& _expressionStatement) override;
+	bool visit(InlineAssembly const& _inlineAssembly) override;
+	bool visit(PlaceholderStatement const& _placeholder) override;
+	bool visit(Throw const& _throw) override;
+
+	bool visit(Conditional const& _conditional) override;
+	bool visit(Assignment const& _assignment) override;
+	bool visit(TupleExpression const& _tuple) override;
+	bool visit(UnaryOperation const& _unaryOperation) override;
+	bool visit(BinaryOperation const& _binaryOperation) override;
+	bool visit(FunctionCall const& _functionCall) override;
+	bool visit(NewExpression const& _newExpression) override;
+	bool visit(MemberAccess const& _memberAccess) override;
+	bool visit(IndexAccess const& _indexAccess) override;
+	bool visit(Identifier const& _identifier) override;
+	bool visit(ElementaryTypeNameExpression const& _typeName) override;
+	bool visit(Literal const& _literal) override;
+
+	/// Generates the code of a loop. @a _condition and @a _loopExpression may be null.
+	void generateLoop(
+		Statement const& _body,
+		Expression const* _condition,
+		ExpressionStatement const* _loopExpression,
+		bool _isDoWhileLoop
+	);
+	/// Generates the code of an external event.
+	void appendEvent(FunctionCall const& _functionCall);
+	/// Generates code that reverts, with the error message @a _message if it is not null.
+	void appendRevert(Expression const* _message);
+	/// Generates code that stores @a _values (converted from @a _types) at the free memory
+	/// pointer and @returns the Yul variables holding the start and the end of the encoded data.
+	std::pair<std::string, std::string> appendABIEncoding(
+		std::vector<std::string> const& _values,
+		TypePointers const& _types
+	);
+
+	/// @returns the code generated by @a _generator as a separate string.
+	std::string generateNested(std::function<void()> const& _generator);
+	/// Assigns the result of @a _expression to a new Yul variable and records it as the value of @a _node.
+	void define(Expression const& _node, std::string const& _expression);
+	/// Records @a _variables, which can also be literals, as the values of the components of @a _node.
+	void define(Expression const& _node, std::vector<std::string> const& _variables);
+	/// @returns the Yul variable or literal holding the value of @a _expression, which has to be a single value.
+	std::string valueOf(Expression const& _expression) const;
+	/// @returns the Yul variables holding the components of the value of @a _expression.
+	std::vector<std::string> const& valuesOf(Expression const& _expression) const;
+	/// @returns a Yul expression converting the value of @a _expression to @a _to.
+	std::string convertedValue(Expression const& _expression, Type const& _to);
+	/// @returns a Yul variable or literal holding the value of @a _expression converted to @a _to.
+	std::string convertedVariable(Expression const& _expression, Type const& _to);
+	/// @returns a Yul expression converting the Yul value @a _value of type @a _from to @a _to.
+	std::string convert(std::string const& _value, Type const& _from, Type const& _to);
+
+	/// @returns a Yul expression for the binary operation @a _operator on the values @a _left and
+	/// @a _right of type @a _type, where @a _rightType is the type of @a _right for shifts.
+	std::string binaryOperation(
+		Token _operator,
+		Type const& _type,
+		std::string const& _left,
+		std::string const& _right,
+		Type const& _rightType
+	);
+	/// @returns a Yul expression reading @a _lValue.
+	std::string readFromLValue(LValue const& _lValue);
+	/// Generates code that assigns the Yul expression @a _value to @a _lValue.
+	void writeToLValue(LValue const& _lValue, std::string const& _value);
+
+	IRGenerationContext& m_context;
+	std::ostringstream m_code;
+	std::map<Expression const*, std::vector<std::string>> m_values;
+	std::map<Expression const*, LValue> m_lValues;
+
+	/// Yul variables holding the return parameters of the current function.
+	std::vector<std::string> m_returnVariables;
+	TypePointers m_returnTypes;
+	/// Name of the Yul variable that is set to one by return statements, empty if unused.
+	std::string m_returnFlag;
+	/// For each loop around the current statement, the Yul variable that is set to one by
+	/// continue and to two by break and return statements.
+	std::vector<std::string> m_loopControlVariables;
+	/// For each loop around the current statement, whether it contains a return statement.
+	std::vector<bool> m_loopsContainingReturns;
+	/// True if the statements generated last can skip the rest of the current block.
+	bool m_mayInterrupt = false;
+	/// True if local variables have to be copied when they are read, because the current
+	/// function changes local variables inside of expressions.
+	bool m_copyLocalVariables = true;
+};
+
+}
+}
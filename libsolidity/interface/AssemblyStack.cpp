@@ -178,3 +178,10 @@ string AssemblyStack::print() const
 	solAssert(m_parserResult->code, "");
 	return m_parserResult->toString(m_language == Language::Yul) + "\n";
 }
+
+yul::Object const& AssemblyStack::parserResult() const
+{
+	solAssert(m_parserResult, "");
+	solAssert(m_parserResult->code, "");
+	return *m_parserResult;
+}
@@ -86,6 +86,9 @@ public:
 	/// Pretty-print the input after having parsed it.
 	std::string print() const;
 
+	/// @returns the parsed (and possibly optimized) object. Only valid after parseAndAnalyze.
+	yul::Object const& parserResult() const;
+
 private:
 	bool analyzeParsed();
 	bool analyzeParsed(yul::Object& _object);
@@ -38,22 +38,33 @@
 #include <libsolidity/analysis/ViewPureChecker.h>
 
 #include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTVisitor.h>
+#include <libsolidity/ast/TypeProvider.h>
+#include <libsolidity/codegen/AsmCodeGen.h>
 #include <libsolidity/codegen/Compiler.h>
+#include <libsolidity/codegen/StackSpiller.h>
+#include <libsolidity/codegen/ir/IRGenerator.h>
 #include <libsolidity/formal/SMTChecker.h>
 #include <libsolidity/interface/ABI.h>
+#include <libsolidity/interface/AssemblyStack.h>
 #include <libsolidity/interface/Natspec.h>
 #include <libsolidity/interface/GasEstimator.h>
 #include <libsolidity/interface/Version.h>
 #include <libsolidity/parsing/Parser.h>
 
+#include <libyul/Object.h>
 #include <libyul/YulString.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/evm/EVMObjectCompiler.h>
 
 #include <liblangutil/Scanner.h>
+#include <liblangutil/SourceReferenceFormatter.h>
 
 #include <libevmasm/Exceptions.h>
 
 #include <libdevcore/SwarmHash.h>
 #include <libdevcore/JSON.h>
+#include <libdevcore/ThreadPool.h>
 
 #include <json/json.h>
 
@@ -116,18 +127,22 @@ void CompilerStack::reset(bool _keepSources)
 	m_evmVersion = EVMVersion();
 	m_optimize = false;
 	m_optimizeRuns = 200;
+	m_viaIR = false;
+	m_analysisThreads = 1;
+	m_fileReadingThreads = 1;
 	m_globalContext.reset();
+	m_typeProvider.reset();
 	m_scopes.clear();
 	m_sourceOrder.clear();
 	m_contracts.clear();
 	m_errorReporter.clear();
 }
 
-bool CompilerStack::addSource(string const& _name, string const& _content, bool _isLibrary)
+bool CompilerStack::addSource(string const& _name, string _content, bool _isLibrary)
 {
 	bool existed = m_sources.count(_name) != 0;
 	reset(true);
-	m_sources[_name].scanner = make_shared<Scanner>(CharStream(_content, _name));
+	m_sources[_name].scanner = make_shared<Scanner>(CharStream(std::move(_content), _name));
 	m_sources[_name].isLibrary = _isLibrary;
 	m_stackState = SourcesSet;
 	return existed;
@@ -147,22 +162,26 @@ bool CompilerStack::parse()
 	vector<string> sourcesToParse;
 	for (auto const& s: m_sources)
 		sourcesToParse.push_back(s.first);
+	// A single parser is used for all sources, so that they share the interned identifiers.
+	Parser parser(m_errorReporter);
+	unique_ptr<ThreadPool> fileReadingPool;
+	if (m_readFile && m_fileReadingThreads != 1)
+		fileReadingPool = make_unique<ThreadPool>(m_fileReadingThreads);
 	for (size_t i = 0; i < sourcesToParse.size(); ++i)
 	{
 		string const& path = sourcesToParse[i];
 		Source& source = m_sources[path];
 		source.scanner->reset();
-		source.ast = Parser(m_errorReporter).parse(source.scanner);
+		source.ast = parser.parse(source.scanner);
 		if (!source.ast)
 			solAssert(!Error::containsOnlyWarnings(m_errorReporter.errors()), "Parser returned null but did not report error.");
 		else
 		{
 			source.ast->annotation().path = path;
-			for (auto const& newSource: loadMissingSources(*source.ast, path))
+			for (auto& newSource: loadMissingSources(*source.ast, path, fileReadingPool.get()))
 			{
 				string const& newPath = newSource.first;
-				string const& newContents = newSource.second;
-				m_sources[newPath].scanner = make_shared<Scanner>(CharStream(newContents, newPath));
+				m_sources[newPath].scanner = make_shared<Scanner>(CharStream(std::move(newSource.second), newPath));
 				sourcesToParse.push_back(newPath);
 			}
 		}
@@ -182,6 +201,9 @@ bool CompilerStack::analyze()
 		return false;
 	resolveImports();
 
+	m_typeProvider = make_shared<TypeProvider>();
+	TypeProvider::Scope typeProviderScope(*m_typeProvider);
+
 	bool noErrors = true;
 
 	try {
@@ -245,12 +267,27 @@ bool CompilerStack::analyze()
 		//
 		// Note: this does not resolve overloaded functions. In order to do that, types of arguments are needed,
 		// which is only done one step later.
-		TypeChecker typeChecker(m_evmVersion, m_errorReporter);
-		for (Source const* source: m_sourceOrder)
-			for (ASTPointer<ASTNode> const& node: source->ast->nodes())
-				if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
-					if (!typeChecker.checkTypeRequirements(*contract))
-						noErrors = false;
+		//
+		// Some checks of the type checker depend on whether errors were reported before, so
+		// contracts are only checked in parallel if there are none.
+		if (m_analysisThreads != 1 && Error::containsOnlyWarnings(m_errorReporter.errors()))
+		{
+			vector<ContractDefinition const*> contracts;
+			for (Source const* source: m_sourceOrder)
+				for (ContractDefinition const* contract: ASTNode::filteredNodes<ContractDefinition>(source->ast->nodes()))
+					contracts.push_back(contract);
+			if (!checkTypeRequirementsInParallel(contracts))
+				noErrors = false;
+		}
+		else
+		{
+			TypeChecker typeChecker(m_evmVersion, m_errorReporter);
+			for (Source const* source: m_sourceOrder)
+				for (ASTPointer<ASTNode> const& node: source->ast->nodes())
+					if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
+						if (!typeChecker.checkTypeRequirements(*contract))
+							noErrors = false;
+		}
 
 		if (noErrors)
 		{
@@ -342,13 +379,18 @@ bool CompilerStack::compile()
 		if (!parseAndAnalyze())
 			return false;
 
+	solAssert(m_typeProvider, "");
+	TypeProvider::Scope typeProviderScope(*m_typeProvider);
+
 	// Only compile contracts individually which have been requested.
 	map<ContractDefinition const*, eth::Assembly const*> compiledContracts;
+	// Inline assembly snippets of the code generator are only parsed once for all contracts.
+	auto inlineAssemblyCache = make_shared<InlineAssemblyCache>();
 	for (Source const* source: m_sourceOrder)
 		for (ASTPointer<ASTNode> const& node: source->ast->nodes())
 			if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
 				if (isRequestedContract(*contract))
-					compileContract(*contract, compiledContracts);
+					compileContract(*contract, compiledContracts, inlineAssemblyCache);
 	m_stackState = CompilationSuccessful;
 	this->link();
 	return true;
@@ -457,6 +499,34 @@ std::string const CompilerStack::filesystemFriendlyName(string const& _contractN
 	return matchContract.contract->name();
 }
 
+string const& CompilerStack::yulIR(string const& _contractName) const
+{
+	if (m_stackState < AnalysisSuccessful)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Analysis was not successful."));
+
+	return yulIR(contract(_contractName));
+}
+
+string const& CompilerStack::yulIR(Contract const& _contract) const
+{
+	if (m_stackState < AnalysisSuccessful)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Analysis was not successful."));
+
+	solAssert(_contract.contract, "");
+
+	// caches the result
+	if (!_contract.yulIR)
+	{
+		ContractDefinition const& contract = *_contract.contract;
+		if (contract.annotation().unimplementedFunctions.empty() && contract.constructorIsPublic())
+			_contract.yulIR.reset(new string(IRGenerator(m_evmVersion).run(contract)));
+		else
+			_contract.yulIR.reset(new string());
+	}
+
+	return *_contract.yulIR;
+}
+
 eth::LinkerObject const& CompilerStack::object(string const& _contractName) const
 {
 	if (m_stackState != CompilationSuccessful)
@@ -474,7 +544,7 @@ eth::LinkerObject const& CompilerStack::runtimeObject(string const& _contractNam
 }
 
 /// FIXME: cache this string
-string CompilerStack::assemblyString(string const& _contractName, StringMap _sourceCodes) const
+string CompilerStack::assemblyString(string const& _contractName, StringMap const& _sourceCodes) const
 {
 	if (m_stackState != CompilationSuccessful)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Compilation was not successful."));
@@ -487,7 +557,7 @@ string CompilerStack::assemblyString(string const& _contractName, StringMap _sou
 }
 
 /// FIXME: cache the JSON
-Json::Value CompilerStack::assemblyJSON(string const& _contractName, StringMap _sourceCodes) const
+Json::Value CompilerStack::assemblyJSON(string const& _contractName, StringMap const& _sourceCodes) const
 {
 	if (m_stackState != CompilationSuccessful)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Compilation was not successful."));
@@ -499,6 +569,18 @@ Json::Value CompilerStack::assemblyJSON(string const& _contractName, StringMap _
 		return Json::Value();
 }
 
+void CompilerStack::assemblyJSON(JsonStreamWriter& _writer, string const& _contractName, StringMap const& _sourceCodes) const
+{
+	if (m_stackState != CompilationSuccessful)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Compilation was not successful."));
+
+	Contract const& currentContract = contract(_contractName);
+	if (currentContract.compiler)
+		currentContract.compiler->assemblyJSON(_writer, _sourceCodes);
+	else
+		_writer.value(Json::Value());
+}
+
 vector<string> CompilerStack::sourceNames() const
 {
 	vector<string> names;
@@ -674,10 +756,13 @@ h256 const& CompilerStack::Source::swarmHash() const
 }
 
 
-StringMap CompilerStack::loadMissingSources(SourceUnit const& _ast, std::string const& _sourcePath)
+StringMap CompilerStack::loadMissingSources(SourceUnit const& _ast, std::string const& _sourcePath, ThreadPool* _pool)
 {
 	solAssert(m_stackState < ParsingSuccessful, "");
-	StringMap newSources;
+	// Imports of sources that are not present yet, together with the index of their path in @a paths.
+	vector<pair<ImportDirective const*, size_t>> imports;
+	vector<string> paths;
+	map<string, size_t> pathIndices;
 	for (auto const& node: _ast.nodes())
 		if (ImportDirective const* import = dynamic_cast<ImportDirective*>(node.get()))
 		{
@@ -687,24 +772,55 @@ StringMap CompilerStack::loadMissingSources(SourceUnit const& _ast, std::string
 			// as seen globally.
 			importPath = applyRemapping(importPath, _sourcePath);
 			import->annotation().absolutePath = importPath;
-			if (m_sources.count(importPath) || newSources.count(importPath))
+			if (m_sources.count(importPath))
 				continue;
+			auto inserted = pathIndices.emplace(importPath, paths.size());
+			if (inserted.second)
+				paths.push_back(importPath);
+			imports.emplace_back(import, inserted.first->second);
+		}
 
-			ReadCallback::Result result{false, string("File not supplied initially.")};
-			if (m_readFile)
-				result = m_readFile(importPath);
-
-			if (result.success)
-				newSources[importPath] = result.responseOrErrorMessage;
-			else
-			{
-				m_errorReporter.parserError(
-					import->location(),
-					string("Source \"" + importPath + "\" not found: " + result.responseOrErrorMessage)
-				);
-				continue;
-			}
+	vector<ReadCallback::Result> results(paths.size(), {false, string("File not supplied initially.")});
+	if (m_readFile)
+	{
+		if (_pool && paths.size() > 1)
+		{
+			// Request all files at once, but keep the results (and exceptions) in import order.
+			vector<exception_ptr> exceptions(paths.size());
+			for (size_t i = 0; i < paths.size(); ++i)
+				_pool->post([&, i]() {
+					try
+					{
+						results[i] = m_readFile(paths[i]);
+					}
+					catch (...)
+					{
+						exceptions[i] = current_exception();
+					}
+				});
+			_pool->wait();
+			for (exception_ptr const& exception: exceptions)
+				if (exception)
+					rethrow_exception(exception);
 		}
+		else
+			for (size_t i = 0; i < paths.size(); ++i)
+				results[i] = m_readFile(paths[i]);
+	}
+
+	StringMap newSources;
+	for (auto const& import: imports)
+	{
+		string const& importPath = paths[import.second];
+		ReadCallback::Result const& result = results[import.second];
+		if (result.success)
+			newSources[importPath] = result.responseOrErrorMessage;
+		else
+			m_errorReporter.parserError(
+				import.first->location(),
+				string("Source \"" + importPath + "\" not found: " + result.responseOrErrorMessage)
+			);
+	}
 	return newSources;
 }
 
@@ -782,6 +898,106 @@ void CompilerStack::resolveImports()
 	swap(m_sourceOrder, sourceOrder);
 }
 
+bool CompilerStack::checkTypeRequirementsInParallel(vector<ContractDefinition const*> const& _contracts)
+{
+	// Contracts refer to declarations of other contracts, so everything that is created
+	// on first access has to exist before the threads start: the annotations of all nodes
+	// and the member lists of the contracts.
+	// Yul identifiers are interned per thread, so contracts that contain inline assembly
+	// are checked on this thread, which parsed them.
+	// The type checker adds the contracts created by "new" to the dependencies of a contract.
+	// To detect cyclic creation as in a sequential run, the check of a contract sees these
+	// additional dependencies for all contracts that come before it.
+	map<ContractDefinition const*, size_t> contractIndices;
+	for (size_t i = 0; i < _contracts.size(); ++i)
+		contractIndices[_contracts[i]] = i;
+	vector<set<ContractDefinition const*>> dependenciesBefore(_contracts.size());
+	vector<set<ContractDefinition const*>> dependenciesAfter(_contracts.size());
+	set<ContractDefinition const*> containAssembly;
+	ContractDefinition const* currentContract = nullptr;
+	SimpleASTVisitor annotationInitializer(
+		[&](ASTNode const& _node)
+		{
+			_node.annotation();
+			if (auto contract = dynamic_cast<ContractDefinition const*>(&_node))
+			{
+				currentContract = contract;
+				dependenciesBefore[contractIndices.at(contract)] = contract->annotation().contractDependencies;
+				dependenciesAfter[contractIndices.at(contract)] = contract->annotation().contractDependencies;
+			}
+			else if (dynamic_cast<InlineAssembly const*>(&_node))
+				containAssembly.insert(currentContract);
+			else if (auto newExpression = dynamic_cast<NewExpression const*>(&_node))
+				if (auto typeName = dynamic_cast<UserDefinedTypeName const*>(&newExpression->typeName()))
+					if (auto contract = dynamic_cast<ContractDefinition const*>(typeName->annotation().referencedDeclaration))
+						if (contract->contractKind() != ContractDefinition::ContractKind::Interface)
+							dependenciesAfter[contractIndices.at(currentContract)].insert(contract);
+			return true;
+		},
+		[](ASTNode const&) {}
+	);
+	for (Source const* source: m_sourceOrder)
+		source->ast->accept(annotationInitializer);
+	for (ContractDefinition const* contract: _contracts)
+	{
+		contract->interfaceFunctionList();
+		contract->interfaceEvents();
+		contract->inheritableMembers();
+	}
+
+	struct Result
+	{
+		ErrorList errors;
+		exception_ptr exception;
+	};
+	vector<Result> results(_contracts.size());
+	auto check = [&](size_t _index)
+	{
+		try
+		{
+			TypeProvider::Scope typeProviderScope(*m_typeProvider);
+			ErrorReporter errorReporter(results[_index].errors);
+			TypeChecker typeChecker(
+				m_evmVersion,
+				errorReporter,
+				[&, _index](ContractDefinition const& _contract) -> set<ContractDefinition const*> const&
+				{
+					size_t index = contractIndices.at(&_contract);
+					return index < _index ? dependenciesAfter[index] : dependenciesBefore[index];
+				}
+			);
+			typeChecker.checkTypeRequirements(*_contracts[_index]);
+		}
+		catch (...)
+		{
+			results[_index].exception = current_exception();
+		}
+	};
+	{
+		ThreadPool pool(m_analysisThreads);
+		for (size_t i = 0; i < _contracts.size(); ++i)
+			if (!containAssembly.count(_contracts[i]))
+				pool.post([&check, i]() { check(i); });
+		for (size_t i = 0; i < _contracts.size(); ++i)
+			if (containAssembly.count(_contracts[i]))
+				check(i);
+		pool.wait();
+	}
+
+	// Report in the sequential order. An exception (including a fatal error) ends the
+	// analysis at the same point where the sequential checks would have ended it.
+	bool noErrors = true;
+	for (Result const& result: results)
+	{
+		m_errorReporter.append(result.errors);
+		if (result.exception)
+			rethrow_exception(result.exception);
+		if (!Error::containsOnlyWarnings(result.errors))
+			noErrors = false;
+	}
+	return noErrors;
+}
+
 namespace
 {
 bool onlySafeExperimentalFeaturesActivated(set<ExperimentalFeature> const& features)
@@ -795,7 +1011,8 @@ bool onlySafeExperimentalFeaturesActivated(set<ExperimentalFeature> const& featu
 
 void CompilerStack::compileContract(
 	ContractDefinition const& _contract,
-	map<ContractDefinition const*, eth::Assembly const*>& _compiledContracts
+	map<ContractDefinition const*, eth::Assembly const*>& _compiledContracts,
+	shared_ptr<InlineAssemblyCache> const& _inlineAssemblyCache
 )
 {
 	solAssert(m_stackState >= AnalysisSuccessful, "");
@@ -807,12 +1024,11 @@ void CompilerStack::compileContract(
 	)
 		return;
 	for (auto const* dependency: _contract.annotation().contractDependencies)
-		compileContract(*dependency, _compiledContracts);
+		compileContract(*dependency, _compiledContracts, _inlineAssemblyCache);
 
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
 
-	shared_ptr<Compiler> compiler = make_shared<Compiler>(m_evmVersion, m_optimize, m_optimizeRuns);
-	compiledContract.compiler = compiler;
+	shared_ptr<Compiler> compiler;
 
 	string metadata = createMetadata(compiledContract);
 	compiledContract.metadata = metadata;
@@ -822,14 +1038,41 @@ void CompilerStack::compileContract(
 		!onlySafeExperimentalFeaturesActivated(_contract.sourceUnit().annotation().experimentalFeatures)
 	);
 
-	try
+	if (m_viaIR)
 	{
-		// Run optimiser and compile the contract.
-		compiler->compileContract(_contract, _compiledContracts, cborEncodedMetadata);
+		compileContractViaIR(compiledContract, cborEncodedMetadata);
+		return;
 	}
-	catch(eth::OptimizerException const&)
+
+	// If the code generator runs out of stack slots, local variables of the affected
+	// function are moved to memory one by one and the contract is compiled again.
+	unique_ptr<StackSpiller> stackSpiller;
+	while (true)
 	{
-		solAssert(false, "Optimizer exception during compilation");
+		compiler = make_shared<Compiler>(m_evmVersion, m_optimize, m_optimizeRuns, _inlineAssemblyCache);
+		compiledContract.compiler = compiler;
+		if (stackSpiller)
+			compiler->setSpilledVariables(stackSpiller->spilledVariables());
+		try
+		{
+			// Run optimiser and compile the contract.
+			compiler->compileContract(_contract, _compiledContracts, cborEncodedMetadata);
+			break;
+		}
+		catch(eth::OptimizerException const&)
+		{
+			solAssert(false, "Optimizer exception during compilation");
+		}
+		catch(CompilerError const& _error)
+		{
+			if (!StackSpiller::isStackTooDeepError(_error))
+				throw;
+			SourceLocation const* location = boost::get_error_info<errinfo_sourceLocation>(_error);
+			if (!stackSpiller)
+				stackSpiller = make_unique<StackSpiller>(_contract);
+			if (!location || !stackSpiller->spillVariableAt(*location))
+				throw;
+		}
 	}
 
 	try
@@ -855,6 +1098,63 @@ void CompilerStack::compileContract(
 	_compiledContracts[compiledContract.contract] = &compiler->assembly();
 }
 
+void CompilerStack::compileContractViaIR(Contract& _compiledContract, bytes const& _cborEncodedMetadata)
+{
+	auto compileToAssembly = [&](bool _optimize)
+	{
+		AssemblyStack stack(m_evmVersion, AssemblyStack::Language::StrictAssembly);
+		if (!stack.parseAndAnalyze(_compiledContract.contract->sourceUnitName(), yulIR(_compiledContract)))
+		{
+			string message =
+				"Error parsing/analyzing the generated IR:\n"
+				"------------------ Input: -----------------\n" +
+				yulIR(_compiledContract) + "\n"
+				"------------------ Errors: ----------------\n";
+			for (auto const& error: stack.errors())
+				message += SourceReferenceFormatter::formatExceptionInformation(
+					*error,
+					(error->type() == Error::Type::Warning) ? "Warning" : "Error"
+				);
+			message += "-------------------------------------------\n";
+			solAssert(false, message);
+		}
+		if (_optimize)
+			stack.optimize();
+		auto assembly = make_shared<eth::Assembly>();
+		EthAssemblyAdapter adapter(*assembly);
+		yul::Object object = stack.parserResult();
+		yul::EVMObjectCompiler::compile(object, adapter, *yul::EVMDialect::strictAssemblyForEVMObjects(), false, _optimize);
+		return assembly;
+	};
+
+	shared_ptr<eth::Assembly> assembly;
+	if (m_optimize)
+		try
+		{
+			assembly = compileToAssembly(true);
+		}
+		catch (UnimplementedFeatureError const&)
+		{
+			// The Yul optimiser can keep too many variables on the stack. The unoptimised
+			// code is used instead and only optimised on the assembly level.
+		}
+	if (!assembly)
+		assembly = compileToAssembly(false);
+	// The runtime code is the only sub-assembly and receives the metadata.
+	assembly->sub(0).appendAuxiliaryDataToEnd(_cborEncodedMetadata);
+	assembly->optimise(m_optimize, m_evmVersion, true, m_optimizeRuns);
+
+	try
+	{
+		_compiledContract.object = assembly->assemble();
+		_compiledContract.runtimeObject = assembly->sub(0).assemble();
+	}
+	catch(eth::AssemblyException const&)
+	{
+		solAssert(false, "Assembly exception for bytecode generated via IR");
+	}
+}
+
 CompilerStack::Contract const& CompilerStack::contract(string const& _contractName) const
 {
 	solAssert(m_stackState >= AnalysisSuccessful, "");
@@ -927,6 +1227,8 @@ string CompilerStack::createMetadata(Contract const& _contract) const
 	meta["settings"]["optimizer"]["enabled"] = m_optimize;
 	meta["settings"]["optimizer"]["runs"] = m_optimizeRuns;
 	meta["settings"]["evmVersion"] = m_evmVersion.name();
+	if (m_viaIR)
+		meta["settings"]["viaIR"] = true;
 	meta["settings"]["compilationTarget"][_contract.contract->sourceUnitName()] =
 		_contract.contract->annotation().canonicalName;
 
@@ -41,6 +41,7 @@
 #include <memory>
 #include <ostream>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace langutil
@@ -51,6 +52,9 @@ class Scanner;
 namespace dev
 {
 
+class JsonStreamWriter;
+class ThreadPool;
+
 namespace eth
 {
 class Assembly;
@@ -67,9 +71,11 @@ class ContractDefinition;
 class FunctionDefinition;
 class SourceUnit;
 class Compiler;
+struct InlineAssemblyCache;
 class GlobalContext;
 class Natspec;
 class DeclarationContainer;
+class TypeProvider;
 
 /**
  * Easy to use and self-contained Solidity compiler with as few header dependencies as possible.
@@ -134,10 +140,26 @@ public:
 		m_optimizeRuns = _runs;
 	}
 
+	/// Enables the code generator that translates contracts to Yul and compiles the Yul code,
+	/// which is run through the Yul optimiser if the optimiser is enabled.
+	/// Will not take effect before running compile.
+	void setViaIR(bool _viaIR) { m_viaIR = _viaIR; }
+
 	/// Set the EVM version used before running compile.
 	/// When called without an argument it will revert to the default version.
 	void setEVMVersion(EVMVersion _version = EVMVersion{});
 
+	/// Sets the number of threads used to type check contracts. Zero uses one thread per
+	/// hardware thread, one (the default) checks all contracts on the calling thread.
+	/// Diagnostics are reported in the same order regardless of this setting.
+	void setAnalysisThreads(unsigned _threads) { m_analysisThreads = _threads; }
+
+	/// Sets the number of threads used to read the imports of a source unit through the read
+	/// callback. Values other than one (the default) require the callback to be safe to call
+	/// from several threads at once. Zero uses one thread per hardware thread.
+	/// Sources are parsed and diagnostics are reported in the same order regardless of this setting.
+	void setFileReadingThreads(unsigned _threads) { m_fileReadingThreads = _threads; }
+
 	/// Sets the list of requested contract names. If empty, no filtering is performed and every contract
 	/// found in the supplied sources is compiled. Names are cleared iff @a _contractNames is missing.
 	void setRequestedContractNames(std::set<std::string> const& _contractNames = std::set<std::string>{})
@@ -150,7 +172,7 @@ public:
 
 	/// Adds a source object (e.g. file) to the parser. After this, parse has to be called again.
 	/// @returns true if a source object by the name already existed and was replaced.
-	bool addSource(std::string const& _name, std::string const& _content, bool _isLibrary = false);
+	bool addSource(std::string const& _name, std::string _content, bool _isLibrary = false);
 
 	/// Adds a response to an SMTLib2 query (identified by the hash of the query input).
 	void addSMTLib2Response(h256 const& _hash, std::string const& _response) { m_smtlib2Responses[_hash] = _response; }
@@ -203,6 +225,11 @@ public:
 	/// @returns either the contract's name or a mixture of its name and source file, sanitized for filesystem use
 	std::string const filesystemFriendlyName(std::string const& _contractName) const;
 
+	/// @returns the Yul code generated for a contract or an empty string if the contract
+	/// is not compiled. Throws an UnimplementedFeatureError if the contract uses features
+	/// the Yul code generator does not support yet.
+	std::string const& yulIR(std::string const& _contractName) const;
+
 	/// @returns the assembled object for a contract.
 	eth::LinkerObject const& object(std::string const& _contractName) const;
 
@@ -226,12 +253,15 @@ public:
 	/// @return a verbose text representation of the assembly.
 	/// @arg _sourceCodes is the map of input files to source code strings
 	/// Prerequisite: Successful compilation.
-	std::string assemblyString(std::string const& _contractName, StringMap _sourceCodes = StringMap()) const;
+	std::string assemblyString(std::string const& _contractName, StringMap const& _sourceCodes = StringMap()) const;
 
 	/// @returns a JSON representation of the assembly.
 	/// @arg _sourceCodes is the map of input files to source code strings
 	/// Prerequisite: Successful compilation.
-	Json::Value assemblyJSON(std::string const& _contractName, StringMap _sourceCodes = StringMap()) const;
+	Json::Value assemblyJSON(std::string const& _contractName, StringMap const& _sourceCodes = StringMap()) const;
+	/// Writes the JSON representation of the assembly to @a _writer without building it in memory.
+	/// Prerequisite: Successful compilation.
+	void assemblyJSON(JsonStreamWriter& _writer, std::string const& _contractName, StringMap const& _sourceCodes = StringMap()) const;
 
 	/// @returns a JSON representing the contract ABI.
 	/// Prerequisite: Successful call to parse or compile.
@@ -281,22 +311,31 @@ private:
 		mutable std::unique_ptr<Json::Value const> devDocumentation;
 		mutable std::unique_ptr<std::string const> sourceMapping;
 		mutable std::unique_ptr<std::string const> runtimeSourceMapping;
+		mutable std::unique_ptr<std::string const> yulIR;
 	};
 
 	/// Loads the missing sources from @a _ast (named @a _path) using the callback
 	/// @a m_readFile and stores the absolute paths of all imports in the AST annotations.
+	/// If @a _pool is given, all imports of the source unit are requested at once using its threads.
 	/// @returns the newly loaded sources.
-	StringMap loadMissingSources(SourceUnit const& _ast, std::string const& _path);
+	StringMap loadMissingSources(SourceUnit const& _ast, std::string const& _path, ThreadPool* _pool = nullptr);
 	std::string applyRemapping(std::string const& _path, std::string const& _context);
 	void resolveImports();
 
+	/// Runs the type checker on @a _contracts using a pool of m_analysisThreads threads and
+	/// reports their diagnostics in the order of @a _contracts.
+	/// @returns false if any error was reported.
+	bool checkTypeRequirementsInParallel(std::vector<ContractDefinition const*> const& _contracts);
+
 	/// @returns true if the contract is requested to be compiled.
 	bool isRequestedContract(ContractDefinition const& _contract) const;
 
 	/// Compile a single contract and put the result in @a _compiledContracts.
+	/// @a _inlineAssemblyCache is shared by the code generators of all contracts.
 	void compileContract(
 		ContractDefinition const& _contract,
-		std::map<ContractDefinition const*, eth::Assembly const*>& _compiledContracts
+		std::map<ContractDefinition const*, eth::Assembly const*>& _compiledContracts,
+		std::shared_ptr<InlineAssemblyCache> const& _inlineAssemblyCache
 	);
 
 	/// Links all the known library addresses in the available objects. Any unknown
@@ -315,6 +354,13 @@ private:
 	/// does not exist.
 	ContractDefinition const& contractDefinition(std::string const& _contractName) const;
 
+	/// @returns the Yul code generated for the given contract.
+	/// This will generate the code and store it in the Contract object if it is not present yet.
+	std::string const& yulIR(Contract const& _contract) const;
+
+	/// Generates the Yul code of @a _contract, compiles it and stores the result in @a _compiledContract.
+	void compileContractViaIR(Contract& _compiledContract, bytes const& _cborEncodedMetadata);
+
 	/// @returns the metadata JSON as a compact string for the given contract.
 	std::string createMetadata(Contract const& _contract) const;
 
@@ -346,7 +392,10 @@ private:
 	ReadCallback::Callback m_readFile;
 	bool m_optimize = false;
 	unsigned m_optimizeRuns = 200;
+	bool m_viaIR = false;
 	EVMVersion m_evmVersion;
+	unsigned m_analysisThreads = 1;
+	unsigned m_fileReadingThreads = 1;
 	std::set<std::string> m_requestedContractNames;
 	std::map<std::string, h160> m_libraries;
 	/// list of path prefix remappings, e.g. mylibrary: github.com/ethereum = /usr/local/ethereum
@@ -356,9 +405,11 @@ private:
 	std::vector<std::string> m_unhandledSMTLib2Queries;
 	std::map<h256, std::string> m_smtlib2Responses;
 	std::shared_ptr<GlobalContext> m_globalContext;
+	/// Canonical elementary types of the current compilation, set up by analyze().
+	std::shared_ptr<TypeProvider> m_typeProvider;
 	std::vector<Source const*> m_sourceOrder;
 	/// This is updated during compilation.
-	std::map<ASTNode const*, std::shared_ptr<DeclarationContainer>> m_scopes;
+	std::unordered_map<ASTNode const*, std::shared_ptr<DeclarationContainer>> m_scopes;
 	std::map<std::string const, Contract> m_contracts;
 	langutil::ErrorList m_errorList;
 	langutil::ErrorReporter m_errorReporter;
@@ -32,6 +32,7 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/optional.hpp>
 #include <algorithm>
+#include <sstream>
 
 using namespace std;
 using namespace dev;
@@ -349,9 +350,10 @@ boost::optional<Json::Value> checkOutputSelection(Json::Value const& _outputSele
 
 }
 
-Json::Value StandardCompiler::compileInternal(Json::Value const& _input)
+Json::Value StandardCompiler::compileInternal(Json::Value const& _input, bool _includeASTs)
 {
 	m_compilerStack.reset(false);
+	m_deferredASTs.clear();
 
 	if (!_input.isObject())
 		return formatFatalError("JSONError", "Input is not a JSON object.");
@@ -393,7 +395,7 @@ Json::Value StandardCompiler::compileInternal(Json::Value const& _input)
 					"Mismatch between content and supplied hash for \"" + sourceName + "\""
 				));
 			else
-				m_compilerStack.addSource(sourceName, content);
+				m_compilerStack.addSource(sourceName, std::move(content));
 		}
 		else if (sources[sourceName]["urls"].isArray())
 		{
@@ -419,7 +421,7 @@ Json::Value StandardCompiler::compileInternal(Json::Value const& _input)
 						));
 					else
 					{
-						m_compilerStack.addSource(sourceName, result.responseOrErrorMessage);
+						m_compilerStack.addSource(sourceName, std::move(result.responseOrErrorMessage));
 						found = true;
 						break;
 					}
@@ -692,7 +694,7 @@ Json::Value StandardCompiler::compileInternal(Json::Value const& _input)
 	Json::Value output = Json::objectValue;
 
 	if (errors.size() > 0)
-		output["errors"] = errors;
+		output["errors"] = std::move(errors);
 
 	if (!m_compilerStack.unhandledSMTLib2Queries().empty())
 		for (string const& query: m_compilerStack.unhandledSMTLib2Queries())
@@ -704,13 +706,26 @@ Json::Value StandardCompiler::compileInternal(Json::Value const& _input)
 	{
 		Json::Value sourceResult = Json::objectValue;
 		sourceResult["id"] = sourceIndex++;
-		if (isArtifactRequested(outputSelection, sourceName, "", "ast"))
-			sourceResult["ast"] = ASTJsonConverter(false, m_compilerStack.sourceIndices()).toJson(m_compilerStack.ast(sourceName));
-		if (isArtifactRequested(outputSelection, sourceName, "", "legacyAST"))
-			sourceResult["legacyAST"] = ASTJsonConverter(true, m_compilerStack.sourceIndices()).toJson(m_compilerStack.ast(sourceName));
-		output["sources"][sourceName] = sourceResult;
+		for (string const artifact: {"ast", "legacyAST"})
+			if (isArtifactRequested(outputSelection, sourceName, "", artifact))
+			{
+				if (_includeASTs)
+					sourceResult[artifact] = sourceAST(sourceName, artifact);
+				else
+					m_deferredASTs[sourceName].push_back(artifact);
+			}
+		output["sources"][sourceName] = std::move(sourceResult);
 	}
 
+	// The source list is only needed for the assembly, but it contains a copy of every source,
+	// so it is created once for all contracts.
+	boost::optional<StringMap> sourceList;
+	auto sourceCodes = [&]() -> StringMap const& {
+		if (!sourceList)
+			sourceList = createSourceList(_input);
+		return *sourceList;
+	};
+
 	Json::Value contractsOutput = Json::objectValue;
 	for (string const& contractName: analysisSuccess ? m_compilerStack.contractNames() : vector<string>())
 	{
@@ -734,9 +749,9 @@ Json::Value StandardCompiler::compileInternal(Json::Value const& _input)
 		Json::Value evmData(Json::objectValue);
 		// @TODO: add ir
 		if (compilationSuccess && isArtifactRequested(outputSelection, file, name, "evm.assembly"))
-			evmData["assembly"] = m_compilerStack.assemblyString(contractName, createSourceList(_input));
+			evmData["assembly"] = m_compilerStack.assemblyString(contractName, sourceCodes());
 		if (compilationSuccess && isArtifactRequested(outputSelection, file, name, "evm.legacyAssembly"))
-			evmData["legacyAssembly"] = m_compilerStack.assemblyJSON(contractName, createSourceList(_input));
+			evmData["legacyAssembly"] = m_compilerStack.assemblyJSON(contractName, sourceCodes());
 		if (isArtifactRequested(outputSelection, file, name, "evm.methodIdentifiers"))
 			evmData["methodIdentifiers"] = m_compilerStack.methodIdentifiers(contractName);
 		if (compilationSuccess && isArtifactRequested(outputSelection, file, name, "evm.gasEstimates"))
@@ -765,26 +780,36 @@ Json::Value StandardCompiler::compileInternal(Json::Value const& _input)
 			);
 
 		if (!evmData.empty())
-			contractData["evm"] = evmData;
+			contractData["evm"] = std::move(evmData);
 
 		if (!contractData.empty())
 		{
 			if (!contractsOutput.isMember(file))
 				contractsOutput[file] = Json::objectValue;
-			contractsOutput[file][name] = contractData;
+			contractsOutput[file][name] = std::move(contractData);
 		}
 	}
 	if (!contractsOutput.empty())
-		output["contracts"] = contractsOutput;
+		output["contracts"] = std::move(contractsOutput);
 
 	return output;
 }
 
+Json::Value StandardCompiler::sourceAST(string const& _sourceName, string const& _artifact) const
+{
+	return ASTJsonConverter(_artifact == "legacyAST", m_compilerStack.sourceIndices()).toJson(m_compilerStack.ast(_sourceName));
+}
+
 Json::Value StandardCompiler::compile(Json::Value const& _input) noexcept
+{
+	return compileSafely(_input, true);
+}
+
+Json::Value StandardCompiler::compileSafely(Json::Value const& _input, bool _includeASTs) noexcept
 {
 	try
 	{
-		return compileInternal(_input);
+		return compileInternal(_input, _includeASTs);
 	}
 	catch (Json::LogicError const& _exception)
 	{
@@ -806,25 +831,49 @@ Json::Value StandardCompiler::compile(Json::Value const& _input) noexcept
 
 string StandardCompiler::compile(string const& _input) noexcept
 {
-	Json::Value input;
-	string errors;
-	try
+	Json::Value output;
 	{
-		if (!jsonParseStrict(_input, input, &errors))
-			return jsonCompactPrint(formatFatalError("JSONError", errors));
-	}
-	catch (...)
-	{
-		return "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error parsing input JSON.\"}]}";
-	}
+		Json::Value input;
+		string errors;
+		try
+		{
+			if (!jsonParseStrict(_input, input, &errors))
+				return jsonCompactPrint(formatFatalError("JSONError", errors));
+		}
+		catch (...)
+		{
+			return "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error parsing input JSON.\"}]}";
+		}
 
-	// cout << "Input: " << input.toStyledString() << endl;
-	Json::Value output = compile(input);
-	// cout << "Output: " << output.toStyledString() << endl;
+		// cout << "Input: " << input.toStyledString() << endl;
+		output = compileSafely(input, false);
+		// cout << "Output: " << output.toStyledString() << endl;
+	}
 
 	try
 	{
-		return jsonCompactPrint(output);
+		if (m_deferredASTs.empty() || !output.isMember("sources"))
+			return jsonCompactPrint(output);
+
+		// The ASTs are created and written one at a time.
+		ostringstream stream;
+		JsonStreamWriter writer(stream, "");
+		Json::Value sources;
+		sources.swap(output["sources"]);
+		output.removeMember("sources");
+		writer.object(output, {{"sources", [&]() {
+			writer.beginObject();
+			for (string const& sourceName: sources.getMemberNames())
+			{
+				map<string, function<void()>> asts;
+				for (string const& artifact: m_deferredASTs[sourceName])
+					asts[artifact] = [&, artifact]() { writer.value(sourceAST(sourceName, artifact)); };
+				writer.key(sourceName);
+				writer.object(sources[sourceName], asts);
+			}
+			writer.endObject();
+		}}});
+		return stream.str();
 	}
 	catch (...)
 	{
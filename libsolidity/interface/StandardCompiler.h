@@ -50,13 +50,23 @@ public:
 	Json::Value compile(Json::Value const& _input) noexcept;
 	/// Parses input as JSON and peforms the above processing steps, returning a serialized JSON
 	/// output. Parsing errors are returned as regular errors.
+	/// The output is serialised directly, so that the ASTs of the sources are never part of
+	/// a complete output tree.
 	std::string compile(std::string const& _input) noexcept;
 
 private:
-	Json::Value compileInternal(Json::Value const& _input);
+	/// Calls compileInternal and turns exceptions into errors.
+	Json::Value compileSafely(Json::Value const& _input, bool _includeASTs) noexcept;
+	/// Performs the processing steps of compile(). If @a _includeASTs is false, the requested ASTs
+	/// are not added to the output but recorded in m_deferredASTs instead.
+	Json::Value compileInternal(Json::Value const& _input, bool _includeASTs);
+	/// @returns the output artifact @a _artifact ("ast" or "legacyAST") of the source @a _sourceName.
+	Json::Value sourceAST(std::string const& _sourceName, std::string const& _artifact) const;
 
 	CompilerStack m_compilerStack;
 	ReadCallback::Callback m_readFile;
+	/// Names of the AST artifacts requested for each source, if they were not added to the output.
+	std::map<std::string, std::vector<std::string>> m_deferredASTs;
 };
 
 }
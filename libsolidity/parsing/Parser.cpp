@@ -62,7 +62,11 @@ public:
 		solAssert(m_location.source, "");
 		if (m_location.end < 0)
 			markEndPosition();
-		return make_shared<NodeType>(m_location, std::forward<Args>(_args)...);
+		return allocate_shared<NodeType>(
+			ArenaAllocator<NodeType>(m_parser.m_arena),
+			m_location,
+			std::forward<Args>(_args)...
+		);
 	}
 
 private:
@@ -75,7 +79,9 @@ ASTPointer<SourceUnit> Parser::parse(shared_ptr<Scanner> const& _scanner)
 	try
 	{
 		m_recursionDepth = 0;
+		m_insideModifier = false;
 		m_scanner = _scanner;
+		m_arena = make_shared<Arena>();
 		ASTNodeFactory nodeFactory(*this);
 		vector<ASTPointer<ASTNode>> nodes;
 		while (m_scanner->currentToken() != Token::EOS)
@@ -1802,9 +1808,11 @@ ASTPointer<ASTString> Parser::expectIdentifierToken()
 
 ASTPointer<ASTString> Parser::getLiteralAndAdvance()
 {
-	ASTPointer<ASTString> identifier = make_shared<ASTString>(m_scanner->currentLiteral());
+	ASTPointer<ASTString>& literal = m_literals[m_scanner->currentLiteral()];
+	if (!literal)
+		literal = make_shared<ASTString>(m_scanner->currentLiteral());
 	m_scanner->next();
-	return identifier;
+	return literal;
 }
 
 }
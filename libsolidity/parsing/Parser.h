@@ -25,6 +25,10 @@
 #include <libsolidity/ast/AST.h>
 #include <liblangutil/ParserBase.h>
 
+#include <libdevcore/Arena.h>
+
+#include <unordered_map>
+
 namespace langutil
 {
 class Scanner;
@@ -173,6 +177,8 @@ private:
 	ASTPointer<Expression> expressionFromIndexAccessStructure(IndexAccessedPath const& _pathAndIndices);
 
 	ASTPointer<ASTString> expectIdentifierToken();
+	/// @returns the literal of the current token and advances. Equal literals share a
+	/// single string for all sources parsed by this parser.
 	ASTPointer<ASTString> getLiteralAndAdvance();
 	///@}
 
@@ -181,6 +187,11 @@ private:
 
 	/// Flag that signifies whether '_' is parsed as a PlaceholderStatement or a regular identifier.
 	bool m_insideModifier = false;
+	/// Interned identifiers and literals.
+	std::unordered_map<std::string, ASTPointer<ASTString>> m_literals;
+	/// Memory for the nodes of the source unit being parsed. It is released once
+	/// all nodes of the source unit are destroyed.
+	std::shared_ptr<dev::Arena> m_arena;
 };
 
 }
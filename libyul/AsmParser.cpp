@@ -309,7 +309,7 @@ Expression Parser::parseExpression()
 std::map<string, dev::solidity::Instruction> const& Parser::instructions()
 {
 	// Allowed instructions, lowercase names.
-	static map<string, dev::solidity::Instruction> s_instructions;
+	thread_local map<string, dev::solidity::Instruction> s_instructions;
 	if (s_instructions.empty())
 	{
 		for (auto const& instruction: solidity::c_instructions)
@@ -329,7 +329,7 @@ std::map<string, dev::solidity::Instruction> const& Parser::instructions()
 
 std::map<dev::solidity::Instruction, string> const& Parser::instructionNames()
 {
-	static map<dev::solidity::Instruction, string> s_instructionNames;
+	thread_local map<dev::solidity::Instruction, string> s_instructionNames;
 	if (s_instructionNames.empty())
 	{
 		for (auto const& instr: instructions())
@@ -34,6 +34,8 @@ namespace yul
 /// Owns the string data for all YulStrings, which can be referenced by a Handle.
 /// A Handle consists of an ID (that depends on the insertion order of YulStrings and is potentially
 /// non-deterministic) and a deterministic string hash.
+/// There is one repository per thread, so that independent compilations can run
+/// concurrently without sharing (and locking) the string table.
 class YulStringRepository: boost::noncopyable
 {
 public:
@@ -47,7 +49,7 @@ public:
 
 	static YulStringRepository& instance()
 	{
-		static YulStringRepository inst;
+		thread_local YulStringRepository inst;
 		return inst;
 	}
 	Handle stringToHandle(std::string const& _string)
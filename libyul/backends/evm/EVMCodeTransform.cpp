@@ -171,14 +171,34 @@ void CodeTransform::deleteVariable(Scope::Variable const& _var)
 	m_variablesScheduledForDeletion.erase(&_var);
 }
 
+bool CodeTransform::isLastReferenceOnStackTop(YulString _name, Scope::Variable const& _var) const
+{
+	if (!m_allowStackOpt || m_inLoopCondition)
+		return false;
+	auto declaration = m_scope->identifiers.find(_name);
+	if (
+		declaration == m_scope->identifiers.end() ||
+		declaration->second.type() != typeid(Scope::Variable) ||
+		&boost::get<Scope::Variable>(declaration->second) != &_var
+	)
+		return false;
+	auto references = m_context->variableReferences.find(&_var);
+	auto height = m_context->variableStackHeights.find(&_var);
+	return
+		references != m_context->variableReferences.end() &&
+		references->second == 1 &&
+		height != m_context->variableStackHeights.end() &&
+		m_assembly.stackHeight() - height->second == 1;
+}
+
 void CodeTransform::operator()(VariableDeclaration const& _varDecl)
 {
 	solAssert(m_scope, "");
 
 	int const numVariables = _varDecl.variables.size();
-	int height = m_assembly.stackHeight();
 	if (_varDecl.value)
 	{
+		int height = m_assembly.stackHeight() - m_stackAdjustment;
 		boost::apply_visitor(*this, *_varDecl.value);
 		expectDeposit(numVariables, height);
 	}
@@ -188,6 +208,8 @@ void CodeTransform::operator()(VariableDeclaration const& _varDecl)
 		while (variablesLeft--)
 			m_assembly.appendConstant(u256(0));
 	}
+	// The value might have taken over the slot of a variable that is not used anymore.
+	int height = m_assembly.stackHeight() - numVariables;
 
 	bool atTopOfStack = true;
 	for (int varIndex = numVariables - 1; varIndex >= 0; --varIndex)
@@ -228,7 +250,7 @@ void CodeTransform::operator()(VariableDeclaration const& _varDecl)
 
 void CodeTransform::operator()(Assignment const& _assignment)
 {
-	int height = m_assembly.stackHeight();
+	int height = m_assembly.stackHeight() - m_stackAdjustment;
 	boost::apply_visitor(*this, *_assignment.value);
 	expectDeposit(_assignment.variableNames.size(), height);
 
@@ -351,8 +373,16 @@ void CodeTransform::operator()(Identifier const& _identifier)
 	if (m_scope->lookup(_identifier.name, Scope::NonconstVisitor(
 		[=](Scope::Variable& _var)
 		{
-			// TODO: opportunity for optimization: Do not DUP if this is the last reference
-			// to the top most element of the stack
+			if (isLastReferenceOnStackTop(_identifier.name, _var))
+			{
+				// The variable is not used afterwards, so its slot is taken over by the
+				// value of the expression instead of duplicating it and popping it later.
+				m_context->variableStackHeights.erase(&_var);
+				m_context->variableReferences.erase(&_var);
+				m_variablesScheduledForDeletion.erase(&_var);
+				--m_stackAdjustment;
+				return;
+			}
 			if (int heightDiff = variableHeightDiff(_var, false))
 				m_assembly.appendInstruction(solidity::dupInstruction(heightDiff));
 			else
@@ -585,7 +615,9 @@ void CodeTransform::operator()(ForLoop const& _forLoop)
 	m_assembly.setSourceLocation(_forLoop.location);
 	m_assembly.appendLabel(loopStart);
 
+	m_inLoopCondition = true;
 	visitExpression(*_forLoop.condition);
+	m_inLoopCondition = false;
 	m_assembly.setSourceLocation(_forLoop.location);
 	m_assembly.appendInstruction(solidity::Instruction::ISZERO);
 	m_assembly.appendJumpToIf(loopEnd);
@@ -656,7 +688,7 @@ AbstractAssembly::LabelID CodeTransform::functionEntryID(YulString _name, Scope:
 
 void CodeTransform::visitExpression(Expression const& _expression)
 {
-	int height = m_assembly.stackHeight();
+	int height = m_assembly.stackHeight() - m_stackAdjustment;
 	boost::apply_visitor(*this, _expression);
 	expectDeposit(1, height);
 }
@@ -743,7 +775,7 @@ int CodeTransform::variableHeightDiff(Scope::Variable const& _var, bool _forSwap
 
 void CodeTransform::expectDeposit(int _deposit, int _oldHeight) const
 {
-	solAssert(m_assembly.stackHeight() == _oldHeight + _deposit, "Invalid stack deposit.");
+	solAssert(m_assembly.stackHeight() - m_stackAdjustment == _oldHeight + _deposit, "Invalid stack deposit.");
 }
 
 void CodeTransform::checkStackHeight(void const* _astElement) const
@@ -133,6 +133,10 @@ protected:
 	void freeUnusedVariables();
 	/// Marks the stack slot of @a _var to be reused.
 	void deleteVariable(Scope::Variable const& _var);
+	/// @returns true if the variable @a _name is declared in the current scope, occupies the
+	/// topmost stack slot and is referenced exactly once more, i.e. its value can be used in
+	/// place instead of duplicating it and removing it later.
+	bool isLastReferenceOnStackTop(YulString _name, Scope::Variable const& _var) const;
 
 public:
 	void operator()(Instruction const& _instruction);
@@ -174,6 +178,8 @@ private:
 	/// the (positive) stack height difference otherwise.
 	int variableHeightDiff(Scope::Variable const& _var, bool _forSwap) const;
 
+	/// Asserts that the stack height (excluding the stack adjustment) is @a _deposit
+	/// higher than @a _oldHeight.
 	void expectDeposit(int _deposit, int _oldHeight) const;
 
 	void checkStackHeight(void const* _astElement) const;
@@ -198,6 +204,9 @@ private:
 	/// statement level in the scope where the variable was defined.
 	std::set<Scope::Variable const*> m_variablesScheduledForDeletion;
 	std::set<int> m_unusedStackSlots;
+	/// True while generating code for the condition of a for loop, which is evaluated
+	/// in the scope of the loop's pre block but executed repeatedly.
+	bool m_inLoopCondition = false;
 };
 
 }
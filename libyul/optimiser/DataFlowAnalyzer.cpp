@@ -26,6 +26,7 @@
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/Exceptions.h>
 #include <libyul/AsmData.h>
+#include <libyul/Utilities.h>
 
 #include <libdevcore/CommonData.h>
 
@@ -35,12 +36,63 @@ using namespace std;
 using namespace dev;
 using namespace yul;
 
+namespace
+{
+
+/// @returns the value of the number literal the variable is known to be equal to, if any.
+boost::optional<u256> knownNumber(map<YulString, Expression const*> const& _values, YulString _name)
+{
+	auto it = _values.find(_name);
+	if (it == _values.end() || it->second->type() != typeid(Literal))
+		return {};
+	Literal const& literal = boost::get<Literal>(*it->second);
+	if (literal.kind != LiteralKind::Number)
+		return {};
+	return valueOfNumberLiteral(literal);
+}
+
+}
+
+void DataFlowAnalyzer::operator()(ExpressionStatement& _statement)
+{
+	bool simpleStore =
+		isSimpleStore(solidity::Instruction::SSTORE, _statement) ||
+		isSimpleStore(solidity::Instruction::MSTORE, _statement);
+	if (!simpleStore)
+		clearKnowledgeIfInvalidated(_statement.expression);
+
+	ASTModifier::operator()(_statement);
+
+	// Check again, the arguments might have been replaced while visiting.
+	if (auto vars = isSimpleStore(solidity::Instruction::SSTORE, _statement))
+	{
+		for (auto it = m_storage.begin(); it != m_storage.end();)
+			if (knownToBeDifferent(vars->first, it->first))
+				++it;
+			else
+				it = m_storage.erase(it);
+		m_storage[vars->first] = vars->second;
+	}
+	else if (auto vars = isSimpleStore(solidity::Instruction::MSTORE, _statement))
+	{
+		for (auto it = m_memory.begin(); it != m_memory.end();)
+			if (knownToBeDifferentByAtLeast32(vars->first, it->first))
+				++it;
+			else
+				it = m_memory.erase(it);
+		m_memory[vars->first] = vars->second;
+	}
+	else if (simpleStore)
+		clearKnowledgeIfInvalidated(_statement.expression);
+}
+
 void DataFlowAnalyzer::operator()(Assignment& _assignment)
 {
 	set<YulString> names;
 	for (auto const& var: _assignment.variableNames)
 		names.emplace(var.name);
 	assertThrow(_assignment.value, OptimizerException, "");
+	clearKnowledgeIfInvalidated(*_assignment.value);
 	visit(*_assignment.value);
 	handleAssignment(names, _assignment.value.get());
 }
@@ -53,15 +105,24 @@ void DataFlowAnalyzer::operator()(VariableDeclaration& _varDecl)
 	m_variableScopes.back().variables += names;
 
 	if (_varDecl.value)
+	{
+		clearKnowledgeIfInvalidated(*_varDecl.value);
 		visit(*_varDecl.value);
+	}
 
 	handleAssignment(names, _varDecl.value.get());
 }
 
 void DataFlowAnalyzer::operator()(If& _if)
 {
+	clearKnowledgeIfInvalidated(*_if.condition);
+	map<YulString, YulString> storage = m_storage;
+	map<YulString, YulString> memory = m_memory;
+
 	ASTModifier::operator()(_if);
 
+	joinKnowledge(storage, memory);
+
 	Assignments assignments;
 	assignments(_if.body);
 	clearValues(assignments.names());
@@ -69,17 +130,34 @@ void DataFlowAnalyzer::operator()(If& _if)
 
 void DataFlowAnalyzer::operator()(Switch& _switch)
 {
+	clearKnowledgeIfInvalidated(*_switch.expression);
 	visit(*_switch.expression);
 	set<YulString> assignedVariables;
+	map<YulString, YulString> storage = m_storage;
+	map<YulString, YulString> memory = m_memory;
+	// Knowledge at the end of each case and initial knowledge if there is no default case.
+	vector<pair<map<YulString, YulString>, map<YulString, YulString>>> knowledge;
+	bool hasDefault = false;
 	for (auto& _case: _switch.cases)
 	{
+		m_storage = storage;
+		m_memory = memory;
 		(*this)(_case.body);
 		Assignments assignments;
 		assignments(_case.body);
 		assignedVariables += assignments.names();
 		// This is a little too destructive, we could retain the old values.
 		clearValues(assignments.names());
+		knowledge.emplace_back(move(m_storage), move(m_memory));
+		if (!_case.value)
+			hasDefault = true;
 	}
+	if (!hasDefault)
+		knowledge.emplace_back(move(storage), move(memory));
+	m_storage = move(knowledge.front().first);
+	m_memory = move(knowledge.front().second);
+	for (size_t i = 1; i < knowledge.size(); ++i)
+		joinKnowledge(knowledge[i].first, knowledge[i].second);
 	clearValues(assignedVariables);
 }
 
@@ -90,9 +168,13 @@ void DataFlowAnalyzer::operator()(FunctionDefinition& _fun)
 	map<YulString, Expression const*> value;
 	map<YulString, set<YulString>> references;
 	map<YulString, set<YulString>> referencedBy;
+	map<YulString, YulString> storage;
+	map<YulString, YulString> memory;
 	m_value.swap(value);
 	m_references.swap(references);
 	m_referencedBy.swap(referencedBy);
+	m_storage.swap(storage);
+	m_memory.swap(memory);
 	pushScope(true);
 
 	for (auto const& parameter: _fun.parameters)
@@ -108,6 +190,8 @@ void DataFlowAnalyzer::operator()(FunctionDefinition& _fun)
 	m_value.swap(value);
 	m_references.swap(references);
 	m_referencedBy.swap(referencedBy);
+	m_storage.swap(storage);
+	m_memory.swap(memory);
 }
 
 void DataFlowAnalyzer::operator()(ForLoop& _for)
@@ -122,10 +206,23 @@ void DataFlowAnalyzer::operator()(ForLoop& _for)
 	assignments(_for.post);
 	clearValues(assignments.names());
 
+	// The knowledge that is valid at the start of the loop is also valid at the start of
+	// each iteration and after the loop.
+	clearKnowledgeIfInvalidated(*_for.condition);
+	clearKnowledgeIfInvalidated(_for.post);
+	clearKnowledgeIfInvalidated(_for.body);
+	map<YulString, YulString> storage = m_storage;
+	map<YulString, YulString> memory = m_memory;
+
 	visit(*_for.condition);
 	(*this)(_for.body);
+	// The post block can also be reached via continue.
+	m_storage = storage;
+	m_memory = memory;
 	(*this)(_for.post);
 
+	m_storage = move(storage);
+	m_memory = move(memory);
 	clearValues(assignments.names());
 	popScope();
 }
@@ -141,7 +238,7 @@ void DataFlowAnalyzer::operator()(Block& _block)
 
 void DataFlowAnalyzer::handleAssignment(set<YulString> const& _variables, Expression* _value)
 {
-	static Expression const zero{Literal{{}, LiteralKind::Number, YulString{"0"}, {}}};
+	thread_local Expression const zero{Literal{{}, LiteralKind::Number, YulString{"0"}, {}}};
 	clearValues(_variables);
 
 	MovableChecker movableChecker{m_dialect};
@@ -167,6 +264,23 @@ void DataFlowAnalyzer::handleAssignment(set<YulString> const& _variables, Expres
 		for (auto const& ref: referencedVariables)
 			m_referencedBy[ref].emplace(name);
 	}
+
+	// Record the value of the slot a single variable was loaded from.
+	if (_value && _variables.size() == 1 && _value->type() == typeid(FunctionalInstruction))
+	{
+		FunctionalInstruction const& instruction = boost::get<FunctionalInstruction>(*_value);
+		YulString name = *_variables.begin();
+		if (instruction.arguments.size() == 1 && instruction.arguments.front().type() == typeid(Identifier))
+		{
+			YulString key = boost::get<Identifier>(instruction.arguments.front()).name;
+			if (key == name)
+				return;
+			if (instruction.instruction == solidity::Instruction::SLOAD)
+				m_storage[key] = name;
+			else if (instruction.instruction == solidity::Instruction::MLOAD)
+				m_memory[key] = name;
+		}
+	}
 }
 
 void DataFlowAnalyzer::pushScope(bool _functionScope)
@@ -182,6 +296,19 @@ void DataFlowAnalyzer::popScope()
 
 void DataFlowAnalyzer::clearValues(set<YulString> _variables)
 {
+	// Knowledge about storage and memory only depends on the current values of the
+	// variables themselves.
+	auto eraseReferences = [&](map<YulString, YulString>& _content)
+	{
+		for (auto it = _content.begin(); it != _content.end();)
+			if (_variables.count(it->first) || _variables.count(it->second))
+				it = _content.erase(it);
+			else
+				++it;
+	};
+	eraseReferences(m_storage);
+	eraseReferences(m_memory);
+
 	// All variables that reference variables to be cleared also have to be
 	// cleared, but not recursively, since only the value of the original
 	// variables changes. Example:
@@ -222,3 +349,72 @@ bool DataFlowAnalyzer::inScope(YulString _variableName) const
 	}
 	return false;
 }
+
+void DataFlowAnalyzer::clearKnowledgeIfInvalidated(Expression const& _expression)
+{
+	SideEffectsCollector sideEffects(m_dialect, _expression);
+	if (sideEffects.invalidatesStorage())
+		m_storage.clear();
+	if (sideEffects.invalidatesMemory())
+		m_memory.clear();
+}
+
+void DataFlowAnalyzer::clearKnowledgeIfInvalidated(Block const& _block)
+{
+	SideEffectsCollector sideEffects(m_dialect, _block);
+	if (sideEffects.invalidatesStorage())
+		m_storage.clear();
+	if (sideEffects.invalidatesMemory())
+		m_memory.clear();
+}
+
+void DataFlowAnalyzer::joinKnowledge(
+	map<YulString, YulString> const& _storage,
+	map<YulString, YulString> const& _memory
+)
+{
+	auto intersect = [](map<YulString, YulString>& _content, map<YulString, YulString> const& _other)
+	{
+		for (auto it = _content.begin(); it != _content.end();)
+			if (_other.count(it->first) && _other.at(it->first) == it->second)
+				++it;
+			else
+				it = _content.erase(it);
+	};
+	intersect(m_storage, _storage);
+	intersect(m_memory, _memory);
+}
+
+bool DataFlowAnalyzer::knownToBeDifferent(YulString _a, YulString _b) const
+{
+	boost::optional<u256> a = knownNumber(m_value, _a);
+	boost::optional<u256> b = knownNumber(m_value, _b);
+	return a && b && *a != *b;
+}
+
+bool DataFlowAnalyzer::knownToBeDifferentByAtLeast32(YulString _a, YulString _b) const
+{
+	boost::optional<u256> a = knownNumber(m_value, _a);
+	boost::optional<u256> b = knownNumber(m_value, _b);
+	if (!a || !b)
+		return false;
+	u256 difference = *a - *b;
+	return difference >= 32 && difference <= u256(0) - 32;
+}
+
+boost::optional<pair<YulString, YulString>> DataFlowAnalyzer::isSimpleStore(
+	solidity::Instruction _store,
+	ExpressionStatement const& _statement
+) const
+{
+	if (_statement.expression.type() != typeid(FunctionalInstruction))
+		return {};
+	FunctionalInstruction const& instruction = boost::get<FunctionalInstruction>(_statement.expression);
+	if (instruction.instruction != _store)
+		return {};
+	Expression const& key = instruction.arguments.at(0);
+	Expression const& value = instruction.arguments.at(1);
+	if (key.type() != typeid(Identifier) || value.type() != typeid(Identifier))
+		return {};
+	return make_pair(boost::get<Identifier>(key).name, boost::get<Identifier>(value).name);
+}
@@ -25,6 +25,10 @@
 #include <libyul/optimiser/ASTWalker.h>
 #include <libyul/YulString.h>
 
+#include <libevmasm/Instruction.h>
+
+#include <boost/optional.hpp>
+
 #include <map>
 #include <set>
 
@@ -39,6 +43,11 @@ struct Dialect;
  *
  * A special zero constant expression is used for the default value of variables.
  *
+ * It also tracks the contents of storage and memory slots that are known to be equal to
+ * variables, i.e. after ``sstore(a, b)``, ``mstore(a, b)``, ``let b := sload(a)`` or
+ * ``let b := mload(a)``. This knowledge is removed as soon as storage or memory might be
+ * modified otherwise or one of the variables is re-assigned.
+ *
  * Prerequisite: Disambiguator
  */
 class DataFlowAnalyzer: public ASTModifier
@@ -47,6 +56,7 @@ public:
 	explicit DataFlowAnalyzer(Dialect const& _dialect): m_dialect(_dialect) {}
 
 	using ASTModifier::operator();
+	void operator()(ExpressionStatement& _statement) override;
 	void operator()(Assignment& _assignment) override;
 	void operator()(VariableDeclaration& _varDecl) override;
 	void operator()(If& _if) override;
@@ -72,12 +82,39 @@ protected:
 	/// Returns true iff the variable is in scope.
 	bool inScope(YulString _variableName) const;
 
+	/// Clears knowledge about storage or memory if they may be modified inside the expression.
+	void clearKnowledgeIfInvalidated(Expression const& _expression);
+	/// Clears knowledge about storage or memory if they may be modified inside the block.
+	void clearKnowledgeIfInvalidated(Block const& _block);
+	/// Retains only the knowledge about storage and memory that is also present in
+	/// @a _storage and @a _memory, for example at points where control flow is merged.
+	void joinKnowledge(
+		std::map<YulString, YulString> const& _storage,
+		std::map<YulString, YulString> const& _memory
+	);
+
+	/// @returns true if the values of the two variables are known to be different.
+	bool knownToBeDifferent(YulString _a, YulString _b) const;
+	/// @returns true if the values of the two variables are known to differ by at least 32.
+	bool knownToBeDifferentByAtLeast32(YulString _a, YulString _b) const;
+
+	/// @returns the names of the key and value variable if the statement is a call to
+	/// @a _store (``sstore`` or ``mstore``) with two variables as arguments.
+	boost::optional<std::pair<YulString, YulString>> isSimpleStore(
+		dev::solidity::Instruction _store,
+		ExpressionStatement const& _statement
+	) const;
+
 	/// Current values of variables, always movable.
 	std::map<YulString, Expression const*> m_value;
 	/// m_references[a].contains(b) <=> the current expression assigned to a references b
 	std::map<YulString, std::set<YulString>> m_references;
 	/// m_referencedBy[b].contains(a) <=> the current expression assigned to a references b
 	std::map<YulString, std::set<YulString>> m_referencedBy;
+	/// m_storage[a] == b <=> storage slot a (the value of variable a) contains the value of b
+	std::map<YulString, YulString> m_storage;
+	/// m_memory[a] == b <=> the 32 bytes of memory at offset a contain the value of b
+	std::map<YulString, YulString> m_memory;
 
 	struct Scope
 	{
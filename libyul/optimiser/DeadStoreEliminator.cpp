@@ -0,0 +1,171 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Optimisation stage that removes stores to storage and memory that are overwritten.
+ */
+
+#include <libyul/optimiser/DeadStoreEliminator.h>
+
+#include <libyul/optimiser/Semantics.h>
+#include <libyul/optimiser/SyntacticalEquality.h>
+#include <libyul/Exceptions.h>
+#include <libyul/AsmData.h>
+
+using namespace std;
+using namespace dev;
+using namespace yul;
+
+namespace
+{
+
+/// @returns the store instruction if @a _statement is a call to @a _store with
+/// identifiers or literals as arguments.
+FunctionalInstruction const* simpleStore(Statement const& _statement, solidity::Instruction _store)
+{
+	if (_statement.type() != typeid(ExpressionStatement))
+		return nullptr;
+	Expression const& expression = boost::get<ExpressionStatement>(_statement).expression;
+	if (expression.type() != typeid(FunctionalInstruction))
+		return nullptr;
+	FunctionalInstruction const& instruction = boost::get<FunctionalInstruction>(expression);
+	if (instruction.instruction != _store)
+		return nullptr;
+	for (auto const& argument: instruction.arguments)
+		if (argument.type() != typeid(Identifier) && argument.type() != typeid(Literal))
+			return nullptr;
+	return &instruction;
+}
+
+/// Specific AST walker that determines whether an expression contains ``mload``.
+class MemoryReadChecker: public ASTWalker
+{
+public:
+	explicit MemoryReadChecker(Expression const& _expression) { visit(_expression); }
+
+	using ASTWalker::operator();
+	void operator()(FunctionalInstruction const& _instr) override
+	{
+		ASTWalker::operator()(_instr);
+		if (_instr.instruction == solidity::Instruction::MLOAD)
+			m_readsMemory = true;
+	}
+
+	bool readsMemory() const { return m_readsMemory; }
+
+private:
+	bool m_readsMemory = false;
+};
+
+}
+
+void DeadStoreEliminator::run(Dialect const& _dialect, Block& _ast)
+{
+	DeadStoreEliminator{_dialect}(_ast);
+}
+
+void DeadStoreEliminator::operator()(Block& _block)
+{
+	ASTModifier::operator()(_block);
+
+	vector<Statement>& statements = _block.statements;
+	vector<bool> overwritten(statements.size(), false);
+	bool modified = false;
+	for (size_t i = 0; i < statements.size(); ++i)
+		if (
+			isOverwritten(statements, i, solidity::Instruction::SSTORE) ||
+			isOverwritten(statements, i, solidity::Instruction::MSTORE)
+		)
+			modified = overwritten[i] = true;
+	if (!modified)
+		return;
+
+	vector<Statement> remaining;
+	for (size_t i = 0; i < statements.size(); ++i)
+		if (!overwritten[i])
+			remaining.emplace_back(std::move(statements[i]));
+	statements = std::move(remaining);
+}
+
+bool DeadStoreEliminator::isOverwritten(
+	vector<Statement> const& _statements,
+	size_t _index,
+	solidity::Instruction _store
+) const
+{
+	FunctionalInstruction const* store = simpleStore(_statements[_index], _store);
+	if (!store)
+		return false;
+	bool memory = _store == solidity::Instruction::MSTORE;
+	Expression const& key = store->arguments.at(0);
+
+	for (size_t i = _index + 1; i < _statements.size(); ++i)
+	{
+		Statement const& statement = _statements[i];
+		if (!isTransparent(statement, key, memory))
+			return false;
+		if (FunctionalInstruction const* laterStore = simpleStore(statement, _store))
+			if (SyntacticallyEqual{}(key, laterStore->arguments.at(0)))
+				return true;
+	}
+	return false;
+}
+
+bool DeadStoreEliminator::isTransparent(Statement const& _statement, Expression const& _key, bool _memory) const
+{
+	if (_statement.type() == typeid(VariableDeclaration))
+	{
+		VariableDeclaration const& varDecl = boost::get<VariableDeclaration>(_statement);
+		return !varDecl.value || isTransparent(*varDecl.value, _memory);
+	}
+	else if (_statement.type() == typeid(Assignment))
+	{
+		Assignment const& assignment = boost::get<Assignment>(_statement);
+		if (_key.type() == typeid(Identifier))
+			for (auto const& var: assignment.variableNames)
+				if (var.name == boost::get<Identifier>(_key).name)
+					return false;
+		return isTransparent(*assignment.value, _memory);
+	}
+	else if (_statement.type() == typeid(ExpressionStatement))
+	{
+		Expression const& expression = boost::get<ExpressionStatement>(_statement).expression;
+		if (expression.type() == typeid(FunctionalInstruction))
+		{
+			FunctionalInstruction const& instruction = boost::get<FunctionalInstruction>(expression);
+			if (
+				instruction.instruction == solidity::Instruction::SSTORE ||
+				instruction.instruction == solidity::Instruction::MSTORE ||
+				instruction.instruction == solidity::Instruction::MSTORE8
+			)
+			{
+				for (auto const& argument: instruction.arguments)
+					if (!isTransparent(argument, _memory))
+						return false;
+				return true;
+			}
+		}
+		return isTransparent(expression, _memory);
+	}
+	return false;
+}
+
+bool DeadStoreEliminator::isTransparent(Expression const& _expression, bool _memory) const
+{
+	if (!MovableChecker{m_dialect, _expression}.movable())
+		return false;
+	return !_memory || !MemoryReadChecker{_expression}.readsMemory();
+}
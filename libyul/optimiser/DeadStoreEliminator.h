@@ -0,0 +1,76 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Optimisation stage that removes stores to storage and memory that are overwritten.
+ */
+
+#pragma once
+
+#include <libyul/optimiser/ASTWalker.h>
+
+#include <libevmasm/Instruction.h>
+
+namespace yul
+{
+
+struct Dialect;
+
+/**
+ * Optimisation stage that removes stores to storage and memory that are overwritten
+ * before they can be observed.
+ *
+ * A statement ``sstore(k, v)`` (resp. ``mstore(k, v)``) where ``k`` and ``v`` are
+ * identifiers or literals is removed if it is followed in the same block by another
+ * ``sstore`` (resp. ``mstore``) to the syntactically same location and all statements
+ * in between (and the arguments of the later store) are
+ *  - variable declarations, assignments or expression statements with movable expressions
+ *    or
+ *  - calls to ``sstore``, ``mstore`` or ``mstore8`` with movable arguments
+ * that do not read from memory in the case of ``mstore`` and do not assign to ``k``.
+ *
+ * Works best if the code is in SSA form and the ExpressionSplitter has been run.
+ *
+ * Prerequisite: Disambiguator
+ */
+class DeadStoreEliminator: public ASTModifier
+{
+public:
+	static void run(Dialect const& _dialect, Block& _ast);
+
+	using ASTModifier::operator();
+	void operator()(Block& _block) override;
+
+private:
+	explicit DeadStoreEliminator(Dialect const& _dialect): m_dialect(_dialect) {}
+
+	/// @returns true if the statement at @a _index is a store of type @a _store
+	/// which is overwritten by a later statement in the same block.
+	bool isOverwritten(
+		std::vector<Statement> const& _statements,
+		size_t _index,
+		dev::solidity::Instruction _store
+	) const;
+	/// @returns true if the statement can be executed between the two stores without
+	/// observing the first and without changing the location referred to by @a _key.
+	bool isTransparent(Statement const& _statement, Expression const& _key, bool _memory) const;
+	/// @returns true if the expression is movable and does not read from memory if @a _memory is true.
+	bool isTransparent(Expression const& _expression, bool _memory) const;
+
+	Dialect const& m_dialect;
+};
+
+}
@@ -0,0 +1,92 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Optimisation stage that replaces loads from storage and memory by known values.
+ */
+
+#include <libyul/optimiser/LoadResolver.h>
+
+#include <libyul/Exceptions.h>
+#include <libyul/AsmData.h>
+
+#include <libdevcore/CommonData.h>
+
+using namespace std;
+using namespace dev;
+using namespace yul;
+
+void LoadResolver::run(Dialect const& _dialect, Block& _ast)
+{
+	LoadResolver{_dialect}(_ast);
+}
+
+void LoadResolver::visit(Expression& _e)
+{
+	DataFlowAnalyzer::visit(_e);
+
+	if (_e.type() != typeid(FunctionalInstruction))
+		return;
+	FunctionalInstruction const& instruction = boost::get<FunctionalInstruction>(_e);
+	if (instruction.arguments.size() != 1 || instruction.arguments.front().type() != typeid(Identifier))
+		return;
+	YulString key = boost::get<Identifier>(instruction.arguments.front()).name;
+
+	map<YulString, YulString> const* content = nullptr;
+	if (instruction.instruction == solidity::Instruction::SLOAD)
+		content = &m_storage;
+	else if (instruction.instruction == solidity::Instruction::MLOAD)
+		content = &m_memory;
+	else
+		return;
+
+	auto it = content->find(key);
+	if (it != content->end())
+	{
+		assertThrow(inScope(it->second), OptimizerException, "");
+		_e = Identifier{instruction.location, it->second};
+	}
+}
+
+void LoadResolver::operator()(Block& _block)
+{
+	size_t numScopes = m_variableScopes.size();
+	pushScope(false);
+	iterateReplacing(
+		_block.statements,
+		[&](Statement& _statement) -> boost::optional<vector<Statement>>
+		{
+			if (
+				_statement.type() == typeid(ExpressionStatement) &&
+				isRedundantStore(boost::get<ExpressionStatement>(_statement))
+			)
+				return vector<Statement>{};
+			visit(_statement);
+			return {};
+		}
+	);
+	popScope();
+	assertThrow(numScopes == m_variableScopes.size(), OptimizerException, "");
+}
+
+bool LoadResolver::isRedundantStore(ExpressionStatement const& _statement) const
+{
+	if (auto vars = isSimpleStore(solidity::Instruction::SSTORE, _statement))
+		return m_storage.count(vars->first) && m_storage.at(vars->first) == vars->second;
+	if (auto vars = isSimpleStore(solidity::Instruction::MSTORE, _statement))
+		return m_memory.count(vars->first) && m_memory.at(vars->first) == vars->second;
+	return false;
+}
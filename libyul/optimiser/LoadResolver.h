@@ -0,0 +1,61 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Optimisation stage that replaces loads from storage and memory by known values.
+ */
+
+#pragma once
+
+#include <libyul/optimiser/DataFlowAnalyzer.h>
+
+namespace yul
+{
+
+struct Dialect;
+
+/**
+ * Optimisation stage that replaces expressions of type ``sload(x)`` and ``mload(x)`` by the value
+ * currently stored in storage resp. memory, if known. It also removes stores of values
+ * that are already known to be present at the respective location.
+ *
+ * Example: ``mstore(x, y) let a := mload(x) sstore(z, a)`` is turned into
+ * ``mstore(x, y) let a := y sstore(z, y)``.
+ *
+ * Works best if the code is in SSA form and the ExpressionSplitter has been run.
+ *
+ * Prerequisite: Disambiguator, ForLoopInitRewriter
+ */
+class LoadResolver: public DataFlowAnalyzer
+{
+public:
+	static void run(Dialect const& _dialect, Block& _ast);
+
+protected:
+	explicit LoadResolver(Dialect const& _dialect): DataFlowAnalyzer(_dialect) {}
+
+	using ASTModifier::visit;
+	void visit(Expression& _e) override;
+
+	using DataFlowAnalyzer::operator();
+	void operator()(Block& _block) override;
+
+	/// @returns true if the statement stores a value to a location that is already
+	/// known to contain this value.
+	bool isRedundantStore(ExpressionStatement const& _statement) const;
+};
+
+}
@@ -52,10 +52,21 @@ size_t CodeSize::codeSize(Block const& _block)
 	return cs.m_size;
 }
 
+size_t CodeSize::codeSizeIncludingFunctions(Block const& _block)
+{
+	CodeSize cs(false);
+	cs(_block);
+	return cs.m_size;
+}
+
 void CodeSize::visit(Statement const& _statement)
 {
 	if (_statement.type() == typeid(FunctionDefinition))
+	{
+		if (!m_ignoreFunctions)
+			ASTWalker::visit(_statement);
 		return;
+	}
 	else if (!(
 		_statement.type() == typeid(Block) ||
 		_statement.type() == typeid(ExpressionStatement) ||
@@ -82,6 +93,13 @@ size_t CodeCost::codeCost(Expression const& _expr)
 	return cc.m_cost;
 }
 
+size_t CodeCost::codeCost(Block const& _block)
+{
+	CodeCost cc;
+	cc(_block);
+	return cc.m_cost;
+}
+
 
 void CodeCost::operator()(FunctionCall const& _funCall)
 {
@@ -134,3 +152,22 @@ void CodeCost::visit(Expression const& _expression)
 	++m_cost;
 	ASTWalker::visit(_expression);
 }
+
+size_t NodeCount::nodeCount(Block const& _block)
+{
+	NodeCount nc;
+	nc(_block);
+	return nc.m_count;
+}
+
+void NodeCount::visit(Statement const& _statement)
+{
+	++m_count;
+	ASTWalker::visit(_statement);
+}
+
+void NodeCount::visit(Expression const& _expression)
+{
+	++m_count;
+	ASTWalker::visit(_expression);
+}
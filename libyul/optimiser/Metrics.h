@@ -29,7 +29,8 @@ namespace yul
  * Metric for the size of code.
  * More specifically, the number of AST nodes.
  * Ignores function definitions while traversing the AST.
- * If you want to know the size of a function, you have to invoke this on its body.
+ * If you want to know the size of a function, you have to invoke this on its body
+ * (or use codeSizeIncludingFunctions to get the size of the whole AST).
  *
  * As an exception, the following AST elements have a cost of zero:
  *  - expression statement (only the expression inside has a cost)
@@ -44,14 +45,17 @@ public:
 	static size_t codeSize(Statement const& _statement);
 	static size_t codeSize(Expression const& _expression);
 	static size_t codeSize(Block const& _block);
+	/// @returns the size of the block including the bodies of all function definitions.
+	static size_t codeSizeIncludingFunctions(Block const& _block);
 
 private:
-	CodeSize() {}
+	CodeSize(bool _ignoreFunctions = true): m_ignoreFunctions(_ignoreFunctions) {}
 
 	void visit(Statement const& _statement) override;
 	void visit(Expression const& _expression) override;
 
 private:
+	bool m_ignoreFunctions;
 	size_t m_size = 0;
 };
 
@@ -65,8 +69,10 @@ class CodeCost: public ASTWalker
 {
 public:
 	static size_t codeCost(Expression const& _expression);
+	static size_t codeCost(Block const& _block);
 
 private:
+	using ASTWalker::operator();
 	void operator()(FunctionCall const& _funCall) override;
 	void operator()(FunctionalInstruction const& _instr) override;
 	void operator()(Literal const& _literal) override;
@@ -77,4 +83,21 @@ private:
 	size_t m_cost = 0;
 };
 
+/**
+ * Total number of statements and expressions, including identifiers,
+ * blocks and the contents of function definitions.
+ */
+class NodeCount: public ASTWalker
+{
+public:
+	static size_t nodeCount(Block const& _block);
+
+private:
+	void visit(Statement const& _statement) override;
+	void visit(Expression const& _expression) override;
+
+private:
+	size_t m_count = 0;
+};
+
 }
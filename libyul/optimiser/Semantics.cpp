@@ -72,3 +72,36 @@ void MovableChecker::visit(Statement const&)
 {
 	assertThrow(false, OptimizerException, "Movability for statement requested.");
 }
+
+SideEffectsCollector::SideEffectsCollector(Dialect const& _dialect, Expression const& _expression):
+	SideEffectsCollector(_dialect)
+{
+	visit(_expression);
+}
+
+SideEffectsCollector::SideEffectsCollector(Dialect const& _dialect, Block const& _block):
+	SideEffectsCollector(_dialect)
+{
+	(*this)(_block);
+}
+
+void SideEffectsCollector::operator()(FunctionalInstruction const& _instr)
+{
+	ASTWalker::operator()(_instr);
+
+	if (eth::SemanticInformation::invalidatesStorage(_instr.instruction))
+		m_invalidatesStorage = true;
+	if (eth::SemanticInformation::invalidatesMemory(_instr.instruction))
+		m_invalidatesMemory = true;
+}
+
+void SideEffectsCollector::operator()(FunctionCall const& _functionCall)
+{
+	ASTWalker::operator()(_functionCall);
+
+	if (BuiltinFunction const* f = m_dialect.builtin(_functionCall.functionName.name))
+		if (f->movable)
+			return;
+	m_invalidatesStorage = true;
+	m_invalidatesMemory = true;
+}
@@ -56,4 +56,30 @@ private:
 	bool m_movable = true;
 };
 
+/**
+ * Specific AST walker that determines whether an expression or a piece of code can modify
+ * storage or memory. Calls to functions that are not movable builtins are assumed to
+ * modify both. Function definitions are not visited.
+ */
+class SideEffectsCollector: public ASTWalker
+{
+public:
+	explicit SideEffectsCollector(Dialect const& _dialect): m_dialect(_dialect) {}
+	SideEffectsCollector(Dialect const& _dialect, Expression const& _expression);
+	SideEffectsCollector(Dialect const& _dialect, Block const& _block);
+
+	using ASTWalker::operator();
+	void operator()(FunctionalInstruction const& _functionalInstruction) override;
+	void operator()(FunctionCall const& _functionCall) override;
+	void operator()(FunctionDefinition const&) override {}
+
+	bool invalidatesStorage() const { return m_invalidatesStorage; }
+	bool invalidatesMemory() const { return m_invalidatesMemory; }
+
+private:
+	Dialect const& m_dialect;
+	bool m_invalidatesStorage = false;
+	bool m_invalidatesMemory = false;
+};
+
 }
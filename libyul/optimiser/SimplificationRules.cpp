@@ -43,7 +43,7 @@ SimplificationRule<Pattern> const* SimplificationRules::findFirstMatch(
 	if (_expr.type() != typeid(FunctionalInstruction))
 		return nullptr;
 
-	static SimplificationRules rules;
+	thread_local SimplificationRules rules;
 	assertThrow(rules.isInitialized(), OptimizerException, "Rule list not properly initialized.");
 
 	FunctionalInstruction const& instruction = boost::get<FunctionalInstruction>(_expr);
@@ -120,7 +120,7 @@ bool StructuralSimplifier::expressionAlwaysTrue(Expression const& _expression)
 			return false;
 		},
 		[](Literal const& _literal) -> bool {
-			static YulString const trueString("true");
+			thread_local YulString const trueString("true");
 			return
 				(_literal.kind == LiteralKind::Boolean && _literal.value == trueString) ||
 				(_literal.kind == LiteralKind::Number && valueOfNumberLiteral(_literal) != u256(0))
@@ -138,7 +138,7 @@ bool StructuralSimplifier::expressionAlwaysFalse(Expression const& _expression)
 			return false;
 		},
 		[](Literal const& _literal) -> bool {
-			static YulString const falseString("false");
+			thread_local YulString const falseString("false");
 			return
 				(_literal.kind == LiteralKind::Boolean && _literal.value == falseString) ||
 				(_literal.kind == LiteralKind::Number && valueOfNumberLiteral(_literal) == u256(0))
@@ -32,6 +32,8 @@
 #include <libyul/optimiser/FullInliner.h>
 #include <libyul/optimiser/ForLoopInitRewriter.h>
 #include <libyul/optimiser/Rematerialiser.h>
+#include <libyul/optimiser/LoadResolver.h>
+#include <libyul/optimiser/DeadStoreEliminator.h>
 #include <libyul/optimiser/UnusedPruner.h>
 #include <libyul/optimiser/ExpressionSimplifier.h>
 #include <libyul/optimiser/CommonSubexpressionEliminator.h>
@@ -44,6 +46,8 @@
 
 #include <libdevcore/CommonData.h>
 
+#include <functional>
+
 using namespace std;
 using namespace dev;
 using namespace yul;
@@ -52,84 +56,97 @@ void OptimiserSuite::run(
 	Dialect const& _dialect,
 	Block& _ast,
 	AsmAnalysisInfo const& _analysisInfo,
-	set<YulString> const& _externallyUsedIdentifiers
+	set<YulString> const& _externallyUsedIdentifiers,
+	OptimiserStepObserver* _observer
 )
 {
 	set<YulString> reservedIdentifiers = _externallyUsedIdentifiers;
 
 	Block ast = boost::get<Block>(Disambiguator(_dialect, _analysisInfo, reservedIdentifiers)(_ast));
 
-	(VarDeclInitializer{})(ast);
-	(FunctionHoister{})(ast);
-	(BlockFlattener{})(ast);
-	(FunctionGrouper{})(ast);
-	EquivalentFunctionCombiner::run(ast);
-	UnusedPruner::runUntilStabilised(_dialect, ast, reservedIdentifiers);
-	(ForLoopInitRewriter{})(ast);
-	(BlockFlattener{})(ast);
-	StructuralSimplifier{_dialect}(ast);
+	auto step = [&](string const& _name, function<void()> const& _step)
+	{
+		if (_observer)
+			_observer->beforeStep(_name, ast);
+		_step();
+		if (_observer)
+			_observer->afterStep(_name, ast);
+	};
+
+	step("VarDeclInitializer", [&]() { (VarDeclInitializer{})(ast); });
+	step("FunctionHoister", [&]() { (FunctionHoister{})(ast); });
+	step("BlockFlattener", [&]() { (BlockFlattener{})(ast); });
+	step("FunctionGrouper", [&]() { (FunctionGrouper{})(ast); });
+	step("EquivalentFunctionCombiner", [&]() { EquivalentFunctionCombiner::run(ast); });
+	step("UnusedPruner", [&]() { UnusedPruner::runUntilStabilised(_dialect, ast, reservedIdentifiers); });
+	step("ForLoopInitRewriter", [&]() { (ForLoopInitRewriter{})(ast); });
+	step("BlockFlattener", [&]() { (BlockFlattener{})(ast); });
+	step("StructuralSimplifier", [&]() { StructuralSimplifier{_dialect}(ast); });
 
 	NameDispenser dispenser{_dialect, ast};
 
 	for (size_t i = 0; i < 4; i++)
 	{
-		ExpressionSplitter{_dialect, dispenser}(ast);
-		SSATransform::run(ast, dispenser);
-		RedundantAssignEliminator::run(_dialect, ast);
-		RedundantAssignEliminator::run(_dialect, ast);
-
-		CommonSubexpressionEliminator{_dialect}(ast);
-		ExpressionSimplifier::run(_dialect, ast);
-		StructuralSimplifier{_dialect}(ast);
-		(BlockFlattener{})(ast);
-		SSATransform::run(ast, dispenser);
-		RedundantAssignEliminator::run(_dialect, ast);
-		RedundantAssignEliminator::run(_dialect, ast);
-		UnusedPruner::runUntilStabilised(_dialect, ast, reservedIdentifiers);
-		CommonSubexpressionEliminator{_dialect}(ast);
-		UnusedPruner::runUntilStabilised(_dialect, ast, reservedIdentifiers);
-		SSATransform::run(ast, dispenser);
-		RedundantAssignEliminator::run(_dialect, ast);
-		RedundantAssignEliminator::run(_dialect, ast);
-
-		ExpressionJoiner::run(ast);
-		ExpressionJoiner::run(ast);
-		ExpressionInliner(_dialect, ast).run();
-		UnusedPruner::runUntilStabilised(_dialect, ast);
-
-		ExpressionSplitter{_dialect, dispenser}(ast);
-		SSATransform::run(ast, dispenser);
-		RedundantAssignEliminator::run(_dialect, ast);
-		RedundantAssignEliminator::run(_dialect, ast);
-		CommonSubexpressionEliminator{_dialect}(ast);
-
-		(FunctionGrouper{})(ast);
-		EquivalentFunctionCombiner::run(ast);
-		FullInliner{ast, dispenser}.run();
-
-		SSATransform::run(ast, dispenser);
-		RedundantAssignEliminator::run(_dialect, ast);
-		RedundantAssignEliminator::run(_dialect, ast);
-		ExpressionSimplifier::run(_dialect, ast);
-		StructuralSimplifier{_dialect}(ast);
-		(BlockFlattener{})(ast);
-		CommonSubexpressionEliminator{_dialect}(ast);
-		SSATransform::run(ast, dispenser);
-		RedundantAssignEliminator::run(_dialect, ast);
-		RedundantAssignEliminator::run(_dialect, ast);
-		UnusedPruner::runUntilStabilised(_dialect, ast, reservedIdentifiers);
-		CommonSubexpressionEliminator{_dialect}(ast);
+		step("ExpressionSplitter", [&]() { ExpressionSplitter{_dialect, dispenser}(ast); });
+		step("SSATransform", [&]() { SSATransform::run(ast, dispenser); });
+		step("RedundantAssignEliminator", [&]() { RedundantAssignEliminator::run(_dialect, ast); });
+		step("RedundantAssignEliminator", [&]() { RedundantAssignEliminator::run(_dialect, ast); });
+
+		step("CommonSubexpressionEliminator", [&]() { CommonSubexpressionEliminator{_dialect}(ast); });
+		step("LoadResolver", [&]() { LoadResolver::run(_dialect, ast); });
+		step("DeadStoreEliminator", [&]() { DeadStoreEliminator::run(_dialect, ast); });
+		step("ExpressionSimplifier", [&]() { ExpressionSimplifier::run(_dialect, ast); });
+		step("StructuralSimplifier", [&]() { StructuralSimplifier{_dialect}(ast); });
+		step("BlockFlattener", [&]() { (BlockFlattener{})(ast); });
+		step("SSATransform", [&]() { SSATransform::run(ast, dispenser); });
+		step("RedundantAssignEliminator", [&]() { RedundantAssignEliminator::run(_dialect, ast); });
+		step("RedundantAssignEliminator", [&]() { RedundantAssignEliminator::run(_dialect, ast); });
+		step("UnusedPruner", [&]() { UnusedPruner::runUntilStabilised(_dialect, ast, reservedIdentifiers); });
+		step("CommonSubexpressionEliminator", [&]() { CommonSubexpressionEliminator{_dialect}(ast); });
+		step("UnusedPruner", [&]() { UnusedPruner::runUntilStabilised(_dialect, ast, reservedIdentifiers); });
+		step("SSATransform", [&]() { SSATransform::run(ast, dispenser); });
+		step("RedundantAssignEliminator", [&]() { RedundantAssignEliminator::run(_dialect, ast); });
+		step("RedundantAssignEliminator", [&]() { RedundantAssignEliminator::run(_dialect, ast); });
+
+		step("ExpressionJoiner", [&]() { ExpressionJoiner::run(ast); });
+		step("ExpressionJoiner", [&]() { ExpressionJoiner::run(ast); });
+		step("ExpressionInliner", [&]() { ExpressionInliner(_dialect, ast).run(); });
+		step("UnusedPruner", [&]() { UnusedPruner::runUntilStabilised(_dialect, ast); });
+
+		step("ExpressionSplitter", [&]() { ExpressionSplitter{_dialect, dispenser}(ast); });
+		step("SSATransform", [&]() { SSATransform::run(ast, dispenser); });
+		step("RedundantAssignEliminator", [&]() { RedundantAssignEliminator::run(_dialect, ast); });
+		step("RedundantAssignEliminator", [&]() { RedundantAssignEliminator::run(_dialect, ast); });
+		step("CommonSubexpressionEliminator", [&]() { CommonSubexpressionEliminator{_dialect}(ast); });
+
+		step("FunctionGrouper", [&]() { (FunctionGrouper{})(ast); });
+		step("EquivalentFunctionCombiner", [&]() { EquivalentFunctionCombiner::run(ast); });
+		step("FullInliner", [&]() { FullInliner{ast, dispenser}.run(); });
+
+		step("SSATransform", [&]() { SSATransform::run(ast, dispenser); });
+		step("RedundantAssignEliminator", [&]() { RedundantAssignEliminator::run(_dialect, ast); });
+		step("RedundantAssignEliminator", [&]() { RedundantAssignEliminator::run(_dialect, ast); });
+		step("ExpressionSimplifier", [&]() { ExpressionSimplifier::run(_dialect, ast); });
+		step("StructuralSimplifier", [&]() { StructuralSimplifier{_dialect}(ast); });
+		step("BlockFlattener", [&]() { (BlockFlattener{})(ast); });
+		step("CommonSubexpressionEliminator", [&]() { CommonSubexpressionEliminator{_dialect}(ast); });
+		step("LoadResolver", [&]() { LoadResolver::run(_dialect, ast); });
+		step("SSATransform", [&]() { SSATransform::run(ast, dispenser); });
+		step("RedundantAssignEliminator", [&]() { RedundantAssignEliminator::run(_dialect, ast); });
+		step("RedundantAssignEliminator", [&]() { RedundantAssignEliminator::run(_dialect, ast); });
+		step("UnusedPruner", [&]() { UnusedPruner::runUntilStabilised(_dialect, ast, reservedIdentifiers); });
+		step("CommonSubexpressionEliminator", [&]() { CommonSubexpressionEliminator{_dialect}(ast); });
 	}
-	ExpressionJoiner::run(ast);
-	Rematerialiser::run(_dialect, ast);
-	UnusedPruner::runUntilStabilised(_dialect, ast);
-	ExpressionJoiner::run(ast);
-	UnusedPruner::runUntilStabilised(_dialect, ast);
-	ExpressionJoiner::run(ast);
-	UnusedPruner::runUntilStabilised(_dialect, ast);
-	ExpressionJoiner::run(ast);
-	Rematerialiser::run(_dialect, ast);
-	UnusedPruner::runUntilStabilised(_dialect, ast);
+	step("ExpressionJoiner", [&]() { ExpressionJoiner::run(ast); });
+	step("Rematerialiser", [&]() { Rematerialiser::run(_dialect, ast); });
+	step("UnusedPruner", [&]() { UnusedPruner::runUntilStabilised(_dialect, ast); });
+	step("ExpressionJoiner", [&]() { ExpressionJoiner::run(ast); });
+	step("UnusedPruner", [&]() { UnusedPruner::runUntilStabilised(_dialect, ast); });
+	step("ExpressionJoiner", [&]() { ExpressionJoiner::run(ast); });
+	step("UnusedPruner", [&]() { UnusedPruner::runUntilStabilised(_dialect, ast); });
+	step("ExpressionJoiner", [&]() { ExpressionJoiner::run(ast); });
+	step("Rematerialiser", [&]() { Rematerialiser::run(_dialect, ast); });
+	step("UnusedPruner", [&]() { UnusedPruner::runUntilStabilised(_dialect, ast); });
 
 	_ast = std::move(ast);
 }
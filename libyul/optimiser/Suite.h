@@ -24,6 +24,7 @@
 #include <libyul/YulString.h>
 
 #include <set>
+#include <string>
 
 namespace yul
 {
@@ -31,6 +32,20 @@ namespace yul
 struct AsmAnalysisInfo;
 struct Dialect;
 
+/**
+ * Interface to observe the individual steps performed by the optimiser suite,
+ * for example to collect statistics about them.
+ */
+class OptimiserStepObserver
+{
+public:
+	virtual ~OptimiserStepObserver() = default;
+	/// Called right before the step @a _name is applied to @a _ast.
+	virtual void beforeStep(std::string const& _name, Block const& _ast) = 0;
+	/// Called right after the step @a _name was applied to @a _ast.
+	virtual void afterStep(std::string const& _name, Block const& _ast) = 0;
+};
+
 /**
  * Optimiser suite that combines all steps and also provides the settings for the heuristics
  */
@@ -41,7 +56,8 @@ public:
 		Dialect const& _dialect,
 		Block& _ast,
 		AsmAnalysisInfo const& _analysisInfo,
-		std::set<YulString> const& _externallyUsedIdentifiers = {}
+		std::set<YulString> const& _externallyUsedIdentifiers = {},
+		OptimiserStepObserver* _observer = nullptr
 	);
 };
 
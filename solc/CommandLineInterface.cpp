@@ -30,6 +30,7 @@
 #include <libsolidity/parsing/Parser.h>
 #include <libsolidity/ast/ASTPrinter.h>
 #include <libsolidity/ast/ASTJsonConverter.h>
+#include <libsolidity/ast/ASTBinary.h>
 #include <libsolidity/analysis/NameAndTypeResolver.h>
 #include <liblangutil/Exceptions.h>
 #include <libsolidity/interface/CompilerStack.h>
@@ -45,6 +46,7 @@
 #include <libdevcore/CommonData.h>
 #include <libdevcore/CommonIO.h>
 #include <libdevcore/JSON.h>
+#include <libdevcore/ThreadPool.h>
 
 #include <boost/filesystem.hpp>
 #include <boost/filesystem/operations.hpp>
@@ -88,14 +90,20 @@ std::ostream& serr(bool _used = true)
 #define cout
 #define cerr
 
+/// Number of threads used to read source files. This is bound by the latency of the file
+/// system rather than by the number of CPUs.
+static unsigned const g_fileReadingThreads = 8;
+
 static string const g_stdinFileNameStr = "<stdin>";
 static string const g_strAbi = "abi";
 static string const g_strAllowPaths = "allow-paths";
+static string const g_strAnalysisThreads = "analysis-threads";
 static string const g_strAsm = "asm";
 static string const g_strAsmJson = "asm-json";
 static string const g_strAssemble = "assemble";
 static string const g_strAst = "ast";
 static string const g_strAstJson = "ast-json";
+static string const g_strAstBinary = "ast-binary";
 static string const g_strAstCompactJson = "ast-compact-json";
 static string const g_strBinary = "bin";
 static string const g_strBinaryRuntime = "bin-runtime";
@@ -110,6 +118,7 @@ static string const g_strGas = "gas";
 static string const g_strHelp = "help";
 static string const g_strInputFile = "input-file";
 static string const g_strInterface = "interface";
+static string const g_strIR = "ir";
 static string const g_strYul = "yul";
 static string const g_strLicense = "license";
 static string const g_strLibraries = "libraries";
@@ -133,17 +142,20 @@ static string const g_strStandardJSON = "standard-json";
 static string const g_strStrictAssembly = "strict-assembly";
 static string const g_strPrettyJson = "pretty-json";
 static string const g_strVersion = "version";
+static string const g_strViaIR = "via-ir";
 static string const g_strIgnoreMissingFiles = "ignore-missing";
 
 static string const g_argAbi = g_strAbi;
 static string const g_argPrettyJson = g_strPrettyJson;
 static string const g_argAllowPaths = g_strAllowPaths;
+static string const g_argAnalysisThreads = g_strAnalysisThreads;
 static string const g_argAsm = g_strAsm;
 static string const g_argAsmJson = g_strAsmJson;
 static string const g_argAssemble = g_strAssemble;
 static string const g_argAst = g_strAst;
 static string const g_argAstCompactJson = g_strAstCompactJson;
 static string const g_argAstJson = g_strAstJson;
+static string const g_argAstBinary = g_strAstBinary;
 static string const g_argBinary = g_strBinary;
 static string const g_argBinaryRuntime = g_strBinaryRuntime;
 static string const g_argCombinedJson = g_strCombinedJson;
@@ -151,6 +163,7 @@ static string const g_argCompactJSON = g_strCompactJSON;
 static string const g_argGas = g_strGas;
 static string const g_argHelp = g_strHelp;
 static string const g_argInputFile = g_strInputFile;
+static string const g_argIR = g_strIR;
 static string const g_argYul = g_strYul;
 static string const g_argLibraries = g_strLibraries;
 static string const g_argLink = g_strLink;
@@ -167,6 +180,7 @@ static string const g_argSignatureHashes = g_strSignatureHashes;
 static string const g_argStandardJSON = g_strStandardJSON;
 static string const g_argStrictAssembly = g_strStrictAssembly;
 static string const g_argVersion = g_strVersion;
+static string const g_argViaIR = g_strViaIR;
 static string const g_stdinFileName = g_stdinFileNameStr;
 static string const g_argIgnoreMissingFiles = g_strIgnoreMissingFiles;
 
@@ -229,6 +243,7 @@ static bool needsHumanTargetedStdout(po::variables_map const& _args)
 		g_argAstJson,
 		g_argBinary,
 		g_argBinaryRuntime,
+		g_argIR,
 		g_argMetadata,
 		g_argNatspecUser,
 		g_argNatspecDev,
@@ -312,6 +327,28 @@ void CommandLineInterface::handleMetadata(string const& _contract)
 		sout() << "Metadata: " << endl << data << endl;
 }
 
+void CommandLineInterface::handleIR(string const& _contract)
+{
+	if (!m_args.count(g_argIR))
+		return;
+
+	string data;
+	try
+	{
+		data = m_compiler->yulIR(_contract);
+	}
+	catch (UnimplementedFeatureError const& _exception)
+	{
+		serr() << "Unimplemented feature:" << endl
+			 << boost::diagnostic_information(_exception);
+		return;
+	}
+	if (m_args.count(g_argOutputDir))
+		createFile(m_compiler->filesystemFriendlyName(_contract) + ".yul", data);
+	else
+		sout() << "IR: " << endl << data << endl;
+}
+
 void CommandLineInterface::handleABI(string const& _contract)
 {
 	if (!m_args.count(g_argAbi))
@@ -406,6 +443,7 @@ bool CommandLineInterface::readInputFilesAndConfigureRemappings()
 {
 	bool ignoreMissing = m_args.count(g_argIgnoreMissingFiles);
 	bool addStdin = false;
+	vector<boost::filesystem::path> inputFiles;
 	if (m_args.count(g_argInputFile))
 		for (string path: m_args[g_argInputFile].as<vector<string>>())
 		{
@@ -454,11 +492,20 @@ bool CommandLineInterface::readInputFilesAndConfigureRemappings()
 					continue;
 				}
 
-				m_sourceCodes[infile.generic_string()] = dev::readFileAsString(infile.string());
+				inputFiles.push_back(infile);
 				path = boost::filesystem::canonical(infile).string();
 			}
 			m_allowedDirectories.push_back(boost::filesystem::path(path).remove_filename());
 		}
+	// The files are read concurrently, since each read mostly waits for the file system.
+	vector<string> contents(inputFiles.size());
+	{
+		ThreadPool pool(min<size_t>(g_fileReadingThreads, max<size_t>(inputFiles.size(), 1)));
+		for (size_t i = 0; i < inputFiles.size(); ++i)
+			pool.post([&, i]() { contents[i] = dev::readFileAsString(inputFiles[i].string()); });
+	}
+	for (size_t i = 0; i < inputFiles.size(); ++i)
+		m_sourceCodes[inputFiles[i].generic_string()] = move(contents[i]);
 	if (addStdin)
 		m_sourceCodes[g_stdinFileName] = dev::readStandardInput();
 	if (m_sourceCodes.size() == 0)
@@ -534,6 +581,11 @@ bool CommandLineInterface::parseLibraryOption(string const& _input)
 }
 
 void CommandLineInterface::createFile(string const& _fileName, string const& _data)
+{
+	createFile(_fileName, [&](ostream& _stream) { _stream << _data; });
+}
+
+void CommandLineInterface::createFile(string const& _fileName, function<void(ostream&)> const& _write)
 {
 	namespace fs = boost::filesystem;
 	// create directory if not existent
@@ -549,14 +601,14 @@ void CommandLineInterface::createFile(string const& _fileName, string const& _da
 		return;
 	}
 	ofstream outFile(pathName);
-	outFile << _data;
+	_write(outFile);
 	if (!outFile)
 		BOOST_THROW_EXCEPTION(FileError() << errinfo_comment("Could not write to file: " + pathName));
 }
 
-void CommandLineInterface::createJson(string const& _fileName, string const& _json)
+void CommandLineInterface::createJson(string const& _fileName, function<void(ostream&)> const& _write)
 {
-	createFile(boost::filesystem::basename(_fileName) + string(".json"), _json);
+	createFile(boost::filesystem::basename(_fileName) + string(".json"), _write);
 }
 
 bool CommandLineInterface::parseArguments(int _argc, char** _argv)
@@ -599,6 +651,16 @@ Allowed options)",
 			"Set for how many contract runs to optimize."
 			"Lower values will optimize more for initial deployment cost, higher values will optimize more for high-frequency usage."
 		)
+		(
+			g_argViaIR.c_str(),
+			"Generate the bytecode by translating the contracts to Yul, which is run through the Yul optimizer "
+			"if --optimize is given. Only a subset of the language is supported so far."
+		)
+		(
+			g_argAnalysisThreads.c_str(),
+			po::value<unsigned>()->value_name("n")->default_value(1),
+			"Type check contracts on n threads. Zero uses one thread per CPU."
+		)
 		(g_argPrettyJson.c_str(), "Output JSON in pretty format. Currently it only works with the combined JSON output.")
 		(
 			g_argLibraries.c_str(),
@@ -658,11 +720,13 @@ Allowed options)",
 		(g_argAst.c_str(), "AST of all source files.")
 		(g_argAstJson.c_str(), "AST of all source files in JSON format.")
 		(g_argAstCompactJson.c_str(), "AST of all source files in a compact JSON format.")
+		(g_argAstBinary.c_str(), "AST of all source files in a compact binary format (hex encoded on standard output).")
 		(g_argAsm.c_str(), "EVM assembly of the contracts.")
 		(g_argAsmJson.c_str(), "EVM assembly of the contracts in JSON format.")
 		(g_argOpcodes.c_str(), "Opcodes of the contracts.")
 		(g_argBinary.c_str(), "Binary of the contracts in hex.")
 		(g_argBinaryRuntime.c_str(), "Binary of the runtime part of the contracts in hex.")
+		(g_argIR.c_str(), "Intermediate representation (Yul) of the contracts generated from Solidity.")
 		(g_argAbi.c_str(), "ABI specification of the contracts.")
 		(g_argSignatureHashes.c_str(), "Function signature hashes of the contracts.")
 		(g_argNatspecUser.c_str(), "Natspec user documentation of all contracts.")
@@ -755,6 +819,8 @@ bool CommandLineInterface::processInput()
 				return ReadCallback::Result{false, "Not a valid file."};
 
 			auto contents = dev::readFileAsString(canonicalPath.string());
+			// The compiler reads the imports of a source unit concurrently.
+			lock_guard<mutex> lock(m_sourceCodesMutex);
 			m_sourceCodes[path.generic_string()] = contents;
 			return ReadCallback::Result{true, contents};
 		}
@@ -875,6 +941,9 @@ bool CommandLineInterface::processInput()
 		bool optimize = m_args.count(g_argOptimize) > 0;
 		unsigned runs = m_args[g_argOptimizeRuns].as<unsigned>();
 		m_compiler->setOptimiserSettings(optimize, runs);
+		m_compiler->setViaIR(m_args.count(g_argViaIR) > 0);
+		m_compiler->setAnalysisThreads(m_args[g_argAnalysisThreads].as<unsigned>());
+		m_compiler->setFileReadingThreads(g_fileReadingThreads);
 
 		bool successful = m_compiler->compile();
 
@@ -961,8 +1030,6 @@ void CommandLineInterface::handleCombinedJSON()
 			contractData[g_strBinaryRuntime] = m_compiler->runtimeObject(contractName).toHex();
 		if (requests.count(g_strOpcodes))
 			contractData[g_strOpcodes] = solidity::disassemble(m_compiler->object(contractName).bytecode);
-		if (requests.count(g_strAsm))
-			contractData[g_strAsm] = m_compiler->assemblyJSON(contractName, m_sourceCodes);
 		if (requests.count(g_strSrcMap))
 		{
 			auto map = m_compiler->sourceMapping(contractName);
@@ -991,24 +1058,54 @@ void CommandLineInterface::handleCombinedJSON()
 			output[g_strSourceList].append(source);
 	}
 
-	if (requests.count(g_strAst))
+	// The assembly and the ASTs are the largest parts of the output, so they are written
+	// to the output stream directly instead of being added to the JSON value.
+	bool const assemblyRequested = requests.count(g_strAsm) && !contracts.empty();
+	Json::Value contractsData;
+	if (assemblyRequested)
+		output.removeMember(g_strContracts, &contractsData);
+	auto writeOutput = [&](ostream& _stream)
 	{
-		bool legacyFormat = !requests.count(g_strCompactJSON);
-		output[g_strSources] = Json::Value(Json::objectValue);
-		for (auto const& sourceCode: m_sourceCodes)
-		{
-			ASTJsonConverter converter(legacyFormat, m_compiler->sourceIndices());
-			output[g_strSources][sourceCode.first] = Json::Value(Json::objectValue);
-			output[g_strSources][sourceCode.first]["AST"] = converter.toJson(m_compiler->ast(sourceCode.first));
-		}
-	}
-
-	string json = m_args.count(g_argPrettyJson) ? dev::jsonPrettyPrint(output) : dev::jsonCompactPrint(output);
+		JsonStreamWriter writer(_stream, m_args.count(g_argPrettyJson) ? "  " : "");
+		map<string, function<void()>> streamedMembers;
+		if (assemblyRequested)
+			streamedMembers[g_strContracts] = [&]()
+			{
+				writer.beginObject();
+				for (string const& contractName: contracts)
+				{
+					writer.key(contractName);
+					writer.object(contractsData[contractName], {{g_strAsm, [&]() {
+						m_compiler->assemblyJSON(writer, contractName, m_sourceCodes);
+					}}});
+				}
+				writer.endObject();
+			};
+		if (requests.count(g_strAst))
+			streamedMembers[g_strSources] = [&]()
+			{
+				bool legacyFormat = !requests.count(g_strCompactJSON);
+				writer.beginObject();
+				for (auto const& sourceCode: m_sourceCodes)
+				{
+					writer.key(sourceCode.first);
+					writer.object(Json::Value(Json::objectValue), {{"AST", [&]() {
+						ASTJsonConverter converter(legacyFormat, m_compiler->sourceIndices());
+						converter.print(writer, m_compiler->ast(sourceCode.first));
+					}}});
+				}
+				writer.endObject();
+			};
+		writer.object(output, streamedMembers);
+	};
 
 	if (m_args.count(g_argOutputDir))
-		createJson("combined", json);
+		createJson("combined", writeOutput);
 	else
-		sout() << json << endl;
+	{
+		writeOutput(sout());
+		sout() << endl;
+	}
 }
 
 void CommandLineInterface::handleAst(string const& _argStr)
@@ -1021,6 +1118,8 @@ void CommandLineInterface::handleAst(string const& _argStr)
 		title = "JSON AST:";
 	else if (_argStr == g_argAstCompactJson)
 		title = "JSON AST (compact format):";
+	else if (_argStr == g_argAstBinary)
+		title = "Binary AST:";
 	else
 		BOOST_THROW_EXCEPTION(InternalCompilerError() << errinfo_comment("Illegal argStr for AST"));
 
@@ -1057,6 +1156,12 @@ void CommandLineInterface::handleAst(string const& _argStr)
 					ASTPrinter printer(m_compiler->ast(sourceCode.first), sourceCode.second);
 					printer.print(data);
 				}
+				else if (_argStr == g_argAstBinary)
+				{
+					bytes binaryAst = ASTBinaryWriter().write(m_compiler->ast(sourceCode.first));
+					data.write(reinterpret_cast<char const*>(binaryAst.data()), binaryAst.size());
+					postfix += "_binary";
+				}
 				else
 				{
 					ASTJsonConverter(legacyFormat, m_compiler->sourceIndices()).print(data, m_compiler->ast(sourceCode.first));
@@ -1081,6 +1186,8 @@ void CommandLineInterface::handleAst(string const& _argStr)
 					);
 					printer.print(sout());
 				}
+				else if (_argStr == g_argAstBinary)
+					sout() << toHex(ASTBinaryWriter().write(m_compiler->ast(sourceCode.first))) << endl;
 				else
 					ASTJsonConverter(legacyFormat, m_compiler->sourceIndices()).print(sout(), m_compiler->ast(sourceCode.first));
 			}
@@ -1253,7 +1360,7 @@ bool CommandLineInterface::assemble(
 		MachineAssemblyObject object;
 		try
 		{
-			object = stack.assemble(_targetMachine);
+			object = stack.assemble(_targetMachine, _optimize);
 		}
 		catch (Exception const& _exception)
 		{
@@ -1290,6 +1397,7 @@ void CommandLineInterface::outputCompilationResults()
 	handleAst(g_argAst);
 	handleAst(g_argAstJson);
 	handleAst(g_argAstCompactJson);
+	handleAst(g_argAstBinary);
 
 	vector<string> contracts = m_compiler->contractNames();
 	for (string const& contract: contracts)
@@ -1300,25 +1408,33 @@ void CommandLineInterface::outputCompilationResults()
 		// do we need EVM assembly?
 		if (m_args.count(g_argAsm) || m_args.count(g_argAsmJson))
 		{
-			string ret;
-			if (m_args.count(g_argAsmJson))
-				ret = dev::jsonPrettyPrint(m_compiler->assemblyJSON(contract, m_sourceCodes));
-			else
-				ret = m_compiler->assemblyString(contract, m_sourceCodes);
+			auto writeAssembly = [&](ostream& _stream)
+			{
+				if (m_args.count(g_argAsmJson))
+				{
+					JsonStreamWriter writer(_stream, "  ");
+					m_compiler->assemblyJSON(writer, contract, m_sourceCodes);
+				}
+				else
+					_stream << m_compiler->assemblyString(contract, m_sourceCodes);
+			};
 
 			if (m_args.count(g_argOutputDir))
 			{
-				createFile(m_compiler->filesystemFriendlyName(contract) + (m_args.count(g_argAsmJson) ? "_evm.json" : ".evm"), ret);
+				createFile(m_compiler->filesystemFriendlyName(contract) + (m_args.count(g_argAsmJson) ? "_evm.json" : ".evm"), writeAssembly);
 			}
 			else
 			{
-				sout() << "EVM assembly:" << endl << ret << endl;
+				sout() << "EVM assembly:" << endl;
+				writeAssembly(sout());
+				sout() << endl;
 			}
 		}
 
 		if (m_args.count(g_argGas))
 			handleGasEstimation(contract);
 
+		handleIR(contract);
 		handleBytecode(contract);
 		handleSignatureHashes(contract);
 		handleMetadata(contract);
@@ -28,7 +28,9 @@
 #include <boost/program_options.hpp>
 #include <boost/filesystem/path.hpp>
 
+#include <functional>
 #include <memory>
+#include <mutex>
 
 namespace dev
 {
@@ -68,6 +70,7 @@ private:
 	void handleBytecode(std::string const& _contract);
 	void handleSignatureHashes(std::string const& _contract);
 	void handleMetadata(std::string const& _contract);
+	void handleIR(std::string const& _contract);
 	void handleABI(std::string const& _contract);
 	void handleNatspec(bool _natspecDev, std::string const& _contract);
 	void handleGasEstimation(std::string const& _contract);
@@ -83,11 +86,13 @@ private:
 	/// @arg _fileName the name of the file
 	/// @arg _data to be written
 	void createFile(std::string const& _fileName, std::string const& _data);
+	/// Create a file in the given directory and write its contents using @a _write
+	void createFile(std::string const& _fileName, std::function<void(std::ostream&)> const& _write);
 
 	/// Create a json file in the given directory
 	/// @arg _fileName the name of the file (the extension will be replaced with .json)
-	/// @arg _json json string to be written
-	void createJson(std::string const& _fileName, std::string const& _json);
+	/// @arg _write function that writes the json to the given stream
+	void createJson(std::string const& _fileName, std::function<void(std::ostream&)> const& _write);
 
 	bool m_error = false; ///< If true, some error occurred.
 
@@ -99,6 +104,8 @@ private:
 	boost::program_options::variables_map m_args;
 	/// map of input files to source code strings
 	std::map<std::string, std::string> m_sourceCodes;
+	/// Guards @a m_sourceCodes while the compiler reads imports
+	std::mutex m_sourceCodesMutex;
 	/// list of remappings
 	std::vector<dev::solidity::CompilerStack::Remapping> m_remappings;
 	/// list of allowed directories to read files from
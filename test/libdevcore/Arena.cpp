@@ -0,0 +1,91 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for Arena and ArenaAllocator.
+ */
+
+#include <libdevcore/Arena.h>
+
+#include <test/Options.h>
+
+#include <cstdint>
+
+using namespace std;
+
+namespace dev
+{
+namespace test
+{
+
+BOOST_AUTO_TEST_SUITE(ArenaTest)
+
+BOOST_AUTO_TEST_CASE(alignment_and_blocks)
+{
+	Arena arena(256, 256);
+	char* first = static_cast<char*>(arena.allocate(1, 1));
+	void* aligned = arena.allocate(8, 8);
+	BOOST_CHECK_EQUAL(reinterpret_cast<uintptr_t>(aligned) % 8, 0);
+	BOOST_CHECK_EQUAL(static_cast<char*>(aligned) - first, 8);
+	BOOST_CHECK_EQUAL(arena.allocatedBytes(), 256);
+	arena.allocate(100, 8);
+	arena.allocate(100, 8);
+	BOOST_CHECK_EQUAL(arena.allocatedBytes(), 256);
+	arena.allocate(100, 8);
+	BOOST_CHECK_EQUAL(arena.allocatedBytes(), 512);
+}
+
+BOOST_AUTO_TEST_CASE(large_allocations)
+{
+	Arena arena(256, 256);
+	char* small = static_cast<char*>(arena.allocate(16, 8));
+	arena.allocate(1000, 8);
+	BOOST_CHECK_EQUAL(arena.allocatedBytes(), 1256);
+	// The current block is still used after a large allocation.
+	BOOST_CHECK_EQUAL(static_cast<char*>(arena.allocate(16, 8)) - small, 16);
+	BOOST_CHECK_EQUAL(arena.allocatedBytes(), 1256);
+}
+
+BOOST_AUTO_TEST_CASE(growing_blocks)
+{
+	Arena arena(256, 1024);
+	for (size_t i = 0; i < 8; ++i)
+		arena.allocate(64, 8);
+	BOOST_CHECK_EQUAL(arena.allocatedBytes(), 256 + 512);
+	for (size_t i = 0; i < 21; ++i)
+		arena.allocate(64, 8);
+	BOOST_CHECK_EQUAL(arena.allocatedBytes(), 256 + 512 + 1024 + 1024);
+}
+
+BOOST_AUTO_TEST_CASE(shared_objects_keep_arena_alive)
+{
+	auto arena = make_shared<Arena>();
+	weak_ptr<Arena> weakArena = arena;
+	auto value = allocate_shared<string>(ArenaAllocator<string>(arena), "a string that does not fit inline");
+	auto other = allocate_shared<int>(ArenaAllocator<int>(arena), 7);
+	arena.reset();
+	BOOST_CHECK(!weakArena.expired());
+	BOOST_CHECK_EQUAL(*value, "a string that does not fit inline");
+	value.reset();
+	BOOST_CHECK(!weakArena.expired());
+	other.reset();
+	BOOST_CHECK(weakArena.expired());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
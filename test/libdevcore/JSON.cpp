@@ -23,6 +23,9 @@
 
 #include <test/Options.h>
 
+#include <functional>
+#include <sstream>
+
 using namespace std;
 
 namespace dev
@@ -145,6 +148,98 @@ BOOST_AUTO_TEST_CASE(parse_json_strict)
 	BOOST_CHECK(json[0] == "\x80\xec\x80");
 }
 
+namespace
+{
+
+/// @returns a value that uses all kinds of nesting, including empty containers.
+Json::Value nestedValue()
+{
+	Json::Value json(Json::objectValue);
+	json["array"] = Json::arrayValue;
+	json["array"].append(1);
+	json["array"].append("two");
+	json["array"].append(Json::objectValue);
+	json["array"].append(Json::arrayValue);
+	Json::Value inner(Json::objectValue);
+	inner["a"] = Json::nullValue;
+	inner["b"] = true;
+	inner["c"] = Json::arrayValue;
+	inner["c"].append(Json::arrayValue);
+	inner["c"][0].append(-3);
+	json["array"].append(inner);
+	json["empty"] = Json::objectValue;
+	json["escaped \"key\"\n"] = "line\nbreak";
+	json["object"] = inner;
+	return json;
+}
+
+/// @returns the output of writing @a _value piece by piece with the given indentation.
+string streamed(Json::Value const& _value, string const& _indentation)
+{
+	stringstream stream;
+	JsonStreamWriter writer(stream, _indentation);
+	function<void(Json::Value const&)> write = [&](Json::Value const& _v)
+	{
+		if (_v.isArray())
+		{
+			writer.beginArray();
+			for (auto const& element: _v)
+				write(element);
+			writer.endArray();
+		}
+		else if (_v.isObject())
+		{
+			writer.beginObject();
+			for (auto const& key: _v.getMemberNames())
+			{
+				writer.key(key);
+				// Alternate between writing members in one piece and element by element.
+				if (key.size() % 2)
+					writer.value(_v[key]);
+				else
+					write(_v[key]);
+			}
+			writer.endObject();
+		}
+		else
+			writer.value(_v);
+	};
+	write(_value);
+	return stream.str();
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(json_stream_writer)
+{
+	Json::Value json = nestedValue();
+	BOOST_CHECK_EQUAL(streamed(json, "  "), jsonPrettyPrint(json));
+	BOOST_CHECK_EQUAL(streamed(json, ""), jsonCompactPrint(json));
+	stringstream tabs;
+	tabs << json;
+	BOOST_CHECK_EQUAL(streamed(json, "\t"), tabs.str());
+	for (Json::Value const& value: {Json::Value(), Json::Value(7), Json::Value(Json::arrayValue), json["object"]})
+	{
+		BOOST_CHECK_EQUAL(streamed(value, "  "), jsonPrettyPrint(value));
+		BOOST_CHECK_EQUAL(streamed(value, ""), jsonCompactPrint(value));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(json_stream_writer_lazy_members)
+{
+	Json::Value json = nestedValue();
+	Json::Value members = json;
+	members.removeMember("array");
+	members.removeMember("object");
+	stringstream stream;
+	JsonStreamWriter writer(stream, "  ");
+	writer.object(members, {
+		{"array", [&]() { writer.value(json["array"]); }},
+		{"object", [&]() { writer.object(json["object"], {}); }}
+	});
+	BOOST_CHECK_EQUAL(stream.str(), jsonPrettyPrint(json));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
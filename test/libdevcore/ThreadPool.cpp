@@ -0,0 +1,75 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for ThreadPool.
+ */
+
+#include <libdevcore/ThreadPool.h>
+
+#include <test/Options.h>
+
+#include <atomic>
+
+using namespace std;
+
+namespace dev
+{
+namespace test
+{
+
+BOOST_AUTO_TEST_SUITE(ThreadPoolTest)
+
+BOOST_AUTO_TEST_CASE(runs_all_tasks)
+{
+	ThreadPool pool(4);
+	vector<int> results(100, 0);
+	for (size_t i = 0; i < results.size(); ++i)
+		pool.post([&, i]() { results[i] = int(i) * 2; });
+	pool.wait();
+	for (size_t i = 0; i < results.size(); ++i)
+		BOOST_CHECK_EQUAL(results[i], int(i) * 2);
+}
+
+BOOST_AUTO_TEST_CASE(nested_tasks)
+{
+	ThreadPool pool(3);
+	atomic<int> counter{0};
+	for (int i = 0; i < 10; ++i)
+		pool.post([&]() {
+			for (int j = 0; j < 10; ++j)
+				pool.post([&]() { ++counter; });
+		});
+	pool.wait();
+	BOOST_CHECK_EQUAL(counter.load(), 100);
+}
+
+BOOST_AUTO_TEST_CASE(reuse_after_wait)
+{
+	ThreadPool pool(2);
+	atomic<int> counter{0};
+	pool.post([&]() { ++counter; });
+	pool.wait();
+	pool.post([&]() { ++counter; });
+	pool.wait();
+	BOOST_CHECK_EQUAL(counter.load(), 2);
+	BOOST_CHECK_EQUAL(pool.size(), 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
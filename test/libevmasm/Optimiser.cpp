@@ -656,6 +656,63 @@ BOOST_AUTO_TEST_CASE(cse_optimise_return)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(cse_transferable_knowledge)
+{
+	eth::KnownState state = createInitialState(AssemblyItems{
+		Instruction::DUP1,
+		u256(1),
+		Instruction::SSTORE,
+		u256(7),
+		u256(0),
+		Instruction::SSTORE,
+		Instruction::BALANCE
+	});
+	state.reduceToTransferableKnowledge();
+	BOOST_CHECK(state.stackElements().empty());
+	// The value stored at 0 is still known, the value stored at 1 was on the initial stack.
+	checkCSE({u256(0), Instruction::SLOAD}, {u256(7)}, state);
+	checkCSE({u256(1), Instruction::SLOAD}, {u256(1), Instruction::SLOAD}, state);
+}
+
+BOOST_AUTO_TEST_CASE(cse_across_blocks)
+{
+	auto run = [](bool _loop) -> AssemblyItems
+	{
+		Assembly assembly;
+		AssemblyItem tag = assembly.newTag();
+		assembly.append(u256(7));
+		assembly.append(u256(0));
+		assembly.append(Instruction::SSTORE);
+		assembly.append(Instruction::CALLVALUE);
+		assembly.append(tag.pushTag());
+		assembly.append(Instruction::JUMPI);
+		assembly.append(tag);
+		assembly.append(u256(0));
+		assembly.append(Instruction::SLOAD);
+		assembly.append(u256(0x20));
+		assembly.append(Instruction::MSTORE);
+		if (_loop)
+		{
+			assembly.append(tag.pushTag());
+			assembly.append(Instruction::JUMP);
+		}
+		Assembly::OptimiserSettings settings;
+		settings.runCSE = true;
+		settings.evmVersion = dev::test::Options::get().evmVersion();
+		assembly.optimise(settings);
+		return assembly.items();
+	};
+
+	// The tag is only reached from above, so the value in storage is known.
+	AssemblyItems items = run(false);
+	BOOST_CHECK(find(items.begin(), items.end(), AssemblyItem(Instruction::SLOAD)) == items.end());
+	BOOST_CHECK_EQUAL(count(items.begin(), items.end(), AssemblyItem(u256(7))), 2);
+
+	// The jump back to the tag can change storage.
+	items = run(true);
+	BOOST_CHECK(find(items.begin(), items.end(), AssemblyItem(Instruction::SLOAD)) != items.end());
+}
+
 BOOST_AUTO_TEST_CASE(control_flow_graph_remove_unused)
 {
 	// remove parts of the code that are unused
@@ -0,0 +1,217 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Tests for the binary AST format.
+ */
+
+#include <libsolidity/ast/ASTBinary.h>
+#include <libsolidity/ast/ASTPrinter.h>
+#include <libsolidity/interface/CompilerStack.h>
+
+#include <liblangutil/CharStream.h>
+#include <liblangutil/Scanner.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <sstream>
+#include <string>
+
+using namespace std;
+using namespace langutil;
+
+namespace dev
+{
+namespace solidity
+{
+namespace test
+{
+
+namespace
+{
+
+string const c_source = R"(
+	pragma solidity >=0.0;
+	pragma experimental ABIEncoderV2;
+	import "other" as O;
+	import {A as B, C} from "other";
+	/// @title Library
+	library L {
+		struct S { uint a; mapping(address => bytes32[]) m; }
+		enum E { X, Y }
+		function f(S storage s, uint x) internal view returns (uint) { return s.a + x; }
+	}
+	interface I { function g() external payable returns (address payable); }
+	contract D is I, O.Base(1, "x") {
+		using L for L.S;
+		using L for *;
+		uint constant c = 2 ether + 1 days;
+		L.S s;
+		uint[3][] public arr;
+		function(uint) external returns (bool) public fp;
+		event Ev(uint indexed a, bytes b) anonymous;
+		modifier m(uint x) { require(x > 0, "x"); _; }
+		constructor() public m(1) {}
+		function() external payable {}
+		function g() external payable returns (address payable) { return msg.sender; }
+		function h(uint x) public m(x) returns (uint y, bool) {
+			uint[] memory a = new uint[](x);
+			(uint p, , bool q) = (1, 2, true);
+			int8 z = -1;
+			y = x > 2 ? x ** 2 : ~x;
+			y += a.length;
+			a[0]++;
+			delete a[1];
+			if (q) return (y, !q); else if (p == 1) y--;
+			while (y < 10) { y <<= 1; continue; }
+			do { break; } while (true);
+			for (uint i = 0; i < 3; i++) y = uint8(i);
+			for (;;) {}
+			emit Ev({a: y, b: hex"0102"});
+			this.g.value(1)();
+			bytes memory b = abi.encodePacked(z, uint16(0x1234), bytes1(0xff), "\x00 A", fp);
+			assembly {
+				let r, t := two()
+				function two() -> u1, u2 { u1 := 1 u2 := 2 }
+				function k(u) -> v { v := add(u, 0x20) }
+				switch mload(0x40)
+				case 0 { r := k(t) }
+				case "abc" { }
+				default { sstore(r, 1) }
+				for { let j := 0 } lt(j, 10) { j := add(j, 1) } { if eq(j, 5) { pop(j) } }
+				{ mstore(0, 0) }
+				y := b
+			}
+		}
+	}
+)";
+
+string const c_other = R"(
+	pragma solidity >=0.0;
+	contract A {}
+	contract C {}
+	contract Base { constructor(uint, string memory) public {} }
+)";
+
+/// @returns a readable representation of @a _ast which does not depend on node IDs.
+string print(SourceUnit const& _ast, string const& _source)
+{
+	ostringstream output;
+	ASTPrinter(_ast, _source).print(output);
+	return output.str();
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(ASTBinaryTest)
+
+BOOST_AUTO_TEST_CASE(roundtrip)
+{
+	CompilerStack compiler;
+	compiler.addSource("a", c_source);
+	compiler.addSource("other", c_other);
+	BOOST_REQUIRE(compiler.parse());
+	SourceUnit const& original = compiler.ast("a");
+
+	bytes binary = ASTBinaryWriter().write(original);
+	BOOST_CHECK_EQUAL(binary[0], 'S');
+	ASTBinaryReader reader;
+	ASTPointer<SourceUnit> reloaded = reader.read(binary);
+	BOOST_REQUIRE(reloaded);
+	BOOST_CHECK_EQUAL(reloaded->id(), original.id());
+	BOOST_CHECK_EQUAL(reloaded->annotation().path, "a");
+	BOOST_CHECK_EQUAL(reloaded->location().source->name(), "a");
+	BOOST_CHECK_EQUAL(print(*reloaded, c_source), print(original, c_source));
+	BOOST_CHECK(ASTBinaryWriter().write(*reloaded) == binary);
+	BOOST_CHECK(!reader.type(original.id()));
+}
+
+BOOST_AUTO_TEST_CASE(roundtrip_with_source)
+{
+	CompilerStack compiler;
+	compiler.addSource("a", "contract C { function f() public { assembly { let x := 1 } } }");
+	BOOST_REQUIRE(compiler.parse());
+	auto source = make_shared<CharStream>(compiler.scanner("a").source(), "a");
+	ASTPointer<SourceUnit> reloaded = ASTBinaryReader().read(ASTBinaryWriter().write(compiler.ast("a")), source);
+	BOOST_CHECK(reloaded->location().source == source);
+	BOOST_CHECK_EQUAL(reloaded->location().end, compiler.ast("a").location().end);
+}
+
+BOOST_AUTO_TEST_CASE(types)
+{
+	CompilerStack compiler;
+	compiler.addSource("a", c_source);
+	compiler.addSource("other", c_other);
+	BOOST_REQUIRE(compiler.parseAndAnalyze());
+	SourceUnit const& original = compiler.ast("a");
+
+	ASTBinaryReader reader;
+	ASTPointer<SourceUnit> reloaded = reader.read(ASTBinaryWriter().write(original));
+	BOOST_REQUIRE(reloaded);
+	auto contract = dynamic_cast<ContractDefinition const*>(reloaded->nodes().back().get());
+	BOOST_REQUIRE(contract);
+	VariableDeclaration const* arr = contract->stateVariables().at(2);
+	BOOST_CHECK_EQUAL(arr->name(), "arr");
+	ASTBinaryReader::TypeDescription const* type = reader.type(arr->id());
+	BOOST_REQUIRE(type);
+	BOOST_CHECK_EQUAL(type->name, "uint256[3] storage ref[] storage ref");
+	BOOST_CHECK_EQUAL(type->identifier, "t_array$_t_array$_t_uint256_$3_storage_$dyn_storage");
+	// Annotations are not restored.
+	BOOST_CHECK(!arr->annotation().type);
+	BOOST_CHECK(!reader.type(arr->typeName()->id()));
+}
+
+BOOST_AUTO_TEST_CASE(node_ids_continue_after_read)
+{
+	CompilerStack compiler;
+	compiler.addSource("a", c_source);
+	compiler.addSource("other", c_other);
+	BOOST_REQUIRE(compiler.parse());
+	bytes binary = ASTBinaryWriter().write(compiler.ast("a"));
+
+	ASTNode::resetID();
+	ASTPointer<SourceUnit> reloaded = ASTBinaryReader().read(binary);
+	Identifier identifier(SourceLocation{}, make_shared<string>("x"));
+	BOOST_CHECK(identifier.id() > reloaded->id());
+}
+
+BOOST_AUTO_TEST_CASE(invalid_data)
+{
+	CompilerStack compiler;
+	compiler.addSource("a", c_source);
+	compiler.addSource("other", c_other);
+	BOOST_REQUIRE(compiler.parse());
+	bytes binary = ASTBinaryWriter().write(compiler.ast("a"));
+
+	BOOST_CHECK_THROW(ASTBinaryReader().read(bytes()), InvalidBinaryAST);
+	bytes wrongMagic = binary;
+	wrongMagic[0] = 'X';
+	BOOST_CHECK_THROW(ASTBinaryReader().read(wrongMagic), InvalidBinaryAST);
+	bytes trailingData = binary;
+	trailingData.push_back(0);
+	BOOST_CHECK_THROW(ASTBinaryReader().read(trailingData), InvalidBinaryAST);
+	for (size_t length = 0; length < binary.size(); ++length)
+		BOOST_CHECK_THROW(
+			ASTBinaryReader().read(bytes(binary.begin(), binary.begin() + length)),
+			InvalidBinaryAST
+		);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
+} // end namespaces
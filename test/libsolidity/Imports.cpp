@@ -26,11 +26,16 @@
 #include <liblangutil/Exceptions.h>
 #include <libsolidity/interface/CompilerStack.h>
 
+#include <libdevcore/CommonIO.h>
+
+#include <boost/algorithm/string/predicate.hpp>
 #include <boost/test/unit_test.hpp>
 
+#include <mutex>
 #include <string>
 
 using namespace std;
+using namespace langutil;
 
 namespace dev
 {
@@ -39,6 +44,60 @@ namespace solidity
 namespace test
 {
 
+namespace
+{
+
+/// Sources where every contract refers to the previous ones and has a type error.
+StringMap sourcesWithErrors()
+{
+	StringMap sources;
+	for (size_t i = 0; i < 16; ++i)
+	{
+		string name = "s" + toString(i);
+		string code = "pragma solidity >=0.0;\n";
+		if (i > 0)
+			code += "import \"s" + toString(i - 1) + "\";\n";
+		code += "contract C" + toString(i) + (i > 0 ? " is C" + toString(i - 1) : "") + " {\n";
+		code += "\tstruct S" + toString(i) + " { uint a; bytes b; }\n";
+		code += "\tS" + toString(i) + " s" + toString(i) + ";\n";
+		code += "\tfunction f" + toString(i) + "(uint x) public returns (uint) { return x + s" + toString(i) + ".a; }\n";
+		if (i > 0)
+			code +=
+				"\tfunction g" + toString(i) + "(C" + toString(i - 1) + " c) public returns (bytes memory) {\n"
+				"\t\tuint[2] memory y; y[" + toString(i) + "] = c.f" + toString(i - 1) + "(1);\n"
+				"\t\treturn s" + toString(i - 1) + ".b;\n"
+				"\t}\n";
+		if (i % 3 == 0)
+			code += "\tfunction h" + toString(i) + "() public pure returns (uint r) { assembly { r := 7 } bool b = r; }\n";
+		code += "\tfunction k" + toString(i) + "() public { uint8 z = " + toString(256 + i) + "; }\n";
+		code += "}\n";
+		sources[name] = code;
+	}
+	return sources;
+}
+
+/// @returns the diagnostics of analysing @a _sources on @a _threads threads.
+vector<string> analysisDiagnostics(StringMap const& _sources, unsigned _threads)
+{
+	CompilerStack c;
+	for (auto const& source: _sources)
+		c.addSource(source.first, source.second);
+	c.setEVMVersion(dev::test::Options::get().evmVersion());
+	c.setAnalysisThreads(_threads);
+	c.parseAndAnalyze();
+	vector<string> diagnostics;
+	for (auto const& error: c.errors())
+	{
+		string diagnostic = error->typeName() + ": " + *error->comment();
+		if (auto location = boost::get_error_info<errinfo_sourceLocation>(*error))
+			diagnostic += " " + toString(*location);
+		diagnostics.push_back(diagnostic);
+	}
+	return diagnostics;
+}
+
+}
+
 BOOST_AUTO_TEST_SUITE(SolidityImports)
 
 BOOST_AUTO_TEST_CASE(smoke_test)
@@ -320,6 +379,101 @@ BOOST_AUTO_TEST_CASE(shadowing_builtins_with_alias)
 	}
 }
 
+BOOST_AUTO_TEST_CASE(parallel_analysis_reports_in_source_order)
+{
+	StringMap sources = sourcesWithErrors();
+	vector<string> sequential = analysisDiagnostics(sources, 1);
+	// Out of bounds access, conversion to bool and the too large literal.
+	size_t errors = count_if(sequential.begin(), sequential.end(), [](string const& _diagnostic) {
+		return !boost::starts_with(_diagnostic, "Warning");
+	});
+	BOOST_CHECK_EQUAL(errors, 14 + 6 + 16);
+	for (unsigned threads: {2, 4, 0})
+	{
+		vector<string> parallel = analysisDiagnostics(sources, threads);
+		BOOST_CHECK_EQUAL_COLLECTIONS(sequential.begin(), sequential.end(), parallel.begin(), parallel.end());
+	}
+}
+
+BOOST_AUTO_TEST_CASE(parallel_analysis_cyclic_creation)
+{
+	StringMap sources{
+		{"a", "pragma solidity >=0.0; import \"b\"; import \"c\"; contract A { function f() public { new B(); } }"},
+		{"b", "pragma solidity >=0.0; import \"a\"; import \"c\"; contract B { function f() public { new C(); } }"},
+		{"c", "pragma solidity >=0.0; import \"a\"; import \"b\"; contract C { function f() public { new A(); } }"}
+	};
+	vector<string> sequential = analysisDiagnostics(sources, 1);
+	vector<string> parallel = analysisDiagnostics(sources, 3);
+	BOOST_CHECK_EQUAL_COLLECTIONS(sequential.begin(), sequential.end(), parallel.begin(), parallel.end());
+	BOOST_CHECK(boost::starts_with(sequential.back(), "TypeError: Circular reference for contract creation"));
+}
+
+BOOST_AUTO_TEST_CASE(parallel_analysis_compiles)
+{
+	string const source = R"(
+		pragma solidity >=0.0;
+		contract A {
+			struct S { uint a; bytes b; }
+			S s;
+			function f(uint x) public view returns (uint) { return x + s.a; }
+		}
+		contract B is A {
+			A a;
+			function g() public view returns (uint r) { r = a.f(2) + f(3); assembly { r := add(r, 1) } }
+		}
+		contract C {
+			function h() public returns (B) { return new B(); }
+		}
+	)";
+	CompilerStack sequential;
+	sequential.addSource("a", source);
+	sequential.setEVMVersion(dev::test::Options::get().evmVersion());
+	BOOST_REQUIRE(sequential.compile());
+	CompilerStack parallel;
+	parallel.addSource("a", source);
+	parallel.setEVMVersion(dev::test::Options::get().evmVersion());
+	parallel.setAnalysisThreads(3);
+	BOOST_REQUIRE(parallel.compile());
+	BOOST_CHECK_EQUAL(sequential.errors().size(), parallel.errors().size());
+	for (char const* contract: {"A", "B", "C"})
+		BOOST_CHECK(sequential.object(contract).bytecode == parallel.object(contract).bytecode);
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_import_reading)
+{
+	StringMap files{
+		{"b", "pragma solidity >=0.0; import \"d\"; import \"e\"; contract B is D, E {}"},
+		{"c", "pragma solidity >=0.0; import \"e\"; import \"x\"; contract C is E {}"},
+		{"d", "pragma solidity >=0.0; import \"e\"; contract D is E {}"},
+		{"e", "pragma solidity >=0.0; contract E {}"}
+	};
+	for (unsigned threads: {1, 4})
+	{
+		mutex readsMutex;
+		vector<string> reads;
+		CompilerStack c([&](string const& _path) {
+			lock_guard<mutex> lock(readsMutex);
+			reads.push_back(_path);
+			if (files.count(_path))
+				return ReadCallback::Result{true, files.at(_path)};
+			return ReadCallback::Result{false, "File not found."};
+		});
+		c.addSource("a", "pragma solidity >=0.0; import \"b\"; import \"c\"; import \"y\"; import \"y\"; contract A is B, C {}");
+		c.setEVMVersion(dev::test::Options::get().evmVersion());
+		c.setFileReadingThreads(threads);
+		BOOST_CHECK(!c.parse());
+		// Every missing file is requested once, but reported for each import.
+		sort(reads.begin(), reads.end());
+		BOOST_CHECK((reads == vector<string>{"b", "c", "d", "e", "x", "y"}));
+		vector<string> notFound;
+		for (auto const& error: c.errors())
+			if (error->type() == Error::Type::ParserError)
+				notFound.push_back(toString(*boost::get_error_info<errinfo_sourceLocation>(*error)));
+		BOOST_CHECK((notFound == vector<string>{"a[47,58)", "a[59,70)", "c[35,46)"}));
+		BOOST_CHECK((c.sourceNames() == vector<string>{"a", "b", "c", "d", "e"}));
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -6653,6 +6653,44 @@ BOOST_AUTO_TEST_CASE(packed_storage_structs_delete)
 	BOOST_CHECK(storageEmpty(m_contractAddress));
 }
 
+BOOST_AUTO_TEST_CASE(packed_storage_structs_copy)
+{
+	char const* sourceCode = R"(
+		contract C {
+			enum E { A, B, C }
+			struct S { int8 a; bytes3 b; bool c; E d; address e; uint128 f; uint128 g; function() external returns (uint) h; uint i; uint16 j; }
+			S s1;
+			S s2;
+			function k() external returns (uint) { return 42; }
+			function set() public {
+				S memory m = S(-3, "abc", true, E.C, address(0x1234), 7, 8, this.k, 9, 0xffff);
+				s1 = m;
+				s2 = s1;
+				s1 = s1;
+			}
+			function getMemory() public returns (int8, bytes3, bool, E, address, uint128, uint128, uint, uint, uint16) {
+				S memory r = s2;
+				return (r.a, r.b, r.c, r.d, r.e, r.f, r.g, r.h(), r.i, r.j);
+			}
+			function getStorage() public returns (int8, bytes3, bool, E, address, uint128, uint128, uint, uint, uint16) {
+				return (s1.a, s1.b, s1.c, s1.d, s1.e, s1.f, s1.g, s1.h(), s1.i, s1.j);
+			}
+			function clear() public {
+				S memory m;
+				s1 = m;
+				s2 = s1;
+			}
+		}
+	)";
+	compileAndRun(sourceCode);
+	ABI_CHECK(callContractFunction("set()"), encodeArgs());
+	bytes expectation = encodeArgs(u256(-3), string("abc"), true, 2, u160(0x1234), 7, 8, 42, 9, 0xffff);
+	ABI_CHECK(callContractFunction("getMemory()"), expectation);
+	ABI_CHECK(callContractFunction("getStorage()"), expectation);
+	ABI_CHECK(callContractFunction("clear()"), encodeArgs());
+	BOOST_CHECK(storageEmpty(m_contractAddress));
+}
+
 BOOST_AUTO_TEST_CASE(overloaded_function_call_resolve_to_first)
 {
 	char const* sourceCode = R"(
@@ -14234,6 +14272,208 @@ BOOST_AUTO_TEST_CASE(base_access_to_function_type_variables)
 	ABI_CHECK(callContractFunction("h()"), encodeArgs(2));
 }
 
+BOOST_AUTO_TEST_CASE(local_variables_moved_to_memory)
+{
+	char const* sourceCode = R"(
+		contract C {
+			function g(uint x) internal pure returns (uint, uint) { return (x, x * 2); }
+			function f(uint a1, uint a2, uint a3, uint a4) public pure returns (uint r, bytes memory data) {
+				uint8 b1 = uint8(a1 + 1);
+				bool b2 = a2 > 1;
+				bytes4 b3 = bytes4(uint32(a3));
+				address b4 = address(a4);
+				uint b5 = 5;
+				(uint b6, uint b7) = g(a1);
+				uint b8;
+				uint b9 = 9;
+				uint b10 = 10;
+				uint b11 = 11;
+				uint b12 = 12;
+				uint b13 = 13;
+				b8 += 7;
+				b5++;
+				uint[] memory arr = new uint[](3);
+				arr[0] = b5;
+				for (uint i = 0; i < 3; i++) {
+					uint tmp;
+					tmp += i;
+					arr[i] += tmp;
+				}
+				delete b13;
+				r = a1 + a2 + a3 + a4 + b1 + (b2 ? 100 : 0) + uint32(b3) + uint(b4);
+				r += b5 + b6 + b7 + b8 + b9 + b10 + b11 + b12 + b13;
+				r += arr[0] + arr[1] + arr[2];
+				data = abi.encode(b1, b2, b3, b4);
+			}
+			function h() public pure returns (uint r) {
+				(r, ) = f(1, 2, 3, 4);
+			}
+		}
+	)";
+	compileAndRun(sourceCode);
+	ABI_CHECK(
+		callContractFunction("f(uint256,uint256,uint256,uint256)", 1, 2, 3, 4),
+		encodeArgs(186, 0x40, 0x80, 2, true, u256(3) << 224, 4)
+	);
+	ABI_CHECK(callContractFunction("h()"), encodeArgs(186));
+}
+
+BOOST_AUTO_TEST_CASE(packed_storage_array_and_large_bytes_copied_to_memory)
+{
+	char const* sourceCode = R"(
+		contract C {
+			int8[] a;
+			uint24[5] b;
+			function f() public returns (int8[] memory, uint24[5] memory) {
+				for (uint i = 0; i < 35; i++)
+					a.push(int8(int(i) - 17));
+				for (uint i = 0; i < 5; i++)
+					b[i] = uint24(0x10000 + i);
+				return (a, b);
+			}
+			function g() public pure returns (bytes32, bytes32) {
+				bytes memory x = new bytes(1000);
+				for (uint i = 0; i < x.length; i++)
+					x[i] = byte(uint8(i));
+				bytes memory y = abi.encodePacked(x);
+				return (keccak256(x), keccak256(y));
+			}
+		}
+	)";
+	compileAndRun(sourceCode);
+	vector<u256> expectation{0xc0};
+	for (size_t i = 0; i < 5; i++)
+		expectation.push_back(0x10000 + i);
+	expectation.push_back(35);
+	for (size_t i = 0; i < 35; i++)
+		expectation.push_back(s2u(s256(int(i) - 17)));
+	ABI_CHECK(callContractFunction("f()"), encodeArgs(expectation));
+	bytes data(1000);
+	for (size_t i = 0; i < data.size(); i++)
+		data[i] = uint8_t(i);
+	ABI_CHECK(callContractFunction("g()"), encodeArgs(dev::keccak256(data), dev::keccak256(data)));
+}
+
+BOOST_AUTO_TEST_CASE(delete_sparse_storage_arrays)
+{
+	char const* sourceCode = R"(
+		contract C {
+			uint[] a;
+			uint16[] b;
+			uint[3] c;
+			uint[50] d;
+			function f() public returns (uint, uint, uint, uint, uint) {
+				a.length = 20;
+				a[3] = 1;
+				a[17] = 2;
+				a.length = 10;
+				a.length = 20;
+				uint sum = a[3] + a[17];
+				for (uint i = 0; i < 20; i++)
+					b.push(uint16(i));
+				b.length = 16;
+				b.length = 20;
+				sum += b[15] + b[16] + b[19];
+				c[1] = 3;
+				delete c;
+				delete c;
+				d[40] = 4;
+				delete d;
+				sum += c[1] + d[40];
+				delete a;
+				delete b;
+				return (sum, a.length, b.length, c.length, d.length);
+			}
+		}
+	)";
+	compileAndRun(sourceCode);
+	ABI_CHECK(callContractFunction("f()"), encodeArgs(16, 0, 0, 3, 50));
+}
+
+BOOST_AUTO_TEST_CASE(via_ir_control_flow)
+{
+	char const* sourceCode = R"(
+		contract C {
+			function loops(uint n) public pure returns (uint r) {
+				for (uint i = 0; i < n; i++) {
+					uint j = 0;
+					do {
+						j++;
+						if (j % 2 == 0) continue;
+						r += j;
+						if (r > 1000) return r + 1;
+					} while (j < i);
+					if (i == 20) break;
+				}
+				r *= 3;
+			}
+			function swap(uint x, uint y) public pure returns (uint, uint) {
+				(x, y) = (y, x);
+				return (x, y);
+			}
+			function cond(int x) public pure returns (int) {
+				return x > 0 ? -x : (x < -10 ? int(5) : x * x);
+			}
+		}
+	)";
+	for (bool optimize: {false, true})
+	{
+		m_viaIR = true;
+		m_optimize = optimize;
+		compileAndRun(sourceCode);
+		ABI_CHECK(callContractFunction("loops(uint256)", 0), encodeArgs(0));
+		ABI_CHECK(callContractFunction("loops(uint256)", 5), encodeArgs(33));
+		ABI_CHECK(callContractFunction("loops(uint256)", 100), encodeArgs(2313));
+		ABI_CHECK(callContractFunction("swap(uint256,uint256)", 1, 2), encodeArgs(2, 1));
+		ABI_CHECK(callContractFunction("cond(int256)", 3), encodeArgs(u256(-3)));
+		ABI_CHECK(callContractFunction("cond(int256)", u256(-11)), encodeArgs(5));
+		ABI_CHECK(callContractFunction("cond(int256)", u256(-4)), encodeArgs(16));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(via_ir_storage_and_events)
+{
+	char const* sourceCode = R"(
+		contract C {
+			uint8 public a = 7;
+			bool public b;
+			mapping(uint => mapping(address => uint16)) public nested;
+			event E(uint indexed x, bool y);
+			function set(uint8 x, bool y) public {
+				a = x;
+				b = y;
+				nested[x][msg.sender] += x;
+				emit E(x, y);
+			}
+			function fail(uint x) public pure returns (uint) {
+				require(x != 1, "one");
+				assert(x != 2);
+				return x;
+			}
+			function() external payable { a = 99; }
+		}
+	)";
+	for (bool optimize: {false, true})
+	{
+		m_viaIR = true;
+		m_optimize = optimize;
+		compileAndRun(sourceCode);
+		ABI_CHECK(callContractFunction("a()"), encodeArgs(7));
+		ABI_CHECK(callContractFunction("set(uint8,bool)", 3, true), encodeArgs());
+		BOOST_REQUIRE_EQUAL(m_logs.size(), 1);
+		BOOST_CHECK_EQUAL(m_logs[0].topics[1], h256(3));
+		BOOST_CHECK(m_logs[0].data == encodeArgs(true));
+		ABI_CHECK(callContractFunction("set(uint8,bool)", 3, false), encodeArgs());
+		ABI_CHECK(callContractFunction("a()"), encodeArgs(3));
+		ABI_CHECK(callContractFunction("b()"), encodeArgs(false));
+		ABI_CHECK(callContractFunction("nested(uint256,address)", 3, u160(m_sender)), encodeArgs(6));
+		ABI_CHECK(callContractFunction("fail(uint256)", 1), encodeArgs());
+		ABI_CHECK(callContractFunction("fail(uint256)", 3), encodeArgs(3));
+		ABI_CHECK(callContractFunction(""), encodeArgs());
+		ABI_CHECK(callContractFunction("a()"), encodeArgs(99));
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
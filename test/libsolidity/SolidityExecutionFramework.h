@@ -70,6 +70,7 @@ public:
 		m_compiler.setLibraries(_libraryAddresses);
 		m_compiler.setEVMVersion(m_evmVersion);
 		m_compiler.setOptimiserSettings(m_optimize, m_optimizeRuns);
+		m_compiler.setViaIR(m_viaIR);
 		if (!m_compiler.compile())
 		{
 			langutil::SourceReferenceFormatter formatter(std::cerr);
@@ -88,6 +89,8 @@ public:
 
 protected:
 	dev::solidity::CompilerStack m_compiler;
+	/// If true, contracts are compiled via the Yul intermediate representation.
+	bool m_viaIR = false;
 };
 
 }
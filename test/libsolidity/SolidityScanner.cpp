@@ -622,6 +622,54 @@ BOOST_AUTO_TEST_CASE(irregular_line_breaks_in_strings)
 	}
 }
 
+BOOST_AUTO_TEST_CASE(long_whitespace_comments_and_strings)
+{
+	// The lengths cross the block boundaries of the vectorised fast paths.
+	for (size_t length = 0; length < 40; length++)
+	{
+		string const filler(length, 'x');
+		string const space(length, ' ');
+		string const source =
+			space + "a\n" +
+			"// " + filler + "\n" +
+			"/* " + filler + "* */" +
+			"\"" + filler + "\\n\xC3\xA4" + filler + "\"" +
+			"hex\"" + string(length * 2, 'f') + "\"" +
+			"/// " + filler + "\n" +
+			"/** " + filler + "\n * " + filler + " */" +
+			"b";
+		Scanner scanner(CharStream(source, ""));
+		BOOST_CHECK_EQUAL(scanner.currentToken(), Token::Identifier);
+		BOOST_CHECK_EQUAL(scanner.currentLocation().start, int(length));
+		BOOST_CHECK_EQUAL(scanner.next(), Token::StringLiteral);
+		BOOST_CHECK_EQUAL(scanner.currentLiteral(), filler + "\n\xC3\xA4" + filler);
+		int const stringStart = int(source.find('"'));
+		BOOST_CHECK_EQUAL(scanner.currentLocation().start, stringStart);
+		BOOST_CHECK_EQUAL(scanner.currentLocation().end, stringStart + int(2 * length) + 6);
+		BOOST_CHECK_EQUAL(scanner.next(), Token::StringLiteral);
+		BOOST_CHECK_EQUAL(scanner.currentLiteral(), string(length, '\xff'));
+		BOOST_CHECK_EQUAL(scanner.next(), Token::Identifier);
+		BOOST_CHECK_EQUAL(scanner.currentLiteral(), "b");
+		BOOST_CHECK_EQUAL(scanner.currentCommentLiteral(), (length > 0 ? filler + "\n" + filler + " " : " "));
+		BOOST_CHECK_EQUAL(scanner.currentLocation().start, int(source.size()) - 1);
+		BOOST_CHECK_EQUAL(scanner.next(), Token::EOS);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(long_unterminated_comments_and_strings)
+{
+	for (size_t length = 0; length < 40; length++)
+	{
+		string const filler(length, 'x');
+		Scanner comment(CharStream("/* " + filler + "*", ""));
+		BOOST_CHECK_EQUAL(comment.currentError(), ScannerError::IllegalCommentTerminator);
+		Scanner str(CharStream("\"" + filler, ""));
+		BOOST_CHECK_EQUAL(str.currentError(), ScannerError::IllegalStringEndQuote);
+		Scanner hex(CharStream("hex\"" + string(2 * length + 1, 'a') + "\"", ""));
+		BOOST_CHECK_EQUAL(hex.currentError(), ScannerError::IllegalHexString);
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
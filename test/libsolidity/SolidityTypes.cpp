@@ -21,6 +21,7 @@
  */
 
 #include <libsolidity/ast/Types.h>
+#include <libsolidity/ast/TypeProvider.h>
 #include <libsolidity/ast/AST.h>
 #include <libdevcore/Keccak256.h>
 #include <boost/test/unit_test.hpp>
@@ -219,6 +220,32 @@ BOOST_AUTO_TEST_CASE(type_identifiers)
 	BOOST_CHECK_EQUAL(InaccessibleDynamicType().identifier(), "t_inaccessible");
 }
 
+BOOST_AUTO_TEST_CASE(canonical_elementary_types)
+{
+	// Without a provider, every request creates a new type.
+	BOOST_CHECK(Type::fromElementaryTypeName("uint256") != Type::fromElementaryTypeName("uint"));
+
+	TypeProvider provider;
+	TypeProvider::Scope scope(provider);
+	BOOST_CHECK(Type::fromElementaryTypeName("uint256") == Type::fromElementaryTypeName("uint"));
+	BOOST_CHECK(Type::fromElementaryTypeName("uint256") == TypeProvider::uint256());
+	BOOST_CHECK(Type::fromElementaryTypeName("int8") != Type::fromElementaryTypeName("uint8"));
+	BOOST_CHECK(Type::fromElementaryTypeName("byte") == Type::fromElementaryTypeName("bytes1"));
+	BOOST_CHECK(Type::fromElementaryTypeName("address payable") == TypeProvider::address(StateMutability::Payable));
+	BOOST_CHECK(Type::fromElementaryTypeName("address") != TypeProvider::address(StateMutability::Payable));
+	BOOST_CHECK(Type::fromElementaryTypeName("fixed") == Type::fromElementaryTypeName("fixed128x18"));
+
+	TypePointer bytesMemory = Type::fromElementaryTypeName("bytes memory");
+	BOOST_CHECK(bytesMemory == TypeProvider::byteArray(DataLocation::Memory, false));
+	BOOST_CHECK(bytesMemory != Type::fromElementaryTypeName("string memory"));
+	BOOST_CHECK(bytesMemory->mobileType() == bytesMemory);
+	TypePointer bytesStoragePointer = Type::fromElementaryTypeName("bytes storage");
+	auto const& bytesStorage = dynamic_cast<ArrayType const&>(*bytesStoragePointer);
+	BOOST_CHECK(bytesStorage.isPointer());
+	BOOST_CHECK(!dynamic_cast<ArrayType const&>(*bytesStorage.copyForLocation(DataLocation::Storage, false)).isPointer());
+	BOOST_CHECK(*bytesStorage.copyForLocation(DataLocation::Memory, true) == *bytesMemory);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
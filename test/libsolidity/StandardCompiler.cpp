@@ -860,6 +860,41 @@ BOOST_AUTO_TEST_CASE(evm_version)
 	BOOST_CHECK(result["errors"][0]["message"].asString() == "Invalid EVM version requested.");
 }
 
+BOOST_AUTO_TEST_CASE(serialised_output_matches_json_output)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"fileA": {
+				"content": "import \"fileB\"; contract A is B { function f() public pure returns (uint) { return 7; } }"
+			},
+			"fileB": {
+				"content": "contract B { uint x; } contract C { event E(uint indexed); }"
+			}
+		},
+		"settings": {
+			"outputSelection": {
+				"*": { "*": ["abi", "evm.legacyAssembly", "evm.bytecode.object"], "": ["ast"] },
+				"fileB": { "": ["legacyAST"] }
+			}
+		}
+	}
+	)";
+	Json::Value parsedInput;
+	BOOST_REQUIRE(jsonParseStrict(input, parsedInput));
+	solidity::StandardCompiler compiler;
+	string output = compiler.compile(string(input));
+	BOOST_CHECK_EQUAL(output, jsonCompactPrint(compiler.compile(parsedInput)));
+	Json::Value result;
+	BOOST_REQUIRE(jsonParseStrict(output, result));
+	BOOST_CHECK(containsAtMostWarnings(result));
+	BOOST_CHECK(result["sources"]["fileA"]["ast"].isObject());
+	BOOST_CHECK(!result["sources"]["fileA"].isMember("legacyAST"));
+	BOOST_CHECK(result["sources"]["fileB"]["legacyAST"].isObject());
+	BOOST_CHECK_EQUAL(result["sources"]["fileB"]["id"], 1);
+}
+
 
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -0,0 +1,6 @@
+contract A { function f() public {} uint x; }
+contract B is A { function g() public { f(); x = 1; } }
+contract C is B { uint y; }
+contract D is C { uint f; function h() public { g(); y = x; } }
+// ----
+// DeclarationError: (148-154): Identifier already declared.
@@ -0,0 +1,121 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the Yul interpreter.
+ */
+
+#include <test/Options.h>
+
+#include <test/libyul/Common.h>
+#include <test/tools/yulInterpreter/Interpreter.h>
+
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/AsmData.h>
+
+#include <sstream>
+
+using namespace std;
+using namespace dev;
+
+namespace yul
+{
+namespace test
+{
+
+namespace
+{
+
+InterpreterState run(string const& _source)
+{
+	shared_ptr<Block> ast = parse(_source, false).first;
+	BOOST_REQUIRE(ast);
+	InterpreterState state;
+	Interpreter::run(state, *EVMDialect::strictAssemblyForEVM(), *ast);
+	return state;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulInterpreter)
+
+BOOST_AUTO_TEST_CASE(arithmetic_and_storage)
+{
+	InterpreterState state = run(
+		"{ let x := sub(0, 1) sstore(1, sdiv(x, 2)) sstore(2, exp(2, 255)) sstore(3, smod(x, 3)) }"
+	);
+	BOOST_CHECK(!state.resourcesExhausted);
+	BOOST_CHECK_EQUAL(state.storage.size(), 2);
+	BOOST_CHECK(state.storage.count(1) == 0);
+	BOOST_CHECK_EQUAL(state.storage[2], u256(1) << 255);
+	BOOST_CHECK_EQUAL(state.storage[3], ~u256(0));
+}
+
+BOOST_AUTO_TEST_CASE(functions_and_loops)
+{
+	InterpreterState state = run(
+		"{"
+		"  function f(a) -> r { r := add(a, 1) }"
+		"  for { let i := 0 } lt(i, 5) { i := f(i) } { mstore(mul(i, 32), f(i)) }"
+		"  return(0, 160)"
+		"}"
+	);
+	BOOST_REQUIRE_EQUAL(state.trace.size(), 1);
+	BOOST_CHECK_EQUAL(state.trace.front().substr(0, 8), "RETURN()");
+	BOOST_CHECK_EQUAL(state.memory.size(), 160);
+	BOOST_CHECK_EQUAL(int(state.memory[4 * 32 + 31]), 5);
+}
+
+BOOST_AUTO_TEST_CASE(arguments_right_to_left)
+{
+	InterpreterState state = run(
+		"{"
+		"  function f(a, b) {}"
+		"  function g(v) -> r { mstore(0, v) r := v }"
+		"  f(g(1), g(2))"
+		"}"
+	);
+	// The first argument is evaluated last.
+	BOOST_CHECK_EQUAL(int(state.memory[31]), 1);
+}
+
+BOOST_AUTO_TEST_CASE(step_limit)
+{
+	InterpreterState state = run("{ for {} 1 {} {} }");
+	BOOST_CHECK(state.resourcesExhausted);
+}
+
+BOOST_AUTO_TEST_CASE(trace_and_state)
+{
+	InterpreterState state = run("{ sstore(7, 8) mstore(0x20, 0xff) log1(0x3f, 1, 2) }");
+	ostringstream output;
+	state.dumpTraceAndState(output);
+	BOOST_CHECK_EQUAL(
+		output.str(),
+		"Trace:\n"
+		"  LOG1(2) [ff]\n"
+		"Memory dump:\n"
+		"  0x20: 00000000000000000000000000000000000000000000000000000000000000ff\n"
+		"Storage dump:\n"
+		"  0000000000000000000000000000000000000000000000000000000000000007: "
+		"0000000000000000000000000000000000000000000000000000000000000008\n"
+	);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
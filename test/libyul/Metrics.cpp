@@ -110,6 +110,22 @@ BOOST_AUTO_TEST_CASE(assignment_complex)
 	BOOST_CHECK_EQUAL(codeSize("{ let a let x := mload(a) a := sload(x) }"), 2);
 }
 
+BOOST_AUTO_TEST_CASE(including_functions)
+{
+	shared_ptr<Block> ast = parse("{ function f(x) -> r { r := mload(x) } let y := f(2) }", false).first;
+	BOOST_REQUIRE(ast);
+	BOOST_CHECK_EQUAL(CodeSize::codeSize(*ast), 2);
+	BOOST_CHECK_EQUAL(CodeSize::codeSizeIncludingFunctions(*ast), 3);
+}
+
+BOOST_AUTO_TEST_CASE(node_count)
+{
+	shared_ptr<Block> ast = parse("{ function f(x) -> r { r := mload(x) } let y := f(2) }", false).first;
+	BOOST_REQUIRE(ast);
+	// function definition, assignment, mload, x, variable declaration, f(2), 2
+	BOOST_CHECK_EQUAL(NodeCount::nodeCount(*ast), 7);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -71,7 +71,7 @@ BOOST_AUTO_TEST_CASE(single_var_assigned_plus_code)
 BOOST_AUTO_TEST_CASE(single_var_assigned_plus_code_and_reused)
 {
 	string out = assemble("{ let x := 1 mstore(3, 4) pop(mload(x)) }");
-	BOOST_CHECK_EQUAL(out, "PUSH1 0x1 PUSH1 0x4 PUSH1 0x3 MSTORE DUP1 MLOAD POP POP ");
+	BOOST_CHECK_EQUAL(out, "PUSH1 0x1 PUSH1 0x4 PUSH1 0x3 MSTORE MLOAD POP ");
 }
 
 BOOST_AUTO_TEST_CASE(multi_reuse_single_slot)
@@ -91,7 +91,7 @@ BOOST_AUTO_TEST_CASE(multi_reuse_same_variable_name)
 	string out = assemble("{ let z := mload(0) { let x := 1 x := 6 z := x } { let x := 2 z := x x := 4 } }");
 	BOOST_CHECK_EQUAL(out,
 		"PUSH1 0x0 MLOAD "
-		"PUSH1 0x1 PUSH1 0x6 SWAP1 POP DUP1 SWAP2 POP POP "
+		"PUSH1 0x1 PUSH1 0x6 SWAP1 POP SWAP1 POP "
 		"PUSH1 0x2 DUP1 SWAP2 POP PUSH1 0x4 SWAP1 POP POP "
 		"POP "
 	);
@@ -337,14 +337,34 @@ BOOST_AUTO_TEST_CASE(reuse_slots_function_with_gaps)
 		// stack: d c x3 a b
 		"POP "
 		// stack: d c x3 a
-		"DUP1 DUP3 MSTORE "
-		"POP POP "
+		"DUP2 MSTORE " // the last use of a does not need a copy
+		// stack: d c x3
+		"POP "
 		// stack: d c
 		"DUP2 DUP2 MSTORE "
 		"POP POP "
 	);
 }
 
+BOOST_AUTO_TEST_CASE(last_use_on_stack_top)
+{
+	// The values of x and y are consumed by their last use instead of being duplicated.
+	string out = assemble("{ let x := mload(0) let y := add(1, x) sstore(2, y) }");
+	BOOST_CHECK_EQUAL(out, "PUSH1 0x0 MLOAD PUSH1 0x1 ADD PUSH1 0x2 SSTORE ");
+}
+
+BOOST_AUTO_TEST_CASE(last_use_in_loop_condition)
+{
+	// The condition is evaluated repeatedly, so i has to be duplicated.
+	string out = assemble("{ for { let i := mload(0) } i {} {} }");
+	BOOST_CHECK_EQUAL(out,
+		"PUSH1 0x0 MLOAD "
+		"JUMPDEST DUP1 ISZERO PUSH1 0xd JUMPI "
+		"JUMPDEST PUSH1 0x3 JUMP "
+		"JUMPDEST POP "
+	);
+}
+
 
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -21,6 +21,8 @@
 
 #include <test/Options.h>
 
+#include <test/tools/yulInterpreter/Interpreter.h>
+
 #include <libyul/optimiser/BlockFlattener.h>
 #include <libyul/optimiser/VarDeclInitializer.h>
 #include <libyul/optimiser/Disambiguator.h>
@@ -33,6 +35,7 @@
 #include <libyul/optimiser/ExpressionInliner.h>
 #include <libyul/optimiser/FullInliner.h>
 #include <libyul/optimiser/ForLoopInitRewriter.h>
+#include <libyul/optimiser/LoadResolver.h>
 #include <libyul/optimiser/MainFunction.h>
 #include <libyul/optimiser/Rematerialiser.h>
 #include <libyul/optimiser/ExpressionSimplifier.h>
@@ -41,6 +44,7 @@
 #include <libyul/optimiser/SSATransform.h>
 #include <libyul/optimiser/RedundantAssignEliminator.h>
 #include <libyul/optimiser/StructuralSimplifier.h>
+#include <libyul/optimiser/DeadStoreEliminator.h>
 #include <libyul/optimiser/Suite.h>
 #include <libyul/backends/evm/EVMDialect.h>
 #include <libyul/AsmPrinter.h>
@@ -101,6 +105,11 @@ bool YulOptimizerTest::run(ostream& _stream, string const& _linePrefix, bool con
 	if (!parse(_stream, _linePrefix, _formatted))
 		return false;
 
+	// Yul with types cannot be interpreted, only strict assembly.
+	boost::optional<string> traceBefore;
+	if (!m_yul)
+		traceBefore = interpret();
+
 	if (m_optimizerStep == "disambiguator")
 		disambiguate();
 	else if (m_optimizerStep == "blockFlattener")
@@ -218,6 +227,17 @@ bool YulOptimizerTest::run(ostream& _stream, string const& _linePrefix, bool con
 		disambiguate();
 		StructuralSimplifier{*m_dialect}(*m_ast);
 	}
+	else if (m_optimizerStep == "loadResolver")
+	{
+		disambiguate();
+		ForLoopInitRewriter{}(*m_ast);
+		LoadResolver::run(*m_dialect, *m_ast);
+	}
+	else if (m_optimizerStep == "deadStoreEliminator")
+	{
+		disambiguate();
+		DeadStoreEliminator::run(*m_dialect, *m_ast);
+	}
 	else if (m_optimizerStep == "equivalentFunctionCombiner")
 	{
 		disambiguate();
@@ -233,6 +253,21 @@ bool YulOptimizerTest::run(ostream& _stream, string const& _linePrefix, bool con
 
 	m_obtainedResult = m_optimizerStep + "\n" + printer(*m_ast) + "\n";
 
+	if (traceBefore)
+	{
+		boost::optional<string> traceAfter = interpret();
+		if (traceAfter && *traceBefore != *traceAfter)
+		{
+			string nextIndentLevel = _linePrefix + "  ";
+			FormattedScope(_stream, _formatted, {formatting::BOLD, formatting::RED}) << _linePrefix << "Optimizer step changed the behaviour of the code." << endl;
+			FormattedScope(_stream, _formatted, {formatting::BOLD, formatting::CYAN}) << _linePrefix << "Trace before:" << endl;
+			printIndented(_stream, *traceBefore, nextIndentLevel);
+			FormattedScope(_stream, _formatted, {formatting::BOLD, formatting::CYAN}) << _linePrefix << "Trace after:" << endl;
+			printIndented(_stream, *traceAfter, nextIndentLevel);
+			return false;
+		}
+	}
+
 	if (m_expectation != m_obtainedResult)
 	{
 		string nextIndentLevel = _linePrefix + "  ";
@@ -294,6 +329,21 @@ bool YulOptimizerTest::parse(ostream& _stream, string const& _linePrefix, bool c
 	return true;
 }
 
+boost::optional<string> YulOptimizerTest::interpret() const
+{
+	InterpreterState state;
+	state.evmVersion = dev::test::Options::get().evmVersion();
+	// Deterministic non-zero call data, so that calldataload is not constant.
+	for (size_t i = 0; i < 128; ++i)
+		state.calldata.push_back(uint8_t(i * 7 + 1));
+	Interpreter::run(state, *m_dialect, *m_ast);
+	if (state.resourcesExhausted)
+		return boost::none;
+	ostringstream trace;
+	state.dumpTraceAndState(trace);
+	return trace.str();
+}
+
 void YulOptimizerTest::disambiguate()
 {
 	*m_ast = boost::get<Block>(Disambiguator(*m_dialect, *m_analysisInfo)(*m_ast));
@@ -19,6 +19,8 @@
 
 #include <test/TestCase.h>
 
+#include <boost/optional.hpp>
+
 namespace langutil
 {
 class Scanner;
@@ -57,6 +59,9 @@ private:
 	void printIndented(std::ostream& _stream, std::string const& _output, std::string const& _linePrefix = "") const;
 	bool parse(std::ostream& _stream, std::string const& _linePrefix, bool const _formatted);
 	void disambiguate();
+	/// Runs the interpreter on the current AST and @returns the trace and final state
+	/// or boost::none if the outcome depends on resource limits.
+	boost::optional<std::string> interpret() const;
 
 	static void printErrors(std::ostream& _stream, langutil::ErrorList const& _errors);
 
@@ -18,132 +18,19 @@
  * Executable for use with AFL <http://lcamtuf.coredump.cx/afl>.
  */
 
-#include <libdevcore/CommonIO.h>
-#include <libevmasm/Assembly.h>
-#include <libevmasm/ConstantOptimiser.h>
-#include <libsolc/libsolc.h>
+#include <test/tools/fuzzer_common.h>
 
-#include <libdevcore/JSON.h>
+#include <libdevcore/CommonIO.h>
 
 #include <boost/program_options.hpp>
 
 #include <string>
-#include <sstream>
 #include <iostream>
 
 using namespace std;
 using namespace dev;
-using namespace dev::eth;
 namespace po = boost::program_options;
 
-namespace
-{
-
-bool quiet = false;
-
-string contains(string const& _haystack, vector<string> const& _needles)
-{
-	for (string const& needle: _needles)
-		if (_haystack.find(needle) != string::npos)
-			return needle;
-	return "";
-}
-
-void testConstantOptimizer(string const& input)
-{
-	if (!quiet)
-		cout << "Testing constant optimizer" << endl;
-	vector<u256> numbers;
-	stringstream sin(input);
-
-	while (!sin.eof())
-	{
-		h256 data;
-		sin.read(reinterpret_cast<char*>(data.data()), 32);
-		numbers.push_back(u256(data));
-	}
-	if (!quiet)
-		cout << "Got " << numbers.size() << " inputs:" << endl;
-
-	Assembly assembly;
-	for (u256 const& n: numbers)
-	{
-		if (!quiet)
-			cout << n << endl;
-		assembly.append(n);
-	}
-	for (bool isCreation: {false, true})
-	{
-		for (unsigned runs: {1, 2, 3, 20, 40, 100, 200, 400, 1000})
-		{
-			ConstantOptimisationMethod::optimiseConstants(
-				isCreation,
-				runs,
-				EVMVersion{},
-				assembly,
-				const_cast<AssemblyItems&>(assembly.items())
-			);
-		}
-	}
-}
-
-void runCompiler(string input)
-{
-	string outputString(solidity_compile(input.c_str(), nullptr));
-	Json::Value output;
-	if (!jsonParseStrict(outputString, output))
-	{
-		cout << "Compiler produced invalid JSON output." << endl;
-		abort();
-	}
-	if (output.isMember("errors"))
-		for (auto const& error: output["errors"])
-		{
-			string invalid = contains(error["type"].asString(), vector<string>{
-				"Exception",
-				"InternalCompilerError"
-			});
-			if (!invalid.empty())
-			{
-				cout << "Invalid error: \"" << error["type"].asString() << "\"" << endl;
-				abort();
-			}
-		}
-}
-
-void testStandardCompiler(string const& input)
-{
-	if (!quiet)
-		cout << "Testing compiler via JSON interface." << endl;
-
-	runCompiler(input);
-}
-
-void testCompiler(string const& input, bool optimize)
-{
-	if (!quiet)
-		cout << "Testing compiler " << (optimize ? "with" : "without") << " optimizer." << endl;
-
-	Json::Value config = Json::objectValue;
-	config["language"] = "Solidity";
-	config["sources"] = Json::objectValue;
-	config["sources"][""] = Json::objectValue;
-	config["sources"][""]["content"] = input;
-	config["settings"] = Json::objectValue;
-	config["settings"]["optimizer"] = Json::objectValue;
-	config["settings"]["optimizer"]["enabled"] = optimize;
-	config["settings"]["optimizer"]["runs"] = 200;
-
-	// Enable all SourceUnit-level outputs.
-	config["settings"]["outputSelection"]["*"][""][0] = "*";
-	// Enable all Contract-level outputs.
-	config["settings"]["outputSelection"]["*"]["*"][0] = "*";
-
-	runCompiler(jsonCompactPrint(config));
-}
-
-}
-
 int main(int argc, char** argv)
 {
 	po::options_description options(
@@ -168,6 +55,16 @@ Allowed options)",
 			"Run the constant optimizer instead of compiling. "
 			"Expects a binary string of up to 32 bytes on stdin."
 		)
+		(
+			"asm-opt",
+			"Run the assembly optimizer instead of compiling. "
+			"Expects EVM bytecode on stdin."
+		)
+		(
+			"yul-opt",
+			"Run the Yul optimizer instead of compiling. "
+			"Expects strict assembly on stdin."
+		)
 		(
 			"input-file",
 			po::value<string>(),
@@ -201,17 +98,20 @@ Allowed options)",
 	else
 		input = readStandardInput();
 
-	if (arguments.count("quiet"))
-		quiet = true;
+	bool quiet = arguments.count("quiet");
 
 	if (arguments.count("help"))
 		cout << options;
 	else if (arguments.count("const-opt"))
-		testConstantOptimizer(input);
+		FuzzerUtil::testConstantOptimizer(input, quiet);
+	else if (arguments.count("asm-opt"))
+		FuzzerUtil::testAssemblyOptimizer(input, quiet);
+	else if (arguments.count("yul-opt"))
+		FuzzerUtil::testYulOptimizer(input, quiet);
 	else if (arguments.count("standard-json"))
-		testStandardCompiler(input);
+		FuzzerUtil::runCompiler(input, quiet);
 	else
-		testCompiler(input, !arguments.count("without-optimizer"));
+		FuzzerUtil::testCompiler(input, !arguments.count("without-optimizer"), quiet);
 
 	return 0;
 }
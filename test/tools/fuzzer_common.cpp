@@ -0,0 +1,178 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <test/tools/fuzzer_common.h>
+
+#include <libdevcore/JSON.h>
+#include <libevmasm/Assembly.h>
+#include <libevmasm/ConstantOptimiser.h>
+#include <libsolc/libsolc.h>
+#include <libsolidity/interface/AssemblyStack.h>
+
+#include <sstream>
+#include <iostream>
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+using namespace dev::solidity;
+
+namespace
+{
+
+string contains(string const& _haystack, vector<string> const& _needles)
+{
+	for (string const& needle: _needles)
+		if (_haystack.find(needle) != string::npos)
+			return needle;
+	return "";
+}
+
+}
+
+void FuzzerUtil::runCompiler(string const& _input, bool _quiet)
+{
+	if (!_quiet)
+		cout << "Testing compiler via JSON interface." << endl;
+
+	string outputString(solidity_compile(_input.c_str(), nullptr));
+	Json::Value output;
+	if (!jsonParseStrict(outputString, output))
+	{
+		cout << "Compiler produced invalid JSON output." << endl;
+		abort();
+	}
+	if (output.isMember("errors"))
+		for (auto const& error: output["errors"])
+		{
+			string invalid = contains(error["type"].asString(), vector<string>{
+				"Exception",
+				"InternalCompilerError"
+			});
+			if (!invalid.empty())
+			{
+				cout << "Invalid error: \"" << error["type"].asString() << "\"" << endl;
+				abort();
+			}
+		}
+}
+
+void FuzzerUtil::testCompiler(string const& _input, bool _optimize, bool _quiet)
+{
+	if (!_quiet)
+		cout << "Testing compiler " << (_optimize ? "with" : "without") << " optimizer." << endl;
+
+	Json::Value config = Json::objectValue;
+	config["language"] = "Solidity";
+	config["sources"] = Json::objectValue;
+	config["sources"][""] = Json::objectValue;
+	config["sources"][""]["content"] = _input;
+	config["settings"] = Json::objectValue;
+	config["settings"]["optimizer"] = Json::objectValue;
+	config["settings"]["optimizer"]["enabled"] = _optimize;
+	config["settings"]["optimizer"]["runs"] = 200;
+
+	// Enable all SourceUnit-level outputs.
+	config["settings"]["outputSelection"]["*"][""][0] = "*";
+	// Enable all Contract-level outputs.
+	config["settings"]["outputSelection"]["*"]["*"][0] = "*";
+
+	runCompiler(jsonCompactPrint(config), true);
+}
+
+void FuzzerUtil::testConstantOptimizer(string const& _input, bool _quiet)
+{
+	if (!_quiet)
+		cout << "Testing constant optimizer" << endl;
+	vector<u256> numbers;
+	stringstream sin(_input);
+
+	while (!sin.eof())
+	{
+		h256 data;
+		sin.read(reinterpret_cast<char*>(data.data()), 32);
+		numbers.push_back(u256(data));
+	}
+	if (!_quiet)
+		cout << "Got " << numbers.size() << " inputs:" << endl;
+
+	Assembly assembly;
+	for (u256 const& n: numbers)
+	{
+		if (!_quiet)
+			cout << n << endl;
+		assembly.append(n);
+	}
+	for (bool isCreation: {false, true})
+	{
+		for (unsigned runs: {1, 2, 3, 20, 40, 100, 200, 400, 1000})
+		{
+			ConstantOptimisationMethod::optimiseConstants(
+				isCreation,
+				runs,
+				EVMVersion{},
+				assembly,
+				const_cast<AssemblyItems&>(assembly.items())
+			);
+		}
+	}
+}
+
+void FuzzerUtil::testAssemblyOptimizer(string const& _input, bool _quiet)
+{
+	if (!_quiet)
+		cout << "Testing assembly optimizer" << endl;
+
+	for (bool isCreation: {false, true})
+		for (unsigned runs: {1, 200, 1000})
+		{
+			Assembly assembly;
+			for (size_t i = 0; i < _input.size(); ++i)
+			{
+				Instruction instruction = Instruction(uint8_t(_input[i]));
+				if (!isValidInstruction(instruction))
+					continue;
+				if (isPushInstruction(instruction))
+				{
+					u256 value;
+					for (unsigned j = 0; j < getPushNumber(instruction); ++j)
+						value = (value << 8) | (++i < _input.size() ? uint8_t(_input[i]) : 0);
+					assembly.append(value);
+				}
+				else if (instruction == Instruction::JUMPDEST)
+					assembly.append(assembly.newTag());
+				// Skip instructions that would underflow the stack, the assembly does not allow them.
+				else if (assembly.deposit() >= instructionInfo(instruction).args)
+					assembly.append(instruction);
+			}
+			assembly.optimise(true, EVMVersion{}, isCreation, runs);
+			assembly.assemble();
+		}
+}
+
+void FuzzerUtil::testYulOptimizer(string const& _input, bool _quiet)
+{
+	if (!_quiet)
+		cout << "Testing Yul optimizer" << endl;
+
+	AssemblyStack stack(EVMVersion{}, AssemblyStack::Language::StrictAssembly);
+	// Invalid input is not interesting, only crashes during optimisation and code generation are.
+	if (!stack.parseAndAnalyze("", _input))
+		return;
+	stack.optimize();
+	stack.assemble(AssemblyStack::Machine::EVM, true);
+}
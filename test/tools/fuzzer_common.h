@@ -0,0 +1,41 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Fuzzing actions shared between the solfuzzer binary and the in-process fuzzing harnesses.
+ */
+
+#pragma once
+
+#include <string>
+
+/**
+ * Collection of fuzzing actions. Each of them aborts the process if the
+ * compiler reports an internal error or produces invalid output.
+ */
+struct FuzzerUtil
+{
+	/// Runs the Standard JSON input @a _input through solidity_compile.
+	static void runCompiler(std::string const& _input, bool _quiet);
+	/// Compiles the Solidity source @a _input with all outputs enabled.
+	static void testCompiler(std::string const& _input, bool _optimize, bool _quiet);
+	/// Interprets @a _input as a sequence of 32 byte numbers and runs the constant optimiser on them.
+	static void testConstantOptimizer(std::string const& _input, bool _quiet);
+	/// Interprets @a _input as EVM bytecode, turns it into an assembly and optimises it.
+	static void testAssemblyOptimizer(std::string const& _input, bool _quiet);
+	/// Parses @a _input as strict assembly, runs the Yul optimiser on it and assembles the result.
+	static void testYulOptimizer(std::string const& _input, bool _quiet);
+};
@@ -0,0 +1,397 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Gas profiler: compiles a contract, executes a list of transactions against it
+ * in an in-process EVM and attributes the consumed gas to source lines, functions
+ * and source ranges through the source mapping of the assembly items.
+ */
+
+#include <test/tools/yulInterpreter/EVMBytecodeInterpreter.h>
+
+#include <libsolidity/interface/CompilerStack.h>
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTVisitor.h>
+
+#include <liblangutil/CharStream.h>
+#include <liblangutil/SourceReferenceFormatter.h>
+
+#include <libevmasm/AssemblyItem.h>
+
+#include <libdevcore/CommonIO.h>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace std;
+using namespace dev;
+using namespace langutil;
+using namespace dev::solidity;
+using namespace yul::test;
+
+namespace po = boost::program_options;
+
+namespace
+{
+
+/// Source range of a function or modifier together with its qualified name.
+struct FunctionRange
+{
+	string sourceName;
+	int start;
+	int end;
+	string name;
+};
+
+class FunctionCollector: public ASTConstVisitor
+{
+public:
+	explicit FunctionCollector(vector<FunctionRange>& _ranges): m_ranges(_ranges) {}
+
+	bool visit(ContractDefinition const& _contract) override
+	{
+		m_contractName = _contract.name();
+		return true;
+	}
+	void endVisit(ContractDefinition const&) override { m_contractName.clear(); }
+	bool visit(FunctionDefinition const& _function) override
+	{
+		string name = _function.isConstructor() ? "constructor" : _function.isFallback() ? "fallback" : _function.name();
+		add(_function.location(), name);
+		return false;
+	}
+	bool visit(ModifierDefinition const& _modifier) override
+	{
+		add(_modifier.location(), _modifier.name());
+		return false;
+	}
+
+private:
+	void add(SourceLocation const& _location, string const& _name)
+	{
+		if (_location.source)
+			m_ranges.push_back({_location.source->name(), _location.start, _location.end, m_contractName + "." + _name});
+	}
+
+	vector<FunctionRange>& m_ranges;
+	string m_contractName;
+};
+
+/**
+ * Attributes the gas used by each executed instruction to the source location of the
+ * assembly item it was generated from and to the call stack of internal functions.
+ * Internal calls and returns are detected from the jump types of the assembly items.
+ */
+class GasProfiler
+{
+public:
+	GasProfiler(vector<FunctionRange> _functions, vector<string> const& _sourceNames, string _contractName):
+		m_functions(move(_functions)),
+		m_sourceNames(_sourceNames.begin(), _sourceNames.end()),
+		m_contractName(move(_contractName))
+	{}
+
+	/// Executes the code in @a _state and attributes its gas to @a _items.
+	/// @returns true on success.
+	bool execute(InterpreterState& _state, eth::AssemblyItems const& _items, bytes& o_output)
+	{
+		// Every assembly item is assembled into exactly one instruction.
+		map<size_t, size_t> itemAtPC;
+		for (size_t pc = 0, index = 0; pc < _state.code.size() && index < _items.size(); ++pc, ++index)
+		{
+			itemAtPC[pc] = index;
+			auto instruction = Instruction(_state.code[pc]);
+			if (isPushInstruction(instruction))
+				pc += getPushNumber(instruction);
+		}
+
+		vector<string> callStack{m_contractName};
+		bool enteringFunction = false;
+		EVMBytecodeInterpreter interpreter(_state);
+		bool success = interpreter.run([&](size_t _pc, Instruction, u256 const& _gas) {
+			auto it = itemAtPC.find(_pc);
+			if (it == itemAtPC.end())
+			{
+				record(callStack, "<unknown>", SourceLocation{}, _gas);
+				return;
+			}
+			eth::AssemblyItem const& item = _items[it->second];
+			string function = functionAt(item.location());
+			if (enteringFunction)
+			{
+				callStack.push_back(function);
+				enteringFunction = false;
+			}
+			record(callStack, function, item.location(), _gas);
+			if (item.getJumpType() == eth::AssemblyItem::JumpType::IntoFunction)
+				enteringFunction = true;
+			else if (item.getJumpType() == eth::AssemblyItem::JumpType::OutOfFunction && callStack.size() > 1)
+				callStack.pop_back();
+		});
+		o_output = interpreter.output();
+		return success;
+	}
+
+	void printReport(ostream& _out, size_t _top) const
+	{
+		printTable(_out, "Gas by function", m_gasByFunction, _top);
+		printTable(_out, "Gas by source line", m_gasByLine, _top);
+		printTable(_out, "Gas by source range", m_gasByRange, _top);
+	}
+
+	/// Prints the gas per call stack in the "folded" format used by flamegraph.pl.
+	void printFolded(ostream& _out) const
+	{
+		for (auto const& entry: m_gasByStack)
+			_out << entry.first << " " << entry.second << endl;
+	}
+
+private:
+	string functionAt(SourceLocation const& _location) const
+	{
+		if (!_location.source || _location.start < 0)
+			return "<unknown>";
+		// Utility code inserted by the code generator.
+		if (!m_sourceNames.count(_location.source->name()))
+			return "<generated>";
+		FunctionRange const* innermost = nullptr;
+		for (auto const& range: m_functions)
+			if (
+				range.sourceName == _location.source->name() &&
+				range.start <= _location.start &&
+				_location.end <= range.end &&
+				(!innermost || range.end - range.start < innermost->end - innermost->start)
+			)
+				innermost = &range;
+		return innermost ? innermost->name : m_contractName + ".<dispatch>";
+	}
+
+	void record(vector<string> const& _callStack, string const& _function, SourceLocation const& _location, u256 const& _gas)
+	{
+		string stack = boost::algorithm::join(_callStack, ";");
+		if (_callStack.back() != _function)
+			stack += ";" + _function;
+		m_gasByStack[stack] += _gas;
+		m_gasByFunction[_function] += _gas;
+
+		if (!_location.source || _location.start < 0)
+		{
+			m_gasByLine["<unknown>"] += _gas;
+			m_gasByRange["<unknown>"] += _gas;
+			return;
+		}
+		int line = get<0>(_location.source->translatePositionToLineColumn(_location.start));
+		m_gasByLine[_location.source->name() + ":" + to_string(line + 1)] += _gas;
+
+		string snippet = _location.source->source().substr(
+			size_t(_location.start),
+			size_t(max(0, _location.end - _location.start))
+		);
+		snippet = snippet.substr(0, snippet.find('\n'));
+		if (snippet.size() > 40)
+			snippet = snippet.substr(0, 37) + "...";
+		m_gasByRange[
+			_location.source->name() + ":" + to_string(_location.start) + ":" +
+			to_string(_location.end - _location.start) + " " + snippet
+		] += _gas;
+	}
+
+	static void printTable(ostream& _out, string const& _title, map<string, u256> const& _gas, size_t _top)
+	{
+		vector<pair<u256, string>> sorted;
+		u256 total = 0;
+		for (auto const& entry: _gas)
+		{
+			sorted.emplace_back(entry.second, entry.first);
+			total += entry.second;
+		}
+		sort(sorted.begin(), sorted.end(), [](pair<u256, string> const& _a, pair<u256, string> const& _b) {
+			return tie(_b.first, _a.second) < tie(_a.first, _b.second);
+		});
+		_out << _title << " (total " << total << "):" << endl;
+		for (size_t i = 0; i < sorted.size() && i < _top; ++i)
+		{
+			string gas = sorted[i].first.str();
+			_out << "  " << string(gas.size() < 10 ? 10 - gas.size() : 0, ' ') << gas << "  " << sorted[i].second << endl;
+		}
+		_out << endl;
+	}
+
+	vector<FunctionRange> m_functions;
+	set<string> m_sourceNames;
+	string m_contractName;
+	map<string, u256> m_gasByStack;
+	map<string, u256> m_gasByFunction;
+	map<string, u256> m_gasByLine;
+	map<string, u256> m_gasByRange;
+};
+
+bytes parseHex(string _input)
+{
+	boost::algorithm::trim(_input);
+	if (boost::algorithm::starts_with(_input, "0x"))
+		_input = _input.substr(2);
+	return fromHex(_input, WhenError::Throw);
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	vector<string> inputFiles;
+	string contractName;
+	vector<string> transactions;
+	string transactionFile;
+	string constructorArguments;
+	string foldedOutput;
+	size_t top = 20;
+	u256 gasLimit = 8000000;
+	po::options_description options(
+		R"(gasprofiler, executes transactions against a contract and reports where gas is spent.
+Usage: gasprofiler [Options] --tx <calldata> ... <file>...
+The contract is deployed first and the transactions are then executed in order
+on the same storage. Calls to other contracts are not executed, they succeed
+without return data.
+
+Allowed options)",
+		po::options_description::m_default_line_length,
+		po::options_description::m_default_line_length - 23);
+	options.add_options()
+		("help", "Show this help screen.")
+		("input-file", po::value<vector<string>>(&inputFiles), "Solidity source files.")
+		("contract", po::value<string>(&contractName), "Name of the contract to profile (default: the last one).")
+		("optimize", "Enable the optimizer.")
+		("tx", po::value<vector<string>>(&transactions), "Call data of a transaction, hex encoded.")
+		("tx-file", po::value<string>(&transactionFile), "File with the call data of one transaction per line.")
+		("constructor-args", po::value<string>(&constructorArguments), "Hex encoded constructor arguments.")
+		("gas-limit", po::value<u256>(&gasLimit), "Gas limit of each transaction.")
+		("top", po::value<size_t>(&top), "Number of entries per table.")
+		("folded", po::value<string>(&foldedOutput), "Write the gas per call stack in flamegraph.pl format to this file (\"-\" for standard output).");
+	po::positional_options_description filesPositions;
+	filesPositions.add("input-file", -1);
+	po::variables_map arguments;
+	try
+	{
+		po::command_line_parser cmdLineParser(argc, argv);
+		cmdLineParser.options(options).positional(filesPositions);
+		po::store(cmdLineParser.run(), arguments);
+		po::notify(arguments);
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+	if (arguments.count("help") || inputFiles.empty())
+	{
+		cout << options;
+		return arguments.count("help") ? 0 : 1;
+	}
+
+	CompilerStack compiler;
+	compiler.setOptimiserSettings(arguments.count("optimize") > 0);
+	for (auto const& file: inputFiles)
+		compiler.addSource(file, readFileAsString(file));
+	if (!compiler.compile())
+	{
+		SourceReferenceFormatter formatter(cerr);
+		for (auto const& error: compiler.errors())
+			formatter.printExceptionInformation(*error, (error->type() == Error::Type::Warning) ? "Warning" : "Error");
+		return 1;
+	}
+	if (contractName.empty())
+		contractName = compiler.lastContractName();
+
+	vector<FunctionRange> functions;
+	FunctionCollector collector(functions);
+	for (auto const& sourceName: compiler.sourceNames())
+		compiler.ast(sourceName).accept(collector);
+
+	if (!transactionFile.empty())
+	{
+		string content = readFileAsString(transactionFile);
+		vector<string> lines;
+		boost::algorithm::split(lines, content, boost::is_any_of("\n"));
+		for (auto const& line: lines)
+			if (!boost::algorithm::trim_copy(line).empty())
+				transactions.push_back(line);
+	}
+
+	string const shortName = contractName.substr(contractName.find(':') + 1);
+	GasProfiler profiler(functions, compiler.sourceNames(), shortName);
+	InterpreterState state;
+	state.callvalue = 0;
+	state.gasLimit = gasLimit;
+	state.maxSteps = 100000000;
+
+	auto runTransaction = [&](bytes _code, bytes _calldata, eth::AssemblyItems const& _items, string const& _description)
+	{
+		state.code = move(_code);
+		state.calldata = move(_calldata);
+		state.memory.clear();
+		state.returndata.clear();
+		state.trace.clear();
+		state.gasUsed = 0;
+		state.numSteps = 0;
+		bytes output;
+		bool success = profiler.execute(state, _items, output);
+		cout << _description << ": " << (success ? "success" : "failure") << ", " << state.gasUsed << " gas" << endl;
+		if (!success)
+			for (auto const& line: state.trace)
+				cout << "  " << line << endl;
+		return make_pair(success, output);
+	};
+
+	eth::AssemblyItems const* creationItems = compiler.assemblyItems(contractName);
+	eth::AssemblyItems const* runtimeItems = compiler.runtimeAssemblyItems(contractName);
+	if (!creationItems || !runtimeItems)
+	{
+		cerr << "Contract " << contractName << " cannot be deployed." << endl;
+		return 1;
+	}
+	// Constructor arguments are appended to the creation code.
+	auto deployment = runTransaction(
+		compiler.object(contractName).bytecode + parseHex(constructorArguments),
+		{},
+		*creationItems,
+		"Deployment"
+	);
+	if (!deployment.first)
+		return 1;
+
+	for (size_t i = 0; i < transactions.size(); ++i)
+		runTransaction(deployment.second, parseHex(transactions[i]), *runtimeItems, "Transaction " + to_string(i));
+	cout << endl;
+
+	profiler.printReport(cout, top);
+	if (foldedOutput == "-")
+		profiler.printFolded(cout);
+	else if (!foldedOutput.empty())
+	{
+		ofstream out(foldedOutput);
+		profiler.printFolded(out);
+	}
+	return 0;
+}
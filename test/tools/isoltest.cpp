@@ -16,6 +16,7 @@
 */
 
 #include <libdevcore/CommonIO.h>
+#include <libdevcore/ThreadPool.h>
 
 #include <test/Common.h>
 #include <test/libsolidity/AnalysisFramework.h>
@@ -74,13 +75,22 @@ public:
 		Exception
 	};
 
+	/// Runs the test and reports the result on standard output.
 	Result process();
-
+	/// Runs the test without producing any output, so that it can be called
+	/// from a worker thread. The result has to be reported using @a report.
+	Result run();
+	/// Reports the result of a previous call to @a run on standard output.
+	Result report(Result _result);
+
+	/// Runs all tests found under @a _path. If @a _jobs is larger than one,
+	/// the tests are run concurrently and reported in order afterwards.
 	static TestStats processPath(
 		TestCase::TestCaseCreator _testCaseCreator,
 		fs::path const& _basepath,
 		fs::path const& _path,
-		bool const _formatted
+		bool const _formatted,
+		size_t _jobs
 	);
 
 	static string editor;
@@ -99,6 +109,8 @@ private:
 	string const m_name;
 	fs::path const m_path;
 	unique_ptr<TestCase> m_test;
+	std::stringstream m_outputMessages;
+	string m_exceptionMessage;
 	static bool m_exitRequested;
 };
 
@@ -107,50 +119,62 @@ bool TestTool::m_exitRequested = false;
 
 TestTool::Result TestTool::process()
 {
-	bool success;
-	std::stringstream outputMessages;
-
 	(FormattedScope(cout, m_formatted, {BOLD}) << m_name << ": ").flush();
+	return report(run());
+}
+
+TestTool::Result TestTool::run()
+{
+	m_outputMessages.str(string());
+	m_exceptionMessage.clear();
 
 	try
 	{
 		m_test = m_testCaseCreator(m_path.string());
-		success = m_test->run(outputMessages, "  ", m_formatted);
+		if (m_test->run(m_outputMessages, "  ", m_formatted))
+		{
+			// Only failed tests are needed afterwards, release the compiler state early.
+			m_test.reset();
+			return Result::Success;
+		}
+		else
+			return Result::Failure;
 	}
 	catch(boost::exception const& _e)
 	{
-		FormattedScope(cout, m_formatted, {BOLD, RED}) <<
-			"Exception during syntax test: " << boost::diagnostic_information(_e) << endl;
-		return Result::Exception;
+		m_exceptionMessage = "Exception during syntax test: " + boost::diagnostic_information(_e);
 	}
 	catch (std::exception const& _e)
 	{
-		FormattedScope(cout, m_formatted, {BOLD, RED}) <<
-			"Exception during syntax test: " << _e.what() << endl;
-		return Result::Exception;
+		m_exceptionMessage = "Exception during syntax test: " + string(_e.what());
 	}
 	catch (...)
 	{
-		FormattedScope(cout, m_formatted, {BOLD, RED}) <<
-			"Unknown exception during syntax test." << endl;
-		return Result::Exception;
+		m_exceptionMessage = "Unknown exception during syntax test.";
 	}
+	return Result::Exception;
+}
 
-	if (success)
+TestTool::Result TestTool::report(Result _result)
+{
+	switch (_result)
 	{
+	case Result::Exception:
+		FormattedScope(cout, m_formatted, {BOLD, RED}) << m_exceptionMessage << endl;
+		break;
+	case Result::Success:
 		FormattedScope(cout, m_formatted, {BOLD, GREEN}) << "OK" << endl;
-		return Result::Success;
-	}
-	else
-	{
+		break;
+	case Result::Failure:
 		FormattedScope(cout, m_formatted, {BOLD, RED}) << "FAIL" << endl;
 
 		FormattedScope(cout, m_formatted, {BOLD, CYAN}) << "  Contract:" << endl;
 		m_test->printSource(cout, "    ", m_formatted);
 
-		cout << endl << outputMessages.str() << endl;
-		return Result::Failure;
+		cout << endl << m_outputMessages.str() << endl;
+		break;
 	}
+	return _result;
 }
 
 TestTool::Request TestTool::handleResponse(bool const _exception)
@@ -198,22 +222,23 @@ TestStats TestTool::processPath(
 	TestCase::TestCaseCreator _testCaseCreator,
 	fs::path const& _basepath,
 	fs::path const& _path,
-	bool const _formatted
+	bool const _formatted,
+	size_t _jobs
 )
 {
+	// Collect the test files first, so that they can be run ahead of time
+	// and still be reported in traversal order.
+	vector<fs::path> testPaths;
 	std::queue<fs::path> paths;
 	paths.push(_path);
-	int successCount = 0;
-	int testCount = 0;
-
 	while (!paths.empty())
 	{
 		auto currentPath = paths.front();
+		paths.pop();
 
 		fs::path fullpath = _basepath / currentPath;
 		if (fs::is_directory(fullpath))
 		{
-			paths.pop();
 			for (auto const& entry: boost::iterator_range<fs::directory_iterator>(
 				fs::directory_iterator(fullpath),
 				fs::directory_iterator()
@@ -221,46 +246,62 @@ TestStats TestTool::processPath(
 				if (fs::is_directory(entry.path()) || TestCase::isTestFilename(entry.path().filename()))
 					paths.push(currentPath / entry.path().filename());
 		}
-		else if (m_exitRequested)
-		{
-			++testCount;
-			paths.pop();
-		}
 		else
+			testPaths.push_back(currentPath);
+	}
+
+	vector<unique_ptr<TestTool>> testTools;
+	for (auto const& testPath: testPaths)
+		testTools.emplace_back(new TestTool(_testCaseCreator, testPath.string(), _basepath / testPath, _formatted));
+
+	vector<Result> precomputedResults;
+	if (_jobs > 1 && !m_exitRequested)
+	{
+		precomputedResults.resize(testTools.size());
+		ThreadPool pool(_jobs);
+		for (size_t i = 0; i < testTools.size(); ++i)
+			pool.post([&, i]() { precomputedResults[i] = testTools[i]->run(); });
+		pool.wait();
+	}
+
+	int successCount = 0;
+	int testCount = 0;
+
+	for (size_t i = 0; i < testTools.size(); ++i)
+	{
+		++testCount;
+		TestTool& testTool = *testTools[i];
+		bool precomputed = i < precomputedResults.size();
+
+		while (!m_exitRequested)
 		{
-			++testCount;
-			TestTool testTool(_testCaseCreator, currentPath.string(), fullpath, _formatted);
-			auto result = testTool.process();
+			Result result;
+			if (precomputed)
+			{
+				(FormattedScope(cout, _formatted, {BOLD}) << testTool.m_name << ": ").flush();
+				result = testTool.report(precomputedResults[i]);
+				precomputed = false;
+			}
+			else
+				result = testTool.process();
 
-			switch(result)
+			if (result == Result::Success)
 			{
-			case Result::Failure:
-			case Result::Exception:
-				switch(testTool.handleResponse(result == Result::Exception))
-				{
-				case Request::Quit:
-					paths.pop();
-					m_exitRequested = true;
-					break;
-				case Request::Rerun:
-					cout << "Re-running test case..." << endl;
-					--testCount;
-					break;
-				case Request::Skip:
-					paths.pop();
-					break;
-				}
-				break;
-			case Result::Success:
-				paths.pop();
 				++successCount;
 				break;
 			}
+
+			Request request = testTool.handleResponse(result == Result::Exception);
+			if (request == Request::Quit)
+				m_exitRequested = true;
+			else if (request == Request::Rerun)
+				cout << "Re-running test case..." << endl;
+			else
+				break;
 		}
 	}
 
 	return { successCount, testCount };
-
 }
 
 namespace
@@ -291,7 +332,8 @@ boost::optional<TestStats> runTestSuite(
 	fs::path const& _basePath,
 	fs::path const& _subdirectory,
 	TestCase::TestCaseCreator _testCaseCreator,
-	bool _formatted
+	bool _formatted,
+	size_t _jobs
 )
 {
 	fs::path testPath = _basePath / _subdirectory;
@@ -302,7 +344,7 @@ boost::optional<TestStats> runTestSuite(
 		return {};
 	}
 
-	TestStats stats = TestTool::processPath(_testCaseCreator, _basePath, _subdirectory, _formatted);
+	TestStats stats = TestTool::processPath(_testCaseCreator, _basePath, _subdirectory, _formatted, _jobs);
 
 	cout << endl << _name << " Test Summary: ";
 	FormattedScope(cout, _formatted, {BOLD, stats ? GREEN : RED}) <<
@@ -328,6 +370,7 @@ int main(int argc, char *argv[])
 	fs::path testPath;
 	bool disableSMT = false;
 	bool formatted = true;
+	size_t jobs = 1;
 	po::options_description options(
 		R"(isoltest, tool for interactively managing test contracts.
 Usage: isoltest [Options] --testpath path
@@ -341,6 +384,7 @@ Allowed options)",
 		("testpath", po::value<fs::path>(&testPath), "path to test files")
 		("no-smt", "disable SMT checker")
 		("no-color", "don't use colors")
+		("jobs,j", po::value<size_t>(&jobs), "number of tests to run in parallel (0 for one per hardware thread)")
 		("editor", po::value<string>(&TestTool::editor), "editor for opening contracts");
 
 	po::variables_map arguments;
@@ -363,6 +407,9 @@ Allowed options)",
 
 		if (arguments.count("no-smt"))
 			disableSMT = true;
+
+		if (jobs == 0)
+			jobs = ThreadPool::hardwareConcurrency();
 	}
 	catch (std::exception const& _exception)
 	{
@@ -382,7 +429,7 @@ Allowed options)",
 		if (ts.smt && disableSMT)
 			continue;
 
-		if (auto stats = runTestSuite(ts.title, testPath / ts.path, ts.subpath, ts.testCaseCreator, formatted))
+		if (auto stats = runTestSuite(ts.title, testPath / ts.path, ts.subpath, ts.testCaseCreator, formatted, jobs))
 			global_stats += *stats;
 		else
 			return 1;
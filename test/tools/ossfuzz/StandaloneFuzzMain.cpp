@@ -0,0 +1,133 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Driver for the fuzzing harnesses if they are not linked against libFuzzer.
+ * Runs LLVMFuzzerTestOneInput in a persistent in-process loop over a corpus
+ * and reports the throughput. If built with afl-clang-fast, uses AFL's
+ * persistent mode instead.
+ */
+
+#include <libdevcore/CommonIO.h>
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace dev;
+namespace fs = boost::filesystem;
+
+extern "C" int LLVMFuzzerTestOneInput(uint8_t const* _data, size_t _size);
+
+namespace
+{
+
+void runOne(string const& _input)
+{
+	LLVMFuzzerTestOneInput(reinterpret_cast<uint8_t const*>(_input.data()), _input.size());
+}
+
+void printStats(size_t _executions, chrono::steady_clock::time_point _start, string const& _event)
+{
+	double seconds = chrono::duration<double>(chrono::steady_clock::now() - _start).count();
+	cerr <<
+		"#" << _executions << "\t" << _event <<
+		" exec/s: " << size_t(seconds > 0 ? double(_executions) / seconds : 0) <<
+		" time: " << size_t(seconds) << "s" <<
+		endl;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+#ifdef __AFL_HAVE_MANUAL_CONTROL
+	(void)argc;
+	(void)argv;
+	while (__AFL_LOOP(1000))
+		runOne(readStandardInput());
+	return 0;
+#else
+	size_t runs = 0;
+	size_t maxTotalTime = 0;
+	vector<fs::path> paths;
+	for (int i = 1; i < argc; ++i)
+	{
+		string arg = argv[i];
+		if (arg.substr(0, 6) == "-runs=")
+			runs = size_t(atoll(arg.substr(6).c_str()));
+		else if (arg.substr(0, 16) == "-max_total_time=")
+			maxTotalTime = size_t(atoll(arg.substr(16).c_str()));
+		else if (arg == "-help=1" || arg == "--help")
+		{
+			cout <<
+				"Usage: " << argv[0] << " [-runs=N] [-max_total_time=S] [file or directory ...]" << endl <<
+				"Runs the fuzzing harness on all inputs (or on standard input) in a loop." << endl <<
+				"Without -runs or -max_total_time, each input is run exactly once." << endl;
+			return 0;
+		}
+		else if (!arg.empty() && arg[0] == '-')
+			cerr << "Ignoring unsupported option " << arg << endl;
+		else if (fs::is_directory(arg))
+		{
+			for (auto const& entry: fs::recursive_directory_iterator(arg))
+				if (fs::is_regular_file(entry.path()))
+					paths.push_back(entry.path());
+		}
+		else
+			paths.push_back(arg);
+	}
+	sort(paths.begin(), paths.end());
+
+	// Inputs are read once and kept in memory, so that the loop only measures the harness.
+	vector<string> inputs;
+	for (auto const& path: paths)
+		inputs.emplace_back(readFileAsString(path.string()));
+	if (paths.empty())
+		inputs.emplace_back(readStandardInput());
+
+	if (runs == 0 && maxTotalTime == 0)
+		runs = inputs.size();
+
+	auto start = chrono::steady_clock::now();
+	size_t executions = 0;
+	size_t nextReport = 1;
+	while (runs == 0 || executions < runs)
+	{
+		runOne(inputs[executions % inputs.size()]);
+		++executions;
+		if (executions == nextReport)
+		{
+			printStats(executions, start, "pulse");
+			nextReport *= 2;
+		}
+		if (
+			maxTotalTime > 0 &&
+			chrono::steady_clock::now() - start >= chrono::seconds(maxTotalTime)
+		)
+			break;
+	}
+	printStats(executions, start, "DONE");
+	return 0;
+#endif
+}
@@ -0,0 +1,87 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Differential fuzzer for the Yul optimizer: runs the interpreter on the
+ * code before and after optimisation and aborts if the traces differ.
+ */
+
+#include <test/tools/yulInterpreter/Interpreter.h>
+
+#include <libsolidity/interface/AssemblyStack.h>
+
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/Object.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+using namespace std;
+using namespace dev;
+using namespace dev::solidity;
+using namespace yul;
+using namespace yul::test;
+
+namespace
+{
+
+/// @returns the trace and final state of @a _code or an empty string
+/// if the result depends on resource limits.
+string interpret(Block const& _code, bytes const& _calldata)
+{
+	static shared_ptr<Dialect> const dialect = EVMDialect::strictAssemblyForEVMObjects();
+	InterpreterState state;
+	state.calldata = _calldata;
+	// Keep the limits small so that a single input does not slow down the fuzzer.
+	state.maxSteps = 10000;
+	Interpreter::run(state, *dialect, _code);
+	if (state.resourcesExhausted)
+		return {};
+	ostringstream result;
+	state.dumpTraceAndState(result);
+	return result.str();
+}
+
+}
+
+extern "C" int LLVMFuzzerTestOneInput(uint8_t const* _data, size_t _size)
+{
+	if (_size > 600)
+		return 0;
+
+	string input(reinterpret_cast<char const*>(_data), _size);
+	AssemblyStack stack(EVMVersion{}, AssemblyStack::Language::StrictAssembly);
+	if (!stack.parseAndAnalyze("", input))
+		return 0;
+
+	// The input doubles as call data, so that calldataload is not constant.
+	bytes calldata(_data, _data + _size);
+	string before = interpret(*stack.parserResult().code, calldata);
+	if (before.empty())
+		return 0;
+	stack.optimize();
+	string after = interpret(*stack.parserResult().code, calldata);
+	if (!after.empty() && before != after)
+	{
+		cerr << "Optimizer changed the behaviour of the code." << endl;
+		cerr << "Before:" << endl << before << "After:" << endl << after;
+		abort();
+	}
+	return 0;
+}
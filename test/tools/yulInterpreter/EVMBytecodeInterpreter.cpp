@@ -0,0 +1,212 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Interpreter for EVM bytecode.
+ */
+
+#include <test/tools/yulInterpreter/EVMBytecodeInterpreter.h>
+
+#include <libevmasm/GasMeter.h>
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+using namespace yul::test;
+
+using dev::solidity::Instruction;
+
+EVMBytecodeInterpreter::EVMBytecodeInterpreter(InterpreterState& _state):
+	m_state(_state),
+	m_instructions(_state)
+{
+	bytes const& code = m_state.code;
+	for (size_t pc = 0; pc < code.size(); ++pc)
+	{
+		Instruction instruction = Instruction(code[pc]);
+		if (instruction == Instruction::JUMPDEST)
+			m_jumpDests.insert(pc);
+		else if (solidity::isPushInstruction(instruction))
+			pc += solidity::getPushNumber(instruction);
+	}
+}
+
+bool EVMBytecodeInterpreter::run(StepObserver const& _observer)
+{
+	m_stack.clear();
+	m_pc = 0;
+	m_output.clear();
+	m_state.codesize = m_state.code.size();
+	while (m_pc < m_state.code.size())
+	{
+		size_t pc = m_pc;
+		Instruction instruction = Instruction(m_state.code[pc]);
+		u256 gasBefore = m_state.gasUsed;
+		bool terminated = true;
+		bool success = false;
+		try
+		{
+			step();
+			terminated = false;
+		}
+		catch (ExplicitlyTerminated const&)
+		{
+			success =
+				instruction == Instruction::STOP ||
+				instruction == Instruction::RETURN ||
+				instruction == Instruction::SELFDESTRUCT;
+		}
+		catch (InterpreterTerminatedGeneric const&)
+		{
+		}
+		if (_observer)
+			_observer(pc, instruction, m_state.gasUsed - gasBefore);
+		if (terminated)
+			return success;
+	}
+	// Running past the end of the code is equivalent to stop.
+	return true;
+}
+
+void EVMBytecodeInterpreter::step()
+{
+	if (++m_state.numSteps >= m_state.maxSteps)
+	{
+		m_state.resourcesExhausted = true;
+		m_state.trace.emplace_back("Interpreter execution step limit reached.");
+		BOOST_THROW_EXCEPTION(StepLimitReached());
+	}
+
+	size_t pc = m_pc++;
+	Instruction instruction = Instruction(m_state.code[pc]);
+	if (!solidity::isValidInstruction(instruction))
+		instruction = Instruction::INVALID;
+
+	if (solidity::isPushInstruction(instruction))
+	{
+		m_instructions.useGas(GasMeter::runGas(instruction));
+		u256 value;
+		for (size_t i = 0; i < solidity::getPushNumber(instruction); ++i)
+		{
+			size_t position = pc + 1 + i;
+			value = (value << 8) | (position < m_state.code.size() ? m_state.code[position] : 0);
+		}
+		m_pc += solidity::getPushNumber(instruction);
+		push(value);
+	}
+	else if (solidity::isDupInstruction(instruction))
+	{
+		m_instructions.useGas(GasMeter::runGas(instruction));
+		size_t depth = solidity::getDupNumber(instruction);
+		if (m_stack.size() < depth)
+			halt();
+		push(m_stack[m_stack.size() - depth]);
+	}
+	else if (solidity::isSwapInstruction(instruction))
+	{
+		m_instructions.useGas(GasMeter::runGas(instruction));
+		size_t depth = solidity::getSwapNumber(instruction);
+		if (m_stack.size() <= depth)
+			halt();
+		swap(m_stack.back(), m_stack[m_stack.size() - 1 - depth]);
+	}
+	else
+		switch (instruction)
+		{
+		case Instruction::JUMP:
+			m_instructions.useGas(GasMeter::runGas(instruction));
+			jump(pop());
+			break;
+		case Instruction::JUMPI:
+		{
+			m_instructions.useGas(GasMeter::runGas(instruction));
+			u256 target = pop();
+			if (pop() != 0)
+				jump(target);
+			break;
+		}
+		case Instruction::JUMPDEST:
+			m_instructions.useGas(GasCosts::jumpdestGas);
+			break;
+		case Instruction::PC:
+			m_instructions.useGas(GasMeter::runGas(instruction));
+			push(pc);
+			break;
+		case Instruction::GAS:
+			m_instructions.useGas(GasMeter::runGas(instruction));
+			push(m_state.gasLimit - m_state.gasUsed);
+			break;
+		case Instruction::RETURN:
+		case Instruction::REVERT:
+		{
+			vector<u256> arguments{pop(), pop()};
+			try
+			{
+				m_instructions.eval(instruction, arguments);
+			}
+			catch (ExplicitlyTerminated const&)
+			{
+				// Memory has been expanded by the instruction, so the area is accessible.
+				if (arguments[1] > 0)
+				{
+					auto begin = m_state.memory.begin() + ptrdiff_t(arguments[0]);
+					m_output = bytes(begin, begin + ptrdiff_t(arguments[1]));
+				}
+				throw;
+			}
+			break;
+		}
+		default:
+		{
+			solidity::InstructionInfo info = solidity::instructionInfo(instruction);
+			vector<u256> arguments;
+			for (int i = 0; i < info.args; ++i)
+				arguments.emplace_back(pop());
+			u256 result = m_instructions.eval(instruction, arguments);
+			if (info.ret > 0)
+				push(result);
+		}
+		}
+}
+
+void EVMBytecodeInterpreter::halt()
+{
+	m_state.trace.emplace_back("Exceptional halt.");
+	BOOST_THROW_EXCEPTION(ExceptionalHalt());
+}
+
+u256 EVMBytecodeInterpreter::pop()
+{
+	if (m_stack.empty())
+		halt();
+	u256 value = m_stack.back();
+	m_stack.pop_back();
+	return value;
+}
+
+void EVMBytecodeInterpreter::push(u256 _value)
+{
+	if (m_stack.size() >= GasCosts::stackLimit)
+		halt();
+	m_stack.emplace_back(move(_value));
+}
+
+void EVMBytecodeInterpreter::jump(u256 const& _target)
+{
+	if (_target >= m_state.code.size() || !m_jumpDests.count(size_t(_target)))
+		halt();
+	m_pc = size_t(_target);
+}
@@ -0,0 +1,80 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Interpreter for EVM bytecode.
+ */
+
+#pragma once
+
+#include <test/tools/yulInterpreter/EVMInstructionInterpreter.h>
+
+#include <functional>
+#include <set>
+
+namespace yul
+{
+namespace test
+{
+
+/// Stack underflow, stack overflow or jump to an invalid destination.
+struct ExceptionalHalt: InterpreterTerminatedGeneric
+{
+};
+
+/**
+ * Executes EVM bytecode on an InterpreterState. The semantics and gas costs of the
+ * instructions are shared with the Yul interpreter, this class adds the stack,
+ * jumps and the program counter.
+ *
+ * The code of the contract is taken from the state at construction time.
+ */
+class EVMBytecodeInterpreter
+{
+public:
+	/// Called after each executed instruction (including the terminating one) with its
+	/// program counter and the amount of gas it consumed.
+	using StepObserver = std::function<void(size_t _pc, dev::solidity::Instruction _instruction, dev::u256 const& _gas)>;
+
+	explicit EVMBytecodeInterpreter(InterpreterState& _state);
+
+	/// Executes the code until it terminates.
+	/// @returns true if it ended with stop, return or selfdestruct and false if it reverted
+	/// or halted exceptionally (including running out of gas or steps).
+	bool run(StepObserver const& _observer = {});
+
+	/// @returns the data passed to return or revert by the last call to run().
+	dev::bytes const& output() const { return m_output; }
+
+private:
+	/// Executes the instruction at the current program counter and advances it.
+	void step();
+	/// Records an exceptional halt at the current instruction and throws.
+	[[noreturn]] void halt();
+	dev::u256 pop();
+	void push(dev::u256 _value);
+	void jump(dev::u256 const& _target);
+
+	InterpreterState& m_state;
+	EVMInstructionInterpreter m_instructions;
+	std::set<size_t> m_jumpDests;
+	std::vector<dev::u256> m_stack;
+	size_t m_pc = 0;
+	dev::bytes m_output;
+};
+
+}
+}
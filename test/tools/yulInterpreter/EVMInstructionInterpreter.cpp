@@ -0,0 +1,433 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Yul interpreter module that evaluates EVM instructions.
+ */
+
+#include <test/tools/yulInterpreter/EVMInstructionInterpreter.h>
+
+#include <libevmasm/GasMeter.h>
+
+#include <libdevcore/Keccak256.h>
+
+#include <boost/multiprecision/integer.hpp>
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+using namespace dev::solidity;
+using namespace yul;
+using namespace yul::test;
+
+namespace
+{
+
+/// Memory beyond this size is never granted, independent of the gas limit.
+/// This keeps accesses with absurd offsets from allocating memory before running out of gas.
+size_t const c_maxMemorySize = size_t(1) << 26;
+
+bigint memoryCost(bigint const& _words)
+{
+	return GasCosts::memoryGas * _words + _words * _words / GasCosts::quadCoeffDiv;
+}
+
+bigint wordsFor(u256 const& _size)
+{
+	return (bigint(_size) + 31) / 32;
+}
+
+/// Value for quantities that depend on other contracts. Derived from a hash,
+/// so that different inputs result in different values.
+u256 externalValue(string const& _purpose, u256 const& _input)
+{
+	return u256(keccak256(_purpose + toHex(_input))) & 0xffffffff;
+}
+
+}
+
+void InterpreterState::dumpTraceAndState(ostream& _out) const
+{
+	_out << "Trace:" << endl;
+	for (auto const& line: trace)
+		_out << "  " << line << endl;
+	_out << "Memory dump:" << endl;
+	for (size_t i = 0; i < memory.size(); i += 32)
+	{
+		bytesConstRef word(memory.data() + i, 32);
+		if (any_of(word.begin(), word.end(), [](uint8_t _b) { return _b != 0; }))
+			_out << "  " << toCompactHexWithPrefix(u256(i)) << ": " << toHex(word.toBytes()) << endl;
+	}
+	_out << "Storage dump:" << endl;
+	for (auto const& slot: storage)
+		if (slot.second != 0)
+			_out << "  " << toHex(slot.first) << ": " << toHex(slot.second) << endl;
+}
+
+u256 EVMInstructionInterpreter::eval(dev::solidity::Instruction _instruction, vector<u256> const& _arguments)
+{
+	using dev::solidity::Instruction;
+
+	auto const& arg = _arguments;
+	InstructionInfo info = instructionInfo(_instruction);
+	if (info.gasPriceTier == Tier::Balance)
+		useGas(GasCosts::balanceGas(m_state.evmVersion));
+	else if (info.gasPriceTier == Tier::ExtCode)
+		useGas(GasCosts::extCodeGas(m_state.evmVersion));
+	else if (info.gasPriceTier != Tier::Special && info.gasPriceTier != Tier::Invalid)
+		useGas(GasMeter::runGas(_instruction));
+
+	switch (_instruction)
+	{
+	case Instruction::STOP:
+		logTrace(_instruction);
+		BOOST_THROW_EXCEPTION(ExplicitlyTerminated());
+	// --------------- arithmetic ---------------
+	case Instruction::ADD:
+		return arg[0] + arg[1];
+	case Instruction::MUL:
+		return arg[0] * arg[1];
+	case Instruction::SUB:
+		return arg[0] - arg[1];
+	case Instruction::DIV:
+		return arg[1] == 0 ? 0 : arg[0] / arg[1];
+	case Instruction::SDIV:
+		return arg[1] == 0 ? 0 : s2u(u2s(arg[0]) / u2s(arg[1]));
+	case Instruction::MOD:
+		return arg[1] == 0 ? 0 : arg[0] % arg[1];
+	case Instruction::SMOD:
+		return arg[1] == 0 ? 0 : s2u(u2s(arg[0]) % u2s(arg[1]));
+	case Instruction::EXP:
+	{
+		useGas(GasCosts::expGas + bigint(GasCosts::expByteGas(m_state.evmVersion)) * toCompactBigEndian(arg[1]).size());
+		return u256(boost::multiprecision::powm(bigint(arg[0]), bigint(arg[1]), bigint(1) << 256));
+	}
+	case Instruction::NOT:
+		return ~arg[0];
+	case Instruction::LT:
+		return arg[0] < arg[1] ? 1 : 0;
+	case Instruction::GT:
+		return arg[0] > arg[1] ? 1 : 0;
+	case Instruction::SLT:
+		return u2s(arg[0]) < u2s(arg[1]) ? 1 : 0;
+	case Instruction::SGT:
+		return u2s(arg[0]) > u2s(arg[1]) ? 1 : 0;
+	case Instruction::EQ:
+		return arg[0] == arg[1] ? 1 : 0;
+	case Instruction::ISZERO:
+		return arg[0] == 0 ? 1 : 0;
+	case Instruction::AND:
+		return arg[0] & arg[1];
+	case Instruction::OR:
+		return arg[0] | arg[1];
+	case Instruction::XOR:
+		return arg[0] ^ arg[1];
+	case Instruction::BYTE:
+		return arg[0] >= 32 ? 0 : (arg[1] >> unsigned(8 * (31 - arg[0]))) & 0xff;
+	case Instruction::SHL:
+		return arg[0] > 255 ? 0 : (arg[1] << unsigned(arg[0]));
+	case Instruction::SHR:
+		return arg[0] > 255 ? 0 : (arg[1] >> unsigned(arg[0]));
+	case Instruction::SAR:
+	{
+		bool negative = boost::multiprecision::bit_test(arg[1], 255);
+		if (arg[0] > 255)
+			return negative ? ~u256(0) : 0;
+		else if (negative)
+			return ~((~arg[1]) >> unsigned(arg[0]));
+		else
+			return arg[1] >> unsigned(arg[0]);
+	}
+	case Instruction::ADDMOD:
+		return arg[2] == 0 ? 0 : u256((bigint(arg[0]) + bigint(arg[1])) % arg[2]);
+	case Instruction::MULMOD:
+		return arg[2] == 0 ? 0 : u256((bigint(arg[0]) * bigint(arg[1])) % arg[2]);
+	case Instruction::SIGNEXTEND:
+	{
+		if (arg[0] >= 31)
+			return arg[1];
+		unsigned testBit = unsigned(arg[0]) * 8 + 7;
+		u256 mask = (u256(1) << testBit) - 1;
+		if (boost::multiprecision::bit_test(arg[1], testBit))
+			return arg[1] | ~mask;
+		else
+			return arg[1] & mask;
+	}
+	// --------------- memory / storage / logs ---------------
+	case Instruction::KECCAK256:
+	{
+		useGas(GasCosts::keccak256Gas + GasCosts::keccak256WordGas * wordsFor(arg[1]));
+		accessMemory(arg[0], arg[1]);
+		return u256(keccak256(readMemory(arg[0], arg[1])));
+	}
+	case Instruction::ADDRESS:
+		return m_state.address;
+	case Instruction::BALANCE:
+		return arg[0] == m_state.address ? m_state.balance : externalValue("balance", arg[0]);
+	case Instruction::ORIGIN:
+		return m_state.origin;
+	case Instruction::CALLER:
+		return m_state.caller;
+	case Instruction::CALLVALUE:
+		return m_state.callvalue;
+	case Instruction::CALLDATALOAD:
+	{
+		u256 result;
+		for (size_t i = 0; i < 32; ++i)
+		{
+			bigint position = bigint(arg[0]) + i;
+			result <<= 8;
+			if (position < m_state.calldata.size())
+				result |= m_state.calldata[size_t(position)];
+		}
+		return result;
+	}
+	case Instruction::CALLDATASIZE:
+		return m_state.calldata.size();
+	case Instruction::CALLDATACOPY:
+		useGas(GasCosts::copyGas * wordsFor(arg[2]));
+		copyToMemory(m_state.calldata, arg[1], arg[0], arg[2]);
+		return 0;
+	case Instruction::CODESIZE:
+		return m_state.codesize;
+	case Instruction::CODECOPY:
+		useGas(GasCosts::copyGas * wordsFor(arg[2]));
+		copyToMemory(m_state.code, arg[1], arg[0], arg[2]);
+		return 0;
+	case Instruction::GASPRICE:
+		return m_state.gasprice;
+	case Instruction::EXTCODESIZE:
+		return externalValue("codesize", arg[0]) & 0xffff;
+	case Instruction::EXTCODECOPY:
+		useGas(GasCosts::copyGas * wordsFor(arg[3]));
+		copyToMemory({}, arg[2], arg[1], arg[3]);
+		return 0;
+	case Instruction::EXTCODEHASH:
+		return u256(keccak256(h256(arg[0])));
+	case Instruction::RETURNDATASIZE:
+		return m_state.returndata.size();
+	case Instruction::RETURNDATACOPY:
+		useGas(GasCosts::copyGas * wordsFor(arg[2]));
+		if (bigint(arg[1]) + arg[2] > m_state.returndata.size())
+		{
+			// Reading beyond the end of the return data is an exceptional halt.
+			logTrace(_instruction, arg);
+			BOOST_THROW_EXCEPTION(ExplicitlyTerminated());
+		}
+		copyToMemory(m_state.returndata, arg[1], arg[0], arg[2]);
+		return 0;
+	case Instruction::BLOCKHASH:
+		if (arg[0] >= m_state.blockNumber || arg[0] + 256 < m_state.blockNumber)
+			return 0;
+		else
+			return u256(keccak256(h256(arg[0])));
+	case Instruction::COINBASE:
+		return m_state.coinbase;
+	case Instruction::TIMESTAMP:
+		return m_state.timestamp;
+	case Instruction::NUMBER:
+		return m_state.blockNumber;
+	case Instruction::DIFFICULTY:
+		return m_state.difficulty;
+	case Instruction::GASLIMIT:
+		return m_state.gaslimit;
+	case Instruction::POP:
+		return 0;
+	case Instruction::MLOAD:
+		accessMemory(arg[0], 32);
+		return readMemoryWord(arg[0]);
+	case Instruction::MSTORE:
+		accessMemory(arg[0], 32);
+		writeMemoryWord(arg[0], arg[1]);
+		return 0;
+	case Instruction::MSTORE8:
+		accessMemory(arg[0], 1);
+		m_state.memory[size_t(arg[0])] = uint8_t(arg[1] & 0xff);
+		return 0;
+	case Instruction::SLOAD:
+	{
+		useGas(GasCosts::sloadGas(m_state.evmVersion));
+		auto it = m_state.storage.find(arg[0]);
+		return it == m_state.storage.end() ? 0 : it->second;
+	}
+	case Instruction::SSTORE:
+	{
+		auto it = m_state.storage.find(arg[0]);
+		bool wasZero = it == m_state.storage.end();
+		useGas(wasZero && arg[1] != 0 ? GasCosts::sstoreSetGas : GasCosts::sstoreResetGas);
+		if (arg[1] == 0)
+		{
+			if (!wasZero)
+				m_state.storage.erase(it);
+		}
+		else
+			m_state.storage[arg[0]] = arg[1];
+		return 0;
+	}
+	case Instruction::PC:
+		// The program counter depends on the code layout, which optimisation changes.
+		return 0x77;
+	case Instruction::MSIZE:
+		return m_state.memory.size();
+	case Instruction::GAS:
+		// Remaining gas is expected to change through optimisation.
+		return 0x99999999;
+	case Instruction::LOG0:
+	case Instruction::LOG1:
+	case Instruction::LOG2:
+	case Instruction::LOG3:
+	case Instruction::LOG4:
+	{
+		size_t topics = size_t(_instruction) - size_t(Instruction::LOG0);
+		useGas(
+			GasCosts::logGas +
+			bigint(GasCosts::logTopicGas) * topics +
+			bigint(GasCosts::logDataGas) * arg[1]
+		);
+		accessMemory(arg[0], arg[1]);
+		logTrace(_instruction, vector<u256>(arg.begin() + 2, arg.end()), readMemory(arg[0], arg[1]));
+		return 0;
+	}
+	// --------------- calls ---------------
+	case Instruction::CREATE:
+	case Instruction::CREATE2:
+		useGas(GasCosts::createGas);
+		accessMemory(arg[1], arg[2]);
+		logTrace(_instruction, arg, readMemory(arg[1], arg[2]));
+		m_state.returndata.clear();
+		return externalValue("create", m_state.trace.size());
+	case Instruction::CALL:
+	case Instruction::CALLCODE:
+	case Instruction::DELEGATECALL:
+	case Instruction::STATICCALL:
+	{
+		bool hasValue = _instruction == Instruction::CALL || _instruction == Instruction::CALLCODE;
+		size_t inputOffset = hasValue ? 3 : 2;
+		useGas(GasCosts::callGas(m_state.evmVersion) + (hasValue && arg[2] != 0 ? GasCosts::callValueTransferGas : 0));
+		accessMemory(arg[inputOffset], arg[inputOffset + 1]);
+		accessMemory(arg[inputOffset + 2], arg[inputOffset + 3]);
+		// The amount of gas supplied to the call is not part of the observable behaviour.
+		vector<u256> traceArguments(arg.begin() + 1, arg.end());
+		logTrace(_instruction, traceArguments, readMemory(arg[inputOffset], arg[inputOffset + 1]));
+		m_state.returndata.clear();
+		return 1;
+	}
+	case Instruction::RETURN:
+	case Instruction::REVERT:
+		accessMemory(arg[0], arg[1]);
+		logTrace(_instruction, {}, readMemory(arg[0], arg[1]));
+		BOOST_THROW_EXCEPTION(ExplicitlyTerminated());
+	case Instruction::INVALID:
+		logTrace(_instruction);
+		BOOST_THROW_EXCEPTION(ExplicitlyTerminated());
+	case Instruction::SELFDESTRUCT:
+		useGas(GasCosts::selfdestructGas(m_state.evmVersion));
+		logTrace(_instruction, arg);
+		BOOST_THROW_EXCEPTION(ExplicitlyTerminated());
+	default:
+		// Jumps, stack manipulation and EVM1.5 instructions cannot be used in strict assembly.
+		BOOST_THROW_EXCEPTION(UnsupportedFeature() << errinfo_comment("Instruction " + info.name + " not supported."));
+	}
+}
+
+u256 EVMInstructionInterpreter::evalBuiltin(YulString _name, vector<u256> const& _arguments)
+{
+	if (_name == "datasize"_yulstring)
+		return externalValue("datasize", _arguments.at(0)) & 0xfff;
+	else if (_name == "dataoffset"_yulstring)
+		return externalValue("dataoffset", _arguments.at(0)) & 0xfff;
+	else if (_name == "datacopy"_yulstring)
+		return eval(dev::solidity::Instruction::CODECOPY, _arguments);
+	BOOST_THROW_EXCEPTION(UnsupportedFeature() << errinfo_comment("Builtin " + _name.str() + " not supported."));
+}
+
+void EVMInstructionInterpreter::useGas(bigint const& _amount)
+{
+	bigint total = bigint(m_state.gasUsed) + _amount;
+	if (total > m_state.gasLimit)
+	{
+		m_state.resourcesExhausted = true;
+		BOOST_THROW_EXCEPTION(OutOfGas());
+	}
+	m_state.gasUsed = u256(total);
+}
+
+void EVMInstructionInterpreter::accessMemory(u256 const& _offset, u256 const& _size)
+{
+	if (_size == 0)
+		return;
+	bigint newWords = (bigint(_offset) + _size + 31) / 32;
+	bigint oldWords = m_state.memory.size() / 32;
+	if (newWords <= oldWords)
+		return;
+	useGas(memoryCost(newWords) - memoryCost(oldWords));
+	if (newWords * 32 > c_maxMemorySize)
+	{
+		m_state.resourcesExhausted = true;
+		BOOST_THROW_EXCEPTION(OutOfGas());
+	}
+	m_state.memory.resize(size_t(newWords * 32), 0);
+}
+
+bytes EVMInstructionInterpreter::readMemory(u256 const& _offset, u256 const& _size)
+{
+	if (_size == 0)
+		return {};
+	auto begin = m_state.memory.begin() + ptrdiff_t(_offset);
+	return bytes(begin, begin + ptrdiff_t(_size));
+}
+
+u256 EVMInstructionInterpreter::readMemoryWord(u256 const& _offset)
+{
+	return fromBigEndian<u256>(bytesConstRef(m_state.memory.data() + size_t(_offset), 32));
+}
+
+void EVMInstructionInterpreter::writeMemoryWord(u256 const& _offset, u256 const& _value)
+{
+	bytesRef target(m_state.memory.data() + size_t(_offset), 32);
+	toBigEndian(_value, target);
+}
+
+void EVMInstructionInterpreter::copyToMemory(
+	bytes const& _source,
+	u256 const& _sourceOffset,
+	u256 const& _targetOffset,
+	u256 const& _size
+)
+{
+	accessMemory(_targetOffset, _size);
+	for (size_t i = 0; i < size_t(_size); ++i)
+	{
+		bigint position = bigint(_sourceOffset) + i;
+		m_state.memory[size_t(_targetOffset) + i] = position < _source.size() ? _source[size_t(position)] : 0;
+	}
+}
+
+void EVMInstructionInterpreter::logTrace(dev::solidity::Instruction _instruction, vector<u256> const& _arguments, bytes const& _data)
+{
+	logTrace(instructionInfo(_instruction).name, _arguments, _data);
+}
+
+void EVMInstructionInterpreter::logTrace(string const& _name, vector<u256> const& _arguments, bytes const& _data)
+{
+	string message = _name + "(";
+	for (size_t i = 0; i < _arguments.size(); ++i)
+		message += (i > 0 ? ", " : "") + formatNumber(_arguments[i]);
+	message += ")";
+	if (!_data.empty())
+		message += " [" + toHex(_data) + "]";
+	m_state.trace.emplace_back(std::move(message));
+}
@@ -0,0 +1,164 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Yul interpreter module that evaluates EVM instructions.
+ */
+
+#pragma once
+
+#include <libyul/YulString.h>
+
+#include <libevmasm/Instruction.h>
+#include <liblangutil/EVMVersion.h>
+
+#include <libdevcore/CommonData.h>
+#include <libdevcore/Exceptions.h>
+
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace yul
+{
+namespace test
+{
+
+/// Base class of all reasons for the interpreter to stop executing code.
+struct InterpreterTerminatedGeneric: virtual dev::Exception
+{
+};
+
+/// Code executed stop, return, revert, invalid or selfdestruct.
+struct ExplicitlyTerminated: InterpreterTerminatedGeneric
+{
+};
+
+/// The configured maximum number of steps or the maximum call depth was reached.
+struct StepLimitReached: InterpreterTerminatedGeneric
+{
+};
+
+/// The code used more gas than the configured gas limit.
+struct OutOfGas: InterpreterTerminatedGeneric
+{
+};
+
+/// The code uses a feature the interpreter does not model (e.g. jumps).
+struct UnsupportedFeature: InterpreterTerminatedGeneric
+{
+};
+
+/**
+ * State of the EVM as seen by the interpreted code. The environment values are fixed,
+ * non-zero and pairwise distinct, so that mix-ups are visible in the trace.
+ */
+struct InterpreterState
+{
+	dev::bytes calldata;
+	dev::bytes returndata;
+	/// Code of the executing contract. Empty when interpreting Yul, in which case
+	/// codecopy reads zeros and codesize returns the fixed value below.
+	dev::bytes code;
+	/// Memory, always a multiple of 32 bytes long.
+	dev::bytes memory;
+	std::map<dev::u256, dev::u256> storage;
+	dev::u256 address = 0x11111111;
+	dev::u256 balance = 0x22222222;
+	dev::u256 origin = 0x33333333;
+	dev::u256 caller = 0x44444444;
+	dev::u256 callvalue = 0x55555555;
+	dev::u256 gasprice = 0x66666666;
+	dev::u256 coinbase = 0x77777777;
+	dev::u256 timestamp = 0x88888888;
+	dev::u256 blockNumber = 1024;
+	dev::u256 difficulty = 0x9999999;
+	dev::u256 gaslimit = 4000000;
+	dev::u256 codesize = 0x1234;
+
+	/// Observable effects (logs, calls, creations and termination) in execution order.
+	std::vector<std::string> trace;
+
+	dev::solidity::EVMVersion evmVersion;
+	/// Gas consumed by instructions, including memory expansion.
+	/// Note that the cost of control flow is not modeled.
+	dev::u256 gasUsed = 0;
+	dev::u256 gasLimit = 10000000;
+	size_t numSteps = 0;
+	size_t maxSteps = 100000;
+	size_t maxCallDepth = 128;
+
+	/// True if execution stopped in a way that depends on the gas or step
+	/// consumption of the code, i.e. in a way that optimisation is allowed to change.
+	bool resourcesExhausted = false;
+
+	/// Prints the trace, the storage and the memory in a canonical form. Two executions
+	/// behave the same if and only if this output is identical.
+	void dumpTraceAndState(std::ostream& _out) const;
+};
+
+/**
+ * Evaluates EVM instructions (and the builtin functions of the EVM dialect)
+ * on a given state. Costs are charged to the gas counter of the state.
+ *
+ * Instructions that would call into other contracts are only recorded in the
+ * trace and report success without return data.
+ */
+class EVMInstructionInterpreter
+{
+public:
+	explicit EVMInstructionInterpreter(InterpreterState& _state):
+		m_state(_state)
+	{}
+
+	/// Evaluates the instruction and returns its value (or zero if it does not return a value).
+	/// The arguments are in source order, i.e. the first argument is the top of the stack.
+	dev::u256 eval(dev::solidity::Instruction _instruction, std::vector<dev::u256> const& _arguments);
+	/// Evaluates datasize, dataoffset and datacopy.
+	dev::u256 evalBuiltin(YulString _name, std::vector<dev::u256> const& _arguments);
+
+	/// Charges @a _amount and throws OutOfGas if the gas limit is exceeded.
+	void useGas(dev::bigint const& _amount);
+
+private:
+	/// Charges memory expansion and grows the memory to cover the given area.
+	/// Zero-sized areas do not access memory.
+	void accessMemory(dev::u256 const& _offset, dev::u256 const& _size);
+	dev::bytes readMemory(dev::u256 const& _offset, dev::u256 const& _size);
+	dev::u256 readMemoryWord(dev::u256 const& _offset);
+	void writeMemoryWord(dev::u256 const& _offset, dev::u256 const& _value);
+	/// Copies @a _size bytes of @a _source starting at @a _sourceOffset into memory,
+	/// padding with zeros beyond the end of the source.
+	void copyToMemory(
+		dev::bytes const& _source,
+		dev::u256 const& _sourceOffset,
+		dev::u256 const& _targetOffset,
+		dev::u256 const& _size
+	);
+
+	void logTrace(
+		dev::solidity::Instruction _instruction,
+		std::vector<dev::u256> const& _arguments = {},
+		dev::bytes const& _data = {}
+	);
+	void logTrace(std::string const& _name, std::vector<dev::u256> const& _arguments, dev::bytes const& _data);
+
+	InterpreterState& m_state;
+};
+
+}
+}
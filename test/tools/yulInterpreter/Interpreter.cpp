@@ -0,0 +1,311 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Yul interpreter.
+ */
+
+#include <test/tools/yulInterpreter/Interpreter.h>
+
+#include <libyul/AsmData.h>
+#include <libyul/Dialect.h>
+#include <libyul/Utilities.h>
+#include <libyul/Exceptions.h>
+
+#include <libdevcore/FixedHash.h>
+
+#include <boost/range/adaptor/reversed.hpp>
+
+using namespace std;
+using namespace dev;
+using namespace yul;
+using namespace yul::test;
+
+namespace
+{
+
+u256 valueOfLiteral(Literal const& _literal)
+{
+	switch (_literal.kind)
+	{
+	case LiteralKind::Number:
+		return valueOfNumberLiteral(_literal);
+	case LiteralKind::Boolean:
+		return _literal.value == "true"_yulstring ? 1 : 0;
+	case LiteralKind::String:
+		return u256(h256(_literal.value.str(), h256::FromBinary, h256::AlignLeft));
+	}
+	yulAssert(false, "");
+	return 0;
+}
+
+}
+
+void Interpreter::run(InterpreterState& _state, Dialect const& _dialect, Block const& _code)
+{
+	try
+	{
+		Interpreter{_state, _dialect}(_code);
+	}
+	catch (StepLimitReached const&)
+	{
+		_state.resourcesExhausted = true;
+	}
+	catch (OutOfGas const&)
+	{
+		_state.resourcesExhausted = true;
+	}
+	catch (UnsupportedFeature const&)
+	{
+		_state.resourcesExhausted = true;
+	}
+	catch (InterpreterTerminatedGeneric const&)
+	{
+	}
+}
+
+void Interpreter::operator()(ExpressionStatement const& _expressionStatement)
+{
+	evaluateMulti(_expressionStatement.expression);
+}
+
+void Interpreter::operator()(Assignment const& _assignment)
+{
+	yulAssert(_assignment.value, "");
+	vector<u256> values = evaluateMulti(*_assignment.value);
+	yulAssert(values.size() == _assignment.variableNames.size(), "");
+	for (size_t i = 0; i < values.size(); ++i)
+	{
+		YulString varName = _assignment.variableNames.at(i).name;
+		yulAssert(m_variables.count(varName), "");
+		m_variables[varName] = values.at(i);
+	}
+}
+
+void Interpreter::operator()(VariableDeclaration const& _declaration)
+{
+	vector<u256> values(_declaration.variables.size(), 0);
+	if (_declaration.value)
+		values = evaluateMulti(*_declaration.value);
+
+	yulAssert(values.size() == _declaration.variables.size(), "");
+	for (size_t i = 0; i < values.size(); ++i)
+		declareVariable(_declaration.variables.at(i).name, values.at(i));
+}
+
+void Interpreter::operator()(If const& _if)
+{
+	yulAssert(_if.condition, "");
+	if (evaluate(*_if.condition) != 0)
+		(*this)(_if.body);
+}
+
+void Interpreter::operator()(Switch const& _switch)
+{
+	yulAssert(_switch.expression, "");
+	u256 value = evaluate(*_switch.expression);
+	for (auto const& c: _switch.cases)
+		// Default case has to be last.
+		if (!c.value || valueOfLiteral(*c.value) == value)
+		{
+			(*this)(c.body);
+			break;
+		}
+}
+
+void Interpreter::operator()(FunctionDefinition const&)
+{
+	// Functions are registered when their enclosing block is entered.
+}
+
+void Interpreter::operator()(ForLoop const& _forLoop)
+{
+	yulAssert(_forLoop.condition, "");
+
+	// Variables and functions of the pre block are visible in all other parts of the loop.
+	openScope(_forLoop.pre);
+	executeStatements(_forLoop.pre);
+	while (evaluate(*_forLoop.condition) != 0)
+	{
+		countStep();
+		(*this)(_forLoop.body);
+		(*this)(_forLoop.post);
+	}
+	closeScope();
+}
+
+void Interpreter::operator()(Block const& _block)
+{
+	openScope(_block);
+	executeStatements(_block);
+	closeScope();
+}
+
+void Interpreter::openScope(Block const& _block)
+{
+	m_scopes.push_back({});
+	m_declaredVariables.push_back({});
+	for (auto const& statement: _block.statements)
+		if (statement.type() == typeid(FunctionDefinition))
+		{
+			FunctionDefinition const& funDef = boost::get<FunctionDefinition>(statement);
+			m_scopes.back()[funDef.name] = &funDef;
+		}
+}
+
+void Interpreter::closeScope()
+{
+	yulAssert(!m_scopes.empty() && !m_declaredVariables.empty(), "");
+	for (YulString variable: m_declaredVariables.back())
+		m_variables.erase(variable);
+	m_declaredVariables.pop_back();
+	m_scopes.pop_back();
+}
+
+void Interpreter::executeStatements(Block const& _block)
+{
+	for (auto const& statement: _block.statements)
+	{
+		countStep();
+		visit(statement);
+	}
+}
+
+void Interpreter::declareVariable(YulString _name, u256 _value)
+{
+	yulAssert(!m_variables.count(_name), "Variable " + _name.str() + " redeclared.");
+	m_variables[_name] = _value;
+	if (!m_declaredVariables.empty())
+		m_declaredVariables.back().emplace_back(_name);
+}
+
+void Interpreter::countStep()
+{
+	if (++m_state.numSteps >= m_state.maxSteps)
+	{
+		m_state.trace.emplace_back("Interpreter execution step limit reached.");
+		BOOST_THROW_EXCEPTION(StepLimitReached());
+	}
+}
+
+u256 Interpreter::evaluate(Expression const& _expression)
+{
+	ExpressionEvaluator ev(m_state, m_dialect, m_variables, m_scopes, m_callDepth);
+	ev.visit(_expression);
+	return ev.value();
+}
+
+vector<u256> Interpreter::evaluateMulti(Expression const& _expression)
+{
+	ExpressionEvaluator ev(m_state, m_dialect, m_variables, m_scopes, m_callDepth);
+	ev.visit(_expression);
+	return ev.values();
+}
+
+void ExpressionEvaluator::operator()(Literal const& _literal)
+{
+	setValue(valueOfLiteral(_literal));
+}
+
+void ExpressionEvaluator::operator()(Identifier const& _identifier)
+{
+	yulAssert(m_variables.count(_identifier.name), "Unknown variable " + _identifier.name.str() + ".");
+	setValue(m_variables.at(_identifier.name));
+}
+
+void ExpressionEvaluator::operator()(FunctionalInstruction const& _instr)
+{
+	evaluateArgs(_instr.arguments);
+	EVMInstructionInterpreter interpreter(m_state);
+	setValue(interpreter.eval(_instr.instruction, m_values));
+}
+
+void ExpressionEvaluator::operator()(FunctionCall const& _funCall)
+{
+	evaluateArgs(_funCall.arguments);
+
+	if (m_dialect.builtin(_funCall.functionName.name))
+	{
+		EVMInstructionInterpreter interpreter(m_state);
+		setValue(interpreter.evalBuiltin(_funCall.functionName.name, m_values));
+		return;
+	}
+
+	if (m_callDepth >= m_state.maxCallDepth)
+	{
+		m_state.trace.emplace_back("Interpreter call depth limit reached.");
+		BOOST_THROW_EXCEPTION(StepLimitReached());
+	}
+
+	FunctionDefinition const* fun = nullptr;
+	size_t visibleScopes = 0;
+	tie(fun, visibleScopes) = findFunction(_funCall.functionName.name);
+	yulAssert(fun, "Function " + _funCall.functionName.name.str() + " not found.");
+	yulAssert(m_values.size() == fun->parameters.size(), "");
+
+	map<YulString, u256> variables;
+	for (size_t i = 0; i < fun->parameters.size(); ++i)
+		variables[fun->parameters.at(i).name] = m_values.at(i);
+	for (size_t i = 0; i < fun->returnVariables.size(); ++i)
+		variables[fun->returnVariables.at(i).name] = 0;
+
+	// The function body can see the functions of the scopes it is defined in, but no variables.
+	vector<map<YulString, FunctionDefinition const*>> scopes(
+		m_scopes.begin(),
+		m_scopes.begin() + ptrdiff_t(visibleScopes)
+	);
+	Interpreter interpreter(m_state, m_dialect, move(variables), move(scopes), m_callDepth + 1);
+	interpreter(fun->body);
+
+	m_values.clear();
+	for (auto const& retVar: fun->returnVariables)
+		m_values.emplace_back(interpreter.valueOfVariable(retVar.name));
+}
+
+u256 ExpressionEvaluator::value() const
+{
+	yulAssert(m_values.size() == 1, "");
+	return m_values.front();
+}
+
+void ExpressionEvaluator::setValue(u256 _value)
+{
+	m_values.clear();
+	m_values.emplace_back(std::move(_value));
+}
+
+void ExpressionEvaluator::evaluateArgs(vector<Expression> const& _expr)
+{
+	vector<u256> values;
+	for (auto const& expr: _expr | boost::adaptors::reversed)
+	{
+		visit(expr);
+		values.emplace_back(value());
+	}
+	m_values = std::move(values);
+	std::reverse(m_values.begin(), m_values.end());
+}
+
+pair<FunctionDefinition const*, size_t> ExpressionEvaluator::findFunction(YulString _name) const
+{
+	for (size_t i = m_scopes.size(); i > 0; --i)
+	{
+		auto it = m_scopes[i - 1].find(_name);
+		if (it != m_scopes[i - 1].end())
+			return make_pair(it->second, i);
+	}
+	return make_pair(nullptr, 0);
+}
@@ -0,0 +1,161 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Yul interpreter.
+ */
+
+#pragma once
+
+#include <test/tools/yulInterpreter/EVMInstructionInterpreter.h>
+
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/AsmDataForward.h>
+
+#include <libdevcore/Common.h>
+
+#include <map>
+#include <vector>
+
+namespace yul
+{
+struct Dialect;
+
+namespace test
+{
+
+/**
+ * Yul interpreter. Executes strict assembly on an InterpreterState and records all
+ * observable effects there, so that the behaviour of code before and after an optimisation
+ * step can be compared.
+ *
+ * The code has to be analyzed and must not use jumps or stack manipulation.
+ */
+class Interpreter: public ASTWalker
+{
+public:
+	Interpreter(
+		InterpreterState& _state,
+		Dialect const& _dialect,
+		std::map<YulString, dev::u256> _variables = {},
+		std::vector<std::map<YulString, FunctionDefinition const*>> _scopes = {},
+		size_t _callDepth = 0
+	):
+		m_dialect(_dialect),
+		m_state(_state),
+		m_variables(std::move(_variables)),
+		m_scopes(std::move(_scopes)),
+		m_callDepth(_callDepth)
+	{}
+
+	/// Runs @a _code on @a _state. Terminates silently if the code stops, runs out of
+	/// gas or steps or uses an unsupported feature. The last two cases are recorded in the state.
+	static void run(InterpreterState& _state, Dialect const& _dialect, Block const& _code);
+
+	void operator()(ExpressionStatement const& _statement) override;
+	void operator()(Assignment const& _assignment) override;
+	void operator()(VariableDeclaration const& _varDecl) override;
+	void operator()(If const& _if) override;
+	void operator()(Switch const& _switch) override;
+	void operator()(FunctionDefinition const&) override;
+	void operator()(ForLoop const&) override;
+	void operator()(Block const& _block) override;
+
+	dev::u256 valueOfVariable(YulString _name) const { return m_variables.at(_name); }
+
+private:
+	/// Opens a new scope and registers the functions defined in @a _block there,
+	/// since functions are visible in the whole block they are defined in.
+	void openScope(Block const& _block);
+	/// Closes the innermost scope and removes the variables declared in it.
+	void closeScope();
+	/// Executes the statements of @a _block inside the current scope.
+	void executeStatements(Block const& _block);
+	void declareVariable(YulString _name, dev::u256 _value);
+	/// Counts one execution step and throws if the limit is reached.
+	void countStep();
+
+	/// Evaluates the expression and assumes it returns exactly one value.
+	dev::u256 evaluate(Expression const& _expression);
+	/// Evaluates the expression and assumes it returns any number of values.
+	std::vector<dev::u256> evaluateMulti(Expression const& _expression);
+
+	Dialect const& m_dialect;
+	InterpreterState& m_state;
+	/// Values of the variables visible in the current function.
+	std::map<YulString, dev::u256> m_variables;
+	/// Functions defined in each of the enclosing blocks, outermost first.
+	std::vector<std::map<YulString, FunctionDefinition const*>> m_scopes;
+	/// Variables declared in each of the blocks of the current function.
+	std::vector<std::vector<YulString>> m_declaredVariables;
+	size_t m_callDepth = 0;
+};
+
+/**
+ * Yul expression evaluator. Arguments are evaluated from right to left, which is
+ * the order in which the code generator evaluates them.
+ */
+class ExpressionEvaluator: public ASTWalker
+{
+public:
+	ExpressionEvaluator(
+		InterpreterState& _state,
+		Dialect const& _dialect,
+		std::map<YulString, dev::u256> const& _variables,
+		std::vector<std::map<YulString, FunctionDefinition const*>> const& _scopes,
+		size_t _callDepth
+	):
+		m_state(_state),
+		m_dialect(_dialect),
+		m_variables(_variables),
+		m_scopes(_scopes),
+		m_callDepth(_callDepth)
+	{}
+
+	void operator()(Literal const&) override;
+	void operator()(Identifier const&) override;
+	void operator()(FunctionalInstruction const& _instr) override;
+	void operator()(FunctionCall const& _funCall) override;
+
+	/// Asserts that the expression has exactly one value and returns it.
+	dev::u256 value() const;
+	/// Returns the list of values of the expression.
+	std::vector<dev::u256> values() const { return m_values; }
+
+private:
+	void setValue(dev::u256 _value);
+
+	/// Evaluates the given expressions from right to left and
+	/// stores them in m_values in source order.
+	void evaluateArgs(std::vector<Expression> const& _expr);
+
+	/// @returns the definition of the function @a _name and the number of
+	/// scopes visible to its body.
+	std::pair<FunctionDefinition const*, size_t> findFunction(YulString _name) const;
+
+	InterpreterState& m_state;
+	Dialect const& m_dialect;
+	/// Values of variables.
+	std::map<YulString, dev::u256> const& m_variables;
+	/// Scopes of functions, outermost first.
+	std::vector<std::map<YulString, FunctionDefinition const*>> const& m_scopes;
+	size_t m_callDepth = 0;
+	/// Current value of the expression
+	std::vector<dev::u256> m_values;
+};
+
+}
+}
@@ -40,6 +40,7 @@
 #include <libyul/optimiser/ExpressionInliner.h>
 #include <libyul/optimiser/FullInliner.h>
 #include <libyul/optimiser/ForLoopInitRewriter.h>
+#include <libyul/optimiser/LoadResolver.h>
 #include <libyul/optimiser/MainFunction.h>
 #include <libyul/optimiser/Rematerialiser.h>
 #include <libyul/optimiser/ExpressionSimplifier.h>
@@ -48,14 +49,21 @@
 #include <libyul/optimiser/RedundantAssignEliminator.h>
 #include <libyul/optimiser/SSATransform.h>
 #include <libyul/optimiser/StructuralSimplifier.h>
+#include <libyul/optimiser/DeadStoreEliminator.h>
 #include <libyul/optimiser/VarDeclInitializer.h>
+#include <libyul/optimiser/Suite.h>
+#include <libyul/optimiser/Metrics.h>
 
 #include <libyul/backends/evm/EVMDialect.h>
 
 #include <libdevcore/JSON.h>
 
+#include <boost/filesystem.hpp>
 #include <boost/program_options.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
 #include <string>
 #include <sstream>
 #include <iostream>
@@ -67,6 +75,85 @@ using namespace dev::solidity;
 using namespace yul;
 
 namespace po = boost::program_options;
+namespace fs = boost::filesystem;
+
+/**
+ * Collects timing and size statistics for each step of the optimiser suite,
+ * aggregated by step name across all processed sources.
+ */
+class StepProfiler: public OptimiserStepObserver
+{
+public:
+	void beforeStep(string const&, yul::Block const& _ast) override
+	{
+		m_nodeCount = NodeCount::nodeCount(_ast);
+		m_codeSize = CodeSize::codeSizeIncludingFunctions(_ast);
+		m_codeCost = CodeCost::codeCost(_ast);
+		m_source = AsmPrinter{}(_ast);
+		m_start = chrono::steady_clock::now();
+	}
+
+	void afterStep(string const& _name, yul::Block const& _ast) override
+	{
+		auto duration = chrono::steady_clock::now() - m_start;
+		Statistics& stats = m_statistics[_name];
+		stats.invocations++;
+		stats.time += chrono::duration_cast<chrono::microseconds>(duration);
+		stats.nodeCountDelta += int64_t(NodeCount::nodeCount(_ast)) - int64_t(m_nodeCount);
+		stats.codeSizeDelta += int64_t(CodeSize::codeSizeIncludingFunctions(_ast)) - int64_t(m_codeSize);
+		stats.codeCostDelta += int64_t(CodeCost::codeCost(_ast)) - int64_t(m_codeCost);
+		if (AsmPrinter{}(_ast) != m_source)
+			stats.changes++;
+	}
+
+	void print(ostream& _out) const
+	{
+		vector<pair<string, Statistics>> sorted(m_statistics.begin(), m_statistics.end());
+		sort(sorted.begin(), sorted.end(), [](auto const& _a, auto const& _b) {
+			return _a.second.time > _b.second.time;
+		});
+		_out <<
+			setw(32) << left << "Step" << right <<
+			setw(8) << "Runs" <<
+			setw(9) << "Changed" <<
+			setw(12) << "Time (ms)" <<
+			setw(10) << "Nodes" <<
+			setw(10) << "Size" <<
+			setw(10) << "Cost" <<
+			endl;
+		for (auto const& entry: sorted)
+		{
+			Statistics const& stats = entry.second;
+			_out <<
+				setw(32) << left << entry.first << right <<
+				setw(8) << stats.invocations <<
+				setw(9) << stats.changes <<
+				setw(12) << fixed << setprecision(2) << double(stats.time.count()) / 1000 <<
+				setw(10) << stats.nodeCountDelta <<
+				setw(10) << stats.codeSizeDelta <<
+				setw(10) << stats.codeCostDelta <<
+				endl;
+		}
+	}
+
+private:
+	struct Statistics
+	{
+		size_t invocations = 0;
+		size_t changes = 0;
+		chrono::microseconds time{0};
+		int64_t nodeCountDelta = 0;
+		int64_t codeSizeDelta = 0;
+		int64_t codeCostDelta = 0;
+	};
+
+	map<string, Statistics> m_statistics;
+	size_t m_nodeCount = 0;
+	size_t m_codeSize = 0;
+	size_t m_codeCost = 0;
+	string m_source;
+	chrono::steady_clock::time_point m_start;
+};
 
 class YulOpti
 {
@@ -129,7 +216,8 @@ public:
 			cout << "(q)quit/(f)flatten/(c)se/initialize var(d)ecls/(x)plit/(j)oin/(g)rouper/(h)oister/" << endl;
 			cout << "  (e)xpr inline/(i)nline/(s)implify/(u)nusedprune/ss(a) transform/" << endl;
 			cout << "  (r)edundant assign elim./re(m)aterializer/f(o)r-loop-pre-rewriter/" << endl;
-			cout << "  s(t)ructural simplifier/equi(v)alent function combiner? " << endl;
+			cout << "  s(t)ructural simplifier/equi(v)alent function combiner/(l)oad resolver/" << endl;
+			cout << "  dead store elimi(n)ator? " << endl;
 			cout.flush();
 			int option = readStandardInputChar();
 			cout << ' ' << char(option) << endl;
@@ -188,6 +276,12 @@ public:
 			case 'v':
 				EquivalentFunctionCombiner::run(*m_ast);
 				break;
+			case 'l':
+				LoadResolver::run(*m_dialect, *m_ast);
+				break;
+			case 'n':
+				DeadStoreEliminator::run(*m_dialect, *m_ast);
+				break;
 			default:
 				cout << "Unknown option." << endl;
 			}
@@ -195,6 +289,16 @@ public:
 		}
 	}
 
+	/// Runs the full optimiser suite on @a _source, reporting each step to @a _profiler.
+	/// @returns false if the source could not be parsed or analyzed.
+	bool runProfiled(string const& _source, StepProfiler& _profiler)
+	{
+		if (!parse(_source))
+			return false;
+		OptimiserSuite::run(*m_dialect, *m_ast, *m_analysisInfo, {}, &_profiler);
+		return true;
+	}
+
 private:
 	ErrorList m_errors;
 	shared_ptr<yul::Block> m_ast;
@@ -220,6 +324,12 @@ Allowed options)",
 			po::value<string>(),
 			"input file"
 		)
+		(
+			"profile",
+			po::value<string>()->value_name("path"),
+			"Run the optimiser suite on all yul files in the given directory (or on the given file) "
+			"and print statistics about the individual optimiser steps."
+		)
 		("help", "Show this help screen.");
 
 	// All positional options should be interpreted as input files
@@ -239,6 +349,32 @@ Allowed options)",
 		return 1;
 	}
 
+	if (arguments.count("profile"))
+	{
+		fs::path profilePath(arguments["profile"].as<string>());
+		vector<fs::path> files;
+		if (fs::is_directory(profilePath))
+		{
+			for (auto const& entry: fs::recursive_directory_iterator(profilePath))
+				if (fs::is_regular_file(entry.path()) && entry.path().extension() == ".yul")
+					files.push_back(entry.path());
+			sort(files.begin(), files.end());
+		}
+		else
+			files.push_back(profilePath);
+
+		StepProfiler profiler;
+		size_t processed = 0;
+		for (auto const& file: files)
+			if (YulOpti{}.runProfiled(readFileAsString(file.string()), profiler))
+				processed++;
+			else
+				cout << "Skipping " << file.string() << endl;
+		cout << "Optimised " << processed << " of " << files.size() << " sources." << endl << endl;
+		profiler.print(cout);
+		return 0;
+	}
+
 	string input;
 	if (arguments.count("input-file"))
 		YulOpti{}.runInteractive(readFileAsString(arguments["input-file"].as<string>()));